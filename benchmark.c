@@ -0,0 +1,1367 @@
+/**
+ * @file benchmark.c
+ * @brief Measures the throughput of the matrix multiplication kernel against the original element-by-element implementation
+ * @author Aaron Fleisher
+ * @date 2026-10-16
+ *
+ * Usage: ./benchmark [size ...]  The exit status is 1 if any check fails, in the tables as well.
+ * Without arguments the square sizes 64, 256, 1024 and 2048 are measured, once with values 0 to 100 and once with binary values.  A last table compares the dense and the sparse (CSR) product of matrices with 0.1% nonzeros.
+ * Before timing, every kernel variant the host supports is checked for bit-identical results against the scalar fallback.  The single and double precision variants fuse their multiply-adds, so their products and dot products are only checked to agree within rounding.  The mixed precision kernels are checked too: their conversions and integer products bit for bit, the bfloat16 product within rounding.  So are sums with a null or diagonal operand and bitpacked products and conversions of narrowed and banded operands, against the same on dense copies, and determinants, against a cofactor expansion.
+ * Besides the integer tables, one table times the single and double precision products against a plain loop, another the products of int8, int16, bfloat16 and float16 operands against the single precision product, another the affine quantization pipeline: quantizing, dequantizing and the fused quantized product, and the last one stochastic rounding against rounding to nearest.
+ */
+#include <float.h>
+#include <math.h>
+
+#include "myMatrix.h"
+#include "matrix_bits.h"
+#include "matrix_double.h"
+#include "matrix_float.h"
+#include "matrix_mixed.h"
+#include "matrix_simd.h"
+#include "matrix_sparse.h"
+#include "matrix_threads.h"
+
+/**
+ * @brief The original multiplication algorithm, kept here as the baseline for comparison.  It allocates a row and a column buffer for every element of the result and gathers the column with strided reads.
+ * @param m1 The first matrix
+ * @param m2 The second matrix
+ * @return A new matrix allocated upon the heap
+ */
+static matrix_int_t*
+referenceMultiply_int(matrix_int_t *m1, matrix_int_t *m2) {
+    assert(m1->j == m2->i);
+    matrix_int_t *m = initializeMatrix_int(m1->i, m2->j);
+
+    for(size_t row_index = 0; row_index < m->i; row_index++) {
+        for(size_t column_index = 0; column_index < m->j; column_index++) {
+            int *row1_array = calloc(m1->j, sizeof(int));
+            int *column2_array = calloc(m2->i, sizeof(int));
+            memcpy(row1_array, m1->array + (m1->ld * row_index), m1->j * sizeof(int));
+            for(size_t index = 0; index < m2->i; index++) {
+                column2_array[index] = m_at_int(m2, index, column_index);
+            }
+            m->array[(row_index * m->ld) + column_index] = m_dotProduct_int(row1_array, column2_array, m1->j);
+            free(column2_array);
+            free(row1_array);
+        }
+    }
+    return m;
+}
+
+/**
+ * @brief Runs every kernel of a table on the same random inputs as the scalar table and compares the outputs bit for bit.  The lengths cover the vector widths, their tails and partial GEMM tiles.
+ * @param kernels The table to check
+ * @param scalar The scalar fallback table
+ * @return true if every output matches
+ */
+static bool
+verify_kernels(const matrix_kernels_int_t *kernels, const matrix_kernels_int_t *scalar) {
+    enum { MAX_LENGTH = 133, KC = 37 };
+    static int a1[MAX_LENGTH], a2[MAX_LENGTH], expected[MAX_LENGTH], actual[MAX_LENGTH];
+    static int a_panel[KC * MATRIX_GEMM_MR], b_panel[KC * MATRIX_GEMM_NR];
+    static int c_expected[MATRIX_GEMM_MR * (MATRIX_GEMM_NR + 3)], c_actual[MATRIX_GEMM_MR * (MATRIX_GEMM_NR + 3)];
+    const size_t ldc = MATRIX_GEMM_NR + 3;
+
+    for(size_t index = 0; index < MAX_LENGTH; index++) {
+        a1[index] = rand() - (RAND_MAX / 2);
+        a2[index] = rand() - (RAND_MAX / 2);
+    }
+    for(size_t length = 0; length <= MAX_LENGTH; length++) {
+        scalar->add(expected, a1, a2, length);
+        kernels->add(actual, a1, a2, length);
+        if(0 != memcmp(expected, actual, length * sizeof(int))) {
+            return false;
+        }
+        scalar->subtract(expected, a1, a2, length);
+        kernels->subtract(actual, a1, a2, length);
+        if(0 != memcmp(expected, actual, length * sizeof(int))) {
+            return false;
+        }
+        scalar->multiply(expected, a1, a2, length);
+        kernels->multiply(actual, a1, a2, length);
+        if(0 != memcmp(expected, actual, length * sizeof(int))) {
+            return false;
+        }
+        memcpy(expected, a1, length * sizeof(int));
+        memcpy(actual, a1, length * sizeof(int));
+        scalar->scalar_add(expected, a2[0], length);
+        kernels->scalar_add(actual, a2[0], length);
+        scalar->scalar_multiply(expected, a2[1], length);
+        kernels->scalar_multiply(actual, a2[1], length);
+        scalar->axpy(expected, a2[2], a1, length);
+        kernels->axpy(actual, a2[2], a1, length);
+        if(0 != memcmp(expected, actual, length * sizeof(int))) {
+            return false;
+        }
+        if(scalar->dot_product(a1, a2, length) != kernels->dot_product(a1, a2, length)) {
+            return false;
+        }
+        matrix_rangeSummary_int_t expected_summary, actual_summary;
+        scalar->summarize(a1, length, &expected_summary);
+        kernels->summarize(a1, length, &actual_summary);
+        if((expected_summary.bits != actual_summary.bits) || (expected_summary.sum != actual_summary.sum)
+           || (expected_summary.minimum != actual_summary.minimum) || (expected_summary.maximum != actual_summary.maximum)) {
+            return false;
+        }
+        scalar->widen_int8(expected, (const int8_t *) a1, length);
+        kernels->widen_int8(actual, (const int8_t *) a1, length);
+        if(0 != memcmp(expected, actual, length * sizeof(int))) {
+            return false;
+        }
+        scalar->widen_int16(expected, (const int16_t *) a1, length);
+        kernels->widen_int16(actual, (const int16_t *) a1, length);
+        if(0 != memcmp(expected, actual, length * sizeof(int))) {
+            return false;
+        }
+    }
+
+    static uint64_t bits1[MAX_LENGTH], bits2[MAX_LENGTH];
+    for(size_t index = 0; index < MAX_LENGTH; index++) {
+        bits1[index] = ((uint64_t) (unsigned int) a1[index] << 32) ^ (uint64_t) (unsigned int) a2[index];
+        bits2[index] = ((uint64_t) (unsigned int) a2[index] << 29) ^ (uint64_t) (unsigned int) a1[index];
+    }
+    for(size_t length = 0; length <= MAX_LENGTH; length++) {
+        if(scalar->and_popcount(bits1, bits2, length) != kernels->and_popcount(bits1, bits2, length)) {
+            return false;
+        }
+    }
+
+    for(size_t index = 0; index < KC * MATRIX_GEMM_MR; index++) {
+        a_panel[index] = rand() - (RAND_MAX / 2);
+    }
+    for(size_t index = 0; index < KC * MATRIX_GEMM_NR; index++) {
+        b_panel[index] = rand() - (RAND_MAX / 2);
+    }
+    for(size_t mr = 1; mr <= MATRIX_GEMM_MR; mr++) {
+        for(size_t nr = 1; nr <= MATRIX_GEMM_NR; nr++) {
+            for(size_t index = 0; index < MATRIX_GEMM_MR * ldc; index++) {
+                c_expected[index] = c_actual[index] = (int) index;
+            }
+            scalar->gemm_micro(KC, a_panel, b_panel, c_expected, ldc, mr, nr);
+            kernels->gemm_micro(KC, a_panel, b_panel, c_actual, ldc, mr, nr);
+            if(0 != memcmp(c_expected, c_actual, sizeof(c_expected))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Returns whether two values agree within tolerance times the given magnitude.
+ */
+static bool
+is_close(const double expected, const double actual, const double magnitude, const double tolerance) {
+    return fabs(expected - actual) <= (tolerance * magnitude);
+}
+
+/**
+ * @brief Runs every kernel of a single precision table on the same random inputs as the scalar table.  The elementwise kernels round the same way in every variant and must match bit for bit; axpy, the dot product and the micro-kernel fuse their multiply-adds and must agree within rounding.
+ * @param kernels The table to check
+ * @param scalar The scalar fallback table
+ * @return true if every output matches
+ */
+static bool
+verify_kernels_float(const matrix_kernels_float_t *kernels, const matrix_kernels_float_t *scalar) {
+    enum { MAX_LENGTH = 133, KC = 37 };
+    static float a1[MAX_LENGTH], a2[MAX_LENGTH], expected[MAX_LENGTH], actual[MAX_LENGTH];
+    static float a_panel[KC * MATRIX_GEMM_MR_FLOAT], b_panel[KC * MATRIX_GEMM_NR_FLOAT];
+    static float c_expected[MATRIX_GEMM_MR_FLOAT * (MATRIX_GEMM_NR_FLOAT + 3)], c_actual[MATRIX_GEMM_MR_FLOAT * (MATRIX_GEMM_NR_FLOAT + 3)];
+    const size_t ldc = MATRIX_GEMM_NR_FLOAT + 3;
+    const double tolerance = 4.0 * KC * FLT_EPSILON;
+
+    for(size_t index = 0; index < MAX_LENGTH; index++) {
+        a1[index] = ((float) rand() / (float) RAND_MAX) - 0.5f;
+        a2[index] = ((float) rand() / (float) RAND_MAX) - 0.5f;
+    }
+    for(size_t length = 0; length <= MAX_LENGTH; length++) {
+        scalar->add(expected, a1, a2, length);
+        kernels->add(actual, a1, a2, length);
+        if(0 != memcmp(expected, actual, length * sizeof(float))) {
+            return false;
+        }
+        scalar->subtract(expected, a1, a2, length);
+        kernels->subtract(actual, a1, a2, length);
+        scalar->scalar_multiply(expected, a2[0], length);
+        kernels->scalar_multiply(actual, a2[0], length);
+        if(0 != memcmp(expected, actual, length * sizeof(float))) {
+            return false;
+        }
+        scalar->axpy(expected, a2[1], a1, length);
+        kernels->axpy(actual, a2[1], a1, length);
+        for(size_t index = 0; index < length; index++) {
+            if(!is_close(expected[index], actual[index], 1.0, tolerance)) {
+                return false;
+            }
+        }
+        if(!is_close(scalar->dot_product(a1, a2, length), kernels->dot_product(a1, a2, length), (double) length, tolerance)) {
+            return false;
+        }
+    }
+    for(size_t index = 0; index < KC * MATRIX_GEMM_MR_FLOAT; index++) {
+        a_panel[index] = ((float) rand() / (float) RAND_MAX) - 0.5f;
+    }
+    for(size_t index = 0; index < KC * MATRIX_GEMM_NR_FLOAT; index++) {
+        b_panel[index] = ((float) rand() / (float) RAND_MAX) - 0.5f;
+    }
+    for(size_t mr = 1; mr <= MATRIX_GEMM_MR_FLOAT; mr++) {
+        for(size_t nr = 1; nr <= MATRIX_GEMM_NR_FLOAT; nr++) {
+            for(size_t index = 0; index < MATRIX_GEMM_MR_FLOAT * ldc; index++) {
+                c_expected[index] = c_actual[index] = (float) index;
+            }
+            scalar->gemm_micro(KC, a_panel, b_panel, c_expected, ldc, mr, nr);
+            kernels->gemm_micro(KC, a_panel, b_panel, c_actual, ldc, mr, nr);
+            for(size_t index = 0; index < MATRIX_GEMM_MR_FLOAT * ldc; index++) {
+                const bool written = ((index / ldc) < mr) && ((index % ldc) < nr);
+                if(written ? !is_close(c_expected[index], c_actual[index], (double) index + KC, tolerance) : (c_actual[index] != (float) index)) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Runs every kernel of a double precision table on the same random inputs as the scalar table.  See verify_kernels_float.
+ * @param kernels The table to check
+ * @param scalar The scalar fallback table
+ * @return true if every output matches
+ */
+static bool
+verify_kernels_double(const matrix_kernels_double_t *kernels, const matrix_kernels_double_t *scalar) {
+    enum { MAX_LENGTH = 133, KC = 37 };
+    static double a1[MAX_LENGTH], a2[MAX_LENGTH], expected[MAX_LENGTH], actual[MAX_LENGTH];
+    static double a_panel[KC * MATRIX_GEMM_MR_DOUBLE], b_panel[KC * MATRIX_GEMM_NR_DOUBLE];
+    static double c_expected[MATRIX_GEMM_MR_DOUBLE * (MATRIX_GEMM_NR_DOUBLE + 3)], c_actual[MATRIX_GEMM_MR_DOUBLE * (MATRIX_GEMM_NR_DOUBLE + 3)];
+    const size_t ldc = MATRIX_GEMM_NR_DOUBLE + 3;
+    const double tolerance = 4.0 * KC * DBL_EPSILON;
+
+    for(size_t index = 0; index < MAX_LENGTH; index++) {
+        a1[index] = ((double) rand() / (double) RAND_MAX) - 0.5;
+        a2[index] = ((double) rand() / (double) RAND_MAX) - 0.5;
+    }
+    for(size_t length = 0; length <= MAX_LENGTH; length++) {
+        scalar->add(expected, a1, a2, length);
+        kernels->add(actual, a1, a2, length);
+        if(0 != memcmp(expected, actual, length * sizeof(double))) {
+            return false;
+        }
+        scalar->subtract(expected, a1, a2, length);
+        kernels->subtract(actual, a1, a2, length);
+        scalar->scalar_multiply(expected, a2[0], length);
+        kernels->scalar_multiply(actual, a2[0], length);
+        if(0 != memcmp(expected, actual, length * sizeof(double))) {
+            return false;
+        }
+        scalar->axpy(expected, a2[1], a1, length);
+        kernels->axpy(actual, a2[1], a1, length);
+        for(size_t index = 0; index < length; index++) {
+            if(!is_close(expected[index], actual[index], 1.0, tolerance)) {
+                return false;
+            }
+        }
+        if(!is_close(scalar->dot_product(a1, a2, length), kernels->dot_product(a1, a2, length), (double) length, tolerance)) {
+            return false;
+        }
+    }
+    for(size_t index = 0; index < KC * MATRIX_GEMM_MR_DOUBLE; index++) {
+        a_panel[index] = ((double) rand() / (double) RAND_MAX) - 0.5;
+    }
+    for(size_t index = 0; index < KC * MATRIX_GEMM_NR_DOUBLE; index++) {
+        b_panel[index] = ((double) rand() / (double) RAND_MAX) - 0.5;
+    }
+    for(size_t mr = 1; mr <= MATRIX_GEMM_MR_DOUBLE; mr++) {
+        for(size_t nr = 1; nr <= MATRIX_GEMM_NR_DOUBLE; nr++) {
+            for(size_t index = 0; index < MATRIX_GEMM_MR_DOUBLE * ldc; index++) {
+                c_expected[index] = c_actual[index] = (double) index;
+            }
+            scalar->gemm_micro(KC, a_panel, b_panel, c_expected, ldc, mr, nr);
+            kernels->gemm_micro(KC, a_panel, b_panel, c_actual, ldc, mr, nr);
+            for(size_t index = 0; index < MATRIX_GEMM_MR_DOUBLE * ldc; index++) {
+                const bool written = ((index / ldc) < mr) && ((index % ldc) < nr);
+                if(written ? !is_close(c_expected[index], c_actual[index], (double) index + KC, tolerance) : (c_actual[index] != (double) index)) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Runs the four conversions of a mixed precision table and of the scalar table on the same inputs and compares the outputs bit for bit.
+ * @param kernels The table to check
+ * @param scalar The scalar fallback table
+ * @param patterns The 16-bit values to widen
+ * @param values The single precision values to narrow
+ * @param length The number of values, at most 2^16
+ * @return true if every output matches
+ */
+static bool
+verify_conversions_mixed(const matrix_kernels_mixed_t *kernels, const matrix_kernels_mixed_t *scalar, const uint16_t *patterns, const float *values, const size_t length) {
+    static float expected[1 << 16], actual[1 << 16];
+    static uint16_t narrow_expected[1 << 16], narrow_actual[1 << 16];
+    scalar->widen_bf16(expected, patterns, length);
+    kernels->widen_bf16(actual, patterns, length);
+    if(0 != memcmp(expected, actual, length * sizeof(float))) {
+        return false;
+    }
+    scalar->widen_fp16(expected, patterns, length);
+    kernels->widen_fp16(actual, patterns, length);
+    if(0 != memcmp(expected, actual, length * sizeof(float))) {
+        return false;
+    }
+    scalar->narrow_bf16(narrow_expected, values, length);
+    kernels->narrow_bf16(narrow_actual, values, length);
+    if(0 != memcmp(narrow_expected, narrow_actual, length * sizeof(uint16_t))) {
+        return false;
+    }
+    scalar->narrow_fp16(narrow_expected, values, length);
+    kernels->narrow_fp16(narrow_actual, values, length);
+    return 0 == memcmp(narrow_expected, narrow_actual, length * sizeof(uint16_t));
+}
+
+/**
+ * @brief Runs the affine quantization kernels of a mixed precision table and of the scalar table on the same inputs and compares the outputs bit for bit.  range is compared by value, since it may find either sign of a zero.
+ * @param kernels The table to check
+ * @param scalar The scalar fallback table
+ * @param values Single precision values of any bit pattern, at least 2 * length of them
+ * @param length The number of values, at most 2^15
+ * @return true if every output matches
+ */
+static bool
+verify_quantization_mixed(const matrix_kernels_mixed_t *kernels, const matrix_kernels_mixed_t *scalar, const float *values, const size_t length) {
+    static float expected[1 << 15], actual[1 << 15], expected_high[1 << 15], actual_high[1 << 15], inverse_scales[1 << 15];
+    static int zero_points[1 << 15];
+    static uint8_t bytes[1 << 15], narrow_expected[1 << 15], narrow_actual[1 << 15];
+    float expected_minimum = INFINITY, expected_maximum = -INFINITY, actual_minimum = INFINITY, actual_maximum = -INFINITY;
+    scalar->range(values, length, &expected_minimum, &expected_maximum);
+    kernels->range(values, length, &actual_minimum, &actual_maximum);
+    if((expected_minimum != actual_minimum) || (expected_maximum != actual_maximum)) {
+        return false;
+    }
+    memcpy(expected, values + length, length * sizeof(float));
+    memcpy(actual, values + length, length * sizeof(float));
+    memcpy(expected_high, values + length, length * sizeof(float));
+    memcpy(actual_high, values + length, length * sizeof(float));
+    scalar->range_columns(expected, expected_high, values, length);
+    kernels->range_columns(actual, actual_high, values, length);
+    if((0 != memcmp(expected, actual, length * sizeof(float))) || (0 != memcmp(expected_high, actual_high, length * sizeof(float)))) {
+        return false;
+    }
+    for(size_t index = 0; index < length; index++) {
+        inverse_scales[index] = (float) (rand() % 1000) / 7.0f;
+        zero_points[index] = (rand() % 256) - 128;
+        bytes[index] = (uint8_t) rand();
+    }
+    for(int is_signed = 0; is_signed < 2; is_signed++) {
+        const int minimum = is_signed ? INT8_MIN : 0;
+        const int maximum = is_signed ? INT8_MAX : UINT8_MAX;
+        const int zero_point = is_signed ? -3 : 131;
+        scalar->quantize(narrow_expected, values, length, inverse_scales[0], zero_point, minimum, maximum);
+        kernels->quantize(narrow_actual, values, length, inverse_scales[0], zero_point, minimum, maximum);
+        if(0 != memcmp(narrow_expected, narrow_actual, length)) {
+            return false;
+        }
+        scalar->quantize_columns(narrow_expected, values, length, inverse_scales, zero_points, minimum, maximum);
+        kernels->quantize_columns(narrow_actual, values, length, inverse_scales, zero_points, minimum, maximum);
+        if(0 != memcmp(narrow_expected, narrow_actual, length)) {
+            return false;
+        }
+        scalar->dequantize(expected, bytes, length, values[0], zero_point, is_signed);
+        kernels->dequantize(actual, bytes, length, values[0], zero_point, is_signed);
+        if(0 != memcmp(expected, actual, length * sizeof(float))) {
+            return false;
+        }
+        scalar->dequantize_columns(expected, bytes, length, values + length, zero_points, is_signed);
+        kernels->dequantize_columns(actual, bytes, length, values + length, zero_points, is_signed);
+        if(0 != memcmp(expected, actual, length * sizeof(float))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Runs the stochastic rounding kernels of a mixed precision table and of the scalar table on the same inputs and the same random words and compares the outputs bit for bit.  The inputs are taken once as they are, which covers NaN, infinities and values beyond every limit, and once scaled into a range where most values have a fraction.
+ * @param kernels The table to check
+ * @param scalar The scalar fallback table
+ * @param values Single precision values of any bit pattern, at least 2 * length of them.  The bits of the second half are the random words.
+ * @param length The number of values, at most 2^15
+ * @return true if every output matches
+ */
+static bool
+verify_stochastic_mixed(const matrix_kernels_mixed_t *kernels, const matrix_kernels_mixed_t *scalar, const float *values, const size_t length) {
+    static float moderate[1 << 15];
+    static uint32_t random[1 << 15];
+    static uint8_t bytes_expected[1 << 15], bytes_actual[1 << 15];
+    static int16_t shorts_expected[1 << 15], shorts_actual[1 << 15];
+    static uint16_t halves_expected[1 << 15], halves_actual[1 << 15];
+    memcpy(random, values + length, length * sizeof(uint32_t));
+    for(size_t index = 0; index < length; index++) {
+        moderate[index] = (float) ((random[index] % 100000u) / 37.0) - 1300.0f;
+    }
+    for(int pass = 0; pass < 2; pass++) {
+        const float *source = (0 == pass) ? values : moderate;
+        for(int is_signed = 0; is_signed < 2; is_signed++) {
+            const int minimum = is_signed ? INT8_MIN : 0;
+            const int maximum = is_signed ? INT8_MAX : UINT8_MAX;
+            scalar->stochastic_int8(bytes_expected, source, length, random, minimum, maximum);
+            kernels->stochastic_int8(bytes_actual, source, length, random, minimum, maximum);
+            if(0 != memcmp(bytes_expected, bytes_actual, length)) {
+                return false;
+            }
+        }
+        scalar->stochastic_int16(shorts_expected, source, length, random);
+        kernels->stochastic_int16(shorts_actual, source, length, random);
+        if(0 != memcmp(shorts_expected, shorts_actual, length * sizeof(int16_t))) {
+            return false;
+        }
+        scalar->stochastic_bf16(halves_expected, source, length, random);
+        kernels->stochastic_bf16(halves_actual, source, length, random);
+        if(0 != memcmp(halves_expected, halves_actual, length * sizeof(uint16_t))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Runs every kernel of a mixed precision table on the same random inputs as the scalar table.  The conversions, the quantization and stochastic rounding kernels and the int8 and int16 micro-kernels must match bit for bit, on every bit pattern of 16 bits and on every edge tile.  The bfloat16 micro-kernel, which the scalar table lacks, must agree within rounding with the product of the widened values.
+ * @param kernels The table to check
+ * @param scalar The scalar fallback table
+ * @return true if every output matches
+ */
+static bool
+verify_kernels_mixed(const matrix_kernels_mixed_t *kernels, const matrix_kernels_mixed_t *scalar) {
+    enum { PATTERNS = 1 << 16, MAX_LENGTH = 133, GROUPS = 37 };
+    static uint16_t patterns[PATTERNS];
+    static float values[PATTERNS];
+    static uint8_t a_panel[GROUPS * MATRIX_GEMM_MR_LOWP * MATRIX_LOWP_GROUP_BYTES], b_panel[GROUPS * MATRIX_GEMM_NR_LOWP * MATRIX_LOWP_GROUP_BYTES];
+    static int c_expected[MATRIX_GEMM_MR_LOWP * (MATRIX_GEMM_NR_LOWP + 3)], c_actual[MATRIX_GEMM_MR_LOWP * (MATRIX_GEMM_NR_LOWP + 3)];
+    static float f_expected[MATRIX_GEMM_MR_LOWP * (MATRIX_GEMM_NR_LOWP + 3)], f_actual[MATRIX_GEMM_MR_LOWP * (MATRIX_GEMM_NR_LOWP + 3)];
+    const size_t ldc = MATRIX_GEMM_NR_LOWP + 3;
+
+    for(size_t index = 0; index < PATTERNS; index++) {
+        patterns[index] = (uint16_t) index;
+        const uint32_t bits = ((uint32_t) rand() << 16) ^ (uint32_t) rand();
+        memcpy(&values[index], &bits, sizeof(float));
+    }
+    for(size_t length = 0; length <= MAX_LENGTH; length++) {
+        if(!verify_conversions_mixed(kernels, scalar, patterns, values, length)) {
+            return false;
+        }
+    }
+    if(!verify_conversions_mixed(kernels, scalar, patterns, values, PATTERNS)) {
+        return false;
+    }
+    for(size_t length = 0; length <= MAX_LENGTH; length++) {
+        if(!verify_quantization_mixed(kernels, scalar, values, length)) {
+            return false;
+        }
+    }
+    if(!verify_quantization_mixed(kernels, scalar, values, PATTERNS / 2)) {
+        return false;
+    }
+    for(size_t length = 0; length <= MAX_LENGTH; length++) {
+        if(!verify_stochastic_mixed(kernels, scalar, values, length)) {
+            return false;
+        }
+    }
+    if(!verify_stochastic_mixed(kernels, scalar, values, PATTERNS / 2)) {
+        return false;
+    }
+
+    for(size_t index = 0; index < sizeof(a_panel); index++) {
+        a_panel[index] = (uint8_t) rand();
+    }
+    for(size_t index = 0; index < sizeof(b_panel); index++) {
+        b_panel[index] = (uint8_t) rand();
+    }
+    for(size_t mr = 1; mr <= MATRIX_GEMM_MR_LOWP; mr++) {
+        for(size_t nr = 1; nr <= MATRIX_GEMM_NR_LOWP; nr++) {
+            for(int precision = MATRIX_PRECISION_INT8; precision <= MATRIX_PRECISION_INT16; precision++) {
+                for(size_t index = 0; index < MATRIX_GEMM_MR_LOWP * ldc; index++) {
+                    c_expected[index] = c_actual[index] = (int) index;
+                }
+                if(MATRIX_PRECISION_INT8 == precision) {
+                    scalar->gemm_int8(GROUPS, a_panel, b_panel, c_expected, ldc, mr, nr);
+                    kernels->gemm_int8(GROUPS, a_panel, b_panel, c_actual, ldc, mr, nr);
+                } else {
+                    scalar->gemm_int16(GROUPS, a_panel, b_panel, c_expected, ldc, mr, nr);
+                    kernels->gemm_int16(GROUPS, a_panel, b_panel, c_actual, ldc, mr, nr);
+                }
+                if(0 != memcmp(c_expected, c_actual, sizeof(c_expected))) {
+                    return false;
+                }
+            }
+        }
+    }
+    if(NULL == kernels->gemm_bf16) {
+        return true;
+    }
+
+    /* bfloat16 values in [-1, 1): a random sign and mantissa over a small exponent, so no product overflows */
+    uint16_t *a_bf16 = (uint16_t*) a_panel;
+    uint16_t *b_bf16 = (uint16_t*) b_panel;
+    for(size_t index = 0; index < sizeof(a_panel) / sizeof(uint16_t); index++) {
+        a_bf16[index] = (uint16_t) ((a_bf16[index] & 0x807f) | (0x3f00 - ((rand() % 4) << 7)));
+    }
+    for(size_t index = 0; index < sizeof(b_panel) / sizeof(uint16_t); index++) {
+        b_bf16[index] = (uint16_t) ((b_bf16[index] & 0x807f) | (0x3f00 - ((rand() % 4) << 7)));
+    }
+    const double tolerance = 4.0 * GROUPS * FLT_EPSILON;
+    for(size_t mr = 1; mr <= MATRIX_GEMM_MR_LOWP; mr++) {
+        for(size_t nr = 1; nr <= MATRIX_GEMM_NR_LOWP; nr++) {
+            for(size_t index = 0; index < MATRIX_GEMM_MR_LOWP * ldc; index++) {
+                f_expected[index] = f_actual[index] = (float) index;
+            }
+            for(size_t r = 0; r < mr; r++) {
+                for(size_t column = 0; column < nr; column++) {
+                    double sum = 0.0;
+                    for(size_t group = 0; group < GROUPS; group++) {
+                        for(size_t half = 0; half < 2; half++) {
+                            sum += (double) m_bfloat16ToFloat(a_bf16[(((group * MATRIX_GEMM_MR_LOWP) + r) * 2) + half]) *
+                                   (double) m_bfloat16ToFloat(b_bf16[(((group * MATRIX_GEMM_NR_LOWP) + column) * 2) + half]);
+                        }
+                    }
+                    f_expected[(r * ldc) + column] += (float) sum;
+                }
+            }
+            kernels->gemm_bf16(GROUPS, a_bf16, b_bf16, f_actual, ldc, mr, nr);
+            for(size_t index = 0; index < MATRIX_GEMM_MR_LOWP * ldc; index++) {
+                const bool written = ((index / ldc) < mr) && ((index % ldc) < nr);
+                if(written ? !is_close(f_expected[index], f_actual[index], (double) index + GROUPS, tolerance) : (f_actual[index] != (float) index)) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Adds and subtracts tall, wide and square matrices with a null operand, and a square one with a diagonal operand, and compares each result with the same sum of dense copies.  The implicit and diagonal operands are added into the diagonal of the other one, which has only min(i, j) elements when it is rectangular.
+ * @return true if every sum matches
+ */
+static bool
+verify_diagonal_sums(void) {
+    const int shapes[][2] = {{2000, 2}, {2, 2000}, {64, 64}};
+    bool equal = true;
+    for(size_t shape = 0; shape < sizeof(shapes) / sizeof(shapes[0]); shape++) {
+        const int rows = shapes[shape][0];
+        const int columns = shapes[shape][1];
+        matrix_int_t *null_matrix = generateNullMatrix_int(rows, columns);
+        matrix_int_t *b = generateRandomMatrix_int(rows, columns, -100, 100);
+        matrix_int_t *negated = createCopy_int(b);
+        m_ScalarMultiply_int(negated, -1);
+        matrix_int_t *difference = m_MatrixSubtract_int(null_matrix, b);
+        matrix_int_t *sum = m_MatrixAdd_int(b, null_matrix);
+        equal = equal && m_isEqual_int(difference, negated) && m_isEqual_int(sum, b);
+        freeMatrix_int(sum);
+        freeMatrix_int(difference);
+        freeMatrix_int(negated);
+        freeMatrix_int(b);
+        freeMatrix_int(null_matrix);
+    }
+    const int diagonal_values[] = {3, -1, 4, 1};
+    matrix_int_t *diagonal = generateDiagonalMatrix_int(4, diagonal_values);
+    matrix_int_t *dense_diagonal = createCopy_int(diagonal);
+    m_setFormat_int(dense_diagonal, MATRIX_FORMAT_DENSE);
+    matrix_int_t *b = generateRandomMatrix_int(4, 4, -100, 100);
+    matrix_int_t *expected = m_MatrixSubtract_int(dense_diagonal, b);
+    matrix_int_t *actual = m_MatrixSubtract_int(diagonal, b);
+    equal = equal && m_isEqual_int(expected, actual);
+    freeMatrix_int(actual);
+    freeMatrix_int(expected);
+    freeMatrix_int(b);
+    freeMatrix_int(dense_diagonal);
+    freeMatrix_int(diagonal);
+    return equal;
+}
+
+/**
+ * @brief Multiplies binary operands in other storages deep enough to take the bitpacked product, moves them to bitpacked storage, asks for it for a matrix that is not binary, and compares each result with the same on dense copies.
+ * @return true if every product and conversion matches
+ */
+static bool
+verify_bits_operands(void) {
+    const int n = 2 * MATRIX_BITS_MIN_DEPTH;
+    matrix_int_t *dense1 = generateRandomMatrix_int(n, n, 0, 1);
+    matrix_int_t *dense2 = generateRandomMatrix_int(n, n, 0, 1);
+    m_setFormat_int(dense1, MATRIX_FORMAT_DENSE);
+    m_setFormat_int(dense2, MATRIX_FORMAT_DENSE);
+    matrix_int_t *expected = m_MatrixMultiply_int(dense1, dense2);
+    matrix_int_t *narrow1 = createCopy_int(dense1);
+    matrix_int_t *narrow2 = createCopy_int(dense2);
+    m_setFormat_int(narrow1, MATRIX_FORMAT_NARROW);
+    m_setFormat_int(narrow2, MATRIX_FORMAT_NARROW);
+    bool equal = (MATRIX_STORAGE_INT8 == narrow1->storage) && (MATRIX_STORAGE_INT8 == narrow2->storage);
+    matrix_int_t *actual = m_MatrixMultiply_int(narrow1, narrow2);
+    equal = equal && m_isEqual_int(expected, actual);
+    freeMatrix_int(actual);
+    actual = m_MatrixMultiply_int(narrow1, dense2);
+    equal = equal && m_isEqual_int(expected, actual);
+    freeMatrix_int(actual);
+    m_setFormat_int(narrow1, MATRIX_FORMAT_BITS);
+    equal = equal && (MATRIX_STORAGE_BITS == narrow1->storage) && m_isEqual_int(narrow1, dense1);
+    /* Ones on the band of one subdiagonal and two superdiagonals, and zeros outside of it. */
+    matrix_int_t *banded = generateRandomMatrix_int(n, n, 0, 1);
+    m_setFormat_int(banded, MATRIX_FORMAT_DENSE);
+    for(int row = 0; row < n; row++) {
+        for(int column = 0; column < n; column++) {
+            if((column < row - 1) || (column > row + 2)) {
+                banded->array[((size_t) row * banded->ld) + (size_t) column] = 0;
+            }
+        }
+    }
+    banded->array[1] = 1;
+    banded->array[banded->ld] = 1;
+    m_invalidateProperties_int(banded);
+    matrix_int_t *dense_banded = createCopy_int(banded);
+    freeMatrix_int(expected);
+    expected = m_MatrixMultiply_int(dense_banded, dense2);
+    m_setFormat_int(banded, MATRIX_FORMAT_BANDED);
+    equal = equal && (MATRIX_STORAGE_BANDED == banded->storage);
+    actual = m_MatrixMultiply_int(banded, dense2);
+    equal = equal && m_isEqual_int(expected, actual);
+    freeMatrix_int(actual);
+    m_setFormat_int(banded, MATRIX_FORMAT_BITS);
+    equal = equal && (MATRIX_STORAGE_BITS == banded->storage) && m_isEqual_int(banded, dense_banded);
+    freeMatrix_int(dense_banded);
+    freeMatrix_int(banded);
+    /* A matrix that is not binary stays in the storage characterization chooses for it. */
+    matrix_int_t *values = generateRandomMatrix_int(n, n, 0, 100);
+    matrix_int_t *dense_values = createCopy_int(values);
+    m_setFormat_int(values, MATRIX_FORMAT_BITS);
+    equal = equal && (MATRIX_STORAGE_BITS != values->storage) && m_isEqual_int(values, dense_values);
+    freeMatrix_int(dense_values);
+    freeMatrix_int(values);
+    freeMatrix_int(narrow2);
+    freeMatrix_int(narrow1);
+    freeMatrix_int(expected);
+    freeMatrix_int(dense2);
+    freeMatrix_int(dense1);
+    return equal;
+}
+
+/**
+ * @brief Expands the determinant of an n x n row-major array along its first row.
+ * @param values The array, which is left as it was
+ * @param n The size, at most 7
+ * @return The determinant
+ */
+static int64_t
+cofactor_determinant(const int64_t *values, size_t n) {
+    if(0 == n) {
+        return 1;
+    }
+    int64_t minor[6 * 6];
+    int64_t determinant = 0;
+    int64_t sign = 1;
+    for(size_t skip = 0; skip < n; skip++) {
+        size_t index = 0;
+        for(size_t row = 1; row < n; row++) {
+            for(size_t column = 0; column < n; column++) {
+                if(column != skip) {
+                    minor[index++] = values[(row * n) + column];
+                }
+            }
+        }
+        determinant += sign * values[skip] * cofactor_determinant(minor, n - 1);
+        sign = -sign;
+    }
+    return determinant;
+}
+
+/**
+ * @brief Compares m_determinant_int with a cofactor expansion of the same matrix.
+ * @param m A square matrix of at most 7 x 7 elements
+ * @return true if both agree
+ */
+static bool
+check_determinant(matrix_int_t *m) {
+    int64_t values[7 * 7];
+    const size_t n = m->i;
+    for(size_t row = 0; row < n; row++) {
+        for(size_t column = 0; column < n; column++) {
+            values[(row * n) + column] = m_at_int(m, (int) row, (int) column);
+        }
+    }
+    return (int64_t) m_determinant_int(m) == cofactor_determinant(values, n);
+}
+
+/**
+ * @brief Checks the determinants of random matrices from 1 x 1 to 7 x 7 against a cofactor expansion: dense ones, ones with a zero first pivot, singular ones, and packed triangular and diagonal ones.
+ * @return true if every determinant matches
+ */
+static bool
+verify_determinants(void) {
+    bool equal = true;
+    for(int n = 1; n <= 7; n++) {
+        matrix_int_t *m = generateRandomMatrix_int(n, n, -9, 9);
+        equal = equal && check_determinant(m);
+        m->array[0] = 0;
+        m_invalidateProperties_int(m);
+        equal = equal && check_determinant(m);
+        if(n > 1) {
+            memcpy(m->array, m->array + m->ld, (size_t) n * sizeof(int));
+            m_invalidateProperties_int(m);
+            equal = equal && check_determinant(m);
+        }
+        freeMatrix_int(m);
+        matrix_int_t *upper = generateRandomMatrix_int(n, n, -9, 9);
+        for(int row = 1; row < n; row++) {
+            memset(upper->array + ((size_t) row * upper->ld), 0, (size_t) row * sizeof(int));
+        }
+        m_invalidateProperties_int(upper);
+        m_characterize_int(upper);
+        equal = equal && check_determinant(upper);
+        freeMatrix_int(upper);
+        const int diagonal_values[] = {3, -1, 4, 1, -5, 9, 2};
+        matrix_int_t *diagonal = generateDiagonalMatrix_int(n, diagonal_values);
+        equal = equal && check_determinant(diagonal);
+        freeMatrix_int(diagonal);
+    }
+    return equal;
+}
+
+/**
+ * @brief Returns a monotonic wall clock time in seconds
+ */
+static double
+now_seconds(void) {
+    struct timespec time_spec;
+    (void) clock_gettime(CLOCK_MONOTONIC, &time_spec);
+    return (double) time_spec.tv_sec + ((double) time_spec.tv_nsec * 1e-9);
+}
+
+/**
+ * @brief Times one multiplication routine on the given operands.  Small sizes are repeated until at least a fifth of a second has elapsed so that the timer resolution does not dominate.
+ * @param multiply The routine to time
+ * @param m1 The first matrix
+ * @param m2 The second matrix
+ * @param result Receives the product of the last repetition.  The caller frees it.
+ * @return Seconds per multiplication
+ */
+static double
+time_multiply(matrix_int_t* (*multiply)(matrix_int_t*, matrix_int_t*), matrix_int_t *m1, matrix_int_t *m2, matrix_int_t **result) {
+    unsigned int repetitions = 0;
+    const double start = now_seconds();
+    double elapsed = 0.0;
+    *result = NULL;
+    do {
+        if(NULL != *result) {
+            freeMatrix_int(*result);
+        }
+        *result = multiply(m1, m2);
+        repetitions++;
+        elapsed = now_seconds() - start;
+    } while(elapsed < 0.2);
+    return elapsed / repetitions;
+}
+
+/**
+ * @brief Times the reference and the library multiplication of two random n x n matrices and prints one row of the table.
+ * @param n The size of the matrices
+ * @param upper_bound The largest value.  1 gives binary matrices, which the library multiplies bitpacked.
+ * @return true if both products are equal
+ */
+static bool
+benchmark_size(const int n, const int upper_bound) {
+    matrix_int_t *m1 = generateRandomMatrix_int(n, n, 0, upper_bound);
+    matrix_int_t *m2 = generateRandomMatrix_int(n, n, 0, upper_bound);
+    matrix_int_t *reference = NULL;
+    matrix_int_t *blocked = NULL;
+
+    const double reference_seconds = time_multiply(referenceMultiply_int, m1, m2, &reference);
+    const double blocked_seconds = time_multiply(m_MatrixMultiply_int, m1, m2, &blocked);
+    const double operations = 2.0 * (double) n * (double) n * (double) n;
+    const bool equal = m_isEqual_int(reference, blocked);
+
+    (void) printf("%8d %9.3f GF/s %9.3f GF/s %9.1fx %8d\n", n,
+                  (operations / reference_seconds) * 1e-9,
+                  (operations / blocked_seconds) * 1e-9,
+                  reference_seconds / blocked_seconds,
+                  equal);
+
+    freeMatrix_int(blocked);
+    freeMatrix_int(reference);
+    freeMatrix_int(m2);
+    freeMatrix_int(m1);
+    return equal;
+}
+
+/**
+ * @brief One row of the table of values 0 to 100.  See benchmark_size.
+ */
+static bool
+benchmark_values(const int n) {
+    return benchmark_size(n, 100);
+}
+
+/**
+ * @brief One row of the table of binary values.  See benchmark_size.
+ */
+static bool
+benchmark_binary(const int n) {
+    return benchmark_size(n, 1);
+}
+
+/**
+ * @brief Times the library's dense multiplication and the sparse x sparse product of two random n x n matrices with 0.1% nonzeros, and prints one row of the table.
+ * @param n The size of the matrices
+ * @return true if both products are equal
+ */
+static bool
+benchmark_sparse(const int n) {
+    matrix_int_t *m1 = initializeMatrix_int(n, n);
+    matrix_int_t *m2 = initializeMatrix_int(n, n);
+    const size_t nonzeros = ((size_t) n * (size_t) n) / 1000;
+    for(size_t index = 0; index < nonzeros; index++) {
+        m1->array[((size_t) (rand() % n) * m1->ld) + (size_t) (rand() % n)] = 1 + (rand() % 100);
+        m2->array[((size_t) (rand() % n) * m2->ld) + (size_t) (rand() % n)] = 1 + (rand() % 100);
+    }
+    /* Kept dense even if they are characterized, they time the blocked product. */
+    m_setFormat_int(m1, MATRIX_FORMAT_DENSE);
+    m_setFormat_int(m2, MATRIX_FORMAT_DENSE);
+    matrix_int_t *blocked = NULL;
+    const double blocked_seconds = time_multiply(m_MatrixMultiply_int, m1, m2, &blocked);
+
+    matrix_sparse_t *sparse1 = m_packSparse_int(m1, MATRIX_SPARSE_CSR);
+    matrix_sparse_t *sparse2 = m_packSparse_int(m2, MATRIX_SPARSE_CSR);
+    matrix_sparse_t *product = NULL;
+    unsigned int repetitions = 0;
+    const double start = now_seconds();
+    double sparse_seconds = 0.0;
+    do {
+        freeMatrix_sparse(product);
+        product = m_MatrixMultiply_sparse(sparse1, sparse2);
+        repetitions++;
+        sparse_seconds = now_seconds() - start;
+    } while(sparse_seconds < 0.2);
+    sparse_seconds /= repetitions;
+    matrix_int_t *unpacked = m_unpackSparse_int(product);
+    const bool equal = m_isEqual_int(blocked, unpacked);
+
+    (void) printf("%8d %12.6f s %12.6f s %9.1fx %8d\n", n, blocked_seconds, sparse_seconds,
+                  blocked_seconds / sparse_seconds, equal);
+
+    freeMatrix_int(unpacked);
+    freeMatrix_sparse(product);
+    freeMatrix_sparse(sparse2);
+    freeMatrix_sparse(sparse1);
+    freeMatrix_int(blocked);
+    freeMatrix_int(m2);
+    freeMatrix_int(m1);
+    return equal;
+}
+
+/**
+ * @brief Times the blocked product of a tridiagonal and a random n x n matrix against the banded product, and prints one row of the table.
+ * @param n The size of the matrices
+ * @return true if both products are equal
+ */
+static bool
+benchmark_banded(const int n) {
+    matrix_int_t *tridiagonal = initializeMatrix_int(n, n);
+    for(size_t row = 0; row < tridiagonal->i; row++) {
+        for(size_t column = (row > 0) ? (row - 1) : 0; (column <= (row + 1)) && (column < tridiagonal->j); column++) {
+            tridiagonal->array[(row * tridiagonal->ld) + column] = 1 + (rand() % 100);
+        }
+    }
+    matrix_int_t *dense = generateRandomMatrix_int(n, n, 0, 100);
+    m_setFormat_int(dense, MATRIX_FORMAT_DENSE);
+    /* Kept dense, the tridiagonal matrix times the blocked product; then it moves to banded storage. */
+    m_setFormat_int(tridiagonal, MATRIX_FORMAT_DENSE);
+    matrix_int_t *blocked = NULL;
+    const double blocked_seconds = time_multiply(m_MatrixMultiply_int, tridiagonal, dense, &blocked);
+    m_setFormat_int(tridiagonal, MATRIX_FORMAT_BANDED);
+    matrix_int_t *banded = NULL;
+    const double banded_seconds = time_multiply(m_MatrixMultiply_int, tridiagonal, dense, &banded);
+    const bool equal = m_isEqual_int(blocked, banded);
+
+    (void) printf("%8d %12.6f s %12.6f s %9.1fx %8d\n", n, blocked_seconds, banded_seconds,
+                  blocked_seconds / banded_seconds, equal);
+
+    freeMatrix_int(banded);
+    freeMatrix_int(blocked);
+    freeMatrix_int(dense);
+    freeMatrix_int(tridiagonal);
+    return equal;
+}
+
+/**
+ * @brief Multiplies two single precision matrices with the plain i-k-j loop, which the compiler vectorizes but does not block.  It is the baseline of the floating point table.
+ */
+static matrix_float_t*
+loopMultiply_float(matrix_float_t *m1, matrix_float_t *m2) {
+    matrix_float_t *m = initializeMatrix_float(m1->i, m2->j);
+    for(size_t row = 0; row < m1->i; row++) {
+        float *destination = m->array + (row * m->ld);
+        for(size_t k = 0; k < m1->j; k++) {
+            const float a = m1->array[(row * m1->ld) + k];
+            const float *source = m2->array + (k * m2->ld);
+            for(size_t column = 0; column < m2->j; column++) {
+                destination[column] += a * source[column];
+            }
+        }
+    }
+    return m;
+}
+
+/**
+ * @brief Multiplies two double precision matrices with the plain i-k-j loop.  See loopMultiply_float.
+ */
+static matrix_double_t*
+loopMultiply_double(matrix_double_t *m1, matrix_double_t *m2) {
+    matrix_double_t *m = initializeMatrix_double(m1->i, m2->j);
+    for(size_t row = 0; row < m1->i; row++) {
+        double *destination = m->array + (row * m->ld);
+        for(size_t k = 0; k < m1->j; k++) {
+            const double a = m1->array[(row * m1->ld) + k];
+            const double *source = m2->array + (k * m2->ld);
+            for(size_t column = 0; column < m2->j; column++) {
+                destination[column] += a * source[column];
+            }
+        }
+    }
+    return m;
+}
+
+/**
+ * @brief Times the plain loop and the blocked product of two random n x n matrices, in single and in double precision, and prints one row of the table for each.  The last column tells whether the two products agree within n times the machine epsilon of the values, which lie in [-1, 1].
+ * @param n The size of the matrices
+ * @return true if the products agree in both precisions
+ */
+static bool
+benchmark_floating(const int n) {
+    const double operations = 2.0 * (double) n * (double) n * (double) n;
+    matrix_float_t *f1 = generateRandomMatrix_float(n, n, -1.0f, 1.0f);
+    matrix_float_t *f2 = generateRandomMatrix_float(n, n, -1.0f, 1.0f);
+    matrix_float_t *f_loop = NULL;
+    matrix_float_t *f_blocked = NULL;
+    unsigned int repetitions = 0;
+    double start = now_seconds();
+    double loop_seconds = 0.0;
+    do {
+        if(NULL != f_loop) {
+            freeMatrix_float(f_loop);
+        }
+        f_loop = loopMultiply_float(f1, f2);
+        repetitions++;
+        loop_seconds = now_seconds() - start;
+    } while(loop_seconds < 0.2);
+    loop_seconds /= repetitions;
+    repetitions = 0;
+    start = now_seconds();
+    double blocked_seconds = 0.0;
+    do {
+        if(NULL != f_blocked) {
+            freeMatrix_float(f_blocked);
+        }
+        f_blocked = m_MatrixMultiply_float(f1, f2);
+        repetitions++;
+        blocked_seconds = now_seconds() - start;
+    } while(blocked_seconds < 0.2);
+    blocked_seconds /= repetitions;
+    bool close = true;
+    for(size_t row = 0; row < f_loop->i; row++) {
+        for(size_t column = 0; column < f_loop->j; column++) {
+            close &= is_close(m_at_float(f_loop, row, column), m_at_float(f_blocked, row, column), (double) n, (double) n * FLT_EPSILON);
+        }
+    }
+    (void) printf("%8d %8s %9.3f GF/s %9.3f GF/s %9.1fx %8d\n", n, "float",
+                  (operations / loop_seconds) * 1e-9, (operations / blocked_seconds) * 1e-9, loop_seconds / blocked_seconds, close);
+    freeMatrix_float(f_blocked);
+    freeMatrix_float(f_loop);
+    freeMatrix_float(f2);
+    freeMatrix_float(f1);
+
+    matrix_double_t *d1 = generateRandomMatrix_double(n, n, -1.0, 1.0);
+    matrix_double_t *d2 = generateRandomMatrix_double(n, n, -1.0, 1.0);
+    matrix_double_t *d_loop = NULL;
+    matrix_double_t *d_blocked = NULL;
+    repetitions = 0;
+    start = now_seconds();
+    do {
+        if(NULL != d_loop) {
+            freeMatrix_double(d_loop);
+        }
+        d_loop = loopMultiply_double(d1, d2);
+        repetitions++;
+        loop_seconds = now_seconds() - start;
+    } while(loop_seconds < 0.2);
+    loop_seconds /= repetitions;
+    repetitions = 0;
+    start = now_seconds();
+    do {
+        if(NULL != d_blocked) {
+            freeMatrix_double(d_blocked);
+        }
+        d_blocked = m_MatrixMultiply_double(d1, d2);
+        repetitions++;
+        blocked_seconds = now_seconds() - start;
+    } while(blocked_seconds < 0.2);
+    blocked_seconds /= repetitions;
+    const bool float_close = close;
+    close = true;
+    for(size_t row = 0; row < d_loop->i; row++) {
+        for(size_t column = 0; column < d_loop->j; column++) {
+            close &= is_close(m_at_double(d_loop, row, column), m_at_double(d_blocked, row, column), (double) n, (double) n * DBL_EPSILON);
+        }
+    }
+    (void) printf("%8d %8s %9.3f GF/s %9.3f GF/s %9.1fx %8d\n", n, "double",
+                  (operations / loop_seconds) * 1e-9, (operations / blocked_seconds) * 1e-9, loop_seconds / blocked_seconds, close);
+    freeMatrix_double(d_blocked);
+    freeMatrix_double(d_loop);
+    freeMatrix_double(d2);
+    freeMatrix_double(d1);
+    return float_close && close;
+}
+
+/**
+ * @brief Times the single precision product of two random n x n matrices against the products of the same values narrowed to int8, int16, bfloat16 and float16, and prints one row of the table for each.  The integer operands are whole numbers in [-100, 100] and must multiply exactly, like m_MatrixMultiply_int; the floating operands lie in [-1, 1] and must agree within n times the machine epsilon with the single precision product of their widened values.
+ * @param n The size of the matrices
+ * @return true if every product agrees
+ */
+static bool
+benchmark_mixed(const int n) {
+    const double operations = 2.0 * (double) n * (double) n * (double) n;
+    matrix_int_t *i1 = generateRandomMatrix_int(n, n, -100, 100);
+    matrix_int_t *i2 = generateRandomMatrix_int(n, n, -100, 100);
+    matrix_float_t *f1 = generateRandomMatrix_float(n, n, -1.0f, 1.0f);
+    matrix_float_t *f2 = generateRandomMatrix_float(n, n, -1.0f, 1.0f);
+    matrix_float_t *f_product = NULL;
+    unsigned int repetitions = 0;
+    double start = now_seconds();
+    double float_seconds = 0.0;
+    do {
+        if(NULL != f_product) {
+            freeMatrix_float(f_product);
+        }
+        f_product = m_MatrixMultiply_float(f1, f2);
+        repetitions++;
+        float_seconds = now_seconds() - start;
+    } while(float_seconds < 0.2);
+    float_seconds /= repetitions;
+    (void) printf("%8d %8s %9.3f GF/s %10.1fx %8d\n", n, "float", (operations / float_seconds) * 1e-9, 1.0, 1);
+    freeMatrix_float(f_product);
+
+    matrix_int_t *i_expected = m_MatrixMultiply_int(i1, i2);
+    bool passed = true;
+    const matrix_precision_t precisions[] = {MATRIX_PRECISION_INT8, MATRIX_PRECISION_INT16, MATRIX_PRECISION_BF16, MATRIX_PRECISION_FP16};
+    const char *names[] = {"int8", "int16", "bf16", "fp16"};
+    for(size_t index = 0; index < sizeof(precisions) / sizeof(precisions[0]); index++) {
+        const bool integer = (MATRIX_PRECISION_INT8 == precisions[index]) || (MATRIX_PRECISION_INT16 == precisions[index]);
+        matrix_lowp_t *l1 = integer ? m_fromInt_lowp(precisions[index], i1) : m_fromFloat_lowp(precisions[index], f1);
+        matrix_lowp_t *l2 = integer ? m_fromInt_lowp(precisions[index], i2) : m_fromFloat_lowp(precisions[index], f2);
+        matrix_int_t *i_product = NULL;
+        f_product = NULL;
+        repetitions = 0;
+        start = now_seconds();
+        double seconds = 0.0;
+        do {
+            if(integer) {
+                if(NULL != i_product) {
+                    freeMatrix_int(i_product);
+                }
+                i_product = m_MatrixMultiplyToInt_lowp(l1, l2);
+            } else {
+                if(NULL != f_product) {
+                    freeMatrix_float(f_product);
+                }
+                f_product = m_MatrixMultiplyToFloat_lowp(l1, l2);
+            }
+            repetitions++;
+            seconds = now_seconds() - start;
+        } while(seconds < 0.2);
+        seconds /= repetitions;
+        bool close = true;
+        if(integer) {
+            close = m_isEqual_int(i_expected, i_product);
+            freeMatrix_int(i_product);
+        } else {
+            matrix_float_t *w1 = m_toFloat_lowp(l1);
+            matrix_float_t *w2 = m_toFloat_lowp(l2);
+            matrix_float_t *f_expected = m_MatrixMultiply_float(w1, w2);
+            for(size_t row = 0; row < f_expected->i; row++) {
+                for(size_t column = 0; column < f_expected->j; column++) {
+                    close &= is_close(m_at_float(f_expected, row, column), m_at_float(f_product, row, column), (double) n, (double) n * FLT_EPSILON);
+                }
+            }
+            freeMatrix_float(f_expected);
+            freeMatrix_float(w2);
+            freeMatrix_float(w1);
+            freeMatrix_float(f_product);
+        }
+        (void) printf("%8d %8s %9.3f GF/s %10.1fx %8d\n", n, names[index], (operations / seconds) * 1e-9, float_seconds / seconds, close);
+        passed &= close;
+        freeMatrix_lowp(l2);
+        freeMatrix_lowp(l1);
+    }
+    freeMatrix_int(i_expected);
+    freeMatrix_float(f2);
+    freeMatrix_float(f1);
+    freeMatrix_int(i2);
+    freeMatrix_int(i1);
+    return passed;
+}
+
+/**
+ * @brief Times one step of the affine quantization pipeline on n x n operands: 0 quantizes m per column, 1 dequantizes q1, 2 multiplies q1 by q2 into uint8 with the given mapping.
+ * @return The seconds per call
+ */
+static double
+time_quantized(const int step, const matrix_float_t *m, const matrix_quantized_t *q1, const matrix_quantized_t *q2, const float scale, const int zero_point) {
+    unsigned int repetitions = 0;
+    const double start = now_seconds();
+    double seconds = 0.0;
+    do {
+        if(0 == step) {
+            freeMatrix_quantized(m_fromFloat_quantized(MATRIX_PRECISION_INT8, MATRIX_QUANT_COLUMNS, m));
+        } else if(1 == step) {
+            freeMatrix_float(m_toFloat_quantized(q1));
+        } else {
+            freeMatrix_quantized(m_MatrixMultiply_quantized(q1, q2, MATRIX_PRECISION_UINT8, scale, zero_point));
+        }
+        repetitions++;
+        seconds = now_seconds() - start;
+    } while(seconds < 0.2);
+    return seconds / repetitions;
+}
+
+/**
+ * @brief Times the affine quantization pipeline on two random n x n matrices: uint8 activations quantized per tensor times int8 weights quantized per column.  Quantizing and dequantizing are rated in bytes of single precision values per second, and the fused product against the single precision product of the dequantized operands.  The quantized values must lie within half a step of the originals, up to rounding, the dequantized ones must match m_at_quantized, and the fused product must lie within 1 of the single precision product quantized with the same mapping.
+ * @param n The size of the matrices
+ * @return true if every step passes its check
+ */
+static bool
+benchmark_quantized(const int n) {
+    const double bytes = 4.0 * (double) n * (double) n;
+    const double operations = 2.0 * (double) n * (double) n * (double) n;
+    matrix_float_t *activations = generateRandomMatrix_float(n, n, 0.0f, 6.0f);
+    matrix_float_t *weights = generateRandomMatrix_float(n, n, -1.0f, 1.0f);
+    matrix_quantized_t *q_activations = m_fromFloat_quantized(MATRIX_PRECISION_UINT8, MATRIX_QUANT_TENSOR, activations);
+    matrix_quantized_t *q_weights = m_fromFloat_quantized(MATRIX_PRECISION_INT8, MATRIX_QUANT_COLUMNS, weights);
+    matrix_float_t *d_activations = m_toFloat_quantized(q_activations);
+    matrix_float_t *d_weights = m_toFloat_quantized(q_weights);
+
+    bool close = true;
+    for(size_t row = 0; row < weights->i; row++) {
+        for(size_t column = 0; column < weights->j; column++) {
+            close &= is_close(m_at_float(weights, row, column), m_at_float(d_weights, row, column), q_weights->scales[column], 0.5001);
+        }
+    }
+    double seconds = time_quantized(0, weights, NULL, NULL, 0.0f, 0);
+    (void) printf("%8d %12s %9.3f GB/s %8d\n", n, "quantize", (bytes / seconds) * 1e-9, close);
+    bool equal = true;
+    for(size_t row = 0; row < weights->i; row++) {
+        for(size_t column = 0; column < weights->j; column++) {
+            equal &= (m_at_float(d_weights, row, column) == m_at_quantized(q_weights, row, column));
+        }
+    }
+    seconds = time_quantized(1, NULL, q_weights, NULL, 0.0f, 0);
+    (void) printf("%8d %12s %9.3f GB/s %8d\n", n, "dequantize", (bytes / seconds) * 1e-9, equal);
+
+    matrix_float_t *reference = NULL;
+    unsigned int repetitions = 0;
+    double start = now_seconds();
+    double float_seconds = 0.0;
+    do {
+        if(NULL != reference) {
+            freeMatrix_float(reference);
+        }
+        reference = m_MatrixMultiply_float(d_activations, d_weights);
+        repetitions++;
+        float_seconds = now_seconds() - start;
+    } while(float_seconds < 0.2);
+    float_seconds /= repetitions;
+    (void) printf("%8d %12s %9.3f GF/s %8d\n", n, "float gemm", (operations / float_seconds) * 1e-9, 1);
+    matrix_quantized_t *q_reference = m_fromFloat_quantized(MATRIX_PRECISION_UINT8, MATRIX_QUANT_TENSOR, reference);
+    const float scale = q_reference->scales[0];
+    const int zero_point = q_reference->zero_points[0];
+    matrix_quantized_t *product = m_MatrixMultiply_quantized(q_activations, q_weights, MATRIX_PRECISION_UINT8, scale, zero_point);
+    const bool passed = close && equal;
+    close = true;
+    for(size_t row = 0; row < reference->i; row++) {
+        for(size_t column = 0; column < reference->j; column++) {
+            close &= is_close(m_at_lowp(q_reference->values, row, column), m_at_lowp(product->values, row, column), 1.0, 1.0);
+        }
+    }
+    seconds = time_quantized(2, NULL, q_activations, q_weights, scale, zero_point);
+    (void) printf("%8d %12s %9.3f GF/s %8d %9.1fx\n", n, "uint8 gemm", (operations / seconds) * 1e-9, close, float_seconds / seconds);
+
+    freeMatrix_quantized(product);
+    freeMatrix_quantized(q_reference);
+    freeMatrix_float(reference);
+    freeMatrix_float(d_weights);
+    freeMatrix_float(d_activations);
+    freeMatrix_quantized(q_weights);
+    freeMatrix_quantized(q_activations);
+    freeMatrix_float(weights);
+    freeMatrix_float(activations);
+    return passed && close;
+}
+
+/**
+ * @brief Times one narrowing of an n x n matrix, to nearest or stochastic.
+ * @return The seconds per call
+ */
+static double
+time_stochastic(const bool stochastic, const matrix_precision_t precision, const matrix_float_t *m) {
+    unsigned int repetitions = 0;
+    const double start = now_seconds();
+    double seconds = 0.0;
+    do {
+        freeMatrix_lowp(stochastic ? m_fromFloatStochastic_lowp(precision, m) : m_fromFloat_lowp(precision, m));
+        repetitions++;
+        seconds = now_seconds() - start;
+    } while(seconds < 0.2);
+    return seconds / repetitions;
+}
+
+/**
+ * @brief Times stochastic rounding against rounding to nearest for int8, int16 and bfloat16, in bytes of single precision values per second.  Every stochastic value must be one of the two neighbours of its original, and the mean rounding error must stay within 6 standard deviations of 0, where rounding to nearest would leave a bias: the integer inputs all sit a quarter above an integer and the bfloat16 inputs a quarter of a step above a bfloat16 value.
+ * @param n The size of the matrix
+ * @return true if rounding is unbiased for every type
+ */
+static bool
+benchmark_stochastic(const int n) {
+    const matrix_precision_t precisions[] = {MATRIX_PRECISION_INT8, MATRIX_PRECISION_INT16, MATRIX_PRECISION_BF16};
+    const char *names[] = {"int8", "int16", "bf16"};
+    const double bytes = 4.0 * (double) n * (double) n;
+    matrix_float_t *m = initializeMatrix_float(n, n);
+    bool passed = true;
+    m_seedStochastic_lowp(1234);
+    for(int index = 0; index < 3; index++) {
+        const bool is_bf16 = (MATRIX_PRECISION_BF16 == precisions[index]);
+        const float step = is_bf16 ? (1.0f / 128.0f) : 1.0f;
+        for(size_t row = 0; row < m->i; row++) {
+            for(size_t column = 0; column < m->j; column++) {
+                const float base = is_bf16 ? (1.0f + (step * (float) (rand() % 128))) : (float) ((rand() % 200) - 100);
+                m->array[(row * m->ld) + column] = base + (0.25f * step);
+            }
+        }
+        m_invalidateProperties_float(m);
+        matrix_lowp_t *narrow = m_fromFloatStochastic_lowp(precisions[index], m);
+        bool close = true;
+        double error = 0.0;
+        for(size_t row = 0; row < m->i; row++) {
+            for(size_t column = 0; column < m->j; column++) {
+                const double difference = (double) m_at_lowp(narrow, row, column) - (double) m_at_float(m, row, column);
+                close &= (fabs(difference) < step);
+                error += difference;
+            }
+        }
+        const double count = (double) n * (double) n;
+        close &= (fabs(error / count) < ((6.0 * 0.5 * step) / sqrt(count)));
+        freeMatrix_lowp(narrow);
+        const double nearest_seconds = time_stochastic(false, precisions[index], m);
+        const double stochastic_seconds = time_stochastic(true, precisions[index], m);
+        (void) printf("%8d %8s %9.3f GB/s %9.3f GB/s %8d\n", n, names[index], (bytes / nearest_seconds) * 1e-9, (bytes / stochastic_seconds) * 1e-9, close);
+        passed &= close;
+    }
+    freeMatrix_float(m);
+    return passed;
+}
+
+/**
+ * @brief One table of the benchmark: its title, its column headers, and the function that measures one size and prints its row.
+ */
+typedef struct Benchmark_table_s {
+    const char *title;
+    const char *header;
+    bool (*run)(const int n);
+} benchmark_table_t;
+
+int
+main(int argument_count, char **argument_vector) {
+    const int default_sizes[] = {64, 256, 1024, 2048};
+    const int default_count = sizeof(default_sizes) / sizeof(default_sizes[0]);
+    const int size_count = (argument_count > 1) ? (argument_count - 1) : default_count;
+
+    const matrix_kernels_int_t *scalar = m_kernelsForIsa_int(MATRIX_ISA_SCALAR);
+    for(int isa = MATRIX_ISA_SCALAR; isa < MATRIX_ISA_COUNT; isa++) {
+        const matrix_kernels_int_t *kernels = m_kernelsForIsa_int((matrix_isa_t) isa);
+        if(NULL == kernels) {
+            continue;
+        }
+        const bool identical = verify_kernels(kernels, scalar);
+        (void) printf("kernels %-15s %s%s\n", kernels->name, identical ? "bit-identical" : "MISMATCH",
+                      (kernels == m_kernels_int()) ? " (active)" : "");
+        if(!identical) {
+            return 1;
+        }
+    }
+    const matrix_kernels_float_t *scalar_float = m_kernelsForIsa_float(MATRIX_ISA_SCALAR);
+    const matrix_kernels_double_t *scalar_double = m_kernelsForIsa_double(MATRIX_ISA_SCALAR);
+    for(int isa = MATRIX_ISA_SCALAR; isa < MATRIX_ISA_COUNT; isa++) {
+        const matrix_kernels_float_t *kernels_float = m_kernelsForIsa_float((matrix_isa_t) isa);
+        const matrix_kernels_double_t *kernels_double = m_kernelsForIsa_double((matrix_isa_t) isa);
+        if((NULL == kernels_float) || (NULL == kernels_double)) {
+            continue;
+        }
+        const bool close = verify_kernels_float(kernels_float, scalar_float) && verify_kernels_double(kernels_double, scalar_double);
+        (void) printf("kernels %-15s %s%s\n", kernels_float->name, close ? "float and double within rounding" : "MISMATCH",
+                      (kernels_float == m_kernels_float()) ? " (active)" : "");
+        if(!close) {
+            return 1;
+        }
+    }
+    const matrix_kernels_mixed_t *scalar_mixed = m_kernelsForIsa_mixed(MATRIX_ISA_SCALAR);
+    for(int isa = MATRIX_ISA_SCALAR; isa < MATRIX_ISA_COUNT; isa++) {
+        const matrix_kernels_mixed_t *kernels_mixed = m_kernelsForIsa_mixed((matrix_isa_t) isa);
+        if(NULL == kernels_mixed) {
+            continue;
+        }
+        const bool identical = verify_kernels_mixed(kernels_mixed, scalar_mixed);
+        (void) printf("kernels %-15s %s%s\n", kernels_mixed->name, identical ? "mixed precision bit-identical" : "MISMATCH",
+                      (kernels_mixed == m_kernels_mixed()) ? " (active)" : "");
+        if(!identical) {
+            return 1;
+        }
+    }
+
+    const bool sums = verify_diagonal_sums();
+    (void) printf("sums     %s\n", sums ? "null and diagonal operands equal to dense" : "MISMATCH");
+    if(!sums) {
+        return 1;
+    }
+
+    const bool bits = verify_bits_operands();
+    (void) printf("bits     %s\n", bits ? "narrowed and banded operands equal to dense" : "MISMATCH");
+    if(!bits) {
+        return 1;
+    }
+
+    const bool determinants = verify_determinants();
+    (void) printf("det      %s\n", determinants ? "equal to a cofactor expansion" : "MISMATCH");
+    if(!determinants) {
+        return 1;
+    }
+
+    (void) printf("threads  %zu (set %s to change)\n", m_getThreadCount(), MATRIX_THREADS_ENVIRONMENT);
+    const benchmark_table_t tables[] = {
+        {"values 0 to 100", "       n      reference        blocked    speedup    equal", benchmark_values},
+        {"values 0 to 1", "       n      reference        blocked    speedup    equal", benchmark_binary},
+        {"0.1% nonzero", "       n        blocked         sparse    speedup    equal", benchmark_sparse},
+        {"tridiagonal x dense", "       n        blocked         banded    speedup    equal", benchmark_banded},
+        {"single and double precision", "       n     type           loop        blocked    speedup    close", benchmark_floating},
+        {"mixed precision operands", "       n     type        product    vs float    close", benchmark_mixed},
+        {"affine quantization, uint8 activations x int8 weights per column", "       n         step           rate    check   vs float", benchmark_quantized},
+        {"stochastic rounding from single precision", "       n     type        nearest     stochastic unbiased", benchmark_stochastic},
+    };
+    bool passed = true;
+    for(size_t table = 0; table < sizeof(tables) / sizeof(tables[0]); table++) {
+        (void) printf("%s\n%s\n", tables[table].title, tables[table].header);
+        for(int size_index = 0; size_index < size_count; size_index++) {
+            const int n = (argument_count > 1) ? atoi(argument_vector[size_index + 1]) : default_sizes[size_index];
+            if(n > 0) {
+                passed &= tables[table].run(n);
+            }
+        }
+    }
+    return passed ? 0 : 1;
+}
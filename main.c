@@ -4,10 +4,15 @@
  * @author Aaron Fleisher
  * @date 2026-01-23
  * 
- * @todo Find a better way to hold the allocations in memory, perhaps an arena or pool.
- * @todo Use discriminated unions to make an easier way to use matrices of different types
+ * The last examples go through matrix_t, the tagged handle for matrices of every element type (see matrix_generic.h), and the low precision, quantized and stochastically rounded matrices of matrix_mixed.h.
  */
 #include "myMatrix.h"
+#include "matrix_pool.h"
+#include "matrix_sparse.h"
+#include "matrix_float.h"
+#include "matrix_double.h"
+#include "matrix_generic.h"
+#include "matrix_mixed.h"
 
 int
 main(int argument_count, char **argument_vector) {
@@ -52,6 +57,19 @@ main(int argument_count, char **argument_vector) {
     (void) printf("\n");
     free(row2_matrix2);
 
+    /* Views share the storage of matrix 2, so slicing it costs neither an allocation nor a copy. */
+    matrix_int_t column2_view = m_columnView_int(m2, 1);
+    (void) printf("\nColumn 2 of matrix 2 as a view: ");
+    for(int index = 0; index < column2_view.i; index++) {
+        (void) printf("%d ", m_at_int(&column2_view, index, 0));
+    }
+    (void) printf("\n");
+    matrix_int_t block_view = m_blockView_int(m2, 1, 1, 2, 2);
+    matrix_int_t *block_square = m_MatrixMultiply_int(&block_view, &block_view);
+    (void) printf("\tLower right 2 x 2 block of matrix 2, squared:\n");
+    printMatrix_int(block_square);
+    freeMatrix_int(block_square);
+
     (void) printf("\tTest equality between m1 and m2: %d\n", m_isEqual_int(m, m2));
 
     matrix_int_t *test_multiplication = m_MatrixMultiply_int(m, m2);
@@ -120,6 +138,114 @@ main(int argument_count, char **argument_vector) {
     (void) printf("\tTest Generate identity matrix, 4 x 4:\n");
     printMatrix_int(test_identity_m);
 
+    /* Identity, null and scalar matrices are implicit: a header without an element array, whatever their size. */
+    matrix_int_t *huge_identity = generateIdentityMatrix_int(100000);
+    matrix_int_t *huge_square = m_MatrixMultiply_int(huge_identity, huge_identity);
+    (void) printf("\tIdentity 100k x 100k squared: %zu header bytes, at [7, 7] : %d\n", sizeof(*huge_square), m_at_int(huge_square, 7, 7));
+    freeMatrix_int(huge_square);
+    freeMatrix_int(huge_identity);
+    matrix_int_t *triple = generateScalarMatrix_int(4, 3);
+    matrix_int_t *tripled = m_MatrixMultiply_int(triple, random_matrix);
+    (void) printf("\tTest 3I x random matrix 4 x 4:\n");
+    printMatrix_int(tripled);
+    freeMatrix_int(tripled);
+    freeMatrix_int(triple);
+
+    /* A diagonal matrix keeps only its diagonal, and multiplying by it scales rows (on the left) or columns (on the right). */
+    const int scales[4] = {1, 2, 3, 4};
+    matrix_int_t *scale = generateDiagonalMatrix_int(4, scales);
+    matrix_int_t *scaled_columns = m_MatrixMultiply_int(random_matrix, scale);
+    (void) printf("\tTest random matrix 4 x 4 x diag(1, 2, 3, 4):\n");
+    printMatrix_int(scaled_columns);
+    freeMatrix_int(scaled_columns);
+    freeMatrix_int(scale);
+
+    /* Characterizing a triangular matrix packs it into its n(n + 1)/2 values.  Multiplying by it skips the zero half, and solving with it undoes the product. */
+    const int unit_lower_array[16] = {1, 0, 0, 0,
+                                      2, 1, 0, 0,
+                                      -1, 3, 1, 0,
+                                      4, 0, -2, 1};
+    matrix_int_t *unit_lower = initializeMatrix_int(4, 4);
+    copyArrayToMatrix_int(unit_lower, unit_lower_array, 16);
+    m_characterize_int(unit_lower);
+    (void) printf("\tUnit lower triangular matrix:\n");
+    printMatrix_int(unit_lower);
+    matrix_int_t *lower_product = m_MatrixMultiply_int(unit_lower, random_matrix);
+    matrix_int_t *solved = m_TriangularSolve_int(unit_lower, lower_product);
+    (void) printf("\tL x random matrix solved back for the random matrix: %d\n", m_isEqual_int(solved, random_matrix));
+    freeMatrix_int(solved);
+    freeMatrix_int(lower_product);
+    freeMatrix_int(unit_lower);
+
+    /* The Gram matrix M^T x M is symmetric: only its upper triangle is computed, and only that triangle is stored. */
+    matrix_int_t *observations = generateRandomMatrix_int(6, 4, -3, 3);
+    matrix_int_t *gram = m_SymmetricRankK_int(observations, true);
+    (void) printf("\tGram matrix of a random 6 x 4 matrix:\n");
+    printMatrix_int(gram);
+    freeMatrix_int(gram);
+    freeMatrix_int(observations);
+
+    /* A graph with a handful of edges is stored as its nonzeros alone, and its powers count the walks between nodes without touching the zeros. */
+    matrix_int_t *graph = initializeMatrix_int(6, 6);
+    const int edges[7][2] = {{0, 1}, {1, 2}, {2, 0}, {2, 3}, {3, 4}, {4, 5}, {5, 3}};
+    for(int edge = 0; edge < 7; edge++) {
+        graph->array[(edges[edge][0] * graph->ld) + edges[edge][1]] = 1;
+    }
+    matrix_sparse_t *adjacency = m_packSparse_int(graph, MATRIX_SPARSE_CSR);
+    matrix_sparse_t *walks = m_MatrixMultiply_sparse(adjacency, adjacency);
+    (void) printf("\tSparse graph of %zu edges, walks of length 2 from node 2 to node 4 : %d, to node 0 : %d\n", adjacency->nnz, m_at_sparse(walks, 2, 4), m_at_sparse(walks, 2, 0));
+    freeMatrix_sparse(walks);
+    freeMatrix_sparse(adjacency);
+    freeMatrix_int(graph);
+
+    /* Characterization picks the smallest storage: a path through 1000 nodes has 999 edges, all on the diagonal above the main one, so its adjacency matrix moves to banded storage, which takes 8 bytes a node where compressed sparse rows would take 16. */
+    matrix_int_t *path = initializeMatrix_int(1000, 1000);
+    for(size_t node = 0; (node + 1) < path->i; node++) {
+        path->array[(node * path->ld) + node + 1] = 1;
+    }
+    m_characterize_int(path);
+    matrix_structure_int_t structure;
+    m_structure_int(path, &structure);
+    matrix_int_t *path_walks = m_MatrixMultiply_int(path, path);
+    (void) printf("\tPath graph of %zu edges, upper bandwidth %zu, banded: %d, walks of length 2 from node 0 to node 2 : %d\n", structure.nonzeros, structure.upper_bandwidth, MATRIX_STORAGE_BANDED == structure.storage, m_at_int(path_walks, 0, 2));
+    freeMatrix_int(path_walks);
+    freeMatrix_int(path);
+
+    /* The second difference of 1000 samples is tridiagonal, so it is stored as its three diagonals and the smoothing system it defines is solved in O(n). */
+    matrix_int_t *difference = initializeMatrix_int(1000, 1000);
+    matrix_int_t *samples = initializeMatrix_int(1000, 1);
+    for(size_t sample = 0; sample < difference->i; sample++) {
+        difference->array[(sample * difference->ld) + sample] = 2;
+        if(sample > 0) {
+            difference->array[(sample * difference->ld) + sample - 1] = -1;
+        }
+        if((sample + 1) < difference->i) {
+            difference->array[(sample * difference->ld) + sample + 1] = -1;
+        }
+        samples->array[sample * samples->ld] = (int) (sample % 7);
+    }
+    m_invalidateProperties_int(difference);
+    m_invalidateProperties_int(samples);
+    m_characterize_int(difference);
+    matrix_int_t *curvature = m_MatrixMultiply_int(difference, samples);
+    matrix_int_t *recovered = m_BandedSolve_int(difference, curvature);
+    (void) printf("\tSecond difference of 1000 samples, banded: %d, solve recovers the samples: %d\n", MATRIX_STORAGE_BANDED == difference->storage, m_isEqual_int(recovered, samples));
+    freeMatrix_int(recovered);
+    freeMatrix_int(curvature);
+    freeMatrix_int(samples);
+    freeMatrix_int(difference);
+
+    /* Every matrix of an iteration comes from the arena and is given back at once by the reset.  After the first iteration the loop no longer calls malloc or free. */
+    matrix_arena_t *arena = m_createArena(0);
+    for(int step = 0; step < 3; step++) {
+        matrix_int_t *weights = generateRandomMatrixArena_int(arena, 3, 3, 0, 10);
+        matrix_int_t *product = m_MatrixMultiplyArena_int(arena, weights, m);
+        matrix_int_t *sum = m_MatrixAddArena_int(arena, product, weights);
+        (void) printf("\tArena step %d, arena capacity %zu bytes, sum[0, 0] : %d\n", step, m_arenaCapacity(arena), m_at_int(sum, 0, 0));
+        m_resetArena(arena);
+    }
+    m_destroyArena(arena);
+
 /* 
     freeMatrix_int(big_identity);
     freeMatrix_int(big_multiplication_identity);
@@ -131,7 +257,6 @@ main(int argument_count, char **argument_vector) {
     freeMatrix_int(random_matrix);
     freeMatrix_int(random_matrix2);
     
-    freeMatrix_int(test_identity_m);
     freeMatrix_int(test_multiplication3);
     freeMatrix_int(test_multiplication2);
     freeMatrix_int(m7);
@@ -143,6 +268,112 @@ main(int argument_count, char **argument_vector) {
     freeMatrix_int(m2);
     freeMatrix_int(m);
 
+    /* Small transforms are recycled through the pool: after the first iteration every header and array is a hit on this thread's free lists. */
+    matrix_int_t *transform = generateRandomMatrix_int(4, 4, 0, 10);
+    for(int step = 0; step < 1000; step++) {
+        matrix_int_t *rotated = m_MatrixMultiply_int(transform, transform);
+        freeMatrix_int(rotated);
+    }
+    freeMatrix_int(transform);
+    freeMatrix_int(test_identity_m);
+    matrix_poolStats_t pool_stats;
+    m_poolStats(&pool_stats);
+    (void) printf("\tPool hits: %llu, misses: %llu, bypassed: %llu\n", (unsigned long long) pool_stats.hits, (unsigned long long) pool_stats.misses, (unsigned long long) pool_stats.bypassed);
+
+    /* Floating point matrices run on the same FMA kernels as the integer engine; the stochastic tests compare sums within rounding. */
+    const float transition_values[] = {0.5f, 0.25f, 0.25f, 0.25f, 0.5f, 0.25f, 0.25f, 0.25f, 0.5f};
+    matrix_float_t *transition = initializeMatrix_float(3, 3);
+    copyArrayToMatrix_float(transition, transition_values, 9);
+    printMatrix_float(transition);
+    (void) printf("\tRight stochastic: %d, left: %d, doubly: %d, sub: %d\n", m_isRightStochastic_float(transition), m_isLeftStochastic_float(transition), m_isDoublyStochastic_float(transition), m_isSubStochastic_float(transition));
+    matrix_float_t *two_steps = m_MatrixMultiply_float(transition, transition);
+    printMatrix_float(two_steps);
+    (void) printf("\tTwo steps still right stochastic: %d\n", m_isRightStochastic_float(two_steps));
+    freeMatrix_float(two_steps);
+    freeMatrix_float(transition);
+
+    matrix_double_t *samples_double = generateRandomMatrix_double(2, 5, -1.0, 1.0);
+    matrix_double_t *samples_transposed = m_transpose_double(samples_double);
+    matrix_double_t *sample_products = m_MatrixMultiply_double(samples_double, samples_transposed);
+    (void) printf("\tProduct of random samples with their transpose is symmetric: %d\n", m_isSymmetric_double(sample_products));
+    freeMatrix_double(sample_products);
+    freeMatrix_double(samples_transposed);
+    freeMatrix_double(samples_double);
+
+    /* The same code runs on every element type: matrix_t dispatches on its tag once per call, and m_multiply picks the specialized product at compile time. */
+    const matrix_type_t types[] = {MATRIX_TYPE_INT, MATRIX_TYPE_FLOAT, MATRIX_TYPE_DOUBLE};
+    for(size_t type = 0; type < (sizeof(types) / sizeof(types[0])); type++) {
+        matrix_t rotation = initializeMatrix_tagged(types[type], 2, 2);
+        m_set_tagged(rotation, 0, 1, -1);
+        m_set_tagged(rotation, 1, 0, 1);
+        matrix_t half_turn = m_multiply(rotation, rotation);
+        matrix_t full_turn = m_multiply(half_turn, half_turn);
+        m_scale(half_turn, -1);
+        (void) printf("\t%s rotation: half turn times -1 is I: %d, full turn [0, 0] : %g, symmetric: %d\n", m_typeOps(rotation.type)->name, (1 == m_at_tagged(half_turn, 0, 0)) && (0 == m_at_tagged(half_turn, 0, 1)), m_at_tagged(full_turn, 0, 0), m_isSymmetric_tagged(full_turn));
+        m_free(full_turn);
+        m_free(half_turn);
+        m_free(rotation);
+    }
+    matrix_float_t *direct = generateRandomMatrix_float(4, 4, 0.0f, 1.0f);
+    matrix_float_t *direct_square = m_multiply(direct, direct);
+    matrix_t tagged_square = m_multiply(m_wrap(direct), m_wrap(direct));
+    (void) printf("\tSpecialized and tagged products agree: %d\n", m_equal(m_wrap(direct_square), tagged_square));
+    m_free(tagged_square);
+    m_free(direct_square);
+    m_free(direct);
+
+    /* Narrow operands: int8 values multiply exactly into int32, bfloat16 values into single precision. */
+    matrix_int_t *small = generateRandomMatrix_int(4, 4, -10, 10);
+    matrix_lowp_t *small_int8 = m_fromInt_lowp(MATRIX_PRECISION_INT8, small);
+    matrix_int_t *small_square = m_MatrixMultiply_int(small, small);
+    matrix_int_t *int8_square = m_MatrixMultiplyToInt_lowp(small_int8, small_int8);
+    (void) printf("\tint8 product equals the int product: %d\n", m_isEqual_int(small_square, int8_square));
+    matrix_float_t *samples_float = generateRandomMatrix_float(2, 3, -1.0f, 1.0f);
+    matrix_lowp_t *samples_bf16 = m_fromFloat_lowp(MATRIX_PRECISION_BF16, samples_float);
+    (void) printf("\t%f is %f as bfloat16\n", m_at_float(samples_float, 0, 0), m_at_lowp(samples_bf16, 0, 0));
+    freeMatrix_lowp(samples_bf16);
+    freeMatrix_float(samples_float);
+    freeMatrix_int(int8_square);
+    freeMatrix_int(small_square);
+    freeMatrix_lowp(small_int8);
+    freeMatrix_int(small);
+
+    /* Affine quantization: per column int8 weights times uint8 activations, requantized without leaving integers. */
+    matrix_float_t *weights = generateRandomMatrix_float(4, 3, -1.0f, 1.0f);
+    matrix_float_t *activations = generateRandomMatrix_float(2, 4, 0.0f, 2.0f);
+    matrix_quantized_t *q_weights = m_fromFloat_quantized(MATRIX_PRECISION_INT8, MATRIX_QUANT_COLUMNS, weights);
+    matrix_quantized_t *q_activations = m_fromFloat_quantized(MATRIX_PRECISION_UINT8, MATRIX_QUANT_TENSOR, activations);
+    (void) printf("\t%f is %f after int8 quantization with scale %f\n", m_at_float(weights, 0, 0), m_at_quantized(q_weights, 0, 0), q_weights->scales[0]);
+    matrix_quantized_t *q_outputs = m_MatrixMultiply_quantized(q_activations, q_weights, MATRIX_PRECISION_UINT8, 0.05f, 128);
+    matrix_float_t *outputs = m_MatrixMultiply_float(activations, weights);
+    (void) printf("\tQuantized product %f, single precision product %f\n", m_at_quantized(q_outputs, 1, 2), m_at_float(outputs, 1, 2));
+    freeMatrix_float(outputs);
+    freeMatrix_quantized(q_outputs);
+    freeMatrix_quantized(q_activations);
+    freeMatrix_quantized(q_weights);
+    freeMatrix_float(activations);
+    freeMatrix_float(weights);
+
+    /* Stochastic rounding: 0.25 becomes 0 or 1 at random, but a quarter of the values round up, so the mean survives. */
+    matrix_float_t *quarters = initializeMatrix_float(16, 16);
+    for(size_t row = 0; row < quarters->i; row++) {
+        for(size_t column = 0; column < quarters->j; column++) {
+            quarters->array[(row * quarters->ld) + column] = 0.25f;
+        }
+    }
+    m_invalidateProperties_float(quarters);
+    m_seedStochastic_lowp(2026);
+    matrix_lowp_t *quarters_int8 = m_fromFloatStochastic_lowp(MATRIX_PRECISION_INT8, quarters);
+    float quarters_sum = 0.0f;
+    for(size_t row = 0; row < quarters->i; row++) {
+        for(size_t column = 0; column < quarters->j; column++) {
+            quarters_sum += m_at_lowp(quarters_int8, row, column);
+        }
+    }
+    (void) printf("\t0.25 rounds to 0 to nearest, and to a mean of %f stochastically\n", quarters_sum / (float) (quarters->i * quarters->j));
+    freeMatrix_lowp(quarters_int8);
+    freeMatrix_float(quarters);
+
     (void) printf("Argument count: %d\n", argument_count);
     return 0;
 }
\ No newline at end of file
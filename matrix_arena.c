@@ -0,0 +1,156 @@
+/**
+ * @file matrix_arena.c
+ * @brief A bump allocator that lets a group of matrices share one lifetime
+ * @author Aaron Fleisher
+ * @date 2026-10-16
+ */
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "matrix_arena.h"
+
+/**
+ * @brief One block of memory owned by an arena.  The usable bytes follow the header, starting on an aligned boundary.
+ * @var next The next chunk in the list
+ * @var capacity The number of usable bytes
+ * @var used The number of bytes handed out
+ */
+struct Matrix_arenaChunk_s {
+    matrix_arenaChunk_t *next;
+    size_t capacity;
+    size_t used;
+};
+
+/**
+ * @brief The distance from the start of a chunk to its first usable byte.
+ */
+#define MATRIX_ARENA_HEADER_SIZE (((sizeof(matrix_arenaChunk_t) + MATRIX_ARENA_ALIGNMENT - 1) / MATRIX_ARENA_ALIGNMENT) * MATRIX_ARENA_ALIGNMENT)
+
+static unsigned char*
+m_chunkData(matrix_arenaChunk_t *chunk) {
+    return (unsigned char *) chunk + MATRIX_ARENA_HEADER_SIZE;
+}
+
+/**
+ * @brief Allocates an empty chunk.
+ * @param capacity The number of usable bytes, a multiple of MATRIX_ARENA_ALIGNMENT
+ */
+static matrix_arenaChunk_t*
+m_createChunk(const size_t capacity) {
+    matrix_arenaChunk_t *chunk = aligned_alloc(MATRIX_ARENA_ALIGNMENT, MATRIX_ARENA_HEADER_SIZE + capacity);
+    assert(NULL != chunk);
+    chunk->next = NULL;
+    chunk->capacity = capacity;
+    chunk->used = 0;
+    return chunk;
+}
+
+/**
+ * @brief Creates an arena.
+ * @param capacity The size of the first chunk in bytes.  Sizing it for one iteration of a loop means the arena never grows.  0 uses MATRIX_ARENA_CHUNK_SIZE.
+ * @return A new arena allocated upon the heap
+ */
+matrix_arena_t*
+m_createArena(const size_t capacity) {
+    matrix_arena_t *arena = malloc(sizeof(matrix_arena_t));
+    assert(NULL != arena);
+    arena->chunk_size = MATRIX_ARENA_CHUNK_SIZE;
+    const size_t first_size = (0 == capacity) ? arena->chunk_size : capacity;
+    arena->first = m_createChunk(((first_size + MATRIX_ARENA_ALIGNMENT - 1) / MATRIX_ARENA_ALIGNMENT) * MATRIX_ARENA_ALIGNMENT);
+    arena->current = arena->first;
+    return arena;
+}
+
+/**
+ * @brief Frees an arena and every chunk it holds.  Matrices allocated from it must not be used afterwards.
+ * @param arena The arena.  NULL is ignored.
+ */
+void
+m_destroyArena(matrix_arena_t *arena) {
+    if(NULL == arena) {
+        return;
+    }
+    matrix_arenaChunk_t *chunk = arena->first;
+    while(NULL != chunk) {
+        matrix_arenaChunk_t *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    free(arena);
+}
+
+/**
+ * @brief Takes back everything allocated from the arena.  The chunks are kept for the next allocations.
+ * @param arena The arena
+ */
+void
+m_resetArena(matrix_arena_t *arena) {
+    arena->current = arena->first;
+    arena->current->used = 0;
+}
+
+/**
+ * @brief Allocates memory from an arena.
+ * @param arena The arena
+ * @param bytes The number of bytes
+ * @return MATRIX_ARENA_ALIGNMENT aligned memory with unspecified contents.  It stays valid until the arena is reset, released past it, or destroyed.
+ */
+void*
+m_arenaAlloc(matrix_arena_t *arena, const size_t bytes) {
+    const size_t size = ((bytes + MATRIX_ARENA_ALIGNMENT - 1) / MATRIX_ARENA_ALIGNMENT) * MATRIX_ARENA_ALIGNMENT;
+    matrix_arenaChunk_t *chunk = arena->current;
+
+    /**
+     * Every chunk after the current one is free.  Move forward to the first that has room, and only add a chunk when none has.  The new chunk goes right after the current one so that the list stays in allocation order, which is what m_arenaRelease relies on.
+     */
+    while(size > (chunk->capacity - chunk->used)) {
+        if(NULL == chunk->next) {
+            matrix_arenaChunk_t *grown = m_createChunk((size > arena->chunk_size) ? size : arena->chunk_size);
+            grown->next = chunk->next;
+            chunk->next = grown;
+        }
+        chunk = chunk->next;
+        chunk->used = 0;
+    }
+    arena->current = chunk;
+    void *memory = m_chunkData(chunk) + chunk->used;
+    chunk->used += size;
+    return memory;
+}
+
+/**
+ * @brief Opens a scratch scope by remembering the current position of the arena.
+ * @param arena The arena
+ * @return The position, to be handed to m_arenaRelease
+ */
+matrix_arenaMark_t
+m_arenaMark(const matrix_arena_t *arena) {
+    const matrix_arenaMark_t mark = {arena->current, arena->current->used};
+    return mark;
+}
+
+/**
+ * @brief Closes a scratch scope.  Everything allocated since the mark was taken is taken back.  Scopes must be released in the reverse order they were opened.
+ * @param arena The arena
+ * @param mark A position returned by m_arenaMark on the same arena
+ */
+void
+m_arenaRelease(matrix_arena_t *arena, const matrix_arenaMark_t mark) {
+    arena->current = mark.chunk;
+    arena->current->used = mark.used;
+}
+
+/**
+ * @brief Returns the total size of the chunks an arena holds.
+ * @param arena The arena
+ * @return The capacity in bytes
+ */
+size_t
+m_arenaCapacity(const matrix_arena_t *arena) {
+    size_t capacity = 0;
+    for(const matrix_arenaChunk_t *chunk = arena->first; NULL != chunk; chunk = chunk->next) {
+        capacity += chunk->capacity;
+    }
+    return capacity;
+}
@@ -0,0 +1,105 @@
+/**
+ * @file matrix_arena.h
+ * @brief A bump allocator that lets a group of matrices share one lifetime
+ * @author Aaron Fleisher
+ * @date 2026-10-16
+ *
+ * An arena hands out memory by advancing an offset inside large chunks, and takes all of it back at once with m_resetArena.  The chunks are kept across resets, so a loop that resets the arena every iteration stops calling malloc and free once the first iteration has sized it.
+ * Every function that returns a new matrix has an ...Arena_int variant taking the arena as its first argument (see myMatrix.h).  Passing NULL allocates from the heap, exactly like the plain function.
+ * Scratch scopes nest: m_arenaMark remembers the current offset and m_arenaRelease rewinds to it, so an operation can borrow memory for temporaries and give it back before it returns.
+ * An arena is not thread safe.  Use one arena per thread.
+ */
+
+#ifndef MATRIX_ARENA_H
+#define MATRIX_ARENA_H
+
+#include <stddef.h>
+
+/**
+ * @brief The default size of a chunk, in bytes.  Requests larger than a chunk get a chunk of their own.
+ */
+#define MATRIX_ARENA_CHUNK_SIZE ((size_t) 1 << 20)
+
+/**
+ * @brief The alignment, in bytes, of every allocation.  It is a cache line, and is enough for any vector load.
+ */
+#define MATRIX_ARENA_ALIGNMENT 64
+
+typedef struct Matrix_arenaChunk_s matrix_arenaChunk_t;
+
+/**
+ * @brief An arena.  Create it with m_createArena and free it with m_destroyArena.
+ * @var first The first chunk.  The chunks form a list that only grows until the arena is destroyed.
+ * @var current The chunk allocations are currently taken from.  Chunks after it are free.
+ * @var chunk_size The size of a new chunk, unless the request that needs it is larger
+ */
+typedef struct Matrix_arena_s {
+    matrix_arenaChunk_t *first;
+    matrix_arenaChunk_t *current;
+    size_t chunk_size;
+} matrix_arena_t;
+
+/**
+ * @brief A position in an arena, returned by m_arenaMark.
+ */
+typedef struct Matrix_arenaMark_s {
+    matrix_arenaChunk_t *chunk;
+    size_t used;
+} matrix_arenaMark_t;
+
+/**
+ * @brief Creates an arena.
+ * @param capacity The size of the first chunk in bytes.  Sizing it for one iteration of a loop means the arena never grows.  0 uses MATRIX_ARENA_CHUNK_SIZE.
+ * @return A new arena allocated upon the heap
+ */
+matrix_arena_t*
+m_createArena(const size_t capacity);
+
+/**
+ * @brief Frees an arena and every chunk it holds.  Matrices allocated from it must not be used afterwards.
+ * @param arena The arena.  NULL is ignored.
+ */
+void
+m_destroyArena(matrix_arena_t *arena);
+
+/**
+ * @brief Takes back everything allocated from the arena.  The chunks are kept for the next allocations.
+ * @param arena The arena
+ */
+void
+m_resetArena(matrix_arena_t *arena);
+
+/**
+ * @brief Allocates memory from an arena.
+ * @param arena The arena
+ * @param bytes The number of bytes
+ * @return MATRIX_ARENA_ALIGNMENT aligned memory with unspecified contents.  It stays valid until the arena is reset, released past it, or destroyed.
+ */
+void*
+m_arenaAlloc(matrix_arena_t *arena, const size_t bytes);
+
+/**
+ * @brief Opens a scratch scope by remembering the current position of the arena.
+ * @param arena The arena
+ * @return The position, to be handed to m_arenaRelease
+ */
+matrix_arenaMark_t
+m_arenaMark(const matrix_arena_t *arena);
+
+/**
+ * @brief Closes a scratch scope.  Everything allocated since the mark was taken is taken back.  Scopes must be released in the reverse order they were opened.
+ * @param arena The arena
+ * @param mark A position returned by m_arenaMark on the same arena
+ */
+void
+m_arenaRelease(matrix_arena_t *arena, const matrix_arenaMark_t mark);
+
+/**
+ * @brief Returns the total size of the chunks an arena holds.
+ * @param arena The arena
+ * @return The capacity in bytes
+ */
+size_t
+m_arenaCapacity(const matrix_arena_t *arena);
+
+#endif /** MATRIX_ARENA_H */
@@ -0,0 +1,263 @@
+/**
+ * @file matrix_bits.c
+ * @brief Bitpacked storage and products for binary matrices
+ * @author Aaron Fleisher
+ * @date 2026-10-16
+ */
+#include "matrix_bits.h"
+#include "matrix_pool.h"
+#include "matrix_simd.h"
+#include "matrix_sparse.h"
+#include "matrix_threads.h"
+
+/**
+ * @brief The number of words in a cache line.
+ */
+#define MATRIX_BITS_LINE_WORDS (MATRIX_ALIGNMENT / sizeof(uint64_t))
+
+/**
+ * @brief Allocates a bit matrix of dimensions i by j with every element 0.
+ * @param i The number of rows
+ * @param j The number of columns
+ * @return A new bit matrix allocated upon the heap
+ */
+matrix_bits_t*
+initializeMatrix_bits(const size_t i, const size_t j) {
+    matrix_bits_t *m = m_poolCalloc(sizeof(matrix_bits_t));
+    assert(NULL != m);
+    m->i = i;
+    m->j = j;
+    m->ld = (j + MATRIX_BITS_PER_WORD - 1) / MATRIX_BITS_PER_WORD;
+    if(m->ld >= MATRIX_BITS_LINE_WORDS) {
+        m->ld = ((m->ld + MATRIX_BITS_LINE_WORDS - 1) / MATRIX_BITS_LINE_WORDS) * MATRIX_BITS_LINE_WORDS;
+    }
+    m->array = m_poolCalloc(i * m->ld * sizeof(uint64_t));
+    assert(NULL != m->array);
+    return m;
+}
+
+/**
+ * @brief Frees a bit matrix and its words.
+ * @param m The matrix.  NULL is ignored.
+ */
+void
+freeMatrix_bits(matrix_bits_t *m) {
+    if(NULL == m) {
+        return;
+    }
+    m_poolFree(m->array, m->i * m->ld * sizeof(uint64_t));
+    m_poolFree(m, sizeof(matrix_bits_t));
+}
+
+/**
+ * @brief Returns one element of a bit matrix.
+ * @param m The matrix
+ * @param i The row index, using C style indexing
+ * @param j The column index, using C style indexing
+ * @return 0 or 1
+ */
+int
+m_at_bits(const matrix_bits_t *m, const size_t i, const size_t j) {
+    return (int) ((m->array[(i * m->ld) + (j / MATRIX_BITS_PER_WORD)] >> (j % MATRIX_BITS_PER_WORD)) & 1u);
+}
+
+/**
+ * @brief Packs a binary integer matrix into bits.
+ * @param m The matrix.  It must be binary; m_isBinary_int is asserted.
+ * @return A new bit matrix allocated upon the heap
+ */
+matrix_bits_t*
+m_packBits_int(matrix_int_t *m) {
+    assert(m_isBinary_int(m));
+    matrix_bits_t *bits = initializeMatrix_bits(m->i, m->j);
+    if(MATRIX_STORAGE_BITS == m->storage) {
+        memcpy(bits->array, m->bits->array, bits->i * bits->ld * sizeof(uint64_t));
+        return bits;
+    }
+    if(MATRIX_STORAGE_CSR == m->storage) {
+        /* Every nonzero of a binary matrix is a 1. */
+        const matrix_sparse_t *sparse = m->sparse;
+        for(size_t row = 0; row < m->i; row++) {
+            uint64_t *words = bits->array + (row * bits->ld);
+            for(size_t index = sparse->offsets[row]; index < sparse->offsets[row + 1]; index++) {
+                words[sparse->indices[index] / MATRIX_BITS_PER_WORD] |= (uint64_t) 1 << (sparse->indices[index] % MATRIX_BITS_PER_WORD);
+            }
+        }
+        return bits;
+    }
+    if((MATRIX_STORAGE_UPPER == m->storage) || (MATRIX_STORAGE_LOWER == m->storage) || (MATRIX_STORAGE_SYMMETRIC == m->storage)) {
+        for(size_t row = 0; row < m->i; row++) {
+            uint64_t *words = bits->array + (row * bits->ld);
+            for(size_t column = 0; column < m->j; column++) {
+                words[column / MATRIX_BITS_PER_WORD] |= (uint64_t) m_at_int(m, row, column) << (column % MATRIX_BITS_PER_WORD);
+            }
+        }
+        return bits;
+    }
+    if(MATRIX_STORAGE_BANDED == m->storage) {
+        for(size_t row = 0; row < m->i; row++) {
+            uint64_t *words = bits->array + (row * bits->ld);
+            const size_t first = (row > m->lower_bandwidth) ? row - m->lower_bandwidth : 0;
+            const size_t end = ((row + m->upper_bandwidth + 1) < m->j) ? row + m->upper_bandwidth + 1 : m->j;
+            for(size_t column = first; column < end; column++) {
+                words[column / MATRIX_BITS_PER_WORD] |= (uint64_t) m_at_int(m, row, column) << (column % MATRIX_BITS_PER_WORD);
+            }
+        }
+        return bits;
+    }
+    if((MATRIX_STORAGE_INT8 == m->storage) || (MATRIX_STORAGE_INT16 == m->storage)) {
+        for(size_t row = 0; row < m->i; row++) {
+            uint64_t *words = bits->array + (row * bits->ld);
+            for(size_t column = 0; column < m->j; column++) {
+                const size_t offset = (row * m->ld) + column;
+                const int value = (MATRIX_STORAGE_INT8 == m->storage) ? ((const int8_t *) m->narrow)[offset] : ((const int16_t *) m->narrow)[offset];
+                words[column / MATRIX_BITS_PER_WORD] |= (uint64_t) value << (column % MATRIX_BITS_PER_WORD);
+            }
+        }
+        return bits;
+    }
+    if(m_isImplicit_int(m) || (MATRIX_STORAGE_DIAGONAL == m->storage)) {
+        /* An implicit or diagonal matrix has no values off the diagonal. */
+        const size_t length = (m->i < m->j) ? m->i : m->j;
+        for(size_t index = 0; index < length; index++) {
+            bits->array[(index * bits->ld) + (index / MATRIX_BITS_PER_WORD)] |= (uint64_t) m_at_int(m, index, index) << (index % MATRIX_BITS_PER_WORD);
+        }
+        return bits;
+    }
+    assert(MATRIX_STORAGE_DENSE == m->storage);
+    for(size_t row = 0; row < m->i; row++) {
+        const int *values = m->array + (row * m->ld);
+        uint64_t *words = bits->array + (row * bits->ld);
+        for(size_t column = 0; column < m->j; column++) {
+            words[column / MATRIX_BITS_PER_WORD] |= (uint64_t) values[column] << (column % MATRIX_BITS_PER_WORD);
+        }
+    }
+    return bits;
+}
+
+/**
+ * @brief Unpacks a bit matrix into a new integer matrix.  The result is known to be binary, so it never needs a sweep to find that out.
+ * @param m The bit matrix
+ * @return A new matrix allocated upon the heap
+ */
+matrix_int_t*
+m_unpackBits_int(const matrix_bits_t *m) {
+    matrix_int_t *unpacked = initializeMatrix_int(m->i, m->j);
+    for(size_t row = 0; row < m->i; row++) {
+        for(size_t column = 0; column < m->j; column++) {
+            unpacked->array[(row * unpacked->ld) + column] = m_at_bits(m, row, column);
+        }
+    }
+    m_setProperties_int(unpacked, MATRIX_IS_BINARY, true);
+    return unpacked;
+}
+
+/**
+ * @brief Transposes a bit matrix.
+ * @param m The matrix
+ * @return A new bit matrix allocated upon the heap.  The work is proportional to the number of set bits.
+ */
+matrix_bits_t*
+m_transpose_bits(const matrix_bits_t *m) {
+    matrix_bits_t *transpose = initializeMatrix_bits(m->j, m->i);
+    for(size_t row = 0; row < m->i; row++) {
+        const uint64_t *words = m->array + (row * m->ld);
+        const uint64_t row_bit = (uint64_t) 1 << (row % MATRIX_BITS_PER_WORD);
+        const size_t row_word = row / MATRIX_BITS_PER_WORD;
+        for(size_t word = 0; word < m->ld; word++) {
+            /* Visit only the set bits: clearing the lowest one each time. */
+            for(uint64_t remaining = words[word]; 0 != remaining; remaining &= remaining - 1) {
+                const size_t column = (word * MATRIX_BITS_PER_WORD) + (size_t) __builtin_ctzll(remaining);
+                transpose->array[(column * transpose->ld) + row_word] |= row_bit;
+            }
+        }
+    }
+    return transpose;
+}
+
+/**
+ * @brief Describes one bit matrix product for the thread pool.  Every task computes one row of the result.
+ */
+typedef struct Matrix_bitsJob_s {
+    const matrix_bits_t *m1;
+    const matrix_bits_t *transpose;
+    matrix_int_t *result;
+} matrix_bitsJob_t;
+
+static void
+m_bitsMultiplyRow(void *context, const size_t task, const size_t worker) {
+    (void) worker;
+    const matrix_bitsJob_t *job = context;
+    uint64_t (*const and_popcount)(const uint64_t*, const uint64_t*, const size_t) = m_kernels_int()->and_popcount;
+    const uint64_t *row = job->m1->array + (task * job->m1->ld);
+    const size_t words = (job->m1->j + MATRIX_BITS_PER_WORD - 1) / MATRIX_BITS_PER_WORD;
+    int *output = job->result->array + (task * job->result->ld);
+    for(size_t column = 0; column < job->result->j; column++) {
+        output[column] = (int) and_popcount(row, job->transpose->array + (column * job->transpose->ld), words);
+    }
+}
+
+/**
+ * @brief Computes the integer product A x B of two bit matrices.  Each element is the popcount of a row of A and'ed with a column of B.
+ * @param m1 The first matrix, i x k
+ * @param m2 The second matrix, k x j
+ * @return A new i x j integer matrix allocated upon the heap
+ */
+matrix_int_t*
+m_MatrixMultiply_bits(const matrix_bits_t *m1, const matrix_bits_t *m2) {
+    matrix_int_t *result = initializeMatrix_int(m1->i, m2->j);
+    m_MatrixMultiplyInto_bits(m1, m2, result);
+    return result;
+}
+
+/**
+ * @brief Computes the integer product A x B of two bit matrices into an existing matrix.
+ * @param m1 The first matrix, i x k
+ * @param m2 The second matrix, k x j
+ * @param result An i x j matrix.  Every element is overwritten.
+ */
+void
+m_MatrixMultiplyInto_bits(const matrix_bits_t *m1, const matrix_bits_t *m2, matrix_int_t *result) {
+    assert(m1->j == m2->i);
+    assert((result->i == m1->i) && (result->j == m2->j));
+    /* The columns of B become rows of its transpose, so both operands of every popcount are contiguous words. */
+    matrix_bits_t *transpose = m_transpose_bits(m2);
+    matrix_bitsJob_t job = {m1, transpose, result};
+    if(((m1->i * m2->j * m1->j) / MATRIX_BITS_PER_WORD) < MATRIX_GEMM_PARALLEL_THRESHOLD) {
+        for(size_t row = 0; row < m1->i; row++) {
+            m_bitsMultiplyRow(&job, row, 0);
+        }
+    } else {
+        m_parallelFor(m1->i, m_bitsMultiplyRow, &job);
+    }
+    freeMatrix_bits(transpose);
+    m_invalidateProperties_int(result);
+}
+
+/**
+ * @brief Computes the boolean product of two bit matrices: C[r][c] = OR over k of (A[r][k] AND B[k][c]).  For adjacency matrices this is the reachability in two steps.
+ * @param m1 The first matrix, i x k
+ * @param m2 The second matrix, k x j
+ * @return A new i x j bit matrix allocated upon the heap.  The work is proportional to the set bits of m1 times the words in a row of m2.
+ */
+matrix_bits_t*
+m_BooleanMultiply_bits(const matrix_bits_t *m1, const matrix_bits_t *m2) {
+    assert(m1->j == m2->i);
+    matrix_bits_t *product = initializeMatrix_bits(m1->i, m2->j);
+    const size_t words = (m2->j + MATRIX_BITS_PER_WORD - 1) / MATRIX_BITS_PER_WORD;
+    for(size_t row = 0; row < m1->i; row++) {
+        const uint64_t *a_words = m1->array + (row * m1->ld);
+        uint64_t *output = product->array + (row * product->ld);
+        /* Every set bit k of row r of A ors row k of B into row r of the product. */
+        for(size_t word = 0; word < m1->ld; word++) {
+            for(uint64_t remaining = a_words[word]; 0 != remaining; remaining &= remaining - 1) {
+                const size_t k = (word * MATRIX_BITS_PER_WORD) + (size_t) __builtin_ctzll(remaining);
+                const uint64_t *b_words = m2->array + (k * m2->ld);
+                for(size_t index = 0; index < words; index++) {
+                    output[index] |= b_words[index];
+                }
+            }
+        }
+    }
+    return product;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file matrix_bits.h
+ * @brief Bitpacked storage and products for binary matrices
+ * @author Aaron Fleisher
+ * @date 2026-10-16
+ *
+ * A binary matrix only holds 0 and 1, so each element fits in one bit.  matrix_bits_t stores 64 elements per word, 32 times denser than matrix_int_t.
+ * The integer product of two bit matrices is a count of common set bits: C[r][c] = popcount(A[r] & B^T[c]).  The count runs 64 elements at a time with POPCNT, VPSHUFB or AVX-512 VPOPCNTDQ, depending on the host (see matrix_simd.h).
+ * m_MatrixMultiply_int takes this route by itself when characterization has found both operands binary.
+ */
+
+#ifndef MATRIX_BITS_H
+#define MATRIX_BITS_H
+
+#include "myMatrix.h"
+
+/**
+ * @brief The number of elements in one word of a bit matrix.
+ */
+#define MATRIX_BITS_PER_WORD 64
+
+/**
+ * @brief The shortest shared dimension for which m_MatrixMultiply_int packs binary operands into bits.  Below it, packing costs more than the dense product.
+ */
+#define MATRIX_BITS_MIN_DEPTH 64
+
+/**
+ * @brief A binary matrix with one bit per element.
+ * @var i The number of rows
+ * @var j The number of columns
+ * @var ld The number of words from the start of one row to the start of the next.  Rows of at least a cache line are padded to whole cache lines.  Bits past column j are always zero.
+ * @var array The words, row after row.  Column c of a row is bit (c % 64) of word (c / 64).
+ */
+typedef struct Matrix_bits_s {
+    size_t i;
+    size_t j;
+    size_t ld;
+    uint64_t *array;
+} matrix_bits_t;
+
+/**
+ * @brief Allocates a bit matrix of dimensions i by j with every element 0.
+ * @param i The number of rows
+ * @param j The number of columns
+ * @return A new bit matrix allocated upon the heap
+ */
+matrix_bits_t*
+initializeMatrix_bits(const size_t i, const size_t j);
+
+/**
+ * @brief Frees a bit matrix and its words.
+ * @param m The matrix.  NULL is ignored.
+ */
+void
+freeMatrix_bits(matrix_bits_t *m);
+
+/**
+ * @brief Returns one element of a bit matrix.
+ * @param m The matrix
+ * @param i The row index, using C style indexing
+ * @param j The column index, using C style indexing
+ * @return 0 or 1
+ */
+int
+m_at_bits(const matrix_bits_t *m, const size_t i, const size_t j);
+
+/**
+ * @brief Packs a binary integer matrix into bits.
+ * @param m The matrix.  It must be binary; m_isBinary_int is asserted.
+ * @return A new bit matrix allocated upon the heap
+ */
+matrix_bits_t*
+m_packBits_int(matrix_int_t *m);
+
+/**
+ * @brief Unpacks a bit matrix into a new integer matrix.  The result is known to be binary, so it never needs a sweep to find that out.
+ * @param m The bit matrix
+ * @return A new matrix allocated upon the heap
+ */
+matrix_int_t*
+m_unpackBits_int(const matrix_bits_t *m);
+
+/**
+ * @brief Transposes a bit matrix.
+ * @param m The matrix
+ * @return A new bit matrix allocated upon the heap.  The work is proportional to the number of set bits.
+ */
+matrix_bits_t*
+m_transpose_bits(const matrix_bits_t *m);
+
+/**
+ * @brief Computes the integer product A x B of two bit matrices.  Each element is the popcount of a row of A and'ed with a column of B.
+ * @param m1 The first matrix, i x k
+ * @param m2 The second matrix, k x j
+ * @return A new i x j integer matrix allocated upon the heap
+ */
+matrix_int_t*
+m_MatrixMultiply_bits(const matrix_bits_t *m1, const matrix_bits_t *m2);
+
+/**
+ * @brief Computes the integer product A x B of two bit matrices into an existing matrix.
+ * @param m1 The first matrix, i x k
+ * @param m2 The second matrix, k x j
+ * @param result An i x j matrix.  Every element is overwritten.
+ */
+void
+m_MatrixMultiplyInto_bits(const matrix_bits_t *m1, const matrix_bits_t *m2, matrix_int_t *result);
+
+/**
+ * @brief Computes the boolean product of two bit matrices: C[r][c] = OR over k of (A[r][k] AND B[k][c]).  For adjacency matrices this is the reachability in two steps.
+ * @param m1 The first matrix, i x k
+ * @param m2 The second matrix, k x j
+ * @return A new i x j bit matrix allocated upon the heap.  The work is proportional to the set bits of m1 times the words in a row of m2.
+ */
+matrix_bits_t*
+m_BooleanMultiply_bits(const matrix_bits_t *m1, const matrix_bits_t *m2);
+
+#endif /** MATRIX_BITS_H */
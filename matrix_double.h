@@ -1,33 +1,365 @@
+/**
+ * @file matrix_double.h
+ * @brief Double precision matrices: allocation, arithmetic, the blocked matrix multiplication and characterization
+ * @author Aaron Fleisher
+ * @date 2026-10-16
+ *
+ * A matrix_double_t is always dense, like a matrix_float_t (see matrix_float.h).  Its rows are padded to whole cache lines like those of a matrix_int_t, and its properties are cached in the same bitmasks (see matrix_propertyFlag_t).  The product is blocked and packed like m_MatrixMultiply_int, with a 6 x 8 micro-kernel that issues one fused multiply-add (FMA) per element and depth on AVX2 and AVX-512 hosts (see matrix_simd.h), and spreads large products over the thread pool (see matrix_threads.h).
+ * Comparisons with zero and one are exact, so characterization finds the same structure as for integers.  The stochastic predicates allow each row or column sum to differ from 1 by its length times twice DBL_EPSILON, the rounding of its values and of their sum.
+ */
+
+#ifndef MATRIX_DOUBLE_H
+#define MATRIX_DOUBLE_H
+
 #include "myMatrix.h"
 
+/**
+ * @brief Blocking parameters of the double precision matrix multiplication.
+ * @note A row of the 6 x 8 register tile is two AVX2 registers or one AVX-512 register, so the tile has the register footprint of the single precision one (see matrix_float.h).  A KC x NR micro-panel of the second matrix (16 KiB) fits in the L1 cache, an MC x KC block of the first matrix (144 KiB) in the L2 cache and a KC x NC panel of the second matrix (2 MiB) in the L3 cache.  MC must be a multiple of MR and NC a multiple of NR.
+ */
+#define MATRIX_GEMM_MR_DOUBLE 6
+#define MATRIX_GEMM_NR_DOUBLE 8
+#define MATRIX_GEMM_KC_DOUBLE 256
+#define MATRIX_GEMM_MC_DOUBLE 72
+#define MATRIX_GEMM_NC_DOUBLE 1024
+
+/**
+ * @brief A dense matrix of double precision values.
+ * @var i The number of rows
+ * @var j The number of columns
+ * @var array The values, row after row.  It is MATRIX_ALIGNMENT aligned.
+ * @var ld The leading dimension: element (r, c) is array[(r * ld) + c].  Rows of at least a cache line are padded to whole cache lines.
+ * @var arena The arena the matrix was allocated from, or NULL if it was allocated upon the heap
+ * @var properties One matrix_propertyFlag_t bit per property in known once it is computed, and its value in value.  The shape flags are known from initialization on; the others are computed by m_characterize_double and forgotten when the matrix is modified.
+ */
 typedef struct Matrix_double_s {
     size_t i; // Row
     size_t j; // Column
     double *array;
+    size_t ld; // Leading dimension
+    matrix_arena_t *arena;
     struct {
-        double *eigenvector;
-        int dot_product;
-        float eigenvalue;
-        int determinant;
-        /**
-         * @todo change make these 16 booleans into bitpacked int.
-         */
-        bool is_binary; /** << If the matrix is binary it can be represented though bitpacking */
-        bool is_column;  
-        bool is_row;
-        bool is_singleton;
-        bool is_square;
-        bool is_UpperTriangular;
-        bool is_LowerTriangular;
-        bool is_diagonal;
-        bool is_identity;
-        bool is_null;
-        bool is_symmetric;
-        bool is_orthoganal;
-        bool is_singular;
-        bool is_idempotent;
-        bool is_involutory;
-        bool is_nilpotent;
+        uint32_t known; /** << One matrix_propertyFlag_t bit per property whose value is cached */
+        uint32_t value; /** << The cached values.  A bit is only meaningful when the same bit is set in known. */
     } properties;
 } matrix_double_t;
 
+
+/*************************** MATRIX WIDE OPERATIONS ************************/
+
+/**
+ * @brief Allocates a matrix of dimensions i by j upon the heap.  The values are zero.
+ * @param i The number of rows
+ * @param j The number of columns
+ * @return A pointer to a matrix struct.  The header and arrays of up to MATRIX_POOL_MAX_BLOCK bytes come from the size-class pool.
+ */
+matrix_double_t*
+initializeMatrix_double(const int i, const int j);
+
+/**
+ * @brief Allocates a matrix of dimensions i by j from an arena.  The values are zero.
+ * @param arena The arena to allocate from, or NULL to allocate upon the heap
+ * @param i The number of rows
+ * @param j The number of columns
+ * @return A pointer to a matrix struct.  freeMatrix_double does nothing for an arena matrix; it is taken back when the arena is reset.
+ */
+matrix_double_t*
+initializeMatrixArena_double(matrix_arena_t *arena, const int i, const int j);
+
+/**
+ * @brief Frees a matrix and its array.  Matrices allocated from an arena are left alone; the arena owns their memory.
+ * @param m The matrix that will be freed.
+ */
+void
+freeMatrix_double(matrix_double_t *m);
+
+/**
+ * @brief Forgets every cached property except the shape flags, which do not depend on the values.  Code that writes to m->array directly must call this.
+ * @param m The matrix that was modified
+ */
+void
+m_invalidateProperties_double(matrix_double_t *m);
+
+/**
+ * @brief Copies the values of a row-major array into a matrix.  The cached properties are forgotten.
+ * @param m The matrix
+ * @param array The values, row after row, without padding
+ * @param array_length The number of values.  It must be i x j.
+ */
+void
+copyArrayToMatrix_double(matrix_double_t *m, const double *array, const size_t array_length);
+
+/**
+ * @brief Prints the matrix to stdout in the appropriate dimensions, followed by its properties.
+ * @param m The matrix
+ */
+void
+printMatrix_double(matrix_double_t *m);
+
+/**
+ * @brief Creates a copy of a matrix upon the heap, cached properties included.
+ * @param m The matrix
+ * @return A new matrix allocated upon the heap
+ */
+matrix_double_t*
+createCopy_double(matrix_double_t *m);
+
+/**
+ * @brief Creates a copy of a matrix in an arena, cached properties included.
+ * @param arena The arena to allocate from, or NULL to allocate upon the heap
+ * @param m The matrix
+ * @return A new matrix allocated from the arena
+ */
+matrix_double_t*
+createCopyArena_double(matrix_arena_t *arena, matrix_double_t *m);
+
+/**
+ * @brief Generates a random matrix of size i x j, with values lower_bound <= x <= upper_bound drawn from rand().  Seed it with srand for a different matrix.
+ * @param i The number of rows
+ * @param j The number of columns
+ * @param lower_bound All values are greater than or equal to this lower bound
+ * @param upper_bound All values are less than or equal to this upper bound
+ * @return A new matrix allocated upon the heap
+ */
+matrix_double_t*
+generateRandomMatrix_double(const int i, const int j, const double lower_bound, const double upper_bound);
+
+
+/******************************* INTERNAL MATRIX OPERATIONS **********************/
+
+/**
+ * @brief Returns the value of the matrix at the given position.
+ * @param m The matrix
+ * @param i The row index, using C style indexing (starting at 0)
+ * @param j The column index, using C style indexing (starting at 0)
+ * @return The value
+ */
+double
+m_at_double(const matrix_double_t *m, const int i, const int j);
+
+/**
+ * @brief Adds two matrices of the same dimensions, M1 + M2, one row at a time with the vectorized add kernel.
+ * @param m1 The first matrix
+ * @param m2 The second matrix
+ * @return A new matrix allocated upon the heap
+ */
+matrix_double_t*
+m_MatrixAdd_double(matrix_double_t *m1, matrix_double_t *m2);
+
+/**
+ * @brief Adds two matrices of the same dimensions, M1 + M2, into an arena.
+ * @param arena The arena to allocate the result from, or NULL to allocate upon the heap
+ * @param m1 The first matrix
+ * @param m2 The second matrix
+ * @return A new matrix allocated from the arena
+ */
+matrix_double_t*
+m_MatrixAddArena_double(matrix_arena_t *arena, matrix_double_t *m1, matrix_double_t *m2);
+
+/**
+ * @brief Subtracts two matrices of the same dimensions, M1 - M2.
+ * @param m1 The first matrix
+ * @param m2 The second matrix
+ * @return A new matrix allocated upon the heap
+ */
+matrix_double_t*
+m_MatrixSubtract_double(matrix_double_t *m1, matrix_double_t *m2);
+
+/**
+ * @brief Subtracts two matrices of the same dimensions, M1 - M2, into an arena.
+ * @param arena The arena to allocate the result from, or NULL to allocate upon the heap
+ * @param m1 The first matrix
+ * @param m2 The second matrix
+ * @return A new matrix allocated from the arena
+ */
+matrix_double_t*
+m_MatrixSubtractArena_double(matrix_arena_t *arena, matrix_double_t *m1, matrix_double_t *m2);
+
+/**
+ * @brief Multiplies every value of a matrix by a scalar, in place.
+ * @param m The matrix
+ * @param scalar The scalar
+ */
+void
+m_ScalarMultiply_double(matrix_double_t *m, const double scalar);
+
+/**
+ * @brief Finds whether two matrices have the same dimensions and the same values.  The comparison is exact: 0.0 equals -0.0 and NaN equals nothing.
+ * @param m1 The first matrix
+ * @param m2 The second matrix
+ * @return true if every value is equal
+ */
+bool
+m_isEqual_double(matrix_double_t *m1, matrix_double_t *m2);
+
+/**
+ * @brief Multiplies two matrices, M1 x M2.  The product is blocked for the caches and packed into micro-panels that the register-tiled FMA micro-kernel of the host (see matrix_simd.h) reads sequentially, exactly as m_MatrixMultiply_int.  Products of at least MATRIX_GEMM_PARALLEL_THRESHOLD multiply-adds are split into tiles for the thread pool.  Every element accumulates its depth in the same order whatever the tiling, so the result does not depend on the thread count.
+ * @param m1 The first matrix, i x k
+ * @param m2 The second matrix, k x j
+ * @return A new i x j matrix allocated upon the heap
+ */
+matrix_double_t*
+m_MatrixMultiply_double(matrix_double_t *m1, matrix_double_t *m2);
+
+/**
+ * @brief Multiplies two matrices, M1 x M2, into an arena.  See m_MatrixMultiply_double.
+ * @param arena The arena to allocate the result from, or NULL to allocate upon the heap
+ * @param m1 The first matrix, i x k
+ * @param m2 The second matrix, k x j
+ * @return A new i x j matrix allocated from the arena
+ */
+matrix_double_t*
+m_MatrixMultiplyArena_double(matrix_arena_t *arena, matrix_double_t *m1, matrix_double_t *m2);
+
+/**
+ * @brief Finds the dot product of two arrays of equal length with the vectorized kernel of the host.
+ * @param a1 The first array
+ * @param a2 The second array
+ * @param length The length of both arrays
+ * @return The sum of a1[n] * a2[n]
+ */
+double
+m_dotProduct_double(const double *a1, const double *a2, const size_t length);
+
+/**
+ * @brief Creates the transpose of a matrix.  The matrix is read and written in 32 x 32 tiles, so neither side is walked down its columns a whole matrix apart.  The properties that transposing preserves are carried over, and the triangular flags swapped.
+ * @param m The matrix
+ * @return A new j x i matrix allocated upon the heap
+ */
+matrix_double_t*
+m_transpose_double(matrix_double_t *m);
+
+
+/*************************** MATRIX CHARACTERIZATIONS ************************** */
+
+/**
+ * @brief Characterizes the matrix in a single sweep over its array and records every result in m->properties: binary, null, upper and lower triangular, diagonal, identity, symmetric and (right) stochastic.  The m_is..._double queries call this on their first use and answer from the recorded flags afterwards.
+ * @param m The matrix
+ * @note Each row is split at the diagonal, and a part is skipped once none of the flags that depend on it can still be true.  The symmetry test compares 32 x 32 tiles above the diagonal with their mirrors below it and stops at the first difference.
+ */
+void
+m_characterize_double(matrix_double_t *m);
+
+/**
+ * @brief Finds whether all values in the matrix are 0 or 1.
+ * @param m The matrix
+ * @return true if the matrix only includes binary values
+ */
+bool
+m_isBinary_double(matrix_double_t *m);
+
+/**
+ * @brief Finds whether the matrix has a single row.
+ * @param m The matrix
+ * @return true if i is 1
+ */
+bool
+m_isColumn_double(matrix_double_t *m);
+
+/**
+ * @brief Finds whether the matrix has a single column.
+ * @param m The matrix
+ * @return true if j is 1
+ */
+bool
+m_isRow_double(matrix_double_t *m);
+
+/**
+ * @brief Finds whether the matrix is square.
+ * @param m The matrix
+ * @return true if i equals j
+ */
+bool
+m_isSquare_double(matrix_double_t *m);
+
+/**
+ * @brief Finds whether the matrix has a single element.
+ * @param m The matrix
+ * @return true if i and j are 1
+ */
+bool
+m_isSingleton_double(matrix_double_t *m);
+
+/**
+ * @brief Finds whether the matrix is square and every value below the diagonal is zero.
+ * @param m The matrix
+ * @return true if upper triangular
+ */
+bool
+m_isUpperTriangular_double(matrix_double_t *m);
+
+/**
+ * @brief Finds whether the matrix is square and every value above the diagonal is zero.
+ * @param m The matrix
+ * @return true if lower triangular
+ */
+bool
+m_isLowerTriangular_double(matrix_double_t *m);
+
+/**
+ * @brief Finds whether the matrix is square and every value off the diagonal is zero.
+ * @param m The matrix
+ * @return true if diagonal
+ */
+bool
+m_isDiagonal_double(matrix_double_t *m);
+
+/**
+ * @brief Finds whether the matrix is the identity matrix.
+ * @param m The matrix
+ * @return true if diagonal with every diagonal value 1
+ */
+bool
+m_isIdentity_double(matrix_double_t *m);
+
+/**
+ * @brief Finds whether every value of the matrix is zero.
+ * @param m The matrix
+ * @return true if null
+ */
+bool
+m_isNull_double(matrix_double_t *m);
+
+/**
+ * @brief Finds whether the matrix equals its transpose.  The comparison is exact.
+ * @param m The matrix
+ * @return true if symmetric
+ */
+bool
+m_isSymmetric_double(matrix_double_t *m);
+
+/**
+ * @brief Determines if the matrix is right stochastic.  In other words the matrix is square, it has nonnegative real numbers, and the sum of each row is 1.
+ * @param m Pointer to matrix_double_t object.
+ * @return boolean.  True if right stochastic, false otherwise.
+ * @note The answer is the MATRIX_IS_STOCHASTIC flag of m_characterize_double.
+ */
+bool
+m_isRightStochastic_double(matrix_double_t *m);
+
+/**
+ * @brief Determines if the matrix is left stochastic.  In other words the matrix is square, it has nonnegative real numbers, and the sum of each column is 1.
+ * @param m Pointer to matrix_double_t object.
+ * @return boolean.  True if left stochastic, false otherwise.
+ * @note The column sums are accumulated along the rows, so the array is read in order.
+ */
+bool
+m_isLeftStochastic_double(matrix_double_t *m);
+
+/**
+ * @brief Determines if the matrix is doubly stochastic.  In other words the matrix is square, it has nonnegative real numbers, the sum of each row is 1, and sum of each column is 1.
+ * @param m Pointer to matrix_double_t object.
+ * @return boolean.  True if doubly stochastic, false otherwise.
+ */
+bool
+m_isDoublyStochastic_double(matrix_double_t *m);
+
+/**
+ * @brief Determines if the matrix is substochastic.  In other words the matrix is square, it has nonnegative real numbers, and the sum of each row is less than or equal to 1.  All right and doubly stochastic matrices are substochastic as well
+ * @param m Pointer to matrix_double_t object.
+ * @return boolean.  True if substochastic, false otherwise.
+ */
+bool
+m_isSubStochastic_double(matrix_double_t *m);
+
+#endif /** MATRIX_DOUBLE_H */
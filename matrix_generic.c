@@ -0,0 +1,398 @@
+/**
+ * @file matrix_generic.c
+ * @brief One matrix handle for every element type, with a table of kernels per type and type-generic macros
+ * @author Aaron Fleisher
+ * @date 2026-10-16
+ */
+#include "matrix_generic.h"
+
+/**
+ * @brief Defines the kernels of the table for a built in type whose functions follow the naming of this library, initializeMatrix_T, m_MatrixMultiply_T and so on.  The ones that differ between types (storage, set and transpose) are written out below.
+ */
+#define MATRIX_TYPE_ADAPTERS(T) \
+    static void* m_initializeAdapter_##T(const int i, const int j) { return initializeMatrix_##T(i, j); } \
+    static void m_freeAdapter_##T(void *m) { freeMatrix_##T(m); } \
+    static void m_printAdapter_##T(void *m) { printMatrix_##T(m); } \
+    static size_t m_rowsAdapter_##T(const void *m) { return ((const matrix_##T##_t*) m)->i; } \
+    static size_t m_columnsAdapter_##T(const void *m) { return ((const matrix_##T##_t*) m)->j; } \
+    static double m_atAdapter_##T(void *m, const size_t r, const size_t c) { return (double) m_at_##T(m, r, c); } \
+    static void* m_addAdapter_##T(void *m1, void *m2) { return m_MatrixAdd_##T(m1, m2); } \
+    static void* m_subtractAdapter_##T(void *m1, void *m2) { return m_MatrixSubtract_##T(m1, m2); } \
+    static void* m_multiplyAdapter_##T(void *m1, void *m2) { return m_MatrixMultiply_##T(m1, m2); } \
+    static void m_scaleAdapter_##T(void *m, const double scalar) { m_ScalarMultiply_##T(m, (T) scalar); } \
+    static bool m_isEqualAdapter_##T(void *m1, void *m2) { return m_isEqual_##T(m1, m2); } \
+    static bool m_isSymmetricAdapter_##T(void *m) { return m_isSymmetric_##T(m); }
+
+/**
+ * @brief The table entry of a built in type, from its adapters.
+ */
+#define MATRIX_TYPE_OPS(T) { \
+    .name = #T, \
+    .element_size = sizeof(T), \
+    .initialize = m_initializeAdapter_##T, \
+    .free = m_freeAdapter_##T, \
+    .print = m_printAdapter_##T, \
+    .rows = m_rowsAdapter_##T, \
+    .columns = m_columnsAdapter_##T, \
+    .storage = m_storageAdapter_##T, \
+    .at = m_atAdapter_##T, \
+    .set = m_setAdapter_##T, \
+    .add = m_addAdapter_##T, \
+    .subtract = m_subtractAdapter_##T, \
+    .multiply = m_multiplyAdapter_##T, \
+    .transpose = m_transposeAdapter_##T, \
+    .scale = m_scaleAdapter_##T, \
+    .isEqual = m_isEqualAdapter_##T, \
+    .isSymmetric = m_isSymmetricAdapter_##T \
+}
+
+MATRIX_TYPE_ADAPTERS(int)
+MATRIX_TYPE_ADAPTERS(float)
+MATRIX_TYPE_ADAPTERS(double)
+
+/**
+ * @brief The storage of an integer matrix, which characterization may have made implicit, compact or encoded.
+ */
+static matrix_storage_t
+m_storageAdapter_int(const void *m) {
+    return ((const matrix_int_t*) m)->storage;
+}
+
+/**
+ * @brief A single precision matrix is always dense.
+ */
+static matrix_storage_t
+m_storageAdapter_float(const void *m) {
+    (void) m;
+    return MATRIX_STORAGE_DENSE;
+}
+
+/**
+ * @brief A double precision matrix is always dense.
+ */
+static matrix_storage_t
+m_storageAdapter_double(const void *m) {
+    (void) m;
+    return MATRIX_STORAGE_DENSE;
+}
+
+/**
+ * @brief Sets an element of an integer matrix, giving it a dense array first.
+ */
+static void
+m_setAdapter_int(void *matrix, const size_t r, const size_t c, const double value) {
+    matrix_int_t *m = matrix;
+    assert((r < m->i) && (c < m->j));
+    m_materialize_int(m);
+    m->array[(r * m->ld) + c] = (int) value;
+    m_invalidateProperties_int(m);
+}
+
+/**
+ * @brief Sets an element of a single precision matrix.
+ */
+static void
+m_setAdapter_float(void *matrix, const size_t r, const size_t c, const double value) {
+    matrix_float_t *m = matrix;
+    assert((r < m->i) && (c < m->j));
+    m->array[(r * m->ld) + c] = (float) value;
+    m_invalidateProperties_float(m);
+}
+
+/**
+ * @brief Sets an element of a double precision matrix.
+ */
+static void
+m_setAdapter_double(void *matrix, const size_t r, const size_t c, const double value) {
+    matrix_double_t *m = matrix;
+    assert((r < m->i) && (c < m->j));
+    m->array[(r * m->ld) + c] = value;
+    m_invalidateProperties_double(m);
+}
+
+/**
+ * @brief Transposes an integer matrix into a new j by i matrix.  m_transpose_int returns a bare array, so the matrix is built here, reading m through m_at_int whatever its storage.
+ */
+static void*
+m_transposeAdapter_int(void *matrix) {
+    matrix_int_t *m = matrix;
+    matrix_int_t *t = initializeMatrix_int(m->j, m->i);
+    m_materialize_int(t);
+    for(size_t row = 0; row < m->i; row++) {
+        for(size_t column = 0; column < m->j; column++) {
+            t->array[(column * t->ld) + row] = m_at_int(m, row, column);
+        }
+    }
+    m_invalidateProperties_int(t);
+    return t;
+}
+
+/**
+ * @brief Transposes a single precision matrix with m_transpose_float.
+ */
+static void*
+m_transposeAdapter_float(void *m) {
+    return m_transpose_float(m);
+}
+
+/**
+ * @brief Transposes a double precision matrix with m_transpose_double.
+ */
+static void*
+m_transposeAdapter_double(void *m) {
+    return m_transpose_double(m);
+}
+
+/**
+ * @brief The kernels of every registered type, indexed by matrix_type_t.  The built in types fill the first entries.
+ */
+static matrix_typeOps_t m_types[MATRIX_TYPE_MAX] = {
+    [MATRIX_TYPE_INT] = MATRIX_TYPE_OPS(int),
+    [MATRIX_TYPE_FLOAT] = MATRIX_TYPE_OPS(float),
+    [MATRIX_TYPE_DOUBLE] = MATRIX_TYPE_OPS(double)
+};
+
+/**
+ * @brief The number of registered types.
+ */
+static size_t m_typeCount = MATRIX_TYPE_BUILTIN_COUNT;
+
+
+/*************************** TYPE REGISTRY ************************/
+
+/**
+ * @brief Registers a new element type.  Every member of ops must be set.  Types are registered before any thread uses the matrix_t functions: the table is not locked.
+ * @param ops The kernels of the type.  They are copied.
+ * @return The tag of the new type
+ */
+matrix_type_t
+m_registerType(const matrix_typeOps_t *ops) {
+    assert(m_typeCount < MATRIX_TYPE_MAX);
+    assert((NULL != ops->initialize) && (NULL != ops->free) && (NULL != ops->print));
+    assert((NULL != ops->rows) && (NULL != ops->columns) && (NULL != ops->storage));
+    assert((NULL != ops->at) && (NULL != ops->set) && (NULL != ops->transpose) && (NULL != ops->scale));
+    assert((NULL != ops->add) && (NULL != ops->subtract) && (NULL != ops->multiply));
+    assert((NULL != ops->isEqual) && (NULL != ops->isSymmetric));
+    m_types[m_typeCount] = *ops;
+    return (matrix_type_t) m_typeCount++;
+}
+
+/**
+ * @brief Finds the kernels of a registered type.
+ * @param type The tag of the type
+ * @return The kernels of the type
+ */
+const matrix_typeOps_t*
+m_typeOps(const matrix_type_t type) {
+    assert((size_t) type < m_typeCount);
+    return &m_types[type];
+}
+
+/**
+ * @brief Wraps a matrix of a registered type in a matrix_t.  The matrix_t does not copy it: freeing one frees the other.
+ * @param type The tag of the type
+ * @param matrix The matrix
+ * @return The matrix_t
+ */
+matrix_t
+m_wrap_tagged(const matrix_type_t type, void *matrix) {
+    assert((size_t) type < m_typeCount);
+    return (matrix_t) {.type = type, .as.any = matrix};
+}
+
+/**
+ * @brief Wraps an integer matrix in a matrix_t.
+ * @param m The matrix
+ * @return The matrix_t
+ */
+matrix_t
+m_wrap_int(matrix_int_t *m) {
+    return (matrix_t) {.type = MATRIX_TYPE_INT, .as.int_matrix = m};
+}
+
+/**
+ * @brief Wraps a single precision matrix in a matrix_t.
+ * @param m The matrix
+ * @return The matrix_t
+ */
+matrix_t
+m_wrap_float(matrix_float_t *m) {
+    return (matrix_t) {.type = MATRIX_TYPE_FLOAT, .as.float_matrix = m};
+}
+
+/**
+ * @brief Wraps a double precision matrix in a matrix_t.
+ * @param m The matrix
+ * @return The matrix_t
+ */
+matrix_t
+m_wrap_double(matrix_double_t *m) {
+    return (matrix_t) {.type = MATRIX_TYPE_DOUBLE, .as.double_matrix = m};
+}
+
+
+/*************************** TAGGED MATRIX OPERATIONS ************************/
+
+/**
+ * @brief Allocates a matrix of dimensions i by j and of a registered type.  The values are zero.
+ * @param type The element type
+ * @param i The number of rows
+ * @param j The number of columns
+ * @return The matrix
+ */
+matrix_t
+initializeMatrix_tagged(const matrix_type_t type, const int i, const int j) {
+    return m_wrap_tagged(type, m_typeOps(type)->initialize(i, j));
+}
+
+/**
+ * @brief Frees a matrix with the kernel of its type.
+ * @param m The matrix
+ */
+void
+freeMatrix_tagged(matrix_t m) {
+    m_typeOps(m.type)->free(m.as.any);
+}
+
+/**
+ * @brief Prints the matrix to stdout with the kernel of its type.
+ * @param m The matrix
+ */
+void
+printMatrix_tagged(matrix_t m) {
+    m_typeOps(m.type)->print(m.as.any);
+}
+
+/**
+ * @brief The number of rows of a matrix.
+ * @param m The matrix
+ * @return The number of rows
+ */
+size_t
+m_rows_tagged(matrix_t m) {
+    return m_typeOps(m.type)->rows(m.as.any);
+}
+
+/**
+ * @brief The number of columns of a matrix.
+ * @param m The matrix
+ * @return The number of columns
+ */
+size_t
+m_columns_tagged(matrix_t m) {
+    return m_typeOps(m.type)->columns(m.as.any);
+}
+
+/**
+ * @brief How a matrix keeps its values.  It can change when the matrix is characterized, so it is asked of the matrix rather than kept in the matrix_t.
+ * @param m The matrix
+ * @return The storage of the matrix
+ */
+matrix_storage_t
+m_storage_tagged(matrix_t m) {
+    return m_typeOps(m.type)->storage(m.as.any);
+}
+
+/**
+ * @brief Element (r, c) of a matrix, converted to double.
+ * @param m The matrix
+ * @param r The row
+ * @param c The column
+ * @return The element
+ */
+double
+m_at_tagged(matrix_t m, const size_t r, const size_t c) {
+    return m_typeOps(m.type)->at(m.as.any, r, c);
+}
+
+/**
+ * @brief Sets element (r, c) of a matrix.  The value is converted to the element type as by a C cast.
+ * @param m The matrix
+ * @param r The row
+ * @param c The column
+ * @param value The new value
+ */
+void
+m_set_tagged(matrix_t m, const size_t r, const size_t c, const double value) {
+    m_typeOps(m.type)->set(m.as.any, r, c, value);
+}
+
+/**
+ * @brief Adds two matrices of the same type, M1 + M2.
+ * @param m1 The first matrix
+ * @param m2 The second matrix
+ * @return A new matrix of the same type
+ */
+matrix_t
+m_MatrixAdd_tagged(matrix_t m1, matrix_t m2) {
+    assert(m1.type == m2.type);
+    return m_wrap_tagged(m1.type, m_typeOps(m1.type)->add(m1.as.any, m2.as.any));
+}
+
+/**
+ * @brief Subtracts two matrices of the same type, M1 - M2.
+ * @param m1 The first matrix
+ * @param m2 The second matrix
+ * @return A new matrix of the same type
+ */
+matrix_t
+m_MatrixSubtract_tagged(matrix_t m1, matrix_t m2) {
+    assert(m1.type == m2.type);
+    return m_wrap_tagged(m1.type, m_typeOps(m1.type)->subtract(m1.as.any, m2.as.any));
+}
+
+/**
+ * @brief Multiplies two matrices of the same type, M1 x M2, with the matrix multiplication of that type.
+ * @param m1 The first matrix
+ * @param m2 The second matrix
+ * @return A new matrix of the same type
+ */
+matrix_t
+m_MatrixMultiply_tagged(matrix_t m1, matrix_t m2) {
+    assert(m1.type == m2.type);
+    return m_wrap_tagged(m1.type, m_typeOps(m1.type)->multiply(m1.as.any, m2.as.any));
+}
+
+/**
+ * @brief Transposes a matrix.
+ * @param m The matrix
+ * @return A new matrix of the same type with the rows and columns of m exchanged
+ */
+matrix_t
+m_transpose_tagged(matrix_t m) {
+    return m_wrap_tagged(m.type, m_typeOps(m.type)->transpose(m.as.any));
+}
+
+/**
+ * @brief Multiplies every value of a matrix by a scalar, in place.  The scalar is converted to the element type first.
+ * @param m The matrix
+ * @param scalar The scalar
+ */
+void
+m_ScalarMultiply_tagged(matrix_t m, const double scalar) {
+    m_typeOps(m.type)->scale(m.as.any, scalar);
+}
+
+/**
+ * @brief Finds whether two matrices have the same type, dimensions and values.
+ * @param m1 The first matrix
+ * @param m2 The second matrix
+ * @return Whether they are equal
+ */
+bool
+m_isEqual_tagged(matrix_t m1, matrix_t m2) {
+    if(m1.type != m2.type) {
+        return false;
+    }
+    return m_typeOps(m1.type)->isEqual(m1.as.any, m2.as.any);
+}
+
+/**
+ * @brief Finds whether a matrix is symmetric.
+ * @param m The matrix
+ * @return Whether it is symmetric
+ */
+bool
+m_isSymmetric_tagged(matrix_t m) {
+    return m_typeOps(m.type)->isSymmetric(m.as.any);
+}
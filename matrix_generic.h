@@ -0,0 +1,343 @@
+/**
+ * @file matrix_generic.h
+ * @brief One matrix handle for every element type, with a table of kernels per type and type-generic macros
+ * @author Aaron Fleisher
+ * @date 2026-10-16
+ *
+ * A matrix_t is a discriminated union: the element type in its tag and a pointer to the matrix of that type.  Every operation on a matrix_t looks the tag up once in the table of registered types and calls the kernel of that type, so there is one branch per call and none per element.  The storage format of the matrix is the one its own engine keeps (m_storage_tagged): a matrix_int_t may be implicit, packed, sparse or narrowed, a matrix_float_t or matrix_double_t is always dense.
+ * int, float and double are registered from the start.  Another element type only needs a matrix_typeOps_t of its kernels given to m_registerType; every function of this header then works on its matrices.
+ * When the types are known at compile time the macros (m_multiply, m_add, ...) choose the specialized function with C11 _Generic, and a matrix_t goes through the table.
+ */
+
+#ifndef MATRIX_GENERIC_H
+#define MATRIX_GENERIC_H
+
+#include "myMatrix.h"
+#include "matrix_double.h"
+#include "matrix_float.h"
+
+/**
+ * @brief The largest number of element types, the built in ones included, that can be registered.
+ */
+#define MATRIX_TYPE_MAX 16
+
+/**
+ * @brief The element type of a matrix_t.  The registered types that are not built in take the values from MATRIX_TYPE_BUILTIN_COUNT on, in the order of registration.
+ */
+typedef enum Matrix_type_e {
+    MATRIX_TYPE_INT = 0,       /** << matrix_int_t */
+    MATRIX_TYPE_FLOAT,         /** << matrix_float_t */
+    MATRIX_TYPE_DOUBLE,        /** << matrix_double_t */
+    MATRIX_TYPE_BUILTIN_COUNT
+} matrix_type_t;
+
+/**
+ * @brief A matrix of any registered element type.  It is two words, so it is passed and returned by value.
+ * @var type The element type, which selects the member of as
+ * @var as The matrix.  any is the member of the types that are not built in.
+ */
+typedef struct Matrix_s {
+    matrix_type_t type;
+    union {
+        void *any;
+        matrix_int_t *int_matrix;
+        matrix_float_t *float_matrix;
+        matrix_double_t *double_matrix;
+    } as;
+} matrix_t;
+
+/**
+ * @brief The kernels of one element type.  Each takes and returns the matrix of that type as a void pointer.  Values cross the table as doubles, which hold every int, float and double exactly.
+ * @var name The name of the type, for printing
+ * @var element_size The size of one element in bytes
+ * @var initialize Allocates a zeroed i by j matrix
+ * @var free Frees a matrix
+ * @var print Prints a matrix to stdout
+ * @var rows, columns The dimensions of a matrix
+ * @var storage How the matrix keeps its values (see matrix_storage_t)
+ * @var at Element (r, c)
+ * @var set Sets element (r, c), which forgets the cached properties of the matrix
+ * @var add, subtract, multiply M1 + M2, M1 - M2 and M1 x M2 as new matrices
+ * @var transpose The transpose as a new matrix
+ * @var scale Multiplies every element by a scalar, in place
+ * @var isEqual Whether two matrices have the same dimensions and values
+ * @var isSymmetric Whether a matrix is symmetric
+ */
+typedef struct Matrix_typeOps_s {
+    const char *name;
+    size_t element_size;
+    void *(*initialize)(const int i, const int j);
+    void (*free)(void *m);
+    void (*print)(void *m);
+    size_t (*rows)(const void *m);
+    size_t (*columns)(const void *m);
+    matrix_storage_t (*storage)(const void *m);
+    double (*at)(void *m, const size_t r, const size_t c);
+    void (*set)(void *m, const size_t r, const size_t c, const double value);
+    void *(*add)(void *m1, void *m2);
+    void *(*subtract)(void *m1, void *m2);
+    void *(*multiply)(void *m1, void *m2);
+    void *(*transpose)(void *m);
+    void (*scale)(void *m, const double scalar);
+    bool (*isEqual)(void *m1, void *m2);
+    bool (*isSymmetric)(void *m);
+} matrix_typeOps_t;
+
+
+/*************************** TYPE REGISTRY ************************/
+
+/**
+ * @brief Registers a new element type.  Every member of ops must be set.  Types are registered before any thread uses the matrix_t functions: the table is not locked.
+ * @param ops The kernels of the type.  They are copied.
+ * @return The tag of the new type
+ */
+matrix_type_t
+m_registerType(const matrix_typeOps_t *ops);
+
+/**
+ * @brief Finds the kernels of a registered type.
+ * @param type The tag of the type
+ * @return The kernels of the type
+ */
+const matrix_typeOps_t*
+m_typeOps(const matrix_type_t type);
+
+/**
+ * @brief Wraps a matrix of a registered type in a matrix_t.  The matrix_t does not copy it: freeing one frees the other.
+ * @param type The tag of the type
+ * @param matrix The matrix
+ * @return The matrix_t
+ */
+matrix_t
+m_wrap_tagged(const matrix_type_t type, void *matrix);
+
+/**
+ * @brief Wraps an integer matrix in a matrix_t.
+ * @param m The matrix
+ * @return The matrix_t
+ */
+matrix_t
+m_wrap_int(matrix_int_t *m);
+
+/**
+ * @brief Wraps a single precision matrix in a matrix_t.
+ * @param m The matrix
+ * @return The matrix_t
+ */
+matrix_t
+m_wrap_float(matrix_float_t *m);
+
+/**
+ * @brief Wraps a double precision matrix in a matrix_t.
+ * @param m The matrix
+ * @return The matrix_t
+ */
+matrix_t
+m_wrap_double(matrix_double_t *m);
+
+
+/*************************** TAGGED MATRIX OPERATIONS ************************/
+
+/**
+ * @brief Allocates a matrix of dimensions i by j and of a registered type.  The values are zero.
+ * @param type The element type
+ * @param i The number of rows
+ * @param j The number of columns
+ * @return The matrix
+ */
+matrix_t
+initializeMatrix_tagged(const matrix_type_t type, const int i, const int j);
+
+/**
+ * @brief Frees a matrix with the kernel of its type.
+ * @param m The matrix
+ */
+void
+freeMatrix_tagged(matrix_t m);
+
+/**
+ * @brief Prints the matrix to stdout with the kernel of its type.
+ * @param m The matrix
+ */
+void
+printMatrix_tagged(matrix_t m);
+
+/**
+ * @brief The number of rows of a matrix.
+ * @param m The matrix
+ * @return The number of rows
+ */
+size_t
+m_rows_tagged(matrix_t m);
+
+/**
+ * @brief The number of columns of a matrix.
+ * @param m The matrix
+ * @return The number of columns
+ */
+size_t
+m_columns_tagged(matrix_t m);
+
+/**
+ * @brief How a matrix keeps its values.  It can change when the matrix is characterized, so it is asked of the matrix rather than kept in the matrix_t.
+ * @param m The matrix
+ * @return The storage of the matrix
+ */
+matrix_storage_t
+m_storage_tagged(matrix_t m);
+
+/**
+ * @brief Element (r, c) of a matrix, converted to double.
+ * @param m The matrix
+ * @param r The row
+ * @param c The column
+ * @return The element
+ */
+double
+m_at_tagged(matrix_t m, const size_t r, const size_t c);
+
+/**
+ * @brief Sets element (r, c) of a matrix.  The value is converted to the element type as by a C cast.
+ * @param m The matrix
+ * @param r The row
+ * @param c The column
+ * @param value The new value
+ */
+void
+m_set_tagged(matrix_t m, const size_t r, const size_t c, const double value);
+
+/**
+ * @brief Adds two matrices of the same type, M1 + M2.
+ * @param m1 The first matrix
+ * @param m2 The second matrix
+ * @return A new matrix of the same type
+ */
+matrix_t
+m_MatrixAdd_tagged(matrix_t m1, matrix_t m2);
+
+/**
+ * @brief Subtracts two matrices of the same type, M1 - M2.
+ * @param m1 The first matrix
+ * @param m2 The second matrix
+ * @return A new matrix of the same type
+ */
+matrix_t
+m_MatrixSubtract_tagged(matrix_t m1, matrix_t m2);
+
+/**
+ * @brief Multiplies two matrices of the same type, M1 x M2, with the matrix multiplication of that type.
+ * @param m1 The first matrix
+ * @param m2 The second matrix
+ * @return A new matrix of the same type
+ */
+matrix_t
+m_MatrixMultiply_tagged(matrix_t m1, matrix_t m2);
+
+/**
+ * @brief Transposes a matrix.
+ * @param m The matrix
+ * @return A new matrix of the same type with the rows and columns of m exchanged
+ */
+matrix_t
+m_transpose_tagged(matrix_t m);
+
+/**
+ * @brief Multiplies every value of a matrix by a scalar, in place.  The scalar is converted to the element type first.
+ * @param m The matrix
+ * @param scalar The scalar
+ */
+void
+m_ScalarMultiply_tagged(matrix_t m, const double scalar);
+
+/**
+ * @brief Finds whether two matrices have the same type, dimensions and values.
+ * @param m1 The first matrix
+ * @param m2 The second matrix
+ * @return Whether they are equal
+ */
+bool
+m_isEqual_tagged(matrix_t m1, matrix_t m2);
+
+/**
+ * @brief Finds whether a matrix is symmetric.
+ * @param m The matrix
+ * @return Whether it is symmetric
+ */
+bool
+m_isSymmetric_tagged(matrix_t m);
+
+
+/*************************** TYPE GENERIC MACROS ************************/
+
+/**
+ * @brief Wraps a matrix_int_t, matrix_float_t or matrix_double_t pointer in a matrix_t.
+ */
+#define m_wrap(m) _Generic((m), \
+    matrix_int_t*: m_wrap_int, \
+    matrix_float_t*: m_wrap_float, \
+    matrix_double_t*: m_wrap_double)(m)
+
+/**
+ * @brief M1 x M2 with the function of the type of m1: m_MatrixMultiply_int, _float or _double for a matrix pointer, m_MatrixMultiply_tagged for a matrix_t.
+ */
+#define m_multiply(m1, m2) _Generic((m1), \
+    matrix_int_t*: m_MatrixMultiply_int, \
+    matrix_float_t*: m_MatrixMultiply_float, \
+    matrix_double_t*: m_MatrixMultiply_double, \
+    matrix_t: m_MatrixMultiply_tagged)((m1), (m2))
+
+/**
+ * @brief M1 + M2 with the function of the type of m1.
+ */
+#define m_add(m1, m2) _Generic((m1), \
+    matrix_int_t*: m_MatrixAdd_int, \
+    matrix_float_t*: m_MatrixAdd_float, \
+    matrix_double_t*: m_MatrixAdd_double, \
+    matrix_t: m_MatrixAdd_tagged)((m1), (m2))
+
+/**
+ * @brief M1 - M2 with the function of the type of m1.
+ */
+#define m_subtract(m1, m2) _Generic((m1), \
+    matrix_int_t*: m_MatrixSubtract_int, \
+    matrix_float_t*: m_MatrixSubtract_float, \
+    matrix_double_t*: m_MatrixSubtract_double, \
+    matrix_t: m_MatrixSubtract_tagged)((m1), (m2))
+
+/**
+ * @brief Multiplies m by a scalar in place with the function of the type of m.
+ */
+#define m_scale(m, scalar) _Generic((m), \
+    matrix_int_t*: m_ScalarMultiply_int, \
+    matrix_float_t*: m_ScalarMultiply_float, \
+    matrix_double_t*: m_ScalarMultiply_double, \
+    matrix_t: m_ScalarMultiply_tagged)((m), (scalar))
+
+/**
+ * @brief Whether M1 and M2 are equal, with the function of the type of m1.
+ */
+#define m_equal(m1, m2) _Generic((m1), \
+    matrix_int_t*: m_isEqual_int, \
+    matrix_float_t*: m_isEqual_float, \
+    matrix_double_t*: m_isEqual_double, \
+    matrix_t: m_isEqual_tagged)((m1), (m2))
+
+/**
+ * @brief Prints m with the function of its type.
+ */
+#define m_print(m) _Generic((m), \
+    matrix_int_t*: printMatrix_int, \
+    matrix_float_t*: printMatrix_float, \
+    matrix_double_t*: printMatrix_double, \
+    matrix_t: printMatrix_tagged)(m)
+
+/**
+ * @brief Frees m with the function of its type.
+ */
+#define m_free(m) _Generic((m), \
+    matrix_int_t*: freeMatrix_int, \
+    matrix_float_t*: freeMatrix_float, \
+    matrix_double_t*: freeMatrix_double, \
+    matrix_t: freeMatrix_tagged)(m)
+
+#endif /** MATRIX_GENERIC_H */
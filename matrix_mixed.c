@@ -0,0 +1,1204 @@
+/**
+ * @file matrix_mixed.c
+ * @brief Low precision matrices and the mixed precision matrix multiplication: int8 and int16 operands accumulated in int32, bfloat16 and float16 operands accumulated in single precision
+ * @author Aaron Fleisher
+ * @date 2026-10-16
+ */
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "SFMT.h"
+#include "matrix_mixed.h"
+#include "matrix_pool.h"
+#include "matrix_simd.h"
+#include "matrix_threads.h"
+
+
+/*************************** CONVERSIONS ************************/
+
+/**
+ * @brief Rounds a single precision value to the nearest bfloat16, ties to even.  A NaN stays a NaN.
+ * @param value The value
+ * @return The bfloat16 value
+ */
+bfloat16_t
+m_floatToBfloat16(const float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    if((bits & 0x7FFFFFFFu) > 0x7F800000u) {
+        /* Rounding could carry the payload of a NaN into the exponent and make it infinity, so the NaN is truncated and quieted instead. */
+        return (bfloat16_t) ((bits >> 16) | 0x0040u);
+    }
+    bits += 0x7FFFu + ((bits >> 16) & 1u);
+    return (bfloat16_t) (bits >> 16);
+}
+
+/**
+ * @brief Widens a bfloat16 value to single precision.  The conversion is exact.
+ * @param value The bfloat16 value
+ * @return The value
+ */
+float
+m_bfloat16ToFloat(const bfloat16_t value) {
+    const uint32_t bits = (uint32_t) value << 16;
+    float result;
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+/**
+ * @brief Rounds a single precision value to the nearest float16, ties to even, as the F16C instruction VCVTPS2PH does.  Values from 65520 on become infinity, and values below 2^-14 become subnormal.
+ * @param value The value
+ * @return The float16 value
+ */
+half_t
+m_floatToHalf(const float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    const uint16_t sign = (uint16_t) ((bits >> 16) & 0x8000u);
+    const uint32_t magnitude = bits & 0x7FFFFFFFu;
+    if(magnitude > 0x7F800000u) {
+        return sign | (uint16_t) (0x7E00u | ((magnitude >> 13) & 0x3FFu));
+    }
+    if(magnitude >= 0x477FF000u) { /* 65520, halfway between 65504 and 65536, rounds to the even neighbour: infinity */
+        return sign | 0x7C00u;
+    }
+    if(magnitude >= 0x38800000u) { /* 2^-14, the smallest normal float16 */
+        /* Rebiasing the exponent from 127 to 15 leaves the 10 mantissa bits above bit 13.  A carry out of the mantissa correctly moves to the next exponent. */
+        uint32_t rebiased = magnitude - 0x38000000u;
+        rebiased += 0xFFFu + ((rebiased >> 13) & 1u);
+        return sign | (uint16_t) (rebiased >> 13);
+    }
+    /* A subnormal float16 is a multiple of 2^-24, which is the last mantissa bit of 0.5, so adding 0.5 makes the hardware round the value to the nearest multiple, ties to even. */
+    float absolute;
+    memcpy(&absolute, &magnitude, sizeof(absolute));
+    const float shifted = absolute + 0.5f;
+    uint32_t shifted_bits;
+    memcpy(&shifted_bits, &shifted, sizeof(shifted_bits));
+    return sign | (uint16_t) (shifted_bits - 0x3F000000u);
+}
+
+/**
+ * @brief Widens a float16 value to single precision.  The conversion is exact, and a NaN is quieted, as the F16C instruction VCVTPH2PS does.
+ * @param value The float16 value
+ * @return The value
+ */
+float
+m_halfToFloat(const half_t value) {
+    const uint32_t sign = (uint32_t) (value & 0x8000u) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1Fu;
+    const uint32_t mantissa = value & 0x3FFu;
+    uint32_t bits;
+    if(0x1Fu == exponent) {
+        bits = sign | 0x7F800000u | (mantissa << 13) | ((0 != mantissa) ? 0x00400000u : 0);
+    } else if(0 != exponent) {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    } else {
+        const float subnormal = (float) mantissa * 0x1p-24f;
+        return (0 != sign) ? -subnormal : subnormal;
+    }
+    float result;
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+
+/*************************** MATRIX WIDE OPERATIONS ************************/
+
+/**
+ * @brief The size of one element of a precision in bytes.
+ * @param precision The element type
+ * @return 1 or 2
+ */
+size_t
+m_elementSize_lowp(const matrix_precision_t precision) {
+    return ((MATRIX_PRECISION_INT8 == precision) || (MATRIX_PRECISION_UINT8 == precision)) ? sizeof(int8_t) : sizeof(uint16_t);
+}
+
+/**
+ * @brief Chooses the leading dimension of a new matrix with j columns.  A row takes a whole number of 4-byte groups, so the product can read the last group of a row without going past it.  Rows of at least a cache line are padded to whole cache lines, plus one more when the stride would be a multiple of 4096 bytes (see m_leadingDimension_int).
+ */
+static size_t
+m_leadingDimension_lowp(const size_t j, const size_t element_size) {
+    const size_t group = MATRIX_LOWP_GROUP_BYTES / element_size;
+    const size_t line = MATRIX_ALIGNMENT / element_size;
+    if(j < line) {
+        return ((j + group - 1) / group) * group;
+    }
+    size_t ld = ((j + line - 1) / line) * line;
+    if(0 == ((ld * element_size) % 4096)) {
+        ld += line;
+    }
+    return ld;
+}
+
+/**
+ * @brief Allocates a low precision matrix of dimensions i by j upon the heap.  The values are zero.
+ * @param precision The element type
+ * @param i The number of rows
+ * @param j The number of columns
+ * @return A pointer to a matrix struct.  The header and arrays of up to MATRIX_POOL_MAX_BLOCK bytes come from the size-class pool.
+ */
+matrix_lowp_t*
+initializeMatrix_lowp(const matrix_precision_t precision, const int i, const int j) {
+    matrix_lowp_t *m = m_poolCalloc(sizeof(matrix_lowp_t));
+    assert(NULL != m);
+    m->i = i;
+    m->j = j;
+    m->precision = precision;
+    m->ld = m_leadingDimension_lowp(m->j, m_elementSize_lowp(precision));
+    m->array = m_poolCalloc(m->i * m->ld * m_elementSize_lowp(precision));
+    assert(NULL != m->array);
+    return m;
+}
+
+/**
+ * @brief Frees a low precision matrix and its array.
+ * @param m The matrix that will be freed.
+ */
+void
+freeMatrix_lowp(matrix_lowp_t *m) {
+    m_poolFree(m->array, m->i * m->ld * m_elementSize_lowp(m->precision));
+    m_poolFree(m, sizeof(matrix_lowp_t));
+}
+
+/**
+ * @brief Rounds a value to the nearest integer, ties to even, and saturates it to [minimum, maximum].  NaN becomes 0.
+ */
+static int
+m_saturate_lowp(const float value, const int minimum, const int maximum) {
+    if(isnan(value)) {
+        return 0;
+    }
+    const float rounded = nearbyintf(value);
+    if(rounded <= (float) minimum) {
+        return minimum;
+    }
+    if(rounded >= (float) maximum) {
+        return maximum;
+    }
+    return (int) rounded;
+}
+
+/**
+ * @brief Narrows one row of single precision values into row r of a low precision matrix.
+ */
+static void
+m_narrowRow_lowp(matrix_lowp_t *m, const size_t r, const float *values) {
+    const matrix_kernels_mixed_t *kernels = m_kernels_mixed();
+    switch(m->precision) {
+        case MATRIX_PRECISION_INT8: {
+            int8_t *row = (int8_t*) m->array + (r * m->ld);
+            for(size_t column = 0; column < m->j; column++) {
+                row[column] = (int8_t) m_saturate_lowp(values[column], INT8_MIN, INT8_MAX);
+            }
+            break;
+        }
+        case MATRIX_PRECISION_UINT8: {
+            uint8_t *row = (uint8_t*) m->array + (r * m->ld);
+            for(size_t column = 0; column < m->j; column++) {
+                row[column] = (uint8_t) m_saturate_lowp(values[column], 0, UINT8_MAX);
+            }
+            break;
+        }
+        case MATRIX_PRECISION_INT16: {
+            int16_t *row = (int16_t*) m->array + (r * m->ld);
+            for(size_t column = 0; column < m->j; column++) {
+                row[column] = (int16_t) m_saturate_lowp(values[column], INT16_MIN, INT16_MAX);
+            }
+            break;
+        }
+        case MATRIX_PRECISION_BF16:
+            kernels->narrow_bf16((uint16_t*) m->array + (r * m->ld), values, m->j);
+            break;
+        case MATRIX_PRECISION_FP16:
+            kernels->narrow_fp16((uint16_t*) m->array + (r * m->ld), values, m->j);
+            break;
+    }
+}
+
+/**
+ * @brief Widens length values of row r of a low precision matrix, from column c on, to single precision.
+ */
+static void
+m_widenRow_lowp(const matrix_lowp_t *m, const size_t r, const size_t c, const size_t length, float *destination) {
+    const matrix_kernels_mixed_t *kernels = m_kernels_mixed();
+    switch(m->precision) {
+        case MATRIX_PRECISION_INT8: {
+            const int8_t *row = (const int8_t*) m->array + (r * m->ld) + c;
+            for(size_t column = 0; column < length; column++) {
+                destination[column] = row[column];
+            }
+            break;
+        }
+        case MATRIX_PRECISION_UINT8: {
+            const uint8_t *row = (const uint8_t*) m->array + (r * m->ld) + c;
+            for(size_t column = 0; column < length; column++) {
+                destination[column] = row[column];
+            }
+            break;
+        }
+        case MATRIX_PRECISION_INT16: {
+            const int16_t *row = (const int16_t*) m->array + (r * m->ld) + c;
+            for(size_t column = 0; column < length; column++) {
+                destination[column] = row[column];
+            }
+            break;
+        }
+        case MATRIX_PRECISION_BF16:
+            kernels->widen_bf16(destination, (const uint16_t*) m->array + (r * m->ld) + c, length);
+            break;
+        case MATRIX_PRECISION_FP16:
+            kernels->widen_fp16(destination, (const uint16_t*) m->array + (r * m->ld) + c, length);
+            break;
+    }
+}
+
+/**
+ * @brief Narrows a single precision matrix.  int8, uint8 and int16 round to the nearest integer, ties to even, and saturate at the limits of the type; bfloat16 and float16 round to the nearest value, ties to even.
+ * @param precision The element type of the new matrix
+ * @param m The matrix
+ * @return A new low precision matrix allocated upon the heap
+ */
+matrix_lowp_t*
+m_fromFloat_lowp(const matrix_precision_t precision, const matrix_float_t *m) {
+    matrix_lowp_t *narrow = initializeMatrix_lowp(precision, m->i, m->j);
+    for(size_t row = 0; row < m->i; row++) {
+        m_narrowRow_lowp(narrow, row, m->array + (row * m->ld));
+    }
+    return narrow;
+}
+
+/**
+ * @brief Narrows an integer matrix.  int8, uint8 and int16 saturate at the limits of the type; bfloat16 and float16 round to the nearest value, ties to even.
+ * @param precision The element type of the new matrix
+ * @param m The matrix, in any storage
+ * @return A new low precision matrix allocated upon the heap
+ */
+matrix_lowp_t*
+m_fromInt_lowp(const matrix_precision_t precision, matrix_int_t *m) {
+    matrix_lowp_t *narrow = initializeMatrix_lowp(precision, m->i, m->j);
+    float *values = m_threadScratch(0, m->j * sizeof(float));
+    for(size_t row = 0; row < m->i; row++) {
+        for(size_t column = 0; column < m->j; column++) {
+            const int value = m_at_int(m, row, column);
+            if(MATRIX_PRECISION_INT8 == precision) {
+                values[column] = (value < INT8_MIN) ? INT8_MIN : ((value > INT8_MAX) ? INT8_MAX : value);
+            } else if(MATRIX_PRECISION_UINT8 == precision) {
+                values[column] = (value < 0) ? 0 : ((value > UINT8_MAX) ? UINT8_MAX : value);
+            } else if(MATRIX_PRECISION_INT16 == precision) {
+                values[column] = (value < INT16_MIN) ? INT16_MIN : ((value > INT16_MAX) ? INT16_MAX : value);
+            } else {
+                values[column] = (float) value;
+            }
+        }
+        m_narrowRow_lowp(narrow, row, values);
+    }
+    return narrow;
+}
+
+/**
+ * @brief Widens a low precision matrix to single precision.  The conversion is exact.
+ * @param m The matrix
+ * @return A new matrix allocated upon the heap
+ */
+matrix_float_t*
+m_toFloat_lowp(const matrix_lowp_t *m) {
+    matrix_float_t *wide = initializeMatrix_float(m->i, m->j);
+    for(size_t row = 0; row < m->i; row++) {
+        m_widenRow_lowp(m, row, 0, m->j, wide->array + (row * wide->ld));
+    }
+    m_invalidateProperties_float(wide);
+    return wide;
+}
+
+/**
+ * @brief Returns the value of the matrix at the given position, widened to single precision.
+ * @param m The matrix
+ * @param i The row index, using C style indexing (starting at 0)
+ * @param j The column index, using C style indexing (starting at 0)
+ * @return The value
+ */
+float
+m_at_lowp(const matrix_lowp_t *m, const size_t i, const size_t j) {
+    float value;
+    m_widenRow_lowp(m, i, j, 1, &value);
+    return value;
+}
+
+
+/*************************** MIXED PRECISION MATRIX MULTIPLICATION ************************/
+
+/**
+ * @brief Describes one mixed precision matrix multiplication.  The result is cut into tiles of row_group x MC rows by column_block columns; every tile is one task for the thread pool.
+ * @var result The array of the result, int for 8 and 16-bit integer operands and float otherwise
+ * @var ldc The leading dimension of the result
+ * @var a_mask XORed into every group of M1 as it is packed: 0x80808080 offsets int8 values by 128 to the unsigned bytes VPDPBUSD takes
+ * @var b_mask XORed into every byte of M2 as it is packed: 0x80 offsets uint8 values by -128 to the signed bytes VPDPBUSD takes
+ * @var epilogue Called on every tile of the result once its sums are complete, to take the offsets back out, or NULL
+ * @var epilogue_context What the epilogue needs besides the job
+ */
+typedef struct Matrix_gemmJob_lowp_s {
+    const matrix_lowp_t *m1;
+    const matrix_lowp_t *m2;
+    void *result;
+    size_t ldc;
+    size_t rows;
+    size_t columns;
+    uint32_t a_mask;
+    uint8_t b_mask;
+    void (*epilogue)(const struct Matrix_gemmJob_lowp_s *job, const size_t row_begin, const size_t row_end, const size_t jc, const size_t nc);
+    const void *epilogue_context;
+    size_t row_tiles;
+    size_t row_group;
+    size_t column_block;
+} matrix_gemmJob_lowp_t;
+
+/**
+ * @brief Packs an mc x kg block of a matrix, kg counted in groups, into consecutive micro-panels of MATRIX_GEMM_MR_LOWP rows.  Within a micro-panel the groups are stored one column of groups at a time, so the micro-kernel reads the buffer strictly sequentially.  Every group is XORed with mask as it is copied.  Rows past the edge of the matrix are padded with zeros.
+ * @param m The matrix
+ * @param ic The first row of the block
+ * @param pg The first group of the block
+ * @param mc The number of rows in the block
+ * @param kg The number of groups in the block
+ * @param mask See matrix_gemmJob_lowp_t
+ * @param buffer Destination buffer holding at least ceil(mc / MATRIX_GEMM_MR_LOWP) * MATRIX_GEMM_MR_LOWP * kg groups
+ */
+static void
+m_packGroupsA_lowp(const matrix_lowp_t *m, const size_t ic, const size_t pg, const size_t mc, const size_t kg, const uint32_t mask, uint8_t *buffer) {
+    const size_t row_bytes = m->ld * m_elementSize_lowp(m->precision);
+    for(size_t panel = 0; panel < mc; panel += MATRIX_GEMM_MR_LOWP) {
+        const size_t rows = (mc - panel < MATRIX_GEMM_MR_LOWP) ? (mc - panel) : MATRIX_GEMM_MR_LOWP;
+        const uint8_t *source = (const uint8_t*) m->array + ((ic + panel) * row_bytes) + (pg * MATRIX_LOWP_GROUP_BYTES);
+        for(size_t g = 0; g < kg; g++) {
+            size_t r = 0;
+            for(; r < rows; r++) {
+                uint32_t group;
+                memcpy(&group, source + (r * row_bytes) + (g * MATRIX_LOWP_GROUP_BYTES), sizeof(group));
+                group ^= mask;
+                memcpy(buffer, &group, sizeof(group));
+                buffer += MATRIX_LOWP_GROUP_BYTES;
+            }
+            for(; r < MATRIX_GEMM_MR_LOWP; r++) {
+                memset(buffer, 0, MATRIX_LOWP_GROUP_BYTES);
+                buffer += MATRIX_LOWP_GROUP_BYTES;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Packs a kg x nc block of a matrix, kg counted in groups, into consecutive micro-panels of MATRIX_GEMM_NR_LOWP columns.  A group holds the values of 4 / element size consecutive rows of one column, and the groups of a micro-panel are stored one row of groups at a time.  Rows past the last row and columns past the edge of the matrix are padded with zeros, so the padding of the groups of M1 multiplies nothing.  The bytes of an 8-bit matrix are XORed with mask as they are copied, the padding is not.
+ * @param m The matrix
+ * @param pg The first group of the block
+ * @param jc The first column of the block
+ * @param kg The number of groups in the block
+ * @param nc The number of columns in the block
+ * @param mask See matrix_gemmJob_lowp_t
+ * @param buffer Destination buffer holding at least ceil(nc / MATRIX_GEMM_NR_LOWP) * MATRIX_GEMM_NR_LOWP * kg groups
+ */
+static void
+m_packGroupsB_lowp(const matrix_lowp_t *m, const size_t pg, const size_t jc, const size_t kg, const size_t nc, const uint8_t mask, uint8_t *buffer) {
+    const size_t element_size = m_elementSize_lowp(m->precision);
+    const size_t per_group = MATRIX_LOWP_GROUP_BYTES / element_size;
+    for(size_t panel = 0; panel < nc; panel += MATRIX_GEMM_NR_LOWP) {
+        const size_t columns = (nc - panel < MATRIX_GEMM_NR_LOWP) ? (nc - panel) : MATRIX_GEMM_NR_LOWP;
+        for(size_t g = 0; g < kg; g++) {
+            memset(buffer, 0, MATRIX_GEMM_NR_LOWP * MATRIX_LOWP_GROUP_BYTES);
+            for(size_t t = 0; t < per_group; t++) {
+                const size_t k = ((pg + g) * per_group) + t;
+                if(k >= m->i) {
+                    break;
+                }
+                if(1 == element_size) {
+                    const uint8_t *source = (const uint8_t*) m->array + (k * m->ld) + jc + panel;
+                    for(size_t column = 0; column < columns; column++) {
+                        buffer[(column * MATRIX_LOWP_GROUP_BYTES) + t] = source[column] ^ mask;
+                    }
+                } else {
+                    const uint8_t *source = (const uint8_t*) m->array + (((k * m->ld) + jc + panel) * sizeof(uint16_t));
+                    for(size_t column = 0; column < columns; column++) {
+                        memcpy(buffer + (column * MATRIX_LOWP_GROUP_BYTES) + (t * sizeof(uint16_t)), source + (column * sizeof(uint16_t)), sizeof(uint16_t));
+                    }
+                }
+            }
+            buffer += MATRIX_GEMM_NR_LOWP * MATRIX_LOWP_GROUP_BYTES;
+        }
+    }
+}
+
+/**
+ * @brief Computes one output tile of a product of packed groups over the whole shared dimension, with the dot product micro-kernel of the precision (see matrix_simd.h).  The tile packs its own blocks into the running thread's scratch buffers, as m_gemmTask_float does, and hands itself to the epilogue of the job once it is complete.
+ * @param context The matrix_gemmJob_lowp_t
+ * @param task The index of the tile.  Consecutive tasks walk down a column of tiles so they reuse the same panel of M2.
+ * @param worker Unused
+ */
+static void
+m_gemmGroupsTask_lowp(void *context, const size_t task, const size_t worker) {
+    (void) worker;
+    const matrix_gemmJob_lowp_t *job = context;
+    const matrix_kernels_mixed_t *kernels = m_kernels_mixed();
+    void (*int_kernel)(const size_t, const void*, const void*, int*, const size_t, const size_t, const size_t) = NULL;
+    void (*float_kernel)(const size_t, const void*, const void*, float*, const size_t, const size_t, const size_t) = NULL;
+    const size_t element_size = m_elementSize_lowp(job->m1->precision);
+    if(sizeof(int8_t) == element_size) {
+        int_kernel = kernels->gemm_int8;
+    } else if(MATRIX_PRECISION_INT16 == job->m1->precision) {
+        int_kernel = kernels->gemm_int16;
+    } else {
+        float_kernel = kernels->gemm_bf16;
+    }
+    const size_t groups = ((job->m1->j * element_size) + MATRIX_LOWP_GROUP_BYTES - 1) / MATRIX_LOWP_GROUP_BYTES;
+
+    const size_t row_begin = (task % job->row_tiles) * job->row_group * MATRIX_GEMM_MC_LOWP;
+    const size_t row_span = job->row_group * MATRIX_GEMM_MC_LOWP;
+    const size_t row_end = (job->rows - row_begin < row_span) ? job->rows : (row_begin + row_span);
+    const size_t jc = (task / job->row_tiles) * job->column_block;
+    const size_t nc = (job->columns - jc < job->column_block) ? (job->columns - jc) : job->column_block;
+    const size_t kg_max = (groups < MATRIX_GEMM_KC_LOWP) ? groups : MATRIX_GEMM_KC_LOWP;
+    const size_t mc_max = (row_end - row_begin < MATRIX_GEMM_MC_LOWP) ? (row_end - row_begin) : MATRIX_GEMM_MC_LOWP;
+    const size_t mc_padded = ((mc_max + MATRIX_GEMM_MR_LOWP - 1) / MATRIX_GEMM_MR_LOWP) * MATRIX_GEMM_MR_LOWP;
+    const size_t nc_padded = ((nc + MATRIX_GEMM_NR_LOWP - 1) / MATRIX_GEMM_NR_LOWP) * MATRIX_GEMM_NR_LOWP;
+    uint8_t *packed_a = m_threadScratch(0, mc_padded * kg_max * MATRIX_LOWP_GROUP_BYTES);
+    uint8_t *packed_b = m_threadScratch(1, nc_padded * kg_max * MATRIX_LOWP_GROUP_BYTES);
+
+    for(size_t pg = 0; pg < groups; pg += MATRIX_GEMM_KC_LOWP) {
+        const size_t kg = (groups - pg < MATRIX_GEMM_KC_LOWP) ? (groups - pg) : MATRIX_GEMM_KC_LOWP;
+        const size_t panel_bytes = kg * MATRIX_LOWP_GROUP_BYTES;
+        m_packGroupsB_lowp(job->m2, pg, jc, kg, nc, job->b_mask, packed_b);
+        for(size_t ic = row_begin; ic < row_end; ic += MATRIX_GEMM_MC_LOWP) {
+            const size_t mc = (row_end - ic < MATRIX_GEMM_MC_LOWP) ? (row_end - ic) : MATRIX_GEMM_MC_LOWP;
+            m_packGroupsA_lowp(job->m1, ic, pg, mc, kg, job->a_mask, packed_a);
+            for(size_t column = 0; column < nc; column += MATRIX_GEMM_NR_LOWP) {
+                const size_t nr = (nc - column < MATRIX_GEMM_NR_LOWP) ? (nc - column) : MATRIX_GEMM_NR_LOWP;
+                for(size_t row = 0; row < mc; row += MATRIX_GEMM_MR_LOWP) {
+                    const size_t mr = (mc - row < MATRIX_GEMM_MR_LOWP) ? (mc - row) : MATRIX_GEMM_MR_LOWP;
+                    const size_t offset = ((ic + row) * job->ldc) + jc + column;
+                    if(NULL != int_kernel) {
+                        int_kernel(kg, packed_a + (row * panel_bytes), packed_b + (column * panel_bytes), (int*) job->result + offset, job->ldc, mr, nr);
+                    } else {
+                        float_kernel(kg, packed_a + (row * panel_bytes), packed_b + (column * panel_bytes), (float*) job->result + offset, job->ldc, mr, nr);
+                    }
+                }
+            }
+        }
+    }
+
+    if(NULL != job->epilogue) {
+        job->epilogue(job, row_begin, row_end, jc, nc);
+    }
+}
+
+/**
+ * @brief Packs an mc x kc block of a bfloat16 or float16 matrix into micro-panels of MATRIX_GEMM_MR_FLOAT rows of single precision values, laid out as m_MatrixMultiply_float packs them.  Each row is widened with the vectorized kernel into row_buffer first, then spread over the panel.
+ */
+static void
+m_packWidenedA_lowp(const matrix_lowp_t *m, const size_t ic, const size_t pc, const size_t mc, const size_t kc, float *buffer, float *row_buffer) {
+    for(size_t panel = 0; panel < mc; panel += MATRIX_GEMM_MR_FLOAT) {
+        const size_t rows = (mc - panel < MATRIX_GEMM_MR_FLOAT) ? (mc - panel) : MATRIX_GEMM_MR_FLOAT;
+        for(size_t r = 0; r < MATRIX_GEMM_MR_FLOAT; r++) {
+            if(r < rows) {
+                m_widenRow_lowp(m, ic + panel + r, pc, kc, row_buffer);
+                for(size_t k = 0; k < kc; k++) {
+                    buffer[(k * MATRIX_GEMM_MR_FLOAT) + r] = row_buffer[k];
+                }
+            } else {
+                for(size_t k = 0; k < kc; k++) {
+                    buffer[(k * MATRIX_GEMM_MR_FLOAT) + r] = 0.0f;
+                }
+            }
+        }
+        buffer += MATRIX_GEMM_MR_FLOAT * kc;
+    }
+}
+
+/**
+ * @brief Packs a kc x nc block of a bfloat16 or float16 matrix into micro-panels of MATRIX_GEMM_NR_FLOAT columns of single precision values, laid out as m_MatrixMultiply_float packs them.
+ */
+static void
+m_packWidenedB_lowp(const matrix_lowp_t *m, const size_t pc, const size_t jc, const size_t kc, const size_t nc, float *buffer) {
+    for(size_t panel = 0; panel < nc; panel += MATRIX_GEMM_NR_FLOAT) {
+        const size_t columns = (nc - panel < MATRIX_GEMM_NR_FLOAT) ? (nc - panel) : MATRIX_GEMM_NR_FLOAT;
+        for(size_t k = 0; k < kc; k++) {
+            m_widenRow_lowp(m, pc + k, jc + panel, columns, buffer);
+            memset(buffer + columns, 0, (MATRIX_GEMM_NR_FLOAT - columns) * sizeof(float));
+            buffer += MATRIX_GEMM_NR_FLOAT;
+        }
+    }
+}
+
+/**
+ * @brief Computes one output tile of a bfloat16 or float16 product by widening the operands as they are packed and running the single precision micro-kernel of the host.  The blocking is that of m_MatrixMultiply_float.
+ * @param context The matrix_gemmJob_lowp_t
+ * @param task The index of the tile
+ * @param worker Unused
+ */
+static void
+m_gemmWidenedTask_lowp(void *context, const size_t task, const size_t worker) {
+    (void) worker;
+    const matrix_gemmJob_lowp_t *job = context;
+    void (*const micro_kernel)(const size_t, const float*, const float*, float*, const size_t, const size_t, const size_t) = m_kernels_float()->gemm_micro;
+    const size_t depth = job->m1->j;
+
+    const size_t row_begin = (task % job->row_tiles) * job->row_group * MATRIX_GEMM_MC_FLOAT;
+    const size_t row_span = job->row_group * MATRIX_GEMM_MC_FLOAT;
+    const size_t row_end = (job->rows - row_begin < row_span) ? job->rows : (row_begin + row_span);
+    const size_t jc = (task / job->row_tiles) * job->column_block;
+    const size_t nc = (job->columns - jc < job->column_block) ? (job->columns - jc) : job->column_block;
+    const size_t kc_max = (depth < MATRIX_GEMM_KC_FLOAT) ? depth : MATRIX_GEMM_KC_FLOAT;
+    const size_t mc_max = (row_end - row_begin < MATRIX_GEMM_MC_FLOAT) ? (row_end - row_begin) : MATRIX_GEMM_MC_FLOAT;
+    const size_t mc_padded = ((mc_max + MATRIX_GEMM_MR_FLOAT - 1) / MATRIX_GEMM_MR_FLOAT) * MATRIX_GEMM_MR_FLOAT;
+    const size_t nc_padded = ((nc + MATRIX_GEMM_NR_FLOAT - 1) / MATRIX_GEMM_NR_FLOAT) * MATRIX_GEMM_NR_FLOAT;
+    float *packed_a = m_threadScratch(0, mc_padded * kc_max * sizeof(float));
+    float *packed_b = m_threadScratch(1, nc_padded * kc_max * sizeof(float));
+    float *row_buffer = m_threadScratch(2, kc_max * sizeof(float));
+
+    for(size_t pc = 0; pc < depth; pc += MATRIX_GEMM_KC_FLOAT) {
+        const size_t kc = (depth - pc < MATRIX_GEMM_KC_FLOAT) ? (depth - pc) : MATRIX_GEMM_KC_FLOAT;
+        m_packWidenedB_lowp(job->m2, pc, jc, kc, nc, packed_b);
+        for(size_t ic = row_begin; ic < row_end; ic += MATRIX_GEMM_MC_FLOAT) {
+            const size_t mc = (row_end - ic < MATRIX_GEMM_MC_FLOAT) ? (row_end - ic) : MATRIX_GEMM_MC_FLOAT;
+            m_packWidenedA_lowp(job->m1, ic, pc, mc, kc, packed_a, row_buffer);
+            float *c = (float*) job->result + (ic * job->ldc) + jc;
+            for(size_t column = 0; column < nc; column += MATRIX_GEMM_NR_FLOAT) {
+                const size_t nr = (nc - column < MATRIX_GEMM_NR_FLOAT) ? (nc - column) : MATRIX_GEMM_NR_FLOAT;
+                for(size_t row = 0; row < mc; row += MATRIX_GEMM_MR_FLOAT) {
+                    const size_t mr = (mc - row < MATRIX_GEMM_MR_FLOAT) ? (mc - row) : MATRIX_GEMM_MR_FLOAT;
+                    micro_kernel(kc, packed_a + (row * kc), packed_b + (column * kc), c + (row * job->ldc) + column, job->ldc, mr, nr);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Splits a product into tiles and runs them, serially below MATRIX_GEMM_PARALLEL_THRESHOLD multiply-adds and otherwise on the thread pool, exactly as m_MatrixMultiply_float does.
+ * @param job The product.  The tiling members are filled in here.
+ * @param task The task that computes one tile
+ * @param mc, nc, nr The blocking parameters of the task
+ */
+static void
+m_runGemm_lowp(matrix_gemmJob_lowp_t *job, matrix_task_fn task, const size_t mc, const size_t nc, const size_t nr) {
+    const size_t row_blocks = (job->rows + mc - 1) / mc;
+    job->row_tiles = 1;
+    job->row_group = row_blocks;
+    job->column_block = (job->columns < nc) ? job->columns : nc;
+    size_t column_tiles = (job->columns + job->column_block - 1) / job->column_block;
+    if((job->rows * job->columns * job->m1->j) < MATRIX_GEMM_PARALLEL_THRESHOLD) {
+        for(size_t tile = 0; tile < column_tiles; tile++) {
+            task(job, tile, 0);
+        }
+        return;
+    }
+    const size_t target_tasks = 4 * m_getThreadCount();
+    while(((row_blocks * column_tiles) < target_tasks) && (job->column_block > (4 * nr))) {
+        job->column_block = (((job->column_block / 2) + nr - 1) / nr) * nr;
+        column_tiles = (job->columns + job->column_block - 1) / job->column_block;
+    }
+    const size_t wanted_row_tiles = (target_tasks + column_tiles - 1) / column_tiles;
+    job->row_tiles = (wanted_row_tiles < row_blocks) ? wanted_row_tiles : row_blocks;
+    job->row_group = (row_blocks + job->row_tiles - 1) / job->row_tiles;
+    job->row_tiles = (row_blocks + job->row_group - 1) / job->row_group;
+    m_parallelFor(job->row_tiles * column_tiles, task, job);
+}
+
+/**
+ * @brief The epilogue of an int8 product.  The packed M1 is offset by 128, so 128 times the column sums of M2, the epilogue context, is taken back from every row of the tile.
+ */
+static void
+m_subtractColumnOffsets_lowp(const matrix_gemmJob_lowp_t *job, const size_t row_begin, const size_t row_end, const size_t jc, const size_t nc) {
+    const int *column_offsets = job->epilogue_context;
+    void (*const subtract)(int*, const int*, const int*, const size_t) = m_kernels_int()->subtract;
+    for(size_t row = row_begin; row < row_end; row++) {
+        int *c = (int*) job->result + (row * job->ldc) + jc;
+        subtract(c, c, column_offsets + jc, nc);
+    }
+}
+
+/**
+ * @brief Multiplies two int8 or two int16 matrices, M1 x M2, accumulating in int32.  The product is blocked and packed like m_MatrixMultiply_int, and runs on the VNNI dot product instructions where the host has them (see matrix_simd.h).  Overflow wraps modulo 2^32.  Products of at least MATRIX_GEMM_PARALLEL_THRESHOLD multiply-adds are split into tiles for the thread pool.
+ * @param m1 The first matrix, i x k
+ * @param m2 The second matrix, k x j, of the same precision
+ * @return A new i x j integer matrix allocated upon the heap
+ */
+matrix_int_t*
+m_MatrixMultiplyToInt_lowp(const matrix_lowp_t *m1, const matrix_lowp_t *m2) {
+    assert(m1->j == m2->i);
+    assert(m1->precision == m2->precision);
+    assert((MATRIX_PRECISION_INT8 == m1->precision) || (MATRIX_PRECISION_INT16 == m1->precision));
+    matrix_int_t *m = initializeMatrix_int(m1->i, m2->j);
+    if((0 == m->i) || (0 == m->j) || (0 == m1->j)) {
+        return m;
+    }
+
+    int *column_offsets = NULL;
+    if(MATRIX_PRECISION_INT8 == m1->precision) {
+        /* Sums in unsigned arithmetic wrap exactly as the products do. */
+        uint32_t *sums = m_poolCalloc(m2->j * sizeof(uint32_t));
+        for(size_t k = 0; k < m2->i; k++) {
+            const int8_t *row = (const int8_t*) m2->array + (k * m2->ld);
+            for(size_t column = 0; column < m2->j; column++) {
+                sums[column] += (uint32_t) row[column];
+            }
+        }
+        column_offsets = (int*) sums;
+        for(size_t column = 0; column < m2->j; column++) {
+            column_offsets[column] = (int) (sums[column] << 7);
+        }
+    }
+
+    matrix_gemmJob_lowp_t job = {m1, m2, m->array, m->ld, m->i, m->j, 0, 0, NULL, NULL, 1, 0, 0};
+    if(MATRIX_PRECISION_INT8 == m1->precision) {
+        job.a_mask = 0x80808080u;
+        job.epilogue = m_subtractColumnOffsets_lowp;
+        job.epilogue_context = column_offsets;
+    }
+    m_runGemm_lowp(&job, m_gemmGroupsTask_lowp, MATRIX_GEMM_MC_LOWP, MATRIX_GEMM_NC_LOWP, MATRIX_GEMM_NR_LOWP);
+    m_poolFree(column_offsets, m2->j * sizeof(uint32_t));
+    m_invalidateProperties_int(m);
+    return m;
+}
+
+/**
+ * @brief Multiplies two bfloat16 or two float16 matrices, M1 x M2, accumulating in single precision.  bfloat16 runs on VDPBF16PS where the host has AVX512_BF16, which adds each pair of products before it rounds; otherwise, and for float16, the operands are widened as they are packed and multiplied by the single precision micro-kernel.  Products of at least MATRIX_GEMM_PARALLEL_THRESHOLD multiply-adds are split into tiles for the thread pool.
+ * @param m1 The first matrix, i x k
+ * @param m2 The second matrix, k x j, of the same precision
+ * @return A new i x j single precision matrix allocated upon the heap
+ */
+matrix_float_t*
+m_MatrixMultiplyToFloat_lowp(const matrix_lowp_t *m1, const matrix_lowp_t *m2) {
+    assert(m1->j == m2->i);
+    assert(m1->precision == m2->precision);
+    assert((MATRIX_PRECISION_BF16 == m1->precision) || (MATRIX_PRECISION_FP16 == m1->precision));
+    matrix_float_t *m = initializeMatrix_float(m1->i, m2->j);
+    if((0 == m->i) || (0 == m->j) || (0 == m1->j)) {
+        return m;
+    }
+
+    matrix_gemmJob_lowp_t job = {m1, m2, m->array, m->ld, m->i, m->j, 0, 0, NULL, NULL, 1, 0, 0};
+    if((MATRIX_PRECISION_BF16 == m1->precision) && (NULL != m_kernels_mixed()->gemm_bf16)) {
+        m_runGemm_lowp(&job, m_gemmGroupsTask_lowp, MATRIX_GEMM_MC_LOWP, MATRIX_GEMM_NC_LOWP, MATRIX_GEMM_NR_LOWP);
+    } else {
+        m_runGemm_lowp(&job, m_gemmWidenedTask_lowp, MATRIX_GEMM_MC_FLOAT, MATRIX_GEMM_NC_FLOAT, MATRIX_GEMM_NR_FLOAT);
+    }
+    m_invalidateProperties_float(m);
+    return m;
+}
+
+
+/*************************** AFFINE QUANTIZATION ************************/
+
+/**
+ * @brief The smallest and the largest value of an 8-bit precision.
+ */
+static void
+m_limits_quantized(const matrix_precision_t precision, int *minimum, int *maximum) {
+    assert((MATRIX_PRECISION_INT8 == precision) || (MATRIX_PRECISION_UINT8 == precision));
+    *minimum = (MATRIX_PRECISION_INT8 == precision) ? INT8_MIN : 0;
+    *maximum = (MATRIX_PRECISION_INT8 == precision) ? INT8_MAX : UINT8_MAX;
+}
+
+/**
+ * @brief Computes the affine mapping of a range of values onto int8 or uint8.  The range is first stretched to hold 0.  The scale is (maximum - minimum) / 255 and the zero point the integer that 0 maps to, so the smallest and the largest value map to the ends of the type.  A range of only 0 gets a scale of 1.
+ * @param minimum The smallest value.  It must be finite.
+ * @param maximum The largest value.  It must be finite.
+ * @param precision MATRIX_PRECISION_INT8 or MATRIX_PRECISION_UINT8
+ * @param scale Set to the scale
+ * @param zero_point Set to the zero point
+ */
+void
+m_affineParameters(const float minimum, const float maximum, const matrix_precision_t precision, float *scale, int *zero_point) {
+    assert(isfinite(minimum) && isfinite(maximum) && (minimum <= maximum));
+    int lowest, highest;
+    m_limits_quantized(precision, &lowest, &highest);
+    const double low = (minimum < 0.0f) ? minimum : 0.0;
+    const double high = (maximum > 0.0f) ? maximum : 0.0;
+    if(high == low) {
+        *scale = 1.0f;
+        *zero_point = 0;
+        return;
+    }
+    const double step = (high - low) / (double) (highest - lowest);
+    const double zero = nearbyint((double) lowest - (low / step));
+    *scale = (float) step;
+    *zero_point = (zero < lowest) ? lowest : ((zero > highest) ? highest : (int) zero);
+}
+
+/**
+ * @brief Allocates a quantized matrix of dimensions i by j upon the heap.  The values are zero, the scales 1 and the zero points 0.
+ * @param precision MATRIX_PRECISION_INT8 or MATRIX_PRECISION_UINT8
+ * @param axis Which values share a scale and a zero point
+ * @param i The number of rows
+ * @param j The number of columns
+ * @return A pointer to a matrix struct
+ */
+matrix_quantized_t*
+initializeMatrix_quantized(const matrix_precision_t precision, const matrix_quantAxis_t axis, const int i, const int j) {
+    int lowest, highest;
+    m_limits_quantized(precision, &lowest, &highest);
+    matrix_quantized_t *m = m_poolCalloc(sizeof(matrix_quantized_t));
+    assert(NULL != m);
+    m->values = initializeMatrix_lowp(precision, i, j);
+    m->axis = axis;
+    m->count = (MATRIX_QUANT_TENSOR == axis) ? 1 : ((MATRIX_QUANT_ROWS == axis) ? m->values->i : m->values->j);
+    m->scales = m_poolAlloc(m->count * sizeof(float));
+    m->zero_points = m_poolCalloc(m->count * sizeof(int));
+    assert((NULL != m->scales) && (NULL != m->zero_points));
+    for(size_t pair = 0; pair < m->count; pair++) {
+        m->scales[pair] = 1.0f;
+    }
+    return m;
+}
+
+/**
+ * @brief Frees a quantized matrix, its values and its mapping.
+ * @param m The matrix that will be freed.
+ */
+void
+freeMatrix_quantized(matrix_quantized_t *m) {
+    m_poolFree(m->zero_points, m->count * sizeof(int));
+    m_poolFree(m->scales, m->count * sizeof(float));
+    freeMatrix_lowp(m->values);
+    m_poolFree(m, sizeof(matrix_quantized_t));
+}
+
+/**
+ * @brief Quantizes the values of a single precision matrix into a quantized matrix of the same dimensions with the mapping it already has.
+ */
+static void
+m_quantizeValues_quantized(matrix_quantized_t *q, const matrix_float_t *m) {
+    const matrix_kernels_mixed_t *kernels = m_kernels_mixed();
+    int lowest, highest;
+    m_limits_quantized(q->values->precision, &lowest, &highest);
+    float *inverse_scales = m_poolAlloc(q->count * sizeof(float));
+    for(size_t pair = 0; pair < q->count; pair++) {
+        inverse_scales[pair] = 1.0f / q->scales[pair];
+    }
+    for(size_t row = 0; row < m->i; row++) {
+        uint8_t *destination = (uint8_t*) q->values->array + (row * q->values->ld);
+        const float *source = m->array + (row * m->ld);
+        if(MATRIX_QUANT_COLUMNS == q->axis) {
+            kernels->quantize_columns(destination, source, m->j, inverse_scales, q->zero_points, lowest, highest);
+        } else {
+            const size_t pair = (MATRIX_QUANT_ROWS == q->axis) ? row : 0;
+            kernels->quantize(destination, source, m->j, inverse_scales[pair], q->zero_points[pair], lowest, highest);
+        }
+    }
+    m_poolFree(inverse_scales, q->count * sizeof(float));
+}
+
+/**
+ * @brief Quantizes a single precision matrix with the mapping of its own range: one pass finds the minimum and maximum of each tensor, row or column (see m_affineParameters) and a second pass rounds every value to the nearest step, ties to even, and saturates it.  NaN is skipped by the first pass and becomes 0 in the second.  Both passes run on the vector kernels of the host (see matrix_simd.h).
+ * @param precision MATRIX_PRECISION_INT8 or MATRIX_PRECISION_UINT8
+ * @param axis Which values share a scale and a zero point
+ * @param m The matrix
+ * @return A new quantized matrix allocated upon the heap
+ */
+matrix_quantized_t*
+m_fromFloat_quantized(const matrix_precision_t precision, const matrix_quantAxis_t axis, const matrix_float_t *m) {
+    const matrix_kernels_mixed_t *kernels = m_kernels_mixed();
+    matrix_quantized_t *q = initializeMatrix_quantized(precision, axis, m->i, m->j);
+    float *minima = m_poolAlloc(q->count * sizeof(float));
+    float *maxima = m_poolAlloc(q->count * sizeof(float));
+    for(size_t pair = 0; pair < q->count; pair++) {
+        minima[pair] = INFINITY;
+        maxima[pair] = -INFINITY;
+    }
+    for(size_t row = 0; row < m->i; row++) {
+        const float *values = m->array + (row * m->ld);
+        if(MATRIX_QUANT_COLUMNS == axis) {
+            kernels->range_columns(minima, maxima, values, m->j);
+        } else {
+            const size_t pair = (MATRIX_QUANT_ROWS == axis) ? row : 0;
+            kernels->range(values, m->j, &minima[pair], &maxima[pair]);
+        }
+    }
+    for(size_t pair = 0; pair < q->count; pair++) {
+        if(minima[pair] > maxima[pair]) { /* no value but NaN */
+            minima[pair] = maxima[pair] = 0.0f;
+        }
+        m_affineParameters(minima[pair], maxima[pair], precision, &q->scales[pair], &q->zero_points[pair]);
+    }
+    m_poolFree(maxima, q->count * sizeof(float));
+    m_poolFree(minima, q->count * sizeof(float));
+    m_quantizeValues_quantized(q, m);
+    return q;
+}
+
+/**
+ * @brief Quantizes a single precision matrix with a given mapping, e.g. one calibrated on other data.  Values outside the range of the mapping saturate.
+ * @param precision MATRIX_PRECISION_INT8 or MATRIX_PRECISION_UINT8
+ * @param m The matrix
+ * @param scale The scale, greater than 0
+ * @param zero_point The zero point, within the range of the precision
+ * @return A new quantized matrix allocated upon the heap, with one pair for the whole matrix
+ */
+matrix_quantized_t*
+m_fromFloatWith_quantized(const matrix_precision_t precision, const matrix_float_t *m, const float scale, const int zero_point) {
+    int lowest, highest;
+    m_limits_quantized(precision, &lowest, &highest);
+    assert(scale > 0.0f);
+    assert((zero_point >= lowest) && (zero_point <= highest));
+    matrix_quantized_t *q = initializeMatrix_quantized(precision, MATRIX_QUANT_TENSOR, m->i, m->j);
+    q->scales[0] = scale;
+    q->zero_points[0] = zero_point;
+    m_quantizeValues_quantized(q, m);
+    return q;
+}
+
+/**
+ * @brief Dequantizes a matrix in a single vectorized pass, scale * (q - zero_point).
+ * @param m The matrix
+ * @return A new single precision matrix allocated upon the heap
+ */
+matrix_float_t*
+m_toFloat_quantized(const matrix_quantized_t *m) {
+    const matrix_kernels_mixed_t *kernels = m_kernels_mixed();
+    const bool is_signed = (MATRIX_PRECISION_INT8 == m->values->precision);
+    matrix_float_t *wide = initializeMatrix_float(m->values->i, m->values->j);
+    for(size_t row = 0; row < wide->i; row++) {
+        const uint8_t *source = (const uint8_t*) m->values->array + (row * m->values->ld);
+        float *destination = wide->array + (row * wide->ld);
+        if(MATRIX_QUANT_COLUMNS == m->axis) {
+            kernels->dequantize_columns(destination, source, wide->j, m->scales, m->zero_points, is_signed);
+        } else {
+            const size_t pair = (MATRIX_QUANT_ROWS == m->axis) ? row : 0;
+            kernels->dequantize(destination, source, wide->j, m->scales[pair], m->zero_points[pair], is_signed);
+        }
+    }
+    m_invalidateProperties_float(wide);
+    return wide;
+}
+
+/**
+ * @brief Returns the real value the matrix holds at the given position, scale * (q - zero_point).
+ * @param m The matrix
+ * @param i The row index, using C style indexing (starting at 0)
+ * @param j The column index, using C style indexing (starting at 0)
+ * @return The value
+ */
+float
+m_at_quantized(const matrix_quantized_t *m, const size_t i, const size_t j) {
+    const size_t pair = (MATRIX_QUANT_TENSOR == m->axis) ? 0 : ((MATRIX_QUANT_ROWS == m->axis) ? i : j);
+    return m->scales[pair] * (m_at_lowp(m->values, i, j) - (float) m->zero_points[pair]);
+}
+
+/**
+ * @brief What m_requantizeTile_quantized needs to turn a tile of int32 sums of the packed values, sum u * s, into the quantized product sum (u - row zero point) * (s - column zero point).
+ * @var output The result
+ * @var row_zero_points The zero point of every row of M1 in the packed values, z1 + 128 for int8
+ * @var column_zero_points The zero point of every column of M2 in the packed values, z2 - 128 for uint8
+ * @var row_sums The sum of the packed values of every row of M1
+ * @var column_terms The sum of the packed values of every column of M2, less the depth times its zero point
+ * @var multipliers, shifts The fixed point form of scale1 * scale2 / scale: multiplier * 2^-(31 + shift)
+ * @var row_step, column_step 1 if the multiplier changes from row to row, or from column to column, of the result, 0 otherwise
+ * @var zero_point The zero point of the result
+ * @var minimum, maximum The range of the precision of the result
+ */
+typedef struct Matrix_requantization_s {
+    matrix_quantized_t *output;
+    const int *row_zero_points;
+    const int *column_zero_points;
+    const int *row_sums;
+    const int *column_terms;
+    const int *multipliers;
+    const int *shifts;
+    size_t row_step;
+    size_t column_step;
+    int zero_point;
+    int minimum;
+    int maximum;
+} matrix_requantization_t;
+
+/**
+ * @brief Writes a positive real number as multiplier * 2^-(31 + shift), with the multiplier in [2^30, 2^31), so that value * real can be taken in integer arithmetic.  A number too small to move any int32 value becomes 0.
+ */
+static void
+m_fixedPoint_quantized(const double real, int *multiplier, int *shift) {
+    int exponent;
+    const double mantissa = frexp(real, &exponent);
+    long long fixed = llround(mantissa * 2147483648.0);
+    if((1LL << 31) == fixed) {
+        fixed >>= 1;
+        exponent++;
+    }
+    assert(exponent <= 30);
+    if(exponent < -31) {
+        *multiplier = 0;
+        *shift = 0;
+        return;
+    }
+    *multiplier = (int) fixed;
+    *shift = -exponent;
+}
+
+/**
+ * @brief The epilogue of a quantized product.  Takes the zero points out of every sum of the tile, scales it by the fixed point multiplier, rounding to nearest with ties upward, adds the zero point of the result, saturates it and stores it as a byte of the result.
+ */
+static void
+m_requantizeTile_quantized(const matrix_gemmJob_lowp_t *job, const size_t row_begin, const size_t row_end, const size_t jc, const size_t nc) {
+    const matrix_requantization_t *requantization = job->epilogue_context;
+    const matrix_lowp_t *output = requantization->output->values;
+    for(size_t row = row_begin; row < row_end; row++) {
+        const int *sums = (const int*) job->result + (row * job->ldc);
+        uint8_t *destination = (uint8_t*) output->array + (row * output->ld);
+        const uint32_t row_zero_point = (uint32_t) requantization->row_zero_points[row];
+        const uint32_t row_sum = (uint32_t) requantization->row_sums[row];
+        for(size_t column = jc; column < jc + nc; column++) {
+            /* (u - a)(s - b) summed over k is sum u * s - b * sum u - a * (sum s - k * b), wrapping as the sums do */
+            const int value = (int) ((uint32_t) sums[column] - ((uint32_t) requantization->column_zero_points[column] * row_sum) - (row_zero_point * (uint32_t) requantization->column_terms[column]));
+            const size_t pair = (row * requantization->row_step) + (column * requantization->column_step);
+            const int total_shift = 31 + requantization->shifts[pair];
+            const int64_t scaled = (((int64_t) value * requantization->multipliers[pair]) + ((int64_t) 1 << (total_shift - 1))) >> total_shift;
+            const int64_t quantized = scaled + requantization->zero_point;
+            destination[column] = (uint8_t) ((quantized < requantization->minimum) ? requantization->minimum : ((quantized > requantization->maximum) ? requantization->maximum : quantized));
+        }
+    }
+}
+
+/**
+ * @brief Multiplies two quantized matrices, M1 x M2, into a quantized matrix with the given mapping, without floating point intermediates.  The 8-bit products accumulate in int32 on the micro-kernel of m_MatrixMultiplyToInt_lowp.  The zero points come out of each finished tile as row sums of M1 and column sums of M2.  The tile is then scaled by the fixed point form of scale1 * scale2 / scale, rounded to nearest (ties upward), offset by zero_point and saturated.  The sums are exact while the shared dimension is below 33000 and wrap modulo 2^32 beyond it.
+ * @param m1 The first matrix, i x k, quantized per tensor or per row
+ * @param m2 The second matrix, k x j, quantized per tensor or per column.  Only one of the two may have more than one scale.
+ * @param precision The precision of the result, MATRIX_PRECISION_INT8 or MATRIX_PRECISION_UINT8
+ * @param scale The scale of the result, greater than 0
+ * @param zero_point The zero point of the result
+ * @return A new i x j quantized matrix allocated upon the heap, with one pair for the whole matrix
+ */
+matrix_quantized_t*
+m_MatrixMultiply_quantized(const matrix_quantized_t *m1, const matrix_quantized_t *m2, const matrix_precision_t precision, const float scale, const int zero_point) {
+    const matrix_lowp_t *a = m1->values;
+    const matrix_lowp_t *b = m2->values;
+    assert(a->j == b->i);
+    assert((MATRIX_QUANT_COLUMNS != m1->axis) && (MATRIX_QUANT_ROWS != m2->axis));
+    assert((MATRIX_QUANT_TENSOR == m1->axis) || (MATRIX_QUANT_TENSOR == m2->axis));
+    int lowest, highest;
+    m_limits_quantized(precision, &lowest, &highest);
+    assert(scale > 0.0f);
+    assert((zero_point >= lowest) && (zero_point <= highest));
+    matrix_quantized_t *m = initializeMatrix_quantized(precision, MATRIX_QUANT_TENSOR, a->i, b->j);
+    m->scales[0] = scale;
+    m->zero_points[0] = zero_point;
+    const size_t rows = a->i;
+    const size_t columns = b->j;
+    const size_t depth = a->j;
+    if((0 == rows) || (0 == columns)) {
+        return m;
+    }
+
+    /* VPDPBUSD multiplies unsigned bytes of M1 by signed bytes of M2: int8 M1 is packed offset by 128 and uint8 M2 by -128, and the zero points move with them. */
+    const bool a_signed = (MATRIX_PRECISION_INT8 == a->precision);
+    const bool b_signed = (MATRIX_PRECISION_INT8 == b->precision);
+    const uint32_t a_offset = a_signed ? 128 : 0;
+    const uint32_t b_offset = b_signed ? 0 : 128;
+    int *row_zero_points = m_poolAlloc(rows * sizeof(int));
+    int *row_sums = m_poolAlloc(rows * sizeof(int));
+    for(size_t row = 0; row < rows; row++) {
+        const uint8_t *values = (const uint8_t*) a->array + (row * a->ld);
+        uint32_t sum = (uint32_t) depth * a_offset;
+        for(size_t k = 0; k < depth; k++) {
+            sum += a_signed ? (uint32_t) (int8_t) values[k] : (uint32_t) values[k];
+        }
+        row_sums[row] = (int) sum;
+        row_zero_points[row] = m1->zero_points[(MATRIX_QUANT_ROWS == m1->axis) ? row : 0] + (int) a_offset;
+    }
+    uint32_t *column_sums = m_poolCalloc(columns * sizeof(uint32_t));
+    for(size_t k = 0; k < depth; k++) {
+        const uint8_t *values = (const uint8_t*) b->array + (k * b->ld);
+        for(size_t column = 0; column < columns; column++) {
+            column_sums[column] += b_signed ? (uint32_t) (int8_t) values[column] : (uint32_t) values[column];
+        }
+    }
+    int *column_zero_points = m_poolAlloc(columns * sizeof(int));
+    int *column_terms = (int*) column_sums;
+    for(size_t column = 0; column < columns; column++) {
+        column_zero_points[column] = m2->zero_points[(MATRIX_QUANT_COLUMNS == m2->axis) ? column : 0] - (int) b_offset;
+        column_terms[column] = (int) (column_sums[column] - ((uint32_t) depth * b_offset) - ((uint32_t) depth * (uint32_t) column_zero_points[column]));
+    }
+
+    const size_t row_step = (MATRIX_QUANT_ROWS == m1->axis) ? 1 : 0;
+    const size_t column_step = (MATRIX_QUANT_COLUMNS == m2->axis) ? 1 : 0;
+    const size_t pairs = (0 != row_step) ? rows : ((0 != column_step) ? columns : 1);
+    int *multipliers = m_poolAlloc(pairs * sizeof(int));
+    int *shifts = m_poolAlloc(pairs * sizeof(int));
+    for(size_t pair = 0; pair < pairs; pair++) {
+        const double real = ((double) m1->scales[(0 != row_step) ? pair : 0] * (double) m2->scales[(0 != column_step) ? pair : 0]) / (double) scale;
+        m_fixedPoint_quantized(real, &multipliers[pair], &shifts[pair]);
+    }
+
+    matrix_int_t *sums = initializeMatrix_int(rows, columns);
+    const matrix_requantization_t requantization = {
+        m, row_zero_points, column_zero_points, row_sums, column_terms, multipliers, shifts, row_step, column_step, zero_point, lowest, highest
+    };
+    matrix_gemmJob_lowp_t job = {a, b, sums->array, sums->ld, rows, columns, a_signed ? 0x80808080u : 0, b_signed ? 0 : 0x80, m_requantizeTile_quantized, &requantization, 1, 0, 0};
+    m_runGemm_lowp(&job, m_gemmGroupsTask_lowp, MATRIX_GEMM_MC_LOWP, MATRIX_GEMM_NC_LOWP, MATRIX_GEMM_NR_LOWP);
+
+    freeMatrix_int(sums);
+    m_poolFree(shifts, pairs * sizeof(int));
+    m_poolFree(multipliers, pairs * sizeof(int));
+    m_poolFree(column_zero_points, columns * sizeof(int));
+    m_poolFree(column_sums, columns * sizeof(uint32_t));
+    m_poolFree(row_sums, rows * sizeof(int));
+    m_poolFree(row_zero_points, rows * sizeof(int));
+    return m;
+}
+
+
+/*************************** STOCHASTIC ROUNDING ************************/
+
+/**
+ * @brief The random words of one thread.  bits comes first so that it keeps the alignment of the allocation.
+ * @var bits The last block drawn from the generator
+ * @var position The index of the first unused word of bits
+ * @var state The thread's SFMT generator
+ * @var seeding The value of m_stochasticSeeding the generator was seeded with
+ * @var ordinal Distinguishes the generators of threads that share a seed
+ */
+typedef struct Matrix_randomStream_s {
+    uint32_t bits[MATRIX_STOCHASTIC_BLOCK];
+    size_t position;
+    sfmt_t state;
+    uint_fast64_t seeding;
+    uint32_t ordinal;
+} matrix_randomStream_t;
+
+/**
+ * @brief The seed in the low 32 bits and the number of calls to m_seedStochastic_lowp above them, so a thread notices a new seed even when it equals the old one.
+ */
+static atomic_uint_fast64_t m_stochasticSeeding = 0;
+static atomic_uint_fast32_t m_streamCount = 0;
+static _Thread_local matrix_randomStream_t *m_threadStream = NULL;
+static pthread_key_t m_streamKey;
+static pthread_once_t m_streamKeyOnce = PTHREAD_ONCE_INIT;
+
+static void
+m_freeRandomStream(void *argument) {
+    free(argument);
+    m_threadStream = NULL;
+}
+
+static void
+m_createStreamKey(void) {
+    (void) pthread_key_create(&m_streamKey, m_freeRandomStream);
+}
+
+/**
+ * @brief Returns the calling thread's random stream, creating it on first use and reseeding it after m_seedStochastic_lowp.
+ */
+static matrix_randomStream_t*
+m_randomStream_lowp(void) {
+    matrix_randomStream_t *stream = m_threadStream;
+    if(NULL == stream) {
+        (void) pthread_once(&m_streamKeyOnce, m_createStreamKey);
+        const size_t bytes = (sizeof(matrix_randomStream_t) + MATRIX_ALIGNMENT - 1) & ~(size_t) (MATRIX_ALIGNMENT - 1);
+        stream = aligned_alloc(MATRIX_ALIGNMENT, bytes);
+        assert(NULL != stream);
+        stream->ordinal = (uint32_t) atomic_fetch_add_explicit(&m_streamCount, 1, memory_order_relaxed);
+        stream->seeding = UINT_FAST64_MAX;
+        (void) pthread_setspecific(m_streamKey, stream);
+        m_threadStream = stream;
+    }
+    const uint_fast64_t seeding = atomic_load_explicit(&m_stochasticSeeding, memory_order_relaxed);
+    if(stream->seeding != seeding) {
+        uint32_t key[2] = {(uint32_t) seeding, stream->ordinal};
+        sfmt_init_by_array(&stream->state, key, 2);
+        stream->seeding = seeding;
+        stream->position = MATRIX_STOCHASTIC_BLOCK;
+    }
+    return stream;
+}
+
+/**
+ * @brief Returns count unused random words of a stream, drawing a new block from its generator when the current one runs short.  The rest of the old block is discarded.
+ */
+static const uint32_t*
+m_randomBits_lowp(matrix_randomStream_t *stream, const size_t count) {
+    assert(count <= MATRIX_STOCHASTIC_BLOCK);
+    if((stream->position + count) > MATRIX_STOCHASTIC_BLOCK) {
+        sfmt_fill_array32(&stream->state, stream->bits, MATRIX_STOCHASTIC_BLOCK);
+        stream->position = 0;
+    }
+    const uint32_t *bits = stream->bits + stream->position;
+    stream->position += count;
+    return bits;
+}
+
+/**
+ * @brief Seeds stochastic rounding.  Each thread seeds its own SFMT generator from the seed and an ordinal of its own, the next time it rounds.  Until the first call the seed is 0.
+ * @param seed The seed
+ * @note A parallel conversion draws the bits of each row from whichever thread rounds it, so it is reproducible in distribution only.  With one thread (m_setThreadCount(1)) the same seed gives the same matrix.
+ */
+void
+m_seedStochastic_lowp(const uint32_t seed) {
+    uint_fast64_t current = atomic_load_explicit(&m_stochasticSeeding, memory_order_relaxed);
+    while(!atomic_compare_exchange_weak_explicit(&m_stochasticSeeding, &current, ((((current >> 32) + 1) & 0xFFFFFFFFu) << 32) | seed,
+                                                 memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+/**
+ * @brief A stochastic narrowing, split into tasks of whole rows.
+ */
+typedef struct Matrix_stochasticJob_lowp_s {
+    const matrix_float_t *source;
+    matrix_lowp_t *destination;
+    size_t task_rows;
+} matrix_stochasticJob_lowp_t;
+
+static void
+m_stochasticTask_lowp(void *context, const size_t task, const size_t worker) {
+    (void) worker;
+    const matrix_stochasticJob_lowp_t *job = context;
+    const matrix_kernels_mixed_t *kernels = m_kernels_mixed();
+    const matrix_float_t *m = job->source;
+    matrix_lowp_t *narrow = job->destination;
+    matrix_randomStream_t *stream = m_randomStream_lowp();
+    const size_t row_begin = task * job->task_rows;
+    const size_t row_end = ((row_begin + job->task_rows) < m->i) ? (row_begin + job->task_rows) : m->i;
+    for(size_t row = row_begin; row < row_end; row++) {
+        const float *values = m->array + (row * m->ld);
+        for(size_t column = 0; column < m->j; column += MATRIX_STOCHASTIC_BLOCK) {
+            const size_t count = ((m->j - column) < MATRIX_STOCHASTIC_BLOCK) ? (m->j - column) : MATRIX_STOCHASTIC_BLOCK;
+            const uint32_t *random = m_randomBits_lowp(stream, count);
+            switch(narrow->precision) {
+                case MATRIX_PRECISION_INT8:
+                    kernels->stochastic_int8((uint8_t*) narrow->array + (row * narrow->ld) + column, values + column, count, random, INT8_MIN, INT8_MAX);
+                    break;
+                case MATRIX_PRECISION_UINT8:
+                    kernels->stochastic_int8((uint8_t*) narrow->array + (row * narrow->ld) + column, values + column, count, random, 0, UINT8_MAX);
+                    break;
+                case MATRIX_PRECISION_INT16:
+                    kernels->stochastic_int16((int16_t*) narrow->array + (row * narrow->ld) + column, values + column, count, random);
+                    break;
+                case MATRIX_PRECISION_BF16:
+                    kernels->stochastic_bf16((uint16_t*) narrow->array + (row * narrow->ld) + column, values + column, count, random);
+                    break;
+                case MATRIX_PRECISION_FP16:
+                    assert(false);
+                    break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Narrows a single precision matrix with stochastic rounding.  int8, uint8 and int16 round down or up to a neighbouring integer, up with the probability of the fraction (to within 2^-24), and saturate at the limits of the type.  bfloat16 rounds away from zero with the probability of the 16 bits it drops.  NaN becomes 0 for the integer types and stays a NaN for bfloat16.  The rows are narrowed in parallel on the vector kernels of the host (see matrix_simd.h).
+ * @param precision MATRIX_PRECISION_INT8, MATRIX_PRECISION_UINT8, MATRIX_PRECISION_INT16 or MATRIX_PRECISION_BF16
+ * @param m The matrix
+ * @return A new low precision matrix allocated upon the heap
+ */
+matrix_lowp_t*
+m_fromFloatStochastic_lowp(const matrix_precision_t precision, const matrix_float_t *m) {
+    assert(MATRIX_PRECISION_FP16 != precision);
+    matrix_lowp_t *narrow = initializeMatrix_lowp(precision, m->i, m->j);
+    const size_t row_elements = (0 < m->j) ? m->j : 1;
+    matrix_stochasticJob_lowp_t job = {m, narrow, (row_elements < MATRIX_STOCHASTIC_TASK) ? (MATRIX_STOCHASTIC_TASK / row_elements) : 1};
+    const size_t task_count = (m->i + job.task_rows - 1) / job.task_rows;
+    if(1 == task_count) {
+        m_stochasticTask_lowp(&job, 0, 0);
+    } else if(1 < task_count) {
+        m_parallelFor(task_count, m_stochasticTask_lowp, &job);
+    }
+    return narrow;
+}
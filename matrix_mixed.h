@@ -0,0 +1,329 @@
+/**
+ * @file matrix_mixed.h
+ * @brief Low precision matrices and the mixed precision matrix multiplication: int8 and int16 operands accumulated in int32, bfloat16 and float16 operands accumulated in single precision
+ * @author Aaron Fleisher
+ * @date 2026-10-16
+ *
+ * A matrix_lowp_t stores its values in 8 or 16 bits, so a product that streams its operands from memory moves a half or a quarter of the bytes of matrix_int_t or matrix_float_t.  Only the operands are narrow: every product accumulates in 32 bits and returns a matrix_int_t or a matrix_float_t.
+ * The product packs its operands into groups of 4 bytes along the shared dimension (4 int8, or 2 int16 or bfloat16 values), the unit of the AVX-512 VNNI and BF16 dot product instructions, which multiply and accumulate a whole group per 32-bit lane.
+ * int8 x int8 runs on VPDPBUSD, which takes an unsigned first operand: the first matrix is offset by 128 when it is packed and 128 times the column sums of the second is taken back from the result.  Hosts without VNNI run an emulation in C on the same packed groups, and the integer results are bit-identical (overflow wraps modulo 2^32, as in m_MatrixMultiply_int).
+ * float16 operands are widened to single precision while they are packed, with F16C (or AVX-512F) on hosts that have it, and multiplied by the FMA micro-kernel of matrix_float.h.  bfloat16 takes the same route on hosts without AVX512_BF16.
+ * The conversions from single precision round to nearest, ties to even, in every variant, so they are bit-identical as well.
+ * A matrix_quantized_t is an int8 or uint8 matrix with the affine mapping back to real values, x = scale * (q - zero_point), kept per tensor, per row or per column.  The scale and the zero point come from the range of the values, which is stretched to hold 0 so that 0 is exact.  m_MatrixMultiply_quantized multiplies two of them on the same 8-bit dot products, takes the zero points out of the int32 sums with row and column sums, and requantizes every tile with a fixed point multiplier as it finishes: the intermediates never pass through floating point.
+ * m_fromFloatStochastic_lowp narrows with stochastic rounding instead: a value rounds up with the probability of the part it loses, so the rounding is unbiased on average and small updates survive in expectation where round to nearest would drop them.  The random bits come in blocks from the bundled SFMT generator, one generator per thread, so threads that round in parallel never wait on each other.
+ */
+
+#ifndef MATRIX_MIXED_H
+#define MATRIX_MIXED_H
+
+#include "myMatrix.h"
+#include "matrix_float.h"
+
+/**
+ * @brief Blocking parameters of the mixed precision matrix multiplication.  The shared dimension is counted in groups of 4 bytes.
+ * @note The 8 x 32 register tile takes 16 of the 32 AVX-512 registers, enough independent accumulators to keep both dot product units busy.  A KC x NR micro-panel of the second matrix (32 KiB) fits in the L1 cache, an MC x KC block of the first matrix (96 KiB) in the L2 cache and a KC x NC panel of the second matrix (2 MiB) in the L3 cache.  MC must be a multiple of MR and NC a multiple of NR.
+ */
+#define MATRIX_GEMM_MR_LOWP 8
+#define MATRIX_GEMM_NR_LOWP 32
+#define MATRIX_GEMM_KC_LOWP 256
+#define MATRIX_GEMM_MC_LOWP 96
+#define MATRIX_GEMM_NC_LOWP 2048
+
+/**
+ * @brief The bytes of one group of the packed shared dimension: 4 int8 values, or 2 int16, bfloat16 or float16 values.
+ */
+#define MATRIX_LOWP_GROUP_BYTES 4
+
+/**
+ * @brief A bfloat16 value: the upper 16 bits of a single precision value.  It has the range of a float and 8 bits of precision.
+ */
+typedef uint16_t bfloat16_t;
+
+/**
+ * @brief An IEEE 754 half precision (float16) value: 5 bits of exponent and 11 bits of precision, up to 65504.
+ */
+typedef uint16_t half_t;
+
+/**
+ * @brief The element type of a low precision matrix.
+ */
+typedef enum Matrix_precision_e {
+    MATRIX_PRECISION_INT8 = 0, /** << int8_t, multiplied into int32 */
+    MATRIX_PRECISION_INT16,    /** << int16_t, multiplied into int32 */
+    MATRIX_PRECISION_BF16,     /** << bfloat16_t, multiplied into single precision */
+    MATRIX_PRECISION_FP16,     /** << half_t, multiplied into single precision */
+    MATRIX_PRECISION_UINT8     /** << uint8_t, the unsigned type of affine quantization */
+} matrix_precision_t;
+
+/**
+ * @brief A dense matrix of 8 or 16-bit values.
+ * @var i The number of rows
+ * @var j The number of columns
+ * @var precision The element type
+ * @var ld The leading dimension in elements: element (r, c) is at index (r * ld) + c of array.  A row takes a whole number of 4-byte groups, or of cache lines once it is at least one, and the padding is zero.
+ * @var array The values, row after row.  It is MATRIX_ALIGNMENT aligned.
+ */
+typedef struct Matrix_lowp_s {
+    size_t i;
+    size_t j;
+    matrix_precision_t precision;
+    size_t ld;
+    void *array;
+} matrix_lowp_t;
+
+
+/*************************** CONVERSIONS ************************/
+
+/**
+ * @brief Rounds a single precision value to the nearest bfloat16, ties to even.  A NaN stays a NaN.
+ * @param value The value
+ * @return The bfloat16 value
+ */
+bfloat16_t
+m_floatToBfloat16(const float value);
+
+/**
+ * @brief Widens a bfloat16 value to single precision.  The conversion is exact.
+ * @param value The bfloat16 value
+ * @return The value
+ */
+float
+m_bfloat16ToFloat(const bfloat16_t value);
+
+/**
+ * @brief Rounds a single precision value to the nearest float16, ties to even, as the F16C instruction VCVTPS2PH does.  Values from 65520 on become infinity, and values below 2^-14 become subnormal.
+ * @param value The value
+ * @return The float16 value
+ */
+half_t
+m_floatToHalf(const float value);
+
+/**
+ * @brief Widens a float16 value to single precision.  The conversion is exact.
+ * @param value The float16 value
+ * @return The value
+ */
+float
+m_halfToFloat(const half_t value);
+
+
+/*************************** MATRIX WIDE OPERATIONS ************************/
+
+/**
+ * @brief Allocates a low precision matrix of dimensions i by j upon the heap.  The values are zero.
+ * @param precision The element type
+ * @param i The number of rows
+ * @param j The number of columns
+ * @return A pointer to a matrix struct.  The header and arrays of up to MATRIX_POOL_MAX_BLOCK bytes come from the size-class pool.
+ */
+matrix_lowp_t*
+initializeMatrix_lowp(const matrix_precision_t precision, const int i, const int j);
+
+/**
+ * @brief Frees a low precision matrix and its array.
+ * @param m The matrix that will be freed.
+ */
+void
+freeMatrix_lowp(matrix_lowp_t *m);
+
+/**
+ * @brief The size of one element of a precision in bytes.
+ * @param precision The element type
+ * @return 1 or 2
+ */
+size_t
+m_elementSize_lowp(const matrix_precision_t precision);
+
+/**
+ * @brief Narrows a single precision matrix.  int8, uint8 and int16 round to the nearest integer, ties to even, and saturate at the limits of the type; bfloat16 and float16 round to the nearest value, ties to even.
+ * @param precision The element type of the new matrix
+ * @param m The matrix
+ * @return A new low precision matrix allocated upon the heap
+ */
+matrix_lowp_t*
+m_fromFloat_lowp(const matrix_precision_t precision, const matrix_float_t *m);
+
+/**
+ * @brief Narrows an integer matrix.  int8, uint8 and int16 saturate at the limits of the type; bfloat16 and float16 round to the nearest value, ties to even.
+ * @param precision The element type of the new matrix
+ * @param m The matrix, in any storage
+ * @return A new low precision matrix allocated upon the heap
+ */
+matrix_lowp_t*
+m_fromInt_lowp(const matrix_precision_t precision, matrix_int_t *m);
+
+/**
+ * @brief Widens a low precision matrix to single precision.  The conversion is exact.
+ * @param m The matrix
+ * @return A new matrix allocated upon the heap
+ */
+matrix_float_t*
+m_toFloat_lowp(const matrix_lowp_t *m);
+
+/**
+ * @brief Returns the value of the matrix at the given position, widened to single precision.
+ * @param m The matrix
+ * @param i The row index, using C style indexing (starting at 0)
+ * @param j The column index, using C style indexing (starting at 0)
+ * @return The value
+ */
+float
+m_at_lowp(const matrix_lowp_t *m, const size_t i, const size_t j);
+
+/**
+ * @brief Multiplies two int8 or two int16 matrices, M1 x M2, accumulating in int32.  The product is blocked and packed like m_MatrixMultiply_int, and runs on the VNNI dot product instructions where the host has them (see matrix_simd.h).  Overflow wraps modulo 2^32.  Products of at least MATRIX_GEMM_PARALLEL_THRESHOLD multiply-adds are split into tiles for the thread pool.
+ * @param m1 The first matrix, i x k
+ * @param m2 The second matrix, k x j, of the same precision
+ * @return A new i x j integer matrix allocated upon the heap
+ */
+matrix_int_t*
+m_MatrixMultiplyToInt_lowp(const matrix_lowp_t *m1, const matrix_lowp_t *m2);
+
+/**
+ * @brief Multiplies two bfloat16 or two float16 matrices, M1 x M2, accumulating in single precision.  bfloat16 runs on VDPBF16PS where the host has AVX512_BF16, which adds each pair of products before it rounds; otherwise, and for float16, the operands are widened as they are packed and multiplied by the single precision micro-kernel.  Products of at least MATRIX_GEMM_PARALLEL_THRESHOLD multiply-adds are split into tiles for the thread pool.
+ * @param m1 The first matrix, i x k
+ * @param m2 The second matrix, k x j, of the same precision
+ * @return A new i x j single precision matrix allocated upon the heap
+ */
+matrix_float_t*
+m_MatrixMultiplyToFloat_lowp(const matrix_lowp_t *m1, const matrix_lowp_t *m2);
+
+
+/*************************** AFFINE QUANTIZATION ************************/
+
+/**
+ * @brief Which values of a quantized matrix share a scale and a zero point.
+ */
+typedef enum Matrix_quantAxis_e {
+    MATRIX_QUANT_TENSOR = 0, /** << one pair for the whole matrix */
+    MATRIX_QUANT_ROWS,       /** << one pair per row */
+    MATRIX_QUANT_COLUMNS     /** << one pair per column, e.g. per output channel of a weight matrix */
+} matrix_quantAxis_t;
+
+/**
+ * @brief An int8 or uint8 matrix and its affine mapping: value (r, c) stands for scale * (q - zero_point), with the pair of its row, its column or the whole matrix.
+ * @var values The quantized values, of precision MATRIX_PRECISION_INT8 or MATRIX_PRECISION_UINT8
+ * @var axis Which values share a pair
+ * @var count The number of pairs: 1, the number of rows or the number of columns
+ * @var scales The scales, all greater than 0
+ * @var zero_points The zero points, within the range of the precision
+ */
+typedef struct Matrix_quantized_s {
+    matrix_lowp_t *values;
+    matrix_quantAxis_t axis;
+    size_t count;
+    float *scales;
+    int *zero_points;
+} matrix_quantized_t;
+
+/**
+ * @brief Computes the affine mapping of a range of values onto int8 or uint8.  The range is first stretched to hold 0.  The scale is (maximum - minimum) / 255 and the zero point the integer that 0 maps to, so the smallest and the largest value map to the ends of the type.  A range of only 0 gets a scale of 1.
+ * @param minimum The smallest value.  It must be finite.
+ * @param maximum The largest value.  It must be finite.
+ * @param precision MATRIX_PRECISION_INT8 or MATRIX_PRECISION_UINT8
+ * @param scale Set to the scale
+ * @param zero_point Set to the zero point
+ */
+void
+m_affineParameters(const float minimum, const float maximum, const matrix_precision_t precision, float *scale, int *zero_point);
+
+/**
+ * @brief Allocates a quantized matrix of dimensions i by j upon the heap.  The values are zero, the scales 1 and the zero points 0.
+ * @param precision MATRIX_PRECISION_INT8 or MATRIX_PRECISION_UINT8
+ * @param axis Which values share a scale and a zero point
+ * @param i The number of rows
+ * @param j The number of columns
+ * @return A pointer to a matrix struct
+ */
+matrix_quantized_t*
+initializeMatrix_quantized(const matrix_precision_t precision, const matrix_quantAxis_t axis, const int i, const int j);
+
+/**
+ * @brief Frees a quantized matrix, its values and its mapping.
+ * @param m The matrix that will be freed.
+ */
+void
+freeMatrix_quantized(matrix_quantized_t *m);
+
+/**
+ * @brief Quantizes a single precision matrix with the mapping of its own range: one pass finds the minimum and maximum of each tensor, row or column (see m_affineParameters) and a second pass rounds every value to the nearest step, ties to even, and saturates it.  NaN is skipped by the first pass and becomes 0 in the second.  Both passes run on the vector kernels of the host (see matrix_simd.h).
+ * @param precision MATRIX_PRECISION_INT8 or MATRIX_PRECISION_UINT8
+ * @param axis Which values share a scale and a zero point
+ * @param m The matrix
+ * @return A new quantized matrix allocated upon the heap
+ */
+matrix_quantized_t*
+m_fromFloat_quantized(const matrix_precision_t precision, const matrix_quantAxis_t axis, const matrix_float_t *m);
+
+/**
+ * @brief Quantizes a single precision matrix with a given mapping, e.g. one calibrated on other data.  Values outside the range of the mapping saturate.
+ * @param precision MATRIX_PRECISION_INT8 or MATRIX_PRECISION_UINT8
+ * @param m The matrix
+ * @param scale The scale, greater than 0
+ * @param zero_point The zero point, within the range of the precision
+ * @return A new quantized matrix allocated upon the heap, with one pair for the whole matrix
+ */
+matrix_quantized_t*
+m_fromFloatWith_quantized(const matrix_precision_t precision, const matrix_float_t *m, const float scale, const int zero_point);
+
+/**
+ * @brief Dequantizes a matrix in a single vectorized pass, scale * (q - zero_point).
+ * @param m The matrix
+ * @return A new single precision matrix allocated upon the heap
+ */
+matrix_float_t*
+m_toFloat_quantized(const matrix_quantized_t *m);
+
+/**
+ * @brief Returns the real value the matrix holds at the given position, scale * (q - zero_point).
+ * @param m The matrix
+ * @param i The row index, using C style indexing (starting at 0)
+ * @param j The column index, using C style indexing (starting at 0)
+ * @return The value
+ */
+float
+m_at_quantized(const matrix_quantized_t *m, const size_t i, const size_t j);
+
+/**
+ * @brief Multiplies two quantized matrices, M1 x M2, into a quantized matrix with the given mapping, without floating point intermediates.  The 8-bit products accumulate in int32 on the micro-kernel of m_MatrixMultiplyToInt_lowp.  The zero points come out of each finished tile as row sums of M1 and column sums of M2.  The tile is then scaled by the fixed point form of scale1 * scale2 / scale, rounded to nearest (ties upward), offset by zero_point and saturated.  The sums are exact while the shared dimension is below 33000 and wrap modulo 2^32 beyond it.
+ * @param m1 The first matrix, i x k, quantized per tensor or per row
+ * @param m2 The second matrix, k x j, quantized per tensor or per column.  Only one of the two may have more than one scale.
+ * @param precision The precision of the result, MATRIX_PRECISION_INT8 or MATRIX_PRECISION_UINT8
+ * @param scale The scale of the result, greater than 0
+ * @param zero_point The zero point of the result
+ * @return A new i x j quantized matrix allocated upon the heap, with one pair for the whole matrix
+ */
+matrix_quantized_t*
+m_MatrixMultiply_quantized(const matrix_quantized_t *m1, const matrix_quantized_t *m2, const matrix_precision_t precision, const float scale, const int zero_point);
+
+
+/*************************** STOCHASTIC ROUNDING ************************/
+
+/**
+ * @brief The number of random words a thread draws from its generator at a time.  sfmt_fill_array32 takes a multiple of 4 that is at least the size of the generator state (624 words).
+ */
+#define MATRIX_STOCHASTIC_BLOCK 4096
+
+/**
+ * @brief The number of elements one parallel task of m_fromFloatStochastic_lowp narrows, rounded to whole rows.
+ */
+#define MATRIX_STOCHASTIC_TASK 65536
+
+/**
+ * @brief Seeds stochastic rounding.  Each thread seeds its own SFMT generator from the seed and an ordinal of its own, the next time it rounds.  Until the first call the seed is 0.
+ * @param seed The seed
+ * @note A parallel conversion draws the bits of each row from whichever thread rounds it, so it is reproducible in distribution only.  With one thread (m_setThreadCount(1)) the same seed gives the same matrix.
+ */
+void
+m_seedStochastic_lowp(const uint32_t seed);
+
+/**
+ * @brief Narrows a single precision matrix with stochastic rounding.  int8, uint8 and int16 round down or up to a neighbouring integer, up with the probability of the fraction (to within 2^-24), and saturate at the limits of the type.  bfloat16 rounds away from zero with the probability of the 16 bits it drops.  NaN becomes 0 for the integer types and stays a NaN for bfloat16.  The rows are narrowed in parallel on the vector kernels of the host (see matrix_simd.h).
+ * @param precision MATRIX_PRECISION_INT8, MATRIX_PRECISION_UINT8, MATRIX_PRECISION_INT16 or MATRIX_PRECISION_BF16
+ * @param m The matrix
+ * @return A new low precision matrix allocated upon the heap
+ */
+matrix_lowp_t*
+m_fromFloatStochastic_lowp(const matrix_precision_t precision, const matrix_float_t *m);
+
+#endif /** MATRIX_MIXED_H */
@@ -0,0 +1,255 @@
+/**
+ * @file matrix_pool.c
+ * @brief A size-class pool that recycles matrix headers and small element arrays
+ * @author Aaron Fleisher
+ * @date 2026-10-16
+ */
+#include <assert.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "matrix_pool.h"
+
+/**
+ * @brief A free block.  The link lives in the block itself, so a free list costs no memory of its own.
+ */
+typedef struct Matrix_poolBlock_s {
+    struct Matrix_poolBlock_s *next;
+} matrix_poolBlock_t;
+
+/**
+ * @brief The free lists and counters of one thread.  Only the owning thread writes to them.  The counters are atomic so that m_poolStats may read them from another thread; the owner updates them with relaxed loads and stores, which compile to plain moves.
+ */
+typedef struct Matrix_poolCache_s {
+    matrix_poolBlock_t *blocks[MATRIX_POOL_CLASS_COUNT];
+    size_t count[MATRIX_POOL_CLASS_COUNT];
+    atomic_uint_fast64_t hits;
+    atomic_uint_fast64_t misses;
+    atomic_uint_fast64_t bypassed;
+    struct Matrix_poolCache_s *previous;
+    struct Matrix_poolCache_s *next;
+} matrix_poolCache_t;
+
+/**
+ * @brief The state shared by every thread.
+ * @var lock Protects everything else in the struct
+ * @var blocks The depot: blocks handed back by threads, per size class
+ * @var slabs Every slab the pool has allocated, linked through their first block
+ * @var caches The live thread caches, so that m_poolStats can sum their counters
+ * @var retired The counters of threads that have exited
+ */
+static struct {
+    pthread_mutex_t lock;
+    matrix_poolBlock_t *blocks[MATRIX_POOL_CLASS_COUNT];
+    matrix_poolBlock_t *slabs;
+    matrix_poolCache_t *caches;
+    matrix_poolStats_t retired;
+} m_depot = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+};
+
+static _Thread_local matrix_poolCache_t *m_threadCache = NULL;
+static pthread_key_t m_poolKey;
+static pthread_once_t m_poolKeyOnce = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Returns the size class of a request.
+ * @param bytes A size no larger than MATRIX_POOL_MAX_BLOCK
+ */
+static size_t
+m_poolClass(const size_t bytes) {
+    size_t size_class = 0;
+    while(((size_t) MATRIX_POOL_MIN_BLOCK << size_class) < bytes) {
+        size_class++;
+    }
+    return size_class;
+}
+
+static void
+m_poolIncrement(atomic_uint_fast64_t *counter) {
+    atomic_store_explicit(counter, atomic_load_explicit(counter, memory_order_relaxed) + 1, memory_order_relaxed);
+}
+
+/**
+ * @brief Returns every block of a thread's cache to the depot and retires its counters.  Runs when the thread exits.
+ */
+static void
+m_destroyPoolCache(void *argument) {
+    matrix_poolCache_t *cache = argument;
+    pthread_mutex_lock(&m_depot.lock);
+    for(size_t size_class = 0; size_class < MATRIX_POOL_CLASS_COUNT; size_class++) {
+        while(NULL != cache->blocks[size_class]) {
+            matrix_poolBlock_t *block = cache->blocks[size_class];
+            cache->blocks[size_class] = block->next;
+            block->next = m_depot.blocks[size_class];
+            m_depot.blocks[size_class] = block;
+        }
+    }
+    m_depot.retired.hits += atomic_load_explicit(&cache->hits, memory_order_relaxed);
+    m_depot.retired.misses += atomic_load_explicit(&cache->misses, memory_order_relaxed);
+    m_depot.retired.bypassed += atomic_load_explicit(&cache->bypassed, memory_order_relaxed);
+    if(NULL != cache->previous) {
+        cache->previous->next = cache->next;
+    } else {
+        m_depot.caches = cache->next;
+    }
+    if(NULL != cache->next) {
+        cache->next->previous = cache->previous;
+    }
+    pthread_mutex_unlock(&m_depot.lock);
+    free(cache);
+    m_threadCache = NULL;
+}
+
+static void
+m_createPoolKey(void) {
+    (void) pthread_key_create(&m_poolKey, m_destroyPoolCache);
+}
+
+/**
+ * @brief Returns the calling thread's cache, creating and registering it on first use.
+ */
+static matrix_poolCache_t*
+m_poolCache(void) {
+    if(NULL != m_threadCache) {
+        return m_threadCache;
+    }
+    (void) pthread_once(&m_poolKeyOnce, m_createPoolKey);
+    matrix_poolCache_t *cache = calloc(1, sizeof(matrix_poolCache_t));
+    assert(NULL != cache);
+    pthread_mutex_lock(&m_depot.lock);
+    cache->next = m_depot.caches;
+    if(NULL != cache->next) {
+        cache->next->previous = cache;
+    }
+    m_depot.caches = cache;
+    pthread_mutex_unlock(&m_depot.lock);
+    (void) pthread_setspecific(m_poolKey, cache);
+    m_threadCache = cache;
+    return cache;
+}
+
+/**
+ * @brief Moves a batch of blocks from the depot into a thread's empty free list, carving a new slab when the depot has none.  The slab's first block links it into the slab list and is never handed out.
+ */
+static void
+m_poolRefill(matrix_poolCache_t *cache, const size_t size_class) {
+    const size_t block_size = (size_t) MATRIX_POOL_MIN_BLOCK << size_class;
+    pthread_mutex_lock(&m_depot.lock);
+    if(NULL == m_depot.blocks[size_class]) {
+        matrix_poolBlock_t *slab = aligned_alloc(MATRIX_POOL_MIN_BLOCK, (MATRIX_POOL_BATCH + 1) * block_size);
+        assert(NULL != slab);
+        slab->next = m_depot.slabs;
+        m_depot.slabs = slab;
+        m_depot.retired.slab_bytes += (MATRIX_POOL_BATCH + 1) * block_size;
+        for(size_t index = MATRIX_POOL_BATCH; index >= 1; index--) {
+            matrix_poolBlock_t *block = (matrix_poolBlock_t *) ((unsigned char *) slab + (index * block_size));
+            block->next = m_depot.blocks[size_class];
+            m_depot.blocks[size_class] = block;
+        }
+    }
+    for(size_t moved = 0; (moved < MATRIX_POOL_BATCH) && (NULL != m_depot.blocks[size_class]); moved++) {
+        matrix_poolBlock_t *block = m_depot.blocks[size_class];
+        m_depot.blocks[size_class] = block->next;
+        block->next = cache->blocks[size_class];
+        cache->blocks[size_class] = block;
+        cache->count[size_class]++;
+    }
+    pthread_mutex_unlock(&m_depot.lock);
+}
+
+/**
+ * @brief Moves a batch of blocks from a thread's free list, which has grown past MATRIX_POOL_CACHE_LIMIT, back to the depot.
+ */
+static void
+m_poolDrain(matrix_poolCache_t *cache, const size_t size_class) {
+    pthread_mutex_lock(&m_depot.lock);
+    for(size_t moved = 0; moved < MATRIX_POOL_BATCH; moved++) {
+        matrix_poolBlock_t *block = cache->blocks[size_class];
+        cache->blocks[size_class] = block->next;
+        cache->count[size_class]--;
+        block->next = m_depot.blocks[size_class];
+        m_depot.blocks[size_class] = block;
+    }
+    pthread_mutex_unlock(&m_depot.lock);
+}
+
+/**
+ * @brief Allocates a block from the pool.
+ * @param bytes The number of bytes.  Requests above MATRIX_POOL_MAX_BLOCK are served by the heap.
+ * @return MATRIX_POOL_MIN_BLOCK aligned memory with unspecified contents.  Free it with m_poolFree and the same size.
+ */
+void*
+m_poolAlloc(const size_t bytes) {
+    matrix_poolCache_t *cache = m_poolCache();
+    if(bytes > MATRIX_POOL_MAX_BLOCK) {
+        m_poolIncrement(&cache->bypassed);
+        return aligned_alloc(MATRIX_POOL_MIN_BLOCK, ((bytes + MATRIX_POOL_MIN_BLOCK - 1) / MATRIX_POOL_MIN_BLOCK) * MATRIX_POOL_MIN_BLOCK);
+    }
+    const size_t size_class = m_poolClass(bytes);
+    if(NULL == cache->blocks[size_class]) {
+        m_poolIncrement(&cache->misses);
+        m_poolRefill(cache, size_class);
+    } else {
+        m_poolIncrement(&cache->hits);
+    }
+    matrix_poolBlock_t *block = cache->blocks[size_class];
+    cache->blocks[size_class] = block->next;
+    cache->count[size_class]--;
+    return block;
+}
+
+/**
+ * @brief Allocates a zeroed block from the pool.
+ * @param bytes The number of bytes
+ * @return Zeroed, MATRIX_POOL_MIN_BLOCK aligned memory.  Free it with m_poolFree and the same size.
+ */
+void*
+m_poolCalloc(const size_t bytes) {
+    void *memory = m_poolAlloc(bytes);
+    memset(memory, 0, bytes);
+    return memory;
+}
+
+/**
+ * @brief Gives a block back to the calling thread's free list.  Blocks may be freed on a different thread from the one that allocated them.
+ * @param memory The block.  NULL is ignored.
+ * @param bytes The size that was passed to m_poolAlloc
+ */
+void
+m_poolFree(void *memory, const size_t bytes) {
+    if(NULL == memory) {
+        return;
+    }
+    if(bytes > MATRIX_POOL_MAX_BLOCK) {
+        free(memory);
+        return;
+    }
+    matrix_poolCache_t *cache = m_poolCache();
+    const size_t size_class = m_poolClass(bytes);
+    matrix_poolBlock_t *block = memory;
+    block->next = cache->blocks[size_class];
+    cache->blocks[size_class] = block;
+    if(++cache->count[size_class] > MATRIX_POOL_CACHE_LIMIT) {
+        m_poolDrain(cache, size_class);
+    }
+}
+
+/**
+ * @brief Reads the pool's counters.
+ * @param stats Receives the counters summed over every thread
+ */
+void
+m_poolStats(matrix_poolStats_t *stats) {
+    pthread_mutex_lock(&m_depot.lock);
+    *stats = m_depot.retired;
+    for(const matrix_poolCache_t *cache = m_depot.caches; NULL != cache; cache = cache->next) {
+        stats->hits += atomic_load_explicit(&cache->hits, memory_order_relaxed);
+        stats->misses += atomic_load_explicit(&cache->misses, memory_order_relaxed);
+        stats->bypassed += atomic_load_explicit(&cache->bypassed, memory_order_relaxed);
+    }
+    pthread_mutex_unlock(&m_depot.lock);
+}
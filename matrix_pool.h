@@ -0,0 +1,88 @@
+/**
+ * @file matrix_pool.h
+ * @brief A size-class pool that recycles matrix headers and small element arrays
+ * @author Aaron Fleisher
+ * @date 2026-10-16
+ *
+ * Matrices that are not allocated from an arena take their header, their derived data and, when it is small enough, their element array from this pool.  Blocks come in power-of-two size classes from MATRIX_POOL_MIN_BLOCK to MATRIX_POOL_MAX_BLOCK bytes.  Larger requests go straight to the heap, with the same alignment.
+ * Every thread keeps its own free list per size class, so allocating and freeing the many small matrices of e.g. 3x3 and 4x4 transforms takes no lock.  Only when a thread's list runs empty or grows past MATRIX_POOL_CACHE_LIMIT does a batch of MATRIX_POOL_BATCH blocks move between the thread and a shared depot, under a mutex.
+ * Blocks are carved out of slabs that are kept for the life of the process.  When a thread exits, its cached blocks go back to the depot.
+ */
+
+#ifndef MATRIX_POOL_H
+#define MATRIX_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief The size of the smallest size class in bytes.  It is a cache line, so every block is cache line aligned.
+ */
+#define MATRIX_POOL_MIN_BLOCK 64
+
+/**
+ * @brief The size of the largest size class in bytes.  It holds a 32 x 32 int array.
+ */
+#define MATRIX_POOL_MAX_BLOCK 4096
+
+/**
+ * @brief The number of size classes: 64, 128, 256, 512, 1024, 2048 and 4096 bytes.
+ */
+#define MATRIX_POOL_CLASS_COUNT 7
+
+/**
+ * @brief The number of blocks a thread may cache per size class before it hands a batch back to the depot.
+ */
+#define MATRIX_POOL_CACHE_LIMIT 128
+
+/**
+ * @brief The number of blocks moved between a thread and the depot at once.
+ */
+#define MATRIX_POOL_BATCH 32
+
+/**
+ * @brief The pool's counters, summed over every thread that has used it.
+ * @var hits Allocations served from the calling thread's own free list
+ * @var misses Allocations that had to refill the thread's free list from the depot or from a new slab
+ * @var bypassed Allocations larger than MATRIX_POOL_MAX_BLOCK, served by the heap
+ * @var slab_bytes The total size of the slabs the pool has carved blocks from
+ */
+typedef struct Matrix_poolStats_s {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t bypassed;
+    uint64_t slab_bytes;
+} matrix_poolStats_t;
+
+/**
+ * @brief Allocates a block from the pool.
+ * @param bytes The number of bytes.  Requests above MATRIX_POOL_MAX_BLOCK are served by the heap.
+ * @return MATRIX_POOL_MIN_BLOCK aligned memory with unspecified contents.  Free it with m_poolFree and the same size.
+ */
+void*
+m_poolAlloc(const size_t bytes);
+
+/**
+ * @brief Allocates a zeroed block from the pool.
+ * @param bytes The number of bytes
+ * @return Zeroed, MATRIX_POOL_MIN_BLOCK aligned memory.  Free it with m_poolFree and the same size.
+ */
+void*
+m_poolCalloc(const size_t bytes);
+
+/**
+ * @brief Gives a block back to the calling thread's free list.  Blocks may be freed on a different thread from the one that allocated them.
+ * @param memory The block.  NULL is ignored.
+ * @param bytes The size that was passed to m_poolAlloc
+ */
+void
+m_poolFree(void *memory, const size_t bytes);
+
+/**
+ * @brief Reads the pool's counters.
+ * @param stats Receives the counters summed over every thread
+ */
+void
+m_poolStats(matrix_poolStats_t *stats);
+
+#endif /** MATRIX_POOL_H */
@@ -0,0 +1,2363 @@
+/**
+ * @file matrix_simd.c
+ * @brief Hand-vectorized integer, single and double precision kernels and the runtime CPU dispatch that selects between them
+ * @author Aaron Fleisher
+ * @date 2026-10-16
+ *
+ * @note The scalar variants do their arithmetic on unsigned integers.  Signed overflow is undefined in C, while the vector instructions wrap.  Wrapping on purpose keeps every variant bit-identical.
+ */
+#include <immintrin.h>
+#include <limits.h>
+#include <math.h>
+
+#include "matrix_simd.h"
+#include "matrix_double.h"
+#include "matrix_float.h"
+#include "matrix_mixed.h"
+
+
+/*************************** SCALAR FALLBACK ************************/
+
+static void
+m_add_scalar(int *result, const int *a1, const int *a2, const size_t length) {
+    for(size_t index = 0; index < length; index++) {
+        result[index] = (int) ((unsigned int) a1[index] + (unsigned int) a2[index]);
+    }
+}
+
+static void
+m_subtract_scalar(int *result, const int *a1, const int *a2, const size_t length) {
+    for(size_t index = 0; index < length; index++) {
+        result[index] = (int) ((unsigned int) a1[index] - (unsigned int) a2[index]);
+    }
+}
+
+static void
+m_multiply_scalar(int *result, const int *a1, const int *a2, const size_t length) {
+    for(size_t index = 0; index < length; index++) {
+        result[index] = (int) ((unsigned int) a1[index] * (unsigned int) a2[index]);
+    }
+}
+
+static void
+m_scalarAdd_scalar(int *array, const int scalar, const size_t length) {
+    for(size_t index = 0; index < length; index++) {
+        array[index] = (int) ((unsigned int) array[index] + (unsigned int) scalar);
+    }
+}
+
+static void
+m_scalarMultiply_scalar(int *array, const int scalar, const size_t length) {
+    for(size_t index = 0; index < length; index++) {
+        array[index] = (int) ((unsigned int) array[index] * (unsigned int) scalar);
+    }
+}
+
+static void
+m_axpy_scalar(int *y, const int scalar, const int *x, const size_t length) {
+    for(size_t index = 0; index < length; index++) {
+        y[index] = (int) ((unsigned int) y[index] + ((unsigned int) scalar * (unsigned int) x[index]));
+    }
+}
+
+static int
+m_dotProduct_scalar(const int *a1, const int *a2, const size_t length) {
+    unsigned int product = 0;
+    for(size_t index = 0; index < length; index++) {
+        product += (unsigned int) a1[index] * (unsigned int) a2[index];
+    }
+    return (int) product;
+}
+
+static void
+m_summarize_scalar(const int *array, const size_t length, matrix_rangeSummary_int_t *summary) {
+    unsigned int bits = 0;
+    int64_t sum = 0;
+    int minimum = INT_MAX;
+    int maximum = INT_MIN;
+    for(size_t index = 0; index < length; index++) {
+        bits |= (unsigned int) array[index];
+        sum += array[index];
+        minimum = (array[index] < minimum) ? array[index] : minimum;
+        maximum = (array[index] > maximum) ? array[index] : maximum;
+    }
+    summary->bits = bits;
+    summary->sum = sum;
+    summary->minimum = minimum;
+    summary->maximum = maximum;
+}
+
+static void
+m_widenInt8_scalar(int *destination, const int8_t *source, const size_t length) {
+    for(size_t index = 0; index < length; index++) {
+        destination[index] = source[index];
+    }
+}
+
+static void
+m_widenInt16_scalar(int *destination, const int16_t *source, const size_t length) {
+    for(size_t index = 0; index < length; index++) {
+        destination[index] = source[index];
+    }
+}
+
+/**
+ * @brief Adds a finished MR x NR accumulator tile into the destination, writing only the mr x nr valid part.
+ */
+static void
+m_gemmStoreTile_scalar(unsigned int accumulator[MATRIX_GEMM_MR][MATRIX_GEMM_NR], int *c, const size_t ldc, const size_t mr, const size_t nr) {
+    for(size_t r = 0; r < mr; r++) {
+        for(size_t column = 0; column < nr; column++) {
+            c[(r * ldc) + column] = (int) ((unsigned int) c[(r * ldc) + column] + accumulator[r][column]);
+        }
+    }
+}
+
+static void
+m_gemmMicro_scalar(const size_t kc, const int *a_panel, const int *b_panel, int *c, const size_t ldc, const size_t mr, const size_t nr) {
+    unsigned int accumulator[MATRIX_GEMM_MR][MATRIX_GEMM_NR] = {{0}};
+    for(size_t k = 0; k < kc; k++) {
+        for(size_t r = 0; r < MATRIX_GEMM_MR; r++) {
+            const unsigned int a_value = (unsigned int) a_panel[r];
+            for(size_t column = 0; column < MATRIX_GEMM_NR; column++) {
+                accumulator[r][column] += a_value * (unsigned int) b_panel[column];
+            }
+        }
+        a_panel += MATRIX_GEMM_MR;
+        b_panel += MATRIX_GEMM_NR;
+    }
+    m_gemmStoreTile_scalar(accumulator, c, ldc, mr, nr);
+}
+
+/**
+ * @note POPCNT arrived after SSE4.1, so the SSE4.1 table uses this variant as well.  Without a target attribute the compiler emits a portable bit-counting sequence.
+ */
+static uint64_t
+m_andPopcount_scalar(const uint64_t *a, const uint64_t *b, const size_t words) {
+    uint64_t count = 0;
+    for(size_t index = 0; index < words; index++) {
+        count += (uint64_t) __builtin_popcountll(a[index] & b[index]);
+    }
+    return count;
+}
+
+
+/*************************** SSE4.1 ************************/
+
+__attribute__((target("sse4.1")))
+static void
+m_add_sse41(int *result, const int *a1, const int *a2, const size_t length) {
+    size_t index = 0;
+    for(; index + 4 <= length; index += 4) {
+        const __m128i x = _mm_loadu_si128((const __m128i *) (a1 + index));
+        const __m128i y = _mm_loadu_si128((const __m128i *) (a2 + index));
+        _mm_storeu_si128((__m128i *) (result + index), _mm_add_epi32(x, y));
+    }
+    m_add_scalar(result + index, a1 + index, a2 + index, length - index);
+}
+
+__attribute__((target("sse4.1")))
+static void
+m_subtract_sse41(int *result, const int *a1, const int *a2, const size_t length) {
+    size_t index = 0;
+    for(; index + 4 <= length; index += 4) {
+        const __m128i x = _mm_loadu_si128((const __m128i *) (a1 + index));
+        const __m128i y = _mm_loadu_si128((const __m128i *) (a2 + index));
+        _mm_storeu_si128((__m128i *) (result + index), _mm_sub_epi32(x, y));
+    }
+    m_subtract_scalar(result + index, a1 + index, a2 + index, length - index);
+}
+
+__attribute__((target("sse4.1")))
+static void
+m_multiply_sse41(int *result, const int *a1, const int *a2, const size_t length) {
+    size_t index = 0;
+    for(; index + 4 <= length; index += 4) {
+        const __m128i x = _mm_loadu_si128((const __m128i *) (a1 + index));
+        const __m128i y = _mm_loadu_si128((const __m128i *) (a2 + index));
+        _mm_storeu_si128((__m128i *) (result + index), _mm_mullo_epi32(x, y));
+    }
+    m_multiply_scalar(result + index, a1 + index, a2 + index, length - index);
+}
+
+__attribute__((target("sse4.1")))
+static void
+m_scalarAdd_sse41(int *array, const int scalar, const size_t length) {
+    const __m128i s = _mm_set1_epi32(scalar);
+    size_t index = 0;
+    for(; index + 4 <= length; index += 4) {
+        const __m128i x = _mm_loadu_si128((const __m128i *) (array + index));
+        _mm_storeu_si128((__m128i *) (array + index), _mm_add_epi32(x, s));
+    }
+    m_scalarAdd_scalar(array + index, scalar, length - index);
+}
+
+__attribute__((target("sse4.1")))
+static void
+m_scalarMultiply_sse41(int *array, const int scalar, const size_t length) {
+    const __m128i s = _mm_set1_epi32(scalar);
+    size_t index = 0;
+    for(; index + 4 <= length; index += 4) {
+        const __m128i x = _mm_loadu_si128((const __m128i *) (array + index));
+        _mm_storeu_si128((__m128i *) (array + index), _mm_mullo_epi32(x, s));
+    }
+    m_scalarMultiply_scalar(array + index, scalar, length - index);
+}
+
+__attribute__((target("sse4.1")))
+static void
+m_axpy_sse41(int *y, const int scalar, const int *x, const size_t length) {
+    const __m128i s = _mm_set1_epi32(scalar);
+    size_t index = 0;
+    for(; index + 4 <= length; index += 4) {
+        const __m128i a = _mm_loadu_si128((const __m128i *) (x + index));
+        const __m128i b = _mm_loadu_si128((const __m128i *) (y + index));
+        _mm_storeu_si128((__m128i *) (y + index), _mm_add_epi32(b, _mm_mullo_epi32(a, s)));
+    }
+    m_axpy_scalar(y + index, scalar, x + index, length - index);
+}
+
+__attribute__((target("sse4.1")))
+static int
+m_dotProduct_sse41(const int *a1, const int *a2, const size_t length) {
+    __m128i sum = _mm_setzero_si128();
+    size_t index = 0;
+    for(; index + 4 <= length; index += 4) {
+        const __m128i x = _mm_loadu_si128((const __m128i *) (a1 + index));
+        const __m128i y = _mm_loadu_si128((const __m128i *) (a2 + index));
+        sum = _mm_add_epi32(sum, _mm_mullo_epi32(x, y));
+    }
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    const unsigned int tail = (unsigned int) m_dotProduct_scalar(a1 + index, a2 + index, length - index);
+    return (int) ((unsigned int) _mm_cvtsi128_si32(sum) + tail);
+}
+
+__attribute__((target("sse4.1")))
+static void
+m_summarize_sse41(const int *array, const size_t length, matrix_rangeSummary_int_t *summary) {
+    __m128i bits = _mm_setzero_si128();
+    __m128i sum = _mm_setzero_si128();
+    __m128i minimum = _mm_set1_epi32(INT_MAX);
+    __m128i maximum = _mm_set1_epi32(INT_MIN);
+    size_t index = 0;
+    for(; index + 4 <= length; index += 4) {
+        const __m128i x = _mm_loadu_si128((const __m128i *) (array + index));
+        bits = _mm_or_si128(bits, x);
+        sum = _mm_add_epi64(sum, _mm_cvtepi32_epi64(x));
+        sum = _mm_add_epi64(sum, _mm_cvtepi32_epi64(_mm_unpackhi_epi64(x, x)));
+        minimum = _mm_min_epi32(minimum, x);
+        maximum = _mm_max_epi32(maximum, x);
+    }
+    bits = _mm_or_si128(bits, _mm_shuffle_epi32(bits, _MM_SHUFFLE(1, 0, 3, 2)));
+    bits = _mm_or_si128(bits, _mm_shuffle_epi32(bits, _MM_SHUFFLE(2, 3, 0, 1)));
+    sum = _mm_add_epi64(sum, _mm_unpackhi_epi64(sum, sum));
+    minimum = _mm_min_epi32(minimum, _mm_shuffle_epi32(minimum, _MM_SHUFFLE(1, 0, 3, 2)));
+    minimum = _mm_min_epi32(minimum, _mm_shuffle_epi32(minimum, _MM_SHUFFLE(2, 3, 0, 1)));
+    maximum = _mm_max_epi32(maximum, _mm_shuffle_epi32(maximum, _MM_SHUFFLE(1, 0, 3, 2)));
+    maximum = _mm_max_epi32(maximum, _mm_shuffle_epi32(maximum, _MM_SHUFFLE(2, 3, 0, 1)));
+    m_summarize_scalar(array + index, length - index, summary);
+    summary->bits |= (unsigned int) _mm_cvtsi128_si32(bits);
+    summary->sum += _mm_cvtsi128_si64(sum);
+    summary->minimum = (_mm_cvtsi128_si32(minimum) < summary->minimum) ? _mm_cvtsi128_si32(minimum) : summary->minimum;
+    summary->maximum = (_mm_cvtsi128_si32(maximum) > summary->maximum) ? _mm_cvtsi128_si32(maximum) : summary->maximum;
+}
+
+__attribute__((target("sse4.1")))
+static void
+m_widenInt8_sse41(int *destination, const int8_t *source, const size_t length) {
+    size_t index = 0;
+    for(; index + 16 <= length; index += 16) {
+        const __m128i x = _mm_loadu_si128((const __m128i *) (source + index));
+        _mm_storeu_si128((__m128i *) (destination + index), _mm_cvtepi8_epi32(x));
+        _mm_storeu_si128((__m128i *) (destination + index + 4), _mm_cvtepi8_epi32(_mm_srli_si128(x, 4)));
+        _mm_storeu_si128((__m128i *) (destination + index + 8), _mm_cvtepi8_epi32(_mm_srli_si128(x, 8)));
+        _mm_storeu_si128((__m128i *) (destination + index + 12), _mm_cvtepi8_epi32(_mm_srli_si128(x, 12)));
+    }
+    m_widenInt8_scalar(destination + index, source + index, length - index);
+}
+
+__attribute__((target("sse4.1")))
+static void
+m_widenInt16_sse41(int *destination, const int16_t *source, const size_t length) {
+    size_t index = 0;
+    for(; index + 8 <= length; index += 8) {
+        const __m128i x = _mm_loadu_si128((const __m128i *) (source + index));
+        _mm_storeu_si128((__m128i *) (destination + index), _mm_cvtepi16_epi32(x));
+        _mm_storeu_si128((__m128i *) (destination + index + 4), _mm_cvtepi16_epi32(_mm_srli_si128(x, 8)));
+    }
+    m_widenInt16_scalar(destination + index, source + index, length - index);
+}
+
+__attribute__((target("sse4.1")))
+static void
+m_gemmMicro_sse41(const size_t kc, const int *a_panel, const int *b_panel, int *c, const size_t ldc, const size_t mr, const size_t nr) {
+    __m128i accumulator[MATRIX_GEMM_MR][MATRIX_GEMM_NR / 4];
+    for(size_t r = 0; r < MATRIX_GEMM_MR; r++) {
+        for(size_t v = 0; v < MATRIX_GEMM_NR / 4; v++) {
+            accumulator[r][v] = _mm_setzero_si128();
+        }
+    }
+    for(size_t k = 0; k < kc; k++) {
+        __m128i b[MATRIX_GEMM_NR / 4];
+        for(size_t v = 0; v < MATRIX_GEMM_NR / 4; v++) {
+            b[v] = _mm_loadu_si128((const __m128i *) (b_panel + (4 * v)));
+        }
+        for(size_t r = 0; r < MATRIX_GEMM_MR; r++) {
+            const __m128i a = _mm_set1_epi32(a_panel[r]);
+            for(size_t v = 0; v < MATRIX_GEMM_NR / 4; v++) {
+                accumulator[r][v] = _mm_add_epi32(accumulator[r][v], _mm_mullo_epi32(a, b[v]));
+            }
+        }
+        a_panel += MATRIX_GEMM_MR;
+        b_panel += MATRIX_GEMM_NR;
+    }
+    if((MATRIX_GEMM_MR == mr) && (MATRIX_GEMM_NR == nr)) {
+        for(size_t r = 0; r < MATRIX_GEMM_MR; r++) {
+            for(size_t v = 0; v < MATRIX_GEMM_NR / 4; v++) {
+                __m128i *destination = (__m128i *) (c + (r * ldc) + (4 * v));
+                _mm_storeu_si128(destination, _mm_add_epi32(_mm_loadu_si128(destination), accumulator[r][v]));
+            }
+        }
+        return;
+    }
+    unsigned int tile[MATRIX_GEMM_MR][MATRIX_GEMM_NR];
+    for(size_t r = 0; r < MATRIX_GEMM_MR; r++) {
+        for(size_t v = 0; v < MATRIX_GEMM_NR / 4; v++) {
+            _mm_storeu_si128((__m128i *) &tile[r][4 * v], accumulator[r][v]);
+        }
+    }
+    m_gemmStoreTile_scalar(tile, c, ldc, mr, nr);
+}
+
+
+/*************************** AVX2 ************************/
+
+__attribute__((target("avx2")))
+static void
+m_add_avx2(int *result, const int *a1, const int *a2, const size_t length) {
+    size_t index = 0;
+    for(; index + 8 <= length; index += 8) {
+        const __m256i x = _mm256_loadu_si256((const __m256i *) (a1 + index));
+        const __m256i y = _mm256_loadu_si256((const __m256i *) (a2 + index));
+        _mm256_storeu_si256((__m256i *) (result + index), _mm256_add_epi32(x, y));
+    }
+    m_add_scalar(result + index, a1 + index, a2 + index, length - index);
+}
+
+__attribute__((target("avx2")))
+static void
+m_subtract_avx2(int *result, const int *a1, const int *a2, const size_t length) {
+    size_t index = 0;
+    for(; index + 8 <= length; index += 8) {
+        const __m256i x = _mm256_loadu_si256((const __m256i *) (a1 + index));
+        const __m256i y = _mm256_loadu_si256((const __m256i *) (a2 + index));
+        _mm256_storeu_si256((__m256i *) (result + index), _mm256_sub_epi32(x, y));
+    }
+    m_subtract_scalar(result + index, a1 + index, a2 + index, length - index);
+}
+
+__attribute__((target("avx2")))
+static void
+m_multiply_avx2(int *result, const int *a1, const int *a2, const size_t length) {
+    size_t index = 0;
+    for(; index + 8 <= length; index += 8) {
+        const __m256i x = _mm256_loadu_si256((const __m256i *) (a1 + index));
+        const __m256i y = _mm256_loadu_si256((const __m256i *) (a2 + index));
+        _mm256_storeu_si256((__m256i *) (result + index), _mm256_mullo_epi32(x, y));
+    }
+    m_multiply_scalar(result + index, a1 + index, a2 + index, length - index);
+}
+
+__attribute__((target("avx2")))
+static void
+m_scalarAdd_avx2(int *array, const int scalar, const size_t length) {
+    const __m256i s = _mm256_set1_epi32(scalar);
+    size_t index = 0;
+    for(; index + 8 <= length; index += 8) {
+        const __m256i x = _mm256_loadu_si256((const __m256i *) (array + index));
+        _mm256_storeu_si256((__m256i *) (array + index), _mm256_add_epi32(x, s));
+    }
+    m_scalarAdd_scalar(array + index, scalar, length - index);
+}
+
+__attribute__((target("avx2")))
+static void
+m_scalarMultiply_avx2(int *array, const int scalar, const size_t length) {
+    const __m256i s = _mm256_set1_epi32(scalar);
+    size_t index = 0;
+    for(; index + 8 <= length; index += 8) {
+        const __m256i x = _mm256_loadu_si256((const __m256i *) (array + index));
+        _mm256_storeu_si256((__m256i *) (array + index), _mm256_mullo_epi32(x, s));
+    }
+    m_scalarMultiply_scalar(array + index, scalar, length - index);
+}
+
+__attribute__((target("avx2")))
+static void
+m_axpy_avx2(int *y, const int scalar, const int *x, const size_t length) {
+    const __m256i s = _mm256_set1_epi32(scalar);
+    size_t index = 0;
+    for(; index + 8 <= length; index += 8) {
+        const __m256i a = _mm256_loadu_si256((const __m256i *) (x + index));
+        const __m256i b = _mm256_loadu_si256((const __m256i *) (y + index));
+        _mm256_storeu_si256((__m256i *) (y + index), _mm256_add_epi32(b, _mm256_mullo_epi32(a, s)));
+    }
+    m_axpy_scalar(y + index, scalar, x + index, length - index);
+}
+
+__attribute__((target("avx2")))
+static int
+m_dotProduct_avx2(const int *a1, const int *a2, const size_t length) {
+    __m256i sum = _mm256_setzero_si256();
+    size_t index = 0;
+    for(; index + 8 <= length; index += 8) {
+        const __m256i x = _mm256_loadu_si256((const __m256i *) (a1 + index));
+        const __m256i y = _mm256_loadu_si256((const __m256i *) (a2 + index));
+        sum = _mm256_add_epi32(sum, _mm256_mullo_epi32(x, y));
+    }
+    __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+    const unsigned int tail = (unsigned int) m_dotProduct_scalar(a1 + index, a2 + index, length - index);
+    return (int) ((unsigned int) _mm_cvtsi128_si32(half) + tail);
+}
+
+__attribute__((target("avx2")))
+static void
+m_summarize_avx2(const int *array, const size_t length, matrix_rangeSummary_int_t *summary) {
+    __m256i bits = _mm256_setzero_si256();
+    __m256i sum = _mm256_setzero_si256();
+    __m256i minimum = _mm256_set1_epi32(INT_MAX);
+    __m256i maximum = _mm256_set1_epi32(INT_MIN);
+    size_t index = 0;
+    for(; index + 8 <= length; index += 8) {
+        const __m256i x = _mm256_loadu_si256((const __m256i *) (array + index));
+        bits = _mm256_or_si256(bits, x);
+        sum = _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(x)));
+        sum = _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(x, 1)));
+        minimum = _mm256_min_epi32(minimum, x);
+        maximum = _mm256_max_epi32(maximum, x);
+    }
+    __m128i bits_half = _mm_or_si128(_mm256_castsi256_si128(bits), _mm256_extracti128_si256(bits, 1));
+    bits_half = _mm_or_si128(bits_half, _mm_shuffle_epi32(bits_half, _MM_SHUFFLE(1, 0, 3, 2)));
+    bits_half = _mm_or_si128(bits_half, _mm_shuffle_epi32(bits_half, _MM_SHUFFLE(2, 3, 0, 1)));
+    __m128i sum_half = _mm_add_epi64(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    sum_half = _mm_add_epi64(sum_half, _mm_unpackhi_epi64(sum_half, sum_half));
+    __m128i minimum_half = _mm_min_epi32(_mm256_castsi256_si128(minimum), _mm256_extracti128_si256(minimum, 1));
+    minimum_half = _mm_min_epi32(minimum_half, _mm_shuffle_epi32(minimum_half, _MM_SHUFFLE(1, 0, 3, 2)));
+    minimum_half = _mm_min_epi32(minimum_half, _mm_shuffle_epi32(minimum_half, _MM_SHUFFLE(2, 3, 0, 1)));
+    __m128i maximum_half = _mm_max_epi32(_mm256_castsi256_si128(maximum), _mm256_extracti128_si256(maximum, 1));
+    maximum_half = _mm_max_epi32(maximum_half, _mm_shuffle_epi32(maximum_half, _MM_SHUFFLE(1, 0, 3, 2)));
+    maximum_half = _mm_max_epi32(maximum_half, _mm_shuffle_epi32(maximum_half, _MM_SHUFFLE(2, 3, 0, 1)));
+    m_summarize_scalar(array + index, length - index, summary);
+    summary->bits |= (unsigned int) _mm_cvtsi128_si32(bits_half);
+    summary->sum += _mm_cvtsi128_si64(sum_half);
+    summary->minimum = (_mm_cvtsi128_si32(minimum_half) < summary->minimum) ? _mm_cvtsi128_si32(minimum_half) : summary->minimum;
+    summary->maximum = (_mm_cvtsi128_si32(maximum_half) > summary->maximum) ? _mm_cvtsi128_si32(maximum_half) : summary->maximum;
+}
+
+__attribute__((target("avx2")))
+static void
+m_widenInt8_avx2(int *destination, const int8_t *source, const size_t length) {
+    size_t index = 0;
+    for(; index + 16 <= length; index += 16) {
+        const __m128i x = _mm_loadu_si128((const __m128i *) (source + index));
+        _mm256_storeu_si256((__m256i *) (destination + index), _mm256_cvtepi8_epi32(x));
+        _mm256_storeu_si256((__m256i *) (destination + index + 8), _mm256_cvtepi8_epi32(_mm_srli_si128(x, 8)));
+    }
+    m_widenInt8_scalar(destination + index, source + index, length - index);
+}
+
+__attribute__((target("avx2")))
+static void
+m_widenInt16_avx2(int *destination, const int16_t *source, const size_t length) {
+    size_t index = 0;
+    for(; index + 16 <= length; index += 16) {
+        _mm256_storeu_si256((__m256i *) (destination + index), _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *) (source + index))));
+        _mm256_storeu_si256((__m256i *) (destination + index + 8), _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *) (source + index + 8))));
+    }
+    m_widenInt16_scalar(destination + index, source + index, length - index);
+}
+
+__attribute__((target("avx2")))
+static void
+m_gemmMicro_avx2(const size_t kc, const int *a_panel, const int *b_panel, int *c, const size_t ldc, const size_t mr, const size_t nr) {
+    __m256i c00 = _mm256_setzero_si256(), c01 = _mm256_setzero_si256();
+    __m256i c10 = _mm256_setzero_si256(), c11 = _mm256_setzero_si256();
+    __m256i c20 = _mm256_setzero_si256(), c21 = _mm256_setzero_si256();
+    __m256i c30 = _mm256_setzero_si256(), c31 = _mm256_setzero_si256();
+    for(size_t k = 0; k < kc; k++) {
+        const __m256i b0 = _mm256_loadu_si256((const __m256i *) b_panel);
+        const __m256i b1 = _mm256_loadu_si256((const __m256i *) (b_panel + 8));
+        __m256i a = _mm256_set1_epi32(a_panel[0]);
+        c00 = _mm256_add_epi32(c00, _mm256_mullo_epi32(a, b0));
+        c01 = _mm256_add_epi32(c01, _mm256_mullo_epi32(a, b1));
+        a = _mm256_set1_epi32(a_panel[1]);
+        c10 = _mm256_add_epi32(c10, _mm256_mullo_epi32(a, b0));
+        c11 = _mm256_add_epi32(c11, _mm256_mullo_epi32(a, b1));
+        a = _mm256_set1_epi32(a_panel[2]);
+        c20 = _mm256_add_epi32(c20, _mm256_mullo_epi32(a, b0));
+        c21 = _mm256_add_epi32(c21, _mm256_mullo_epi32(a, b1));
+        a = _mm256_set1_epi32(a_panel[3]);
+        c30 = _mm256_add_epi32(c30, _mm256_mullo_epi32(a, b0));
+        c31 = _mm256_add_epi32(c31, _mm256_mullo_epi32(a, b1));
+        a_panel += MATRIX_GEMM_MR;
+        b_panel += MATRIX_GEMM_NR;
+    }
+    const __m256i accumulator[MATRIX_GEMM_MR][2] = {{c00, c01}, {c10, c11}, {c20, c21}, {c30, c31}};
+    if((MATRIX_GEMM_MR == mr) && (MATRIX_GEMM_NR == nr)) {
+        for(size_t r = 0; r < MATRIX_GEMM_MR; r++) {
+            __m256i *destination = (__m256i *) (c + (r * ldc));
+            _mm256_storeu_si256(destination, _mm256_add_epi32(_mm256_loadu_si256(destination), accumulator[r][0]));
+            _mm256_storeu_si256(destination + 1, _mm256_add_epi32(_mm256_loadu_si256(destination + 1), accumulator[r][1]));
+        }
+        return;
+    }
+    unsigned int tile[MATRIX_GEMM_MR][MATRIX_GEMM_NR];
+    for(size_t r = 0; r < MATRIX_GEMM_MR; r++) {
+        _mm256_storeu_si256((__m256i *) &tile[r][0], accumulator[r][0]);
+        _mm256_storeu_si256((__m256i *) &tile[r][8], accumulator[r][1]);
+    }
+    m_gemmStoreTile_scalar(tile, c, ldc, mr, nr);
+}
+
+/**
+ * @note Counts bits with a nibble lookup table: VPSHUFB maps every 4-bit half of a byte to its population count, and VPSADBW sums the bytes of each 64-bit lane.  The AVX-512 table uses this variant as well, since plain AVX-512F has no byte shuffle.
+ */
+__attribute__((target("avx2,popcnt")))
+static uint64_t
+m_andPopcount_avx2(const uint64_t *a, const uint64_t *b, const size_t words) {
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_nibbles = _mm256_set1_epi8(0x0F);
+    __m256i sum = _mm256_setzero_si256();
+    size_t index = 0;
+    for(; index + 4 <= words; index += 4) {
+        const __m256i x = _mm256_and_si256(_mm256_loadu_si256((const __m256i *) (a + index)), _mm256_loadu_si256((const __m256i *) (b + index)));
+        const __m256i low = _mm256_shuffle_epi8(lookup, _mm256_and_si256(x, low_nibbles));
+        const __m256i high = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(x, 4), low_nibbles));
+        sum = _mm256_add_epi64(sum, _mm256_sad_epu8(_mm256_add_epi8(low, high), _mm256_setzero_si256()));
+    }
+    uint64_t count = (uint64_t) _mm256_extract_epi64(sum, 0) + (uint64_t) _mm256_extract_epi64(sum, 1)
+                   + (uint64_t) _mm256_extract_epi64(sum, 2) + (uint64_t) _mm256_extract_epi64(sum, 3);
+    for(; index < words; index++) {
+        count += (uint64_t) _mm_popcnt_u64(a[index] & b[index]);
+    }
+    return count;
+}
+
+
+/*************************** AVX-512 ************************/
+
+/**
+ * @note The AVX-512 variants handle the tail of an array with a masked load and store instead of a scalar loop.
+ */
+__attribute__((target("avx512f")))
+static __mmask16
+m_tailMask_avx512(const size_t remaining) {
+    return (remaining >= 16) ? (__mmask16) 0xFFFF : (__mmask16) ((1u << remaining) - 1u);
+}
+
+__attribute__((target("avx512f")))
+static void
+m_add_avx512(int *result, const int *a1, const int *a2, const size_t length) {
+    for(size_t index = 0; index < length; index += 16) {
+        const __mmask16 mask = m_tailMask_avx512(length - index);
+        const __m512i x = _mm512_maskz_loadu_epi32(mask, a1 + index);
+        const __m512i y = _mm512_maskz_loadu_epi32(mask, a2 + index);
+        _mm512_mask_storeu_epi32(result + index, mask, _mm512_add_epi32(x, y));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void
+m_subtract_avx512(int *result, const int *a1, const int *a2, const size_t length) {
+    for(size_t index = 0; index < length; index += 16) {
+        const __mmask16 mask = m_tailMask_avx512(length - index);
+        const __m512i x = _mm512_maskz_loadu_epi32(mask, a1 + index);
+        const __m512i y = _mm512_maskz_loadu_epi32(mask, a2 + index);
+        _mm512_mask_storeu_epi32(result + index, mask, _mm512_sub_epi32(x, y));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void
+m_multiply_avx512(int *result, const int *a1, const int *a2, const size_t length) {
+    for(size_t index = 0; index < length; index += 16) {
+        const __mmask16 mask = m_tailMask_avx512(length - index);
+        const __m512i x = _mm512_maskz_loadu_epi32(mask, a1 + index);
+        const __m512i y = _mm512_maskz_loadu_epi32(mask, a2 + index);
+        _mm512_mask_storeu_epi32(result + index, mask, _mm512_mullo_epi32(x, y));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void
+m_scalarAdd_avx512(int *array, const int scalar, const size_t length) {
+    const __m512i s = _mm512_set1_epi32(scalar);
+    for(size_t index = 0; index < length; index += 16) {
+        const __mmask16 mask = m_tailMask_avx512(length - index);
+        const __m512i x = _mm512_maskz_loadu_epi32(mask, array + index);
+        _mm512_mask_storeu_epi32(array + index, mask, _mm512_add_epi32(x, s));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void
+m_scalarMultiply_avx512(int *array, const int scalar, const size_t length) {
+    const __m512i s = _mm512_set1_epi32(scalar);
+    for(size_t index = 0; index < length; index += 16) {
+        const __mmask16 mask = m_tailMask_avx512(length - index);
+        const __m512i x = _mm512_maskz_loadu_epi32(mask, array + index);
+        _mm512_mask_storeu_epi32(array + index, mask, _mm512_mullo_epi32(x, s));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void
+m_axpy_avx512(int *y, const int scalar, const int *x, const size_t length) {
+    const __m512i s = _mm512_set1_epi32(scalar);
+    for(size_t index = 0; index < length; index += 16) {
+        const __mmask16 mask = m_tailMask_avx512(length - index);
+        const __m512i a = _mm512_maskz_loadu_epi32(mask, x + index);
+        const __m512i b = _mm512_maskz_loadu_epi32(mask, y + index);
+        _mm512_mask_storeu_epi32(y + index, mask, _mm512_add_epi32(b, _mm512_mullo_epi32(a, s)));
+    }
+}
+
+__attribute__((target("avx512f")))
+static int
+m_dotProduct_avx512(const int *a1, const int *a2, const size_t length) {
+    __m512i sum = _mm512_setzero_si512();
+    for(size_t index = 0; index < length; index += 16) {
+        const __mmask16 mask = m_tailMask_avx512(length - index);
+        const __m512i x = _mm512_maskz_loadu_epi32(mask, a1 + index);
+        const __m512i y = _mm512_maskz_loadu_epi32(mask, a2 + index);
+        sum = _mm512_add_epi32(sum, _mm512_mullo_epi32(x, y));
+    }
+    return _mm512_reduce_add_epi32(sum);
+}
+
+__attribute__((target("avx512f")))
+static void
+m_summarize_avx512(const int *array, const size_t length, matrix_rangeSummary_int_t *summary) {
+    __m512i bits = _mm512_setzero_si512();
+    __m512i sum = _mm512_setzero_si512();
+    __m512i minimum = _mm512_set1_epi32(INT_MAX);
+    __m512i maximum = _mm512_set1_epi32(INT_MIN);
+    for(size_t index = 0; index < length; index += 16) {
+        const __mmask16 mask = m_tailMask_avx512(length - index);
+        const __m512i x = _mm512_maskz_loadu_epi32(mask, array + index);
+        bits = _mm512_or_si512(bits, x);
+        sum = _mm512_add_epi64(sum, _mm512_cvtepi32_epi64(_mm512_castsi512_si256(x)));
+        sum = _mm512_add_epi64(sum, _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(x, 1)));
+        /* The zeros that the masked load puts past the end must not reach the range. */
+        minimum = _mm512_mask_min_epi32(minimum, mask, minimum, x);
+        maximum = _mm512_mask_max_epi32(maximum, mask, maximum, x);
+    }
+    summary->bits = (unsigned int) _mm512_reduce_or_epi32(bits);
+    summary->sum = _mm512_reduce_add_epi64(sum);
+    summary->minimum = _mm512_reduce_min_epi32(minimum);
+    summary->maximum = _mm512_reduce_max_epi32(maximum);
+}
+
+/**
+ * @note Masked loads of bytes and words need AVX-512BW, so the widening variants finish the tail with the scalar loop instead.
+ */
+__attribute__((target("avx512f")))
+static void
+m_widenInt8_avx512(int *destination, const int8_t *source, const size_t length) {
+    size_t index = 0;
+    for(; index + 16 <= length; index += 16) {
+        _mm512_storeu_si512(destination + index, _mm512_cvtepi8_epi32(_mm_loadu_si128((const __m128i *) (source + index))));
+    }
+    m_widenInt8_scalar(destination + index, source + index, length - index);
+}
+
+__attribute__((target("avx512f")))
+static void
+m_widenInt16_avx512(int *destination, const int16_t *source, const size_t length) {
+    size_t index = 0;
+    for(; index + 16 <= length; index += 16) {
+        _mm512_storeu_si512(destination + index, _mm512_cvtepi16_epi32(_mm256_loadu_si256((const __m256i *) (source + index))));
+    }
+    m_widenInt16_scalar(destination + index, source + index, length - index);
+}
+
+__attribute__((target("avx512f")))
+static void
+m_gemmMicro_avx512(const size_t kc, const int *a_panel, const int *b_panel, int *c, const size_t ldc, const size_t mr, const size_t nr) {
+    __m512i c0 = _mm512_setzero_si512();
+    __m512i c1 = _mm512_setzero_si512();
+    __m512i c2 = _mm512_setzero_si512();
+    __m512i c3 = _mm512_setzero_si512();
+    for(size_t k = 0; k < kc; k++) {
+        const __m512i b = _mm512_loadu_si512(b_panel);
+        c0 = _mm512_add_epi32(c0, _mm512_mullo_epi32(_mm512_set1_epi32(a_panel[0]), b));
+        c1 = _mm512_add_epi32(c1, _mm512_mullo_epi32(_mm512_set1_epi32(a_panel[1]), b));
+        c2 = _mm512_add_epi32(c2, _mm512_mullo_epi32(_mm512_set1_epi32(a_panel[2]), b));
+        c3 = _mm512_add_epi32(c3, _mm512_mullo_epi32(_mm512_set1_epi32(a_panel[3]), b));
+        a_panel += MATRIX_GEMM_MR;
+        b_panel += MATRIX_GEMM_NR;
+    }
+    const __m512i accumulator[MATRIX_GEMM_MR] = {c0, c1, c2, c3};
+    const __mmask16 mask = m_tailMask_avx512(nr);
+    for(size_t r = 0; r < mr; r++) {
+        int *destination = c + (r * ldc);
+        const __m512i current = _mm512_maskz_loadu_epi32(mask, destination);
+        _mm512_mask_storeu_epi32(destination, mask, _mm512_add_epi32(current, accumulator[r]));
+    }
+}
+
+
+__attribute__((target("avx512f,avx512vpopcntdq")))
+static uint64_t
+m_andPopcount_avx512vpopcntdq(const uint64_t *a, const uint64_t *b, const size_t words) {
+    __m512i sum = _mm512_setzero_si512();
+    for(size_t index = 0; index < words; index += 8) {
+        const __mmask8 mask = (words - index >= 8) ? (__mmask8) 0xFF : (__mmask8) ((1u << (words - index)) - 1u);
+        const __m512i x = _mm512_maskz_loadu_epi64(mask, a + index);
+        const __m512i y = _mm512_maskz_loadu_epi64(mask, b + index);
+        sum = _mm512_add_epi64(sum, _mm512_popcnt_epi64(_mm512_and_si512(x, y)));
+    }
+    return (uint64_t) _mm512_reduce_add_epi64(sum);
+}
+
+
+/*************************** SINGLE PRECISION ************************/
+
+static void
+m_addFloat_scalar(float *result, const float *a1, const float *a2, const size_t length) {
+    for(size_t index = 0; index < length; index++) {
+        result[index] = a1[index] + a2[index];
+    }
+}
+
+static void
+m_subtractFloat_scalar(float *result, const float *a1, const float *a2, const size_t length) {
+    for(size_t index = 0; index < length; index++) {
+        result[index] = a1[index] - a2[index];
+    }
+}
+
+static void
+m_scalarMultiplyFloat_scalar(float *array, const float scalar, const size_t length) {
+    for(size_t index = 0; index < length; index++) {
+        array[index] *= scalar;
+    }
+}
+
+static void
+m_axpyFloat_scalar(float *y, const float scalar, const float *x, const size_t length) {
+    for(size_t index = 0; index < length; index++) {
+        y[index] += scalar * x[index];
+    }
+}
+
+static float
+m_dotProductFloat_scalar(const float *a1, const float *a2, const size_t length) {
+    float product = 0;
+    for(size_t index = 0; index < length; index++) {
+        product += a1[index] * a2[index];
+    }
+    return product;
+}
+
+/**
+ * @brief Adds a finished MR x NR accumulator tile into the destination, writing only the mr x nr valid part.
+ */
+static void
+m_gemmStoreTileFloat_scalar(float accumulator[MATRIX_GEMM_MR_FLOAT][MATRIX_GEMM_NR_FLOAT], float *c, const size_t ldc, const size_t mr, const size_t nr) {
+    for(size_t r = 0; r < mr; r++) {
+        for(size_t column = 0; column < nr; column++) {
+            c[(r * ldc) + column] += accumulator[r][column];
+        }
+    }
+}
+
+static void
+m_gemmMicroFloat_scalar(const size_t kc, const float *a_panel, const float *b_panel, float *c, const size_t ldc, const size_t mr, const size_t nr) {
+    float accumulator[MATRIX_GEMM_MR_FLOAT][MATRIX_GEMM_NR_FLOAT] = {{0}};
+    for(size_t k = 0; k < kc; k++) {
+        for(size_t r = 0; r < MATRIX_GEMM_MR_FLOAT; r++) {
+            const float a_value = a_panel[r];
+            for(size_t column = 0; column < MATRIX_GEMM_NR_FLOAT; column++) {
+                accumulator[r][column] += a_value * b_panel[column];
+            }
+        }
+        a_panel += MATRIX_GEMM_MR_FLOAT;
+        b_panel += MATRIX_GEMM_NR_FLOAT;
+    }
+    m_gemmStoreTileFloat_scalar(accumulator, c, ldc, mr, nr);
+}
+
+/**
+ * @note The tails of the AVX2 axpy and dot product stay in the function, rather than going to the scalar variant, so that every multiply-add of an AVX2 kernel is fused.
+ */
+__attribute__((target("avx2,fma")))
+static void
+m_addFloat_avx2(float *result, const float *a1, const float *a2, const size_t length) {
+    size_t index = 0;
+    for(; index + 8 <= length; index += 8) {
+        _mm256_storeu_ps(result + index, _mm256_add_ps(_mm256_loadu_ps(a1 + index), _mm256_loadu_ps(a2 + index)));
+    }
+    m_addFloat_scalar(result + index, a1 + index, a2 + index, length - index);
+}
+
+__attribute__((target("avx2,fma")))
+static void
+m_subtractFloat_avx2(float *result, const float *a1, const float *a2, const size_t length) {
+    size_t index = 0;
+    for(; index + 8 <= length; index += 8) {
+        _mm256_storeu_ps(result + index, _mm256_sub_ps(_mm256_loadu_ps(a1 + index), _mm256_loadu_ps(a2 + index)));
+    }
+    m_subtractFloat_scalar(result + index, a1 + index, a2 + index, length - index);
+}
+
+__attribute__((target("avx2,fma")))
+static void
+m_scalarMultiplyFloat_avx2(float *array, const float scalar, const size_t length) {
+    const __m256 s = _mm256_set1_ps(scalar);
+    size_t index = 0;
+    for(; index + 8 <= length; index += 8) {
+        _mm256_storeu_ps(array + index, _mm256_mul_ps(_mm256_loadu_ps(array + index), s));
+    }
+    m_scalarMultiplyFloat_scalar(array + index, scalar, length - index);
+}
+
+__attribute__((target("avx2,fma")))
+static void
+m_axpyFloat_avx2(float *y, const float scalar, const float *x, const size_t length) {
+    const __m256 s = _mm256_set1_ps(scalar);
+    size_t index = 0;
+    for(; index + 8 <= length; index += 8) {
+        _mm256_storeu_ps(y + index, _mm256_fmadd_ps(s, _mm256_loadu_ps(x + index), _mm256_loadu_ps(y + index)));
+    }
+    for(; index < length; index++) {
+        y[index] = fmaf(scalar, x[index], y[index]);
+    }
+}
+
+__attribute__((target("avx2,fma")))
+static float
+m_dotProductFloat_avx2(const float *a1, const float *a2, const size_t length) {
+    __m256 sum = _mm256_setzero_ps();
+    size_t index = 0;
+    for(; index + 8 <= length; index += 8) {
+        sum = _mm256_fmadd_ps(_mm256_loadu_ps(a1 + index), _mm256_loadu_ps(a2 + index), sum);
+    }
+    __m128 half = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+    half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+    half = _mm_add_ss(half, _mm_movehdup_ps(half));
+    float product = _mm_cvtss_f32(half);
+    for(; index < length; index++) {
+        product = fmaf(a1[index], a2[index], product);
+    }
+    return product;
+}
+
+__attribute__((target("avx2,fma")))
+static void
+m_gemmMicroFloat_avx2(const size_t kc, const float *a_panel, const float *b_panel, float *c, const size_t ldc, const size_t mr, const size_t nr) {
+    __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+    __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+    __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+    __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+    __m256 c40 = _mm256_setzero_ps(), c41 = _mm256_setzero_ps();
+    __m256 c50 = _mm256_setzero_ps(), c51 = _mm256_setzero_ps();
+    for(size_t k = 0; k < kc; k++) {
+        const __m256 b0 = _mm256_loadu_ps(b_panel);
+        const __m256 b1 = _mm256_loadu_ps(b_panel + 8);
+        __m256 a = _mm256_broadcast_ss(a_panel);
+        c00 = _mm256_fmadd_ps(a, b0, c00);
+        c01 = _mm256_fmadd_ps(a, b1, c01);
+        a = _mm256_broadcast_ss(a_panel + 1);
+        c10 = _mm256_fmadd_ps(a, b0, c10);
+        c11 = _mm256_fmadd_ps(a, b1, c11);
+        a = _mm256_broadcast_ss(a_panel + 2);
+        c20 = _mm256_fmadd_ps(a, b0, c20);
+        c21 = _mm256_fmadd_ps(a, b1, c21);
+        a = _mm256_broadcast_ss(a_panel + 3);
+        c30 = _mm256_fmadd_ps(a, b0, c30);
+        c31 = _mm256_fmadd_ps(a, b1, c31);
+        a = _mm256_broadcast_ss(a_panel + 4);
+        c40 = _mm256_fmadd_ps(a, b0, c40);
+        c41 = _mm256_fmadd_ps(a, b1, c41);
+        a = _mm256_broadcast_ss(a_panel + 5);
+        c50 = _mm256_fmadd_ps(a, b0, c50);
+        c51 = _mm256_fmadd_ps(a, b1, c51);
+        a_panel += MATRIX_GEMM_MR_FLOAT;
+        b_panel += MATRIX_GEMM_NR_FLOAT;
+    }
+    const __m256 accumulator[MATRIX_GEMM_MR_FLOAT][2] = {{c00, c01}, {c10, c11}, {c20, c21}, {c30, c31}, {c40, c41}, {c50, c51}};
+    if((MATRIX_GEMM_MR_FLOAT == mr) && (MATRIX_GEMM_NR_FLOAT == nr)) {
+        for(size_t r = 0; r < MATRIX_GEMM_MR_FLOAT; r++) {
+            float *destination = c + (r * ldc);
+            _mm256_storeu_ps(destination, _mm256_add_ps(_mm256_loadu_ps(destination), accumulator[r][0]));
+            _mm256_storeu_ps(destination + 8, _mm256_add_ps(_mm256_loadu_ps(destination + 8), accumulator[r][1]));
+        }
+        return;
+    }
+    float tile[MATRIX_GEMM_MR_FLOAT][MATRIX_GEMM_NR_FLOAT];
+    for(size_t r = 0; r < MATRIX_GEMM_MR_FLOAT; r++) {
+        _mm256_storeu_ps(&tile[r][0], accumulator[r][0]);
+        _mm256_storeu_ps(&tile[r][8], accumulator[r][1]);
+    }
+    m_gemmStoreTileFloat_scalar(tile, c, ldc, mr, nr);
+}
+
+__attribute__((target("avx512f")))
+static void
+m_addFloat_avx512(float *result, const float *a1, const float *a2, const size_t length) {
+    for(size_t index = 0; index < length; index += 16) {
+        const __mmask16 mask = m_tailMask_avx512(length - index);
+        _mm512_mask_storeu_ps(result + index, mask, _mm512_add_ps(_mm512_maskz_loadu_ps(mask, a1 + index), _mm512_maskz_loadu_ps(mask, a2 + index)));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void
+m_subtractFloat_avx512(float *result, const float *a1, const float *a2, const size_t length) {
+    for(size_t index = 0; index < length; index += 16) {
+        const __mmask16 mask = m_tailMask_avx512(length - index);
+        _mm512_mask_storeu_ps(result + index, mask, _mm512_sub_ps(_mm512_maskz_loadu_ps(mask, a1 + index), _mm512_maskz_loadu_ps(mask, a2 + index)));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void
+m_scalarMultiplyFloat_avx512(float *array, const float scalar, const size_t length) {
+    const __m512 s = _mm512_set1_ps(scalar);
+    for(size_t index = 0; index < length; index += 16) {
+        const __mmask16 mask = m_tailMask_avx512(length - index);
+        _mm512_mask_storeu_ps(array + index, mask, _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, array + index), s));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void
+m_axpyFloat_avx512(float *y, const float scalar, const float *x, const size_t length) {
+    const __m512 s = _mm512_set1_ps(scalar);
+    for(size_t index = 0; index < length; index += 16) {
+        const __mmask16 mask = m_tailMask_avx512(length - index);
+        const __m512 a = _mm512_maskz_loadu_ps(mask, x + index);
+        const __m512 b = _mm512_maskz_loadu_ps(mask, y + index);
+        _mm512_mask_storeu_ps(y + index, mask, _mm512_fmadd_ps(s, a, b));
+    }
+}
+
+__attribute__((target("avx512f")))
+static float
+m_dotProductFloat_avx512(const float *a1, const float *a2, const size_t length) {
+    __m512 sum = _mm512_setzero_ps();
+    for(size_t index = 0; index < length; index += 16) {
+        const __mmask16 mask = m_tailMask_avx512(length - index);
+        sum = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, a1 + index), _mm512_maskz_loadu_ps(mask, a2 + index), sum);
+    }
+    return _mm512_reduce_add_ps(sum);
+}
+
+__attribute__((target("avx512f")))
+static void
+m_gemmMicroFloat_avx512(const size_t kc, const float *a_panel, const float *b_panel, float *c, const size_t ldc, const size_t mr, const size_t nr) {
+    __m512 c0 = _mm512_setzero_ps(), c1 = _mm512_setzero_ps(), c2 = _mm512_setzero_ps();
+    __m512 c3 = _mm512_setzero_ps(), c4 = _mm512_setzero_ps(), c5 = _mm512_setzero_ps();
+    for(size_t k = 0; k < kc; k++) {
+        const __m512 b = _mm512_loadu_ps(b_panel);
+        c0 = _mm512_fmadd_ps(_mm512_set1_ps(a_panel[0]), b, c0);
+        c1 = _mm512_fmadd_ps(_mm512_set1_ps(a_panel[1]), b, c1);
+        c2 = _mm512_fmadd_ps(_mm512_set1_ps(a_panel[2]), b, c2);
+        c3 = _mm512_fmadd_ps(_mm512_set1_ps(a_panel[3]), b, c3);
+        c4 = _mm512_fmadd_ps(_mm512_set1_ps(a_panel[4]), b, c4);
+        c5 = _mm512_fmadd_ps(_mm512_set1_ps(a_panel[5]), b, c5);
+        a_panel += MATRIX_GEMM_MR_FLOAT;
+        b_panel += MATRIX_GEMM_NR_FLOAT;
+    }
+    const __m512 accumulator[MATRIX_GEMM_MR_FLOAT] = {c0, c1, c2, c3, c4, c5};
+    const __mmask16 mask = m_tailMask_avx512(nr);
+    for(size_t r = 0; r < mr; r++) {
+        float *destination = c + (r * ldc);
+        const __m512 current = _mm512_maskz_loadu_ps(mask, destination);
+        _mm512_mask_storeu_ps(destination, mask, _mm512_add_ps(current, accumulator[r]));
+    }
+}
+
+
+/*************************** DOUBLE PRECISION ************************/
+
+static void
+m_addDouble_scalar(double *result, const double *a1, const double *a2, const size_t length) {
+    for(size_t index = 0; index < length; index++) {
+        result[index] = a1[index] + a2[index];
+    }
+}
+
+static void
+m_subtractDouble_scalar(double *result, const double *a1, const double *a2, const size_t length) {
+    for(size_t index = 0; index < length; index++) {
+        result[index] = a1[index] - a2[index];
+    }
+}
+
+static void
+m_scalarMultiplyDouble_scalar(double *array, const double scalar, const size_t length) {
+    for(size_t index = 0; index < length; index++) {
+        array[index] *= scalar;
+    }
+}
+
+static void
+m_axpyDouble_scalar(double *y, const double scalar, const double *x, const size_t length) {
+    for(size_t index = 0; index < length; index++) {
+        y[index] += scalar * x[index];
+    }
+}
+
+static double
+m_dotProductDouble_scalar(const double *a1, const double *a2, const size_t length) {
+    double product = 0;
+    for(size_t index = 0; index < length; index++) {
+        product += a1[index] * a2[index];
+    }
+    return product;
+}
+
+static void
+m_gemmStoreTileDouble_scalar(double accumulator[MATRIX_GEMM_MR_DOUBLE][MATRIX_GEMM_NR_DOUBLE], double *c, const size_t ldc, const size_t mr, const size_t nr) {
+    for(size_t r = 0; r < mr; r++) {
+        for(size_t column = 0; column < nr; column++) {
+            c[(r * ldc) + column] += accumulator[r][column];
+        }
+    }
+}
+
+static void
+m_gemmMicroDouble_scalar(const size_t kc, const double *a_panel, const double *b_panel, double *c, const size_t ldc, const size_t mr, const size_t nr) {
+    double accumulator[MATRIX_GEMM_MR_DOUBLE][MATRIX_GEMM_NR_DOUBLE] = {{0}};
+    for(size_t k = 0; k < kc; k++) {
+        for(size_t r = 0; r < MATRIX_GEMM_MR_DOUBLE; r++) {
+            const double a_value = a_panel[r];
+            for(size_t column = 0; column < MATRIX_GEMM_NR_DOUBLE; column++) {
+                accumulator[r][column] += a_value * b_panel[column];
+            }
+        }
+        a_panel += MATRIX_GEMM_MR_DOUBLE;
+        b_panel += MATRIX_GEMM_NR_DOUBLE;
+    }
+    m_gemmStoreTileDouble_scalar(accumulator, c, ldc, mr, nr);
+}
+
+__attribute__((target("avx2,fma")))
+static void
+m_addDouble_avx2(double *result, const double *a1, const double *a2, const size_t length) {
+    size_t index = 0;
+    for(; index + 4 <= length; index += 4) {
+        _mm256_storeu_pd(result + index, _mm256_add_pd(_mm256_loadu_pd(a1 + index), _mm256_loadu_pd(a2 + index)));
+    }
+    m_addDouble_scalar(result + index, a1 + index, a2 + index, length - index);
+}
+
+__attribute__((target("avx2,fma")))
+static void
+m_subtractDouble_avx2(double *result, const double *a1, const double *a2, const size_t length) {
+    size_t index = 0;
+    for(; index + 4 <= length; index += 4) {
+        _mm256_storeu_pd(result + index, _mm256_sub_pd(_mm256_loadu_pd(a1 + index), _mm256_loadu_pd(a2 + index)));
+    }
+    m_subtractDouble_scalar(result + index, a1 + index, a2 + index, length - index);
+}
+
+__attribute__((target("avx2,fma")))
+static void
+m_scalarMultiplyDouble_avx2(double *array, const double scalar, const size_t length) {
+    const __m256d s = _mm256_set1_pd(scalar);
+    size_t index = 0;
+    for(; index + 4 <= length; index += 4) {
+        _mm256_storeu_pd(array + index, _mm256_mul_pd(_mm256_loadu_pd(array + index), s));
+    }
+    m_scalarMultiplyDouble_scalar(array + index, scalar, length - index);
+}
+
+__attribute__((target("avx2,fma")))
+static void
+m_axpyDouble_avx2(double *y, const double scalar, const double *x, const size_t length) {
+    const __m256d s = _mm256_set1_pd(scalar);
+    size_t index = 0;
+    for(; index + 4 <= length; index += 4) {
+        _mm256_storeu_pd(y + index, _mm256_fmadd_pd(s, _mm256_loadu_pd(x + index), _mm256_loadu_pd(y + index)));
+    }
+    for(; index < length; index++) {
+        y[index] = fma(scalar, x[index], y[index]);
+    }
+}
+
+__attribute__((target("avx2,fma")))
+static double
+m_dotProductDouble_avx2(const double *a1, const double *a2, const size_t length) {
+    __m256d sum = _mm256_setzero_pd();
+    size_t index = 0;
+    for(; index + 4 <= length; index += 4) {
+        sum = _mm256_fmadd_pd(_mm256_loadu_pd(a1 + index), _mm256_loadu_pd(a2 + index), sum);
+    }
+    __m128d half = _mm_add_pd(_mm256_castpd256_pd128(sum), _mm256_extractf128_pd(sum, 1));
+    half = _mm_add_sd(half, _mm_unpackhi_pd(half, half));
+    double product = _mm_cvtsd_f64(half);
+    for(; index < length; index++) {
+        product = fma(a1[index], a2[index], product);
+    }
+    return product;
+}
+
+__attribute__((target("avx2,fma")))
+static void
+m_gemmMicroDouble_avx2(const size_t kc, const double *a_panel, const double *b_panel, double *c, const size_t ldc, const size_t mr, const size_t nr) {
+    __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+    __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+    __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+    __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+    __m256d c40 = _mm256_setzero_pd(), c41 = _mm256_setzero_pd();
+    __m256d c50 = _mm256_setzero_pd(), c51 = _mm256_setzero_pd();
+    for(size_t k = 0; k < kc; k++) {
+        const __m256d b0 = _mm256_loadu_pd(b_panel);
+        const __m256d b1 = _mm256_loadu_pd(b_panel + 4);
+        __m256d a = _mm256_broadcast_sd(a_panel);
+        c00 = _mm256_fmadd_pd(a, b0, c00);
+        c01 = _mm256_fmadd_pd(a, b1, c01);
+        a = _mm256_broadcast_sd(a_panel + 1);
+        c10 = _mm256_fmadd_pd(a, b0, c10);
+        c11 = _mm256_fmadd_pd(a, b1, c11);
+        a = _mm256_broadcast_sd(a_panel + 2);
+        c20 = _mm256_fmadd_pd(a, b0, c20);
+        c21 = _mm256_fmadd_pd(a, b1, c21);
+        a = _mm256_broadcast_sd(a_panel + 3);
+        c30 = _mm256_fmadd_pd(a, b0, c30);
+        c31 = _mm256_fmadd_pd(a, b1, c31);
+        a = _mm256_broadcast_sd(a_panel + 4);
+        c40 = _mm256_fmadd_pd(a, b0, c40);
+        c41 = _mm256_fmadd_pd(a, b1, c41);
+        a = _mm256_broadcast_sd(a_panel + 5);
+        c50 = _mm256_fmadd_pd(a, b0, c50);
+        c51 = _mm256_fmadd_pd(a, b1, c51);
+        a_panel += MATRIX_GEMM_MR_DOUBLE;
+        b_panel += MATRIX_GEMM_NR_DOUBLE;
+    }
+    const __m256d accumulator[MATRIX_GEMM_MR_DOUBLE][2] = {{c00, c01}, {c10, c11}, {c20, c21}, {c30, c31}, {c40, c41}, {c50, c51}};
+    if((MATRIX_GEMM_MR_DOUBLE == mr) && (MATRIX_GEMM_NR_DOUBLE == nr)) {
+        for(size_t r = 0; r < MATRIX_GEMM_MR_DOUBLE; r++) {
+            double *destination = c + (r * ldc);
+            _mm256_storeu_pd(destination, _mm256_add_pd(_mm256_loadu_pd(destination), accumulator[r][0]));
+            _mm256_storeu_pd(destination + 4, _mm256_add_pd(_mm256_loadu_pd(destination + 4), accumulator[r][1]));
+        }
+        return;
+    }
+    double tile[MATRIX_GEMM_MR_DOUBLE][MATRIX_GEMM_NR_DOUBLE];
+    for(size_t r = 0; r < MATRIX_GEMM_MR_DOUBLE; r++) {
+        _mm256_storeu_pd(&tile[r][0], accumulator[r][0]);
+        _mm256_storeu_pd(&tile[r][4], accumulator[r][1]);
+    }
+    m_gemmStoreTileDouble_scalar(tile, c, ldc, mr, nr);
+}
+
+/**
+ * @brief The mask of the first min(remaining, 8) lanes of an AVX-512 vector of doubles.
+ */
+__attribute__((target("avx512f")))
+static __mmask8
+m_tailMask8_avx512(const size_t remaining) {
+    return (remaining >= 8) ? (__mmask8) 0xFF : (__mmask8) ((1u << remaining) - 1u);
+}
+
+__attribute__((target("avx512f")))
+static void
+m_addDouble_avx512(double *result, const double *a1, const double *a2, const size_t length) {
+    for(size_t index = 0; index < length; index += 8) {
+        const __mmask8 mask = m_tailMask8_avx512(length - index);
+        _mm512_mask_storeu_pd(result + index, mask, _mm512_add_pd(_mm512_maskz_loadu_pd(mask, a1 + index), _mm512_maskz_loadu_pd(mask, a2 + index)));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void
+m_subtractDouble_avx512(double *result, const double *a1, const double *a2, const size_t length) {
+    for(size_t index = 0; index < length; index += 8) {
+        const __mmask8 mask = m_tailMask8_avx512(length - index);
+        _mm512_mask_storeu_pd(result + index, mask, _mm512_sub_pd(_mm512_maskz_loadu_pd(mask, a1 + index), _mm512_maskz_loadu_pd(mask, a2 + index)));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void
+m_scalarMultiplyDouble_avx512(double *array, const double scalar, const size_t length) {
+    const __m512d s = _mm512_set1_pd(scalar);
+    for(size_t index = 0; index < length; index += 8) {
+        const __mmask8 mask = m_tailMask8_avx512(length - index);
+        _mm512_mask_storeu_pd(array + index, mask, _mm512_mul_pd(_mm512_maskz_loadu_pd(mask, array + index), s));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void
+m_axpyDouble_avx512(double *y, const double scalar, const double *x, const size_t length) {
+    const __m512d s = _mm512_set1_pd(scalar);
+    for(size_t index = 0; index < length; index += 8) {
+        const __mmask8 mask = m_tailMask8_avx512(length - index);
+        const __m512d a = _mm512_maskz_loadu_pd(mask, x + index);
+        const __m512d b = _mm512_maskz_loadu_pd(mask, y + index);
+        _mm512_mask_storeu_pd(y + index, mask, _mm512_fmadd_pd(s, a, b));
+    }
+}
+
+__attribute__((target("avx512f")))
+static double
+m_dotProductDouble_avx512(const double *a1, const double *a2, const size_t length) {
+    __m512d sum = _mm512_setzero_pd();
+    for(size_t index = 0; index < length; index += 8) {
+        const __mmask8 mask = m_tailMask8_avx512(length - index);
+        sum = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask, a1 + index), _mm512_maskz_loadu_pd(mask, a2 + index), sum);
+    }
+    return _mm512_reduce_add_pd(sum);
+}
+
+__attribute__((target("avx512f")))
+static void
+m_gemmMicroDouble_avx512(const size_t kc, const double *a_panel, const double *b_panel, double *c, const size_t ldc, const size_t mr, const size_t nr) {
+    __m512d c0 = _mm512_setzero_pd(), c1 = _mm512_setzero_pd(), c2 = _mm512_setzero_pd();
+    __m512d c3 = _mm512_setzero_pd(), c4 = _mm512_setzero_pd(), c5 = _mm512_setzero_pd();
+    for(size_t k = 0; k < kc; k++) {
+        const __m512d b = _mm512_loadu_pd(b_panel);
+        c0 = _mm512_fmadd_pd(_mm512_set1_pd(a_panel[0]), b, c0);
+        c1 = _mm512_fmadd_pd(_mm512_set1_pd(a_panel[1]), b, c1);
+        c2 = _mm512_fmadd_pd(_mm512_set1_pd(a_panel[2]), b, c2);
+        c3 = _mm512_fmadd_pd(_mm512_set1_pd(a_panel[3]), b, c3);
+        c4 = _mm512_fmadd_pd(_mm512_set1_pd(a_panel[4]), b, c4);
+        c5 = _mm512_fmadd_pd(_mm512_set1_pd(a_panel[5]), b, c5);
+        a_panel += MATRIX_GEMM_MR_DOUBLE;
+        b_panel += MATRIX_GEMM_NR_DOUBLE;
+    }
+    const __m512d accumulator[MATRIX_GEMM_MR_DOUBLE] = {c0, c1, c2, c3, c4, c5};
+    const __mmask8 mask = m_tailMask8_avx512(nr);
+    for(size_t r = 0; r < mr; r++) {
+        double *destination = c + (r * ldc);
+        const __m512d current = _mm512_maskz_loadu_pd(mask, destination);
+        _mm512_mask_storeu_pd(destination, mask, _mm512_add_pd(current, accumulator[r]));
+    }
+}
+
+
+/*************************** MIXED PRECISION ************************/
+
+/**
+ * @brief Adds an accumulated MATRIX_GEMM_MR_LOWP x MATRIX_GEMM_NR_LOWP tile to the mr x nr tile at c, wrapping modulo 2^32.
+ */
+static void
+m_gemmStoreTileLowp_scalar(uint32_t accumulator[MATRIX_GEMM_MR_LOWP][MATRIX_GEMM_NR_LOWP], int *c, const size_t ldc, const size_t mr, const size_t nr) {
+    for(size_t r = 0; r < mr; r++) {
+        for(size_t column = 0; column < nr; column++) {
+            c[(r * ldc) + column] = (int) ((uint32_t) c[(r * ldc) + column] + accumulator[r][column]);
+        }
+    }
+}
+
+/**
+ * @brief The emulation of VPDPBUSD: each 32-bit lane adds the four products of an unsigned byte of the first panel and a signed byte of the second.  The four products cannot overflow, and the accumulation is unsigned so that it wraps.
+ */
+static void
+m_gemmMicroInt8_scalar(const size_t groups, const void *a_panel, const void *b_panel, int *c, const size_t ldc, const size_t mr, const size_t nr) {
+    const uint8_t *a = a_panel;
+    const int8_t *b = b_panel;
+    uint32_t accumulator[MATRIX_GEMM_MR_LOWP][MATRIX_GEMM_NR_LOWP] = {{0}};
+    for(size_t group = 0; group < groups; group++) {
+        for(size_t r = 0; r < MATRIX_GEMM_MR_LOWP; r++) {
+            const uint8_t *a_group = a + (r * MATRIX_LOWP_GROUP_BYTES);
+            for(size_t column = 0; column < MATRIX_GEMM_NR_LOWP; column++) {
+                const int8_t *b_group = b + (column * MATRIX_LOWP_GROUP_BYTES);
+                const int32_t sum = (a_group[0] * b_group[0]) + (a_group[1] * b_group[1]) + (a_group[2] * b_group[2]) + (a_group[3] * b_group[3]);
+                accumulator[r][column] += (uint32_t) sum;
+            }
+        }
+        a += MATRIX_GEMM_MR_LOWP * MATRIX_LOWP_GROUP_BYTES;
+        b += MATRIX_GEMM_NR_LOWP * MATRIX_LOWP_GROUP_BYTES;
+    }
+    m_gemmStoreTileLowp_scalar(accumulator, c, ldc, mr, nr);
+}
+
+/**
+ * @brief The emulation of VPDPWSSD: each 32-bit lane adds the two products of a pair of signed 16-bit values.  Two products of -32768 x -32768 overflow an int, so they are added unsigned.
+ */
+static void
+m_gemmMicroInt16_scalar(const size_t groups, const void *a_panel, const void *b_panel, int *c, const size_t ldc, const size_t mr, const size_t nr) {
+    const int16_t *a = a_panel;
+    const int16_t *b = b_panel;
+    uint32_t accumulator[MATRIX_GEMM_MR_LOWP][MATRIX_GEMM_NR_LOWP] = {{0}};
+    for(size_t group = 0; group < groups; group++) {
+        for(size_t r = 0; r < MATRIX_GEMM_MR_LOWP; r++) {
+            const int16_t *a_group = a + (r * 2);
+            for(size_t column = 0; column < MATRIX_GEMM_NR_LOWP; column++) {
+                const int16_t *b_group = b + (column * 2);
+                accumulator[r][column] += (uint32_t) (a_group[0] * b_group[0]) + (uint32_t) (a_group[1] * b_group[1]);
+            }
+        }
+        a += MATRIX_GEMM_MR_LOWP * 2;
+        b += MATRIX_GEMM_NR_LOWP * 2;
+    }
+    m_gemmStoreTileLowp_scalar(accumulator, c, ldc, mr, nr);
+}
+
+static void
+m_widenBf16_scalar(float *destination, const uint16_t *source, const size_t length) {
+    for(size_t index = 0; index < length; index++) {
+        destination[index] = m_bfloat16ToFloat(source[index]);
+    }
+}
+
+static void
+m_narrowBf16_scalar(uint16_t *destination, const float *source, const size_t length) {
+    for(size_t index = 0; index < length; index++) {
+        destination[index] = m_floatToBfloat16(source[index]);
+    }
+}
+
+static void
+m_widenFp16_scalar(float *destination, const uint16_t *source, const size_t length) {
+    for(size_t index = 0; index < length; index++) {
+        destination[index] = m_halfToFloat(source[index]);
+    }
+}
+
+static void
+m_narrowFp16_scalar(uint16_t *destination, const float *source, const size_t length) {
+    for(size_t index = 0; index < length; index++) {
+        destination[index] = m_floatToHalf(source[index]);
+    }
+}
+
+__attribute__((target("avx2")))
+static void
+m_widenBf16_avx2(float *destination, const uint16_t *source, const size_t length) {
+    size_t index = 0;
+    for(; index + 8 <= length; index += 8) {
+        const __m256i wide = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*) (source + index)));
+        _mm256_storeu_ps(destination + index, _mm256_castsi256_ps(_mm256_slli_epi32(wide, 16)));
+    }
+    m_widenBf16_scalar(destination + index, source + index, length - index);
+}
+
+/**
+ * @note Rounds to nearest even by adding 0x7FFF plus the lowest kept bit before truncating, as m_floatToBfloat16 does, and quiets NaNs instead of letting the addition carry them into infinity.
+ */
+__attribute__((target("avx2")))
+static void
+m_narrowBf16_avx2(uint16_t *destination, const float *source, const size_t length) {
+    const __m256i magnitude_mask = _mm256_set1_epi32(0x7FFFFFFF);
+    const __m256i infinity = _mm256_set1_epi32(0x7F800000);
+    const __m256i rounding = _mm256_set1_epi32(0x7FFF);
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i quiet = _mm256_set1_epi32(0x0040);
+    size_t index = 0;
+    for(; index + 8 <= length; index += 8) {
+        const __m256i bits = _mm256_castps_si256(_mm256_loadu_ps(source + index));
+        const __m256i nan = _mm256_cmpgt_epi32(_mm256_and_si256(bits, magnitude_mask), infinity);
+        const __m256i odd = _mm256_and_si256(_mm256_srli_epi32(bits, 16), one);
+        const __m256i rounded = _mm256_srli_epi32(_mm256_add_epi32(bits, _mm256_add_epi32(rounding, odd)), 16);
+        const __m256i quieted = _mm256_or_si256(_mm256_srli_epi32(bits, 16), quiet);
+        const __m256i result = _mm256_blendv_epi8(rounded, quieted, nan);
+        _mm_storeu_si128((__m128i*) (destination + index), _mm_packus_epi32(_mm256_castsi256_si128(result), _mm256_extracti128_si256(result, 1)));
+    }
+    m_narrowBf16_scalar(destination + index, source + index, length - index);
+}
+
+__attribute__((target("avx2,f16c")))
+static void
+m_widenFp16_avx2(float *destination, const uint16_t *source, const size_t length) {
+    size_t index = 0;
+    for(; index + 8 <= length; index += 8) {
+        _mm256_storeu_ps(destination + index, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*) (source + index))));
+    }
+    m_widenFp16_scalar(destination + index, source + index, length - index);
+}
+
+__attribute__((target("avx2,f16c")))
+static void
+m_narrowFp16_avx2(uint16_t *destination, const float *source, const size_t length) {
+    size_t index = 0;
+    for(; index + 8 <= length; index += 8) {
+        _mm_storeu_si128((__m128i*) (destination + index), _mm256_cvtps_ph(_mm256_loadu_ps(source + index), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+    }
+    m_narrowFp16_scalar(destination + index, source + index, length - index);
+}
+
+/**
+ * @brief Broadcasts one 4-byte group of a packed panel to every lane.
+ */
+__attribute__((target("avx512f")))
+static __m512i
+m_broadcastGroup_avx512(const uint8_t *group) {
+    int32_t value;
+    memcpy(&value, group, sizeof(value));
+    return _mm512_set1_epi32(value);
+}
+
+/**
+ * @brief Adds an accumulated MATRIX_GEMM_MR_LOWP x MATRIX_GEMM_NR_LOWP tile of int32 lanes to the mr x nr tile at c.  Each row is two vectors of 16 columns.
+ */
+__attribute__((target("avx512f")))
+static void
+m_gemmStoreTileLowp_avx512(const __m512i accumulator[MATRIX_GEMM_MR_LOWP][2], int *c, const size_t ldc, const size_t mr, const size_t nr) {
+    const __mmask16 mask0 = m_tailMask_avx512(nr);
+    const __mmask16 mask1 = m_tailMask_avx512((nr > 16) ? (nr - 16) : 0);
+    for(size_t r = 0; r < mr; r++) {
+        int *destination = c + (r * ldc);
+        _mm512_mask_storeu_epi32(destination, mask0, _mm512_add_epi32(_mm512_maskz_loadu_epi32(mask0, destination), accumulator[r][0]));
+        _mm512_mask_storeu_epi32(destination + 16, mask1, _mm512_add_epi32(_mm512_maskz_loadu_epi32(mask1, destination + 16), accumulator[r][1]));
+    }
+}
+
+/**
+ * @note Each group of the second panel is two vectors of 16 columns, and every broadcast group of the first panel feeds two VPDPBUSD, so a row of the tile needs one broadcast for 128 multiply-adds.
+ */
+__attribute__((target("avx512f,avx512vnni")))
+static void
+m_gemmMicroInt8_avx512vnni(const size_t groups, const void *a_panel, const void *b_panel, int *c, const size_t ldc, const size_t mr, const size_t nr) {
+    const uint8_t *a = a_panel;
+    const uint8_t *b = b_panel;
+    __m512i c00 = _mm512_setzero_si512(), c01 = _mm512_setzero_si512(), c10 = _mm512_setzero_si512(), c11 = _mm512_setzero_si512();
+    __m512i c20 = _mm512_setzero_si512(), c21 = _mm512_setzero_si512(), c30 = _mm512_setzero_si512(), c31 = _mm512_setzero_si512();
+    __m512i c40 = _mm512_setzero_si512(), c41 = _mm512_setzero_si512(), c50 = _mm512_setzero_si512(), c51 = _mm512_setzero_si512();
+    __m512i c60 = _mm512_setzero_si512(), c61 = _mm512_setzero_si512(), c70 = _mm512_setzero_si512(), c71 = _mm512_setzero_si512();
+    for(size_t group = 0; group < groups; group++) {
+        const __m512i b0 = _mm512_loadu_si512(b);
+        const __m512i b1 = _mm512_loadu_si512(b + 64);
+        __m512i a_group = m_broadcastGroup_avx512(a);
+        c00 = _mm512_dpbusd_epi32(c00, a_group, b0);
+        c01 = _mm512_dpbusd_epi32(c01, a_group, b1);
+        a_group = m_broadcastGroup_avx512(a + 4);
+        c10 = _mm512_dpbusd_epi32(c10, a_group, b0);
+        c11 = _mm512_dpbusd_epi32(c11, a_group, b1);
+        a_group = m_broadcastGroup_avx512(a + 8);
+        c20 = _mm512_dpbusd_epi32(c20, a_group, b0);
+        c21 = _mm512_dpbusd_epi32(c21, a_group, b1);
+        a_group = m_broadcastGroup_avx512(a + 12);
+        c30 = _mm512_dpbusd_epi32(c30, a_group, b0);
+        c31 = _mm512_dpbusd_epi32(c31, a_group, b1);
+        a_group = m_broadcastGroup_avx512(a + 16);
+        c40 = _mm512_dpbusd_epi32(c40, a_group, b0);
+        c41 = _mm512_dpbusd_epi32(c41, a_group, b1);
+        a_group = m_broadcastGroup_avx512(a + 20);
+        c50 = _mm512_dpbusd_epi32(c50, a_group, b0);
+        c51 = _mm512_dpbusd_epi32(c51, a_group, b1);
+        a_group = m_broadcastGroup_avx512(a + 24);
+        c60 = _mm512_dpbusd_epi32(c60, a_group, b0);
+        c61 = _mm512_dpbusd_epi32(c61, a_group, b1);
+        a_group = m_broadcastGroup_avx512(a + 28);
+        c70 = _mm512_dpbusd_epi32(c70, a_group, b0);
+        c71 = _mm512_dpbusd_epi32(c71, a_group, b1);
+        a += MATRIX_GEMM_MR_LOWP * MATRIX_LOWP_GROUP_BYTES;
+        b += MATRIX_GEMM_NR_LOWP * MATRIX_LOWP_GROUP_BYTES;
+    }
+    const __m512i accumulator[MATRIX_GEMM_MR_LOWP][2] = {{c00, c01}, {c10, c11}, {c20, c21}, {c30, c31}, {c40, c41}, {c50, c51}, {c60, c61}, {c70, c71}};
+    m_gemmStoreTileLowp_avx512(accumulator, c, ldc, mr, nr);
+}
+
+__attribute__((target("avx512f,avx512vnni")))
+static void
+m_gemmMicroInt16_avx512vnni(const size_t groups, const void *a_panel, const void *b_panel, int *c, const size_t ldc, const size_t mr, const size_t nr) {
+    const uint8_t *a = a_panel;
+    const uint8_t *b = b_panel;
+    __m512i c00 = _mm512_setzero_si512(), c01 = _mm512_setzero_si512(), c10 = _mm512_setzero_si512(), c11 = _mm512_setzero_si512();
+    __m512i c20 = _mm512_setzero_si512(), c21 = _mm512_setzero_si512(), c30 = _mm512_setzero_si512(), c31 = _mm512_setzero_si512();
+    __m512i c40 = _mm512_setzero_si512(), c41 = _mm512_setzero_si512(), c50 = _mm512_setzero_si512(), c51 = _mm512_setzero_si512();
+    __m512i c60 = _mm512_setzero_si512(), c61 = _mm512_setzero_si512(), c70 = _mm512_setzero_si512(), c71 = _mm512_setzero_si512();
+    for(size_t group = 0; group < groups; group++) {
+        const __m512i b0 = _mm512_loadu_si512(b);
+        const __m512i b1 = _mm512_loadu_si512(b + 64);
+        __m512i a_group = m_broadcastGroup_avx512(a);
+        c00 = _mm512_dpwssd_epi32(c00, a_group, b0);
+        c01 = _mm512_dpwssd_epi32(c01, a_group, b1);
+        a_group = m_broadcastGroup_avx512(a + 4);
+        c10 = _mm512_dpwssd_epi32(c10, a_group, b0);
+        c11 = _mm512_dpwssd_epi32(c11, a_group, b1);
+        a_group = m_broadcastGroup_avx512(a + 8);
+        c20 = _mm512_dpwssd_epi32(c20, a_group, b0);
+        c21 = _mm512_dpwssd_epi32(c21, a_group, b1);
+        a_group = m_broadcastGroup_avx512(a + 12);
+        c30 = _mm512_dpwssd_epi32(c30, a_group, b0);
+        c31 = _mm512_dpwssd_epi32(c31, a_group, b1);
+        a_group = m_broadcastGroup_avx512(a + 16);
+        c40 = _mm512_dpwssd_epi32(c40, a_group, b0);
+        c41 = _mm512_dpwssd_epi32(c41, a_group, b1);
+        a_group = m_broadcastGroup_avx512(a + 20);
+        c50 = _mm512_dpwssd_epi32(c50, a_group, b0);
+        c51 = _mm512_dpwssd_epi32(c51, a_group, b1);
+        a_group = m_broadcastGroup_avx512(a + 24);
+        c60 = _mm512_dpwssd_epi32(c60, a_group, b0);
+        c61 = _mm512_dpwssd_epi32(c61, a_group, b1);
+        a_group = m_broadcastGroup_avx512(a + 28);
+        c70 = _mm512_dpwssd_epi32(c70, a_group, b0);
+        c71 = _mm512_dpwssd_epi32(c71, a_group, b1);
+        a += MATRIX_GEMM_MR_LOWP * MATRIX_LOWP_GROUP_BYTES;
+        b += MATRIX_GEMM_NR_LOWP * MATRIX_LOWP_GROUP_BYTES;
+    }
+    const __m512i accumulator[MATRIX_GEMM_MR_LOWP][2] = {{c00, c01}, {c10, c11}, {c20, c21}, {c30, c31}, {c40, c41}, {c50, c51}, {c60, c61}, {c70, c71}};
+    m_gemmStoreTileLowp_avx512(accumulator, c, ldc, mr, nr);
+}
+
+/**
+ * @note VDPBF16PS adds both products of a pair to the single precision accumulator in one instruction.  It does not round between them and flushes subnormals, so its sums can differ from the widened product in the last bits.
+ */
+__attribute__((target("avx512f,avx512bf16")))
+static void
+m_gemmMicroBf16_avx512bf16(const size_t groups, const void *a_panel, const void *b_panel, float *c, const size_t ldc, const size_t mr, const size_t nr) {
+    const uint8_t *a = a_panel;
+    const uint8_t *b = b_panel;
+    __m512 c00 = _mm512_setzero_ps(), c01 = _mm512_setzero_ps(), c10 = _mm512_setzero_ps(), c11 = _mm512_setzero_ps();
+    __m512 c20 = _mm512_setzero_ps(), c21 = _mm512_setzero_ps(), c30 = _mm512_setzero_ps(), c31 = _mm512_setzero_ps();
+    __m512 c40 = _mm512_setzero_ps(), c41 = _mm512_setzero_ps(), c50 = _mm512_setzero_ps(), c51 = _mm512_setzero_ps();
+    __m512 c60 = _mm512_setzero_ps(), c61 = _mm512_setzero_ps(), c70 = _mm512_setzero_ps(), c71 = _mm512_setzero_ps();
+    for(size_t group = 0; group < groups; group++) {
+        const __m512bh b0 = (__m512bh) _mm512_loadu_si512(b);
+        const __m512bh b1 = (__m512bh) _mm512_loadu_si512(b + 64);
+        __m512bh a_group = (__m512bh) m_broadcastGroup_avx512(a);
+        c00 = _mm512_dpbf16_ps(c00, a_group, b0);
+        c01 = _mm512_dpbf16_ps(c01, a_group, b1);
+        a_group = (__m512bh) m_broadcastGroup_avx512(a + 4);
+        c10 = _mm512_dpbf16_ps(c10, a_group, b0);
+        c11 = _mm512_dpbf16_ps(c11, a_group, b1);
+        a_group = (__m512bh) m_broadcastGroup_avx512(a + 8);
+        c20 = _mm512_dpbf16_ps(c20, a_group, b0);
+        c21 = _mm512_dpbf16_ps(c21, a_group, b1);
+        a_group = (__m512bh) m_broadcastGroup_avx512(a + 12);
+        c30 = _mm512_dpbf16_ps(c30, a_group, b0);
+        c31 = _mm512_dpbf16_ps(c31, a_group, b1);
+        a_group = (__m512bh) m_broadcastGroup_avx512(a + 16);
+        c40 = _mm512_dpbf16_ps(c40, a_group, b0);
+        c41 = _mm512_dpbf16_ps(c41, a_group, b1);
+        a_group = (__m512bh) m_broadcastGroup_avx512(a + 20);
+        c50 = _mm512_dpbf16_ps(c50, a_group, b0);
+        c51 = _mm512_dpbf16_ps(c51, a_group, b1);
+        a_group = (__m512bh) m_broadcastGroup_avx512(a + 24);
+        c60 = _mm512_dpbf16_ps(c60, a_group, b0);
+        c61 = _mm512_dpbf16_ps(c61, a_group, b1);
+        a_group = (__m512bh) m_broadcastGroup_avx512(a + 28);
+        c70 = _mm512_dpbf16_ps(c70, a_group, b0);
+        c71 = _mm512_dpbf16_ps(c71, a_group, b1);
+        a += MATRIX_GEMM_MR_LOWP * MATRIX_LOWP_GROUP_BYTES;
+        b += MATRIX_GEMM_NR_LOWP * MATRIX_LOWP_GROUP_BYTES;
+    }
+    const __m512 accumulator[MATRIX_GEMM_MR_LOWP][2] = {{c00, c01}, {c10, c11}, {c20, c21}, {c30, c31}, {c40, c41}, {c50, c51}, {c60, c61}, {c70, c71}};
+    const __mmask16 mask0 = m_tailMask_avx512(nr);
+    const __mmask16 mask1 = m_tailMask_avx512((nr > 16) ? (nr - 16) : 0);
+    for(size_t r = 0; r < mr; r++) {
+        float *destination = c + (r * ldc);
+        _mm512_mask_storeu_ps(destination, mask0, _mm512_add_ps(_mm512_maskz_loadu_ps(mask0, destination), accumulator[r][0]));
+        _mm512_mask_storeu_ps(destination + 16, mask1, _mm512_add_ps(_mm512_maskz_loadu_ps(mask1, destination + 16), accumulator[r][1]));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void
+m_widenBf16_avx512(float *destination, const uint16_t *source, const size_t length) {
+    size_t index = 0;
+    for(; index + 16 <= length; index += 16) {
+        const __m512i wide = _mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i*) (source + index)));
+        _mm512_storeu_ps(destination + index, _mm512_castsi512_ps(_mm512_slli_epi32(wide, 16)));
+    }
+    m_widenBf16_scalar(destination + index, source + index, length - index);
+}
+
+/**
+ * @note The same rounding as m_narrowBf16_avx2.  It needs only AVX-512F; VCVTNEPS2BF16 would flush subnormals and differ from the other variants.
+ */
+__attribute__((target("avx512f")))
+static void
+m_narrowBf16_avx512(uint16_t *destination, const float *source, const size_t length) {
+    const __m512i magnitude_mask = _mm512_set1_epi32(0x7FFFFFFF);
+    const __m512i infinity = _mm512_set1_epi32(0x7F800000);
+    const __m512i rounding = _mm512_set1_epi32(0x7FFF);
+    const __m512i one = _mm512_set1_epi32(1);
+    const __m512i quiet = _mm512_set1_epi32(0x0040);
+    size_t index = 0;
+    for(; index + 16 <= length; index += 16) {
+        const __m512i bits = _mm512_castps_si512(_mm512_loadu_ps(source + index));
+        const __mmask16 nan = _mm512_cmpgt_epu32_mask(_mm512_and_si512(bits, magnitude_mask), infinity);
+        const __m512i odd = _mm512_and_si512(_mm512_srli_epi32(bits, 16), one);
+        const __m512i rounded = _mm512_srli_epi32(_mm512_add_epi32(bits, _mm512_add_epi32(rounding, odd)), 16);
+        const __m512i quieted = _mm512_or_si512(_mm512_srli_epi32(bits, 16), quiet);
+        _mm256_storeu_si256((__m256i*) (destination + index), _mm512_cvtepi32_epi16(_mm512_mask_blend_epi32(nan, rounded, quieted)));
+    }
+    m_narrowBf16_scalar(destination + index, source + index, length - index);
+}
+
+__attribute__((target("avx512f")))
+static void
+m_widenFp16_avx512(float *destination, const uint16_t *source, const size_t length) {
+    size_t index = 0;
+    for(; index + 16 <= length; index += 16) {
+        _mm512_storeu_ps(destination + index, _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*) (source + index))));
+    }
+    m_widenFp16_scalar(destination + index, source + index, length - index);
+}
+
+__attribute__((target("avx512f")))
+static void
+m_narrowFp16_avx512(uint16_t *destination, const float *source, const size_t length) {
+    size_t index = 0;
+    for(; index + 16 <= length; index += 16) {
+        _mm256_storeu_si256((__m256i*) (destination + index), _mm512_cvtps_ph(_mm512_loadu_ps(source + index), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+    }
+    m_narrowFp16_scalar(destination + index, source + index, length - index);
+}
+
+
+/*************************** AFFINE QUANTIZATION ************************/
+
+static void
+m_range_scalar(const float *source, const size_t length, float *minimum, float *maximum) {
+    float low = *minimum;
+    float high = *maximum;
+    for(size_t index = 0; index < length; index++) {
+        low = (source[index] < low) ? source[index] : low;
+        high = (source[index] > high) ? source[index] : high;
+    }
+    *minimum = low;
+    *maximum = high;
+}
+
+static void
+m_rangeColumns_scalar(float *minimum, float *maximum, const float *source, const size_t length) {
+    for(size_t index = 0; index < length; index++) {
+        minimum[index] = (source[index] < minimum[index]) ? source[index] : minimum[index];
+        maximum[index] = (source[index] > maximum[index]) ? source[index] : maximum[index];
+    }
+}
+
+/**
+ * @brief Quantizes one value.  The scaled value is clamped to [low, high], the range of the type less the zero point, before it is rounded, in the order the vector variants use.
+ */
+static uint8_t
+m_quantizeValue_scalar(const float value, const float inverse_scale, const int zero_point, const float low, const float high) {
+    float scaled = value * inverse_scale;
+    scaled = isnan(scaled) ? 0.0f : scaled;
+    scaled = (scaled < low) ? low : ((scaled > high) ? high : scaled);
+    return (uint8_t) ((int) nearbyintf(scaled) + zero_point);
+}
+
+static void
+m_quantize_scalar(uint8_t *destination, const float *source, const size_t length, const float inverse_scale, const int zero_point, const int minimum, const int maximum) {
+    const float low = (float) (minimum - zero_point);
+    const float high = (float) (maximum - zero_point);
+    for(size_t index = 0; index < length; index++) {
+        destination[index] = m_quantizeValue_scalar(source[index], inverse_scale, zero_point, low, high);
+    }
+}
+
+static void
+m_quantizeColumns_scalar(uint8_t *destination, const float *source, const size_t length, const float *inverse_scales, const int *zero_points, const int minimum, const int maximum) {
+    for(size_t index = 0; index < length; index++) {
+        destination[index] = m_quantizeValue_scalar(source[index], inverse_scales[index], zero_points[index], (float) (minimum - zero_points[index]), (float) (maximum - zero_points[index]));
+    }
+}
+
+static void
+m_dequantize_scalar(float *destination, const uint8_t *source, const size_t length, const float scale, const int zero_point, const bool is_signed) {
+    for(size_t index = 0; index < length; index++) {
+        const int value = is_signed ? (int) (int8_t) source[index] : (int) source[index];
+        destination[index] = scale * (float) (value - zero_point);
+    }
+}
+
+static void
+m_dequantizeColumns_scalar(float *destination, const uint8_t *source, const size_t length, const float *scales, const int *zero_points, const bool is_signed) {
+    for(size_t index = 0; index < length; index++) {
+        const int value = is_signed ? (int) (int8_t) source[index] : (int) source[index];
+        destination[index] = scales[index] * (float) (value - zero_points[index]);
+    }
+}
+
+/**
+ * @note VMINPS returns its second operand when the first is NaN, so the accumulators skip NaN as the scalar comparison does.
+ */
+__attribute__((target("avx2")))
+static void
+m_range_avx2(const float *source, const size_t length, float *minimum, float *maximum) {
+    __m256 low = _mm256_set1_ps(*minimum);
+    __m256 high = _mm256_set1_ps(*maximum);
+    size_t index = 0;
+    for(; index + 8 <= length; index += 8) {
+        const __m256 values = _mm256_loadu_ps(source + index);
+        low = _mm256_min_ps(values, low);
+        high = _mm256_max_ps(values, high);
+    }
+    float low_lanes[8], high_lanes[8];
+    _mm256_storeu_ps(low_lanes, low);
+    _mm256_storeu_ps(high_lanes, high);
+    for(size_t lane = 0; lane < 8; lane++) {
+        *minimum = (low_lanes[lane] < *minimum) ? low_lanes[lane] : *minimum;
+        *maximum = (high_lanes[lane] > *maximum) ? high_lanes[lane] : *maximum;
+    }
+    m_range_scalar(source + index, length - index, minimum, maximum);
+}
+
+__attribute__((target("avx2")))
+static void
+m_rangeColumns_avx2(float *minimum, float *maximum, const float *source, const size_t length) {
+    size_t index = 0;
+    for(; index + 8 <= length; index += 8) {
+        const __m256 values = _mm256_loadu_ps(source + index);
+        _mm256_storeu_ps(minimum + index, _mm256_min_ps(values, _mm256_loadu_ps(minimum + index)));
+        _mm256_storeu_ps(maximum + index, _mm256_max_ps(values, _mm256_loadu_ps(maximum + index)));
+    }
+    m_rangeColumns_scalar(minimum + index, maximum + index, source + index, length - index);
+}
+
+/**
+ * @brief Quantizes 8 values to 8 int32 lanes: scale, zero NaN, clamp to [low, high], round with VCVTPS2DQ (nearest, ties to even) and add the zero point.
+ */
+__attribute__((target("avx2")))
+static inline __m256i
+m_quantizeLanes_avx2(const __m256 values, const __m256 inverse_scale, const __m256i zero_point, const __m256 low, const __m256 high) {
+    __m256 scaled = _mm256_mul_ps(values, inverse_scale);
+    scaled = _mm256_and_ps(scaled, _mm256_cmp_ps(scaled, scaled, _CMP_ORD_Q));
+    scaled = _mm256_min_ps(_mm256_max_ps(scaled, low), high);
+    return _mm256_add_epi32(_mm256_cvtps_epi32(scaled), zero_point);
+}
+
+/**
+ * @brief Stores the low byte of each of 8 int32 lanes.
+ */
+__attribute__((target("avx2")))
+static inline void
+m_storeLowBytes_avx2(uint8_t *destination, const __m256i lanes) {
+    const __m256i low_bytes = _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                               0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m256i packed = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(lanes, low_bytes), _mm256_setr_epi32(0, 4, 1, 1, 1, 1, 1, 1));
+    _mm_storel_epi64((__m128i*) destination, _mm256_castsi256_si128(packed));
+}
+
+__attribute__((target("avx2")))
+static void
+m_quantize_avx2(uint8_t *destination, const float *source, const size_t length, const float inverse_scale, const int zero_point, const int minimum, const int maximum) {
+    const __m256 inverse = _mm256_set1_ps(inverse_scale);
+    const __m256i zero = _mm256_set1_epi32(zero_point);
+    const __m256 low = _mm256_set1_ps((float) (minimum - zero_point));
+    const __m256 high = _mm256_set1_ps((float) (maximum - zero_point));
+    size_t index = 0;
+    for(; index + 8 <= length; index += 8) {
+        m_storeLowBytes_avx2(destination + index, m_quantizeLanes_avx2(_mm256_loadu_ps(source + index), inverse, zero, low, high));
+    }
+    m_quantize_scalar(destination + index, source + index, length - index, inverse_scale, zero_point, minimum, maximum);
+}
+
+__attribute__((target("avx2")))
+static void
+m_quantizeColumns_avx2(uint8_t *destination, const float *source, const size_t length, const float *inverse_scales, const int *zero_points, const int minimum, const int maximum) {
+    const __m256i lowest = _mm256_set1_epi32(minimum);
+    const __m256i highest = _mm256_set1_epi32(maximum);
+    size_t index = 0;
+    for(; index + 8 <= length; index += 8) {
+        const __m256i zero = _mm256_loadu_si256((const __m256i*) (zero_points + index));
+        const __m256 low = _mm256_cvtepi32_ps(_mm256_sub_epi32(lowest, zero));
+        const __m256 high = _mm256_cvtepi32_ps(_mm256_sub_epi32(highest, zero));
+        m_storeLowBytes_avx2(destination + index, m_quantizeLanes_avx2(_mm256_loadu_ps(source + index), _mm256_loadu_ps(inverse_scales + index), zero, low, high));
+    }
+    m_quantizeColumns_scalar(destination + index, source + index, length - index, inverse_scales + index, zero_points + index, minimum, maximum);
+}
+
+__attribute__((target("avx2")))
+static void
+m_dequantize_avx2(float *destination, const uint8_t *source, const size_t length, const float scale, const int zero_point, const bool is_signed) {
+    const __m256 scales = _mm256_set1_ps(scale);
+    const __m256i zero = _mm256_set1_epi32(zero_point);
+    size_t index = 0;
+    for(; index + 8 <= length; index += 8) {
+        const __m128i bytes = _mm_loadl_epi64((const __m128i*) (source + index));
+        const __m256i values = is_signed ? _mm256_cvtepi8_epi32(bytes) : _mm256_cvtepu8_epi32(bytes);
+        _mm256_storeu_ps(destination + index, _mm256_mul_ps(scales, _mm256_cvtepi32_ps(_mm256_sub_epi32(values, zero))));
+    }
+    m_dequantize_scalar(destination + index, source + index, length - index, scale, zero_point, is_signed);
+}
+
+__attribute__((target("avx2")))
+static void
+m_dequantizeColumns_avx2(float *destination, const uint8_t *source, const size_t length, const float *scales, const int *zero_points, const bool is_signed) {
+    size_t index = 0;
+    for(; index + 8 <= length; index += 8) {
+        const __m128i bytes = _mm_loadl_epi64((const __m128i*) (source + index));
+        const __m256i values = is_signed ? _mm256_cvtepi8_epi32(bytes) : _mm256_cvtepu8_epi32(bytes);
+        const __m256i zero = _mm256_loadu_si256((const __m256i*) (zero_points + index));
+        _mm256_storeu_ps(destination + index, _mm256_mul_ps(_mm256_loadu_ps(scales + index), _mm256_cvtepi32_ps(_mm256_sub_epi32(values, zero))));
+    }
+    m_dequantizeColumns_scalar(destination + index, source + index, length - index, scales + index, zero_points + index, is_signed);
+}
+
+__attribute__((target("avx512f")))
+static void
+m_range_avx512(const float *source, const size_t length, float *minimum, float *maximum) {
+    __m512 low = _mm512_set1_ps(*minimum);
+    __m512 high = _mm512_set1_ps(*maximum);
+    size_t index = 0;
+    for(; index + 16 <= length; index += 16) {
+        const __m512 values = _mm512_loadu_ps(source + index);
+        low = _mm512_min_ps(values, low);
+        high = _mm512_max_ps(values, high);
+    }
+    float low_lanes[16], high_lanes[16];
+    _mm512_storeu_ps(low_lanes, low);
+    _mm512_storeu_ps(high_lanes, high);
+    for(size_t lane = 0; lane < 16; lane++) {
+        *minimum = (low_lanes[lane] < *minimum) ? low_lanes[lane] : *minimum;
+        *maximum = (high_lanes[lane] > *maximum) ? high_lanes[lane] : *maximum;
+    }
+    m_range_scalar(source + index, length - index, minimum, maximum);
+}
+
+__attribute__((target("avx512f")))
+static void
+m_rangeColumns_avx512(float *minimum, float *maximum, const float *source, const size_t length) {
+    size_t index = 0;
+    for(; index + 16 <= length; index += 16) {
+        const __m512 values = _mm512_loadu_ps(source + index);
+        _mm512_storeu_ps(minimum + index, _mm512_min_ps(values, _mm512_loadu_ps(minimum + index)));
+        _mm512_storeu_ps(maximum + index, _mm512_max_ps(values, _mm512_loadu_ps(maximum + index)));
+    }
+    m_rangeColumns_scalar(minimum + index, maximum + index, source + index, length - index);
+}
+
+/**
+ * @brief Quantizes 16 values to 16 int32 lanes, as m_quantizeLanes_avx2 does.
+ */
+__attribute__((target("avx512f")))
+static inline __m512i
+m_quantizeLanes_avx512(const __m512 values, const __m512 inverse_scale, const __m512i zero_point, const __m512 low, const __m512 high) {
+    const __m512 scaled = _mm512_mul_ps(values, inverse_scale);
+    const __m512 clamped = _mm512_min_ps(_mm512_max_ps(_mm512_maskz_mov_ps(_mm512_cmp_ps_mask(scaled, scaled, _CMP_ORD_Q), scaled), low), high);
+    return _mm512_add_epi32(_mm512_cvtps_epi32(clamped), zero_point);
+}
+
+__attribute__((target("avx512f")))
+static void
+m_quantize_avx512(uint8_t *destination, const float *source, const size_t length, const float inverse_scale, const int zero_point, const int minimum, const int maximum) {
+    const __m512 inverse = _mm512_set1_ps(inverse_scale);
+    const __m512i zero = _mm512_set1_epi32(zero_point);
+    const __m512 low = _mm512_set1_ps((float) (minimum - zero_point));
+    const __m512 high = _mm512_set1_ps((float) (maximum - zero_point));
+    size_t index = 0;
+    for(; index + 16 <= length; index += 16) {
+        _mm_storeu_si128((__m128i*) (destination + index), _mm512_cvtepi32_epi8(m_quantizeLanes_avx512(_mm512_loadu_ps(source + index), inverse, zero, low, high)));
+    }
+    m_quantize_scalar(destination + index, source + index, length - index, inverse_scale, zero_point, minimum, maximum);
+}
+
+__attribute__((target("avx512f")))
+static void
+m_quantizeColumns_avx512(uint8_t *destination, const float *source, const size_t length, const float *inverse_scales, const int *zero_points, const int minimum, const int maximum) {
+    const __m512i lowest = _mm512_set1_epi32(minimum);
+    const __m512i highest = _mm512_set1_epi32(maximum);
+    size_t index = 0;
+    for(; index + 16 <= length; index += 16) {
+        const __m512i zero = _mm512_loadu_si512(zero_points + index);
+        const __m512 low = _mm512_cvtepi32_ps(_mm512_sub_epi32(lowest, zero));
+        const __m512 high = _mm512_cvtepi32_ps(_mm512_sub_epi32(highest, zero));
+        const __m512i lanes = m_quantizeLanes_avx512(_mm512_loadu_ps(source + index), _mm512_loadu_ps(inverse_scales + index), zero, low, high);
+        _mm_storeu_si128((__m128i*) (destination + index), _mm512_cvtepi32_epi8(lanes));
+    }
+    m_quantizeColumns_scalar(destination + index, source + index, length - index, inverse_scales + index, zero_points + index, minimum, maximum);
+}
+
+__attribute__((target("avx512f")))
+static void
+m_dequantize_avx512(float *destination, const uint8_t *source, const size_t length, const float scale, const int zero_point, const bool is_signed) {
+    const __m512 scales = _mm512_set1_ps(scale);
+    const __m512i zero = _mm512_set1_epi32(zero_point);
+    size_t index = 0;
+    for(; index + 16 <= length; index += 16) {
+        const __m128i bytes = _mm_loadu_si128((const __m128i*) (source + index));
+        const __m512i values = is_signed ? _mm512_cvtepi8_epi32(bytes) : _mm512_cvtepu8_epi32(bytes);
+        _mm512_storeu_ps(destination + index, _mm512_mul_ps(scales, _mm512_cvtepi32_ps(_mm512_sub_epi32(values, zero))));
+    }
+    m_dequantize_scalar(destination + index, source + index, length - index, scale, zero_point, is_signed);
+}
+
+__attribute__((target("avx512f")))
+static void
+m_dequantizeColumns_avx512(float *destination, const uint8_t *source, const size_t length, const float *scales, const int *zero_points, const bool is_signed) {
+    size_t index = 0;
+    for(; index + 16 <= length; index += 16) {
+        const __m128i bytes = _mm_loadu_si128((const __m128i*) (source + index));
+        const __m512i values = is_signed ? _mm512_cvtepi8_epi32(bytes) : _mm512_cvtepu8_epi32(bytes);
+        const __m512i zero = _mm512_loadu_si512(zero_points + index);
+        _mm512_storeu_ps(destination + index, _mm512_mul_ps(_mm512_loadu_ps(scales + index), _mm512_cvtepi32_ps(_mm512_sub_epi32(values, zero))));
+    }
+    m_dequantizeColumns_scalar(destination + index, source + index, length - index, scales + index, zero_points + index, is_signed);
+}
+
+
+/*************************** STOCHASTIC ROUNDING ************************/
+
+/**
+ * @brief The scale that turns the top 24 bits of a random word into a threshold in [0, 1).  Both the threshold and the fraction it is compared with are exact in single precision, so every variant makes the same choice.
+ */
+#define MATRIX_STOCHASTIC_THRESHOLD_SCALE (1.0f / 16777216.0f)
+
+/**
+ * @brief Rounds one value down to an integer, or up when the threshold of its random word is below its fraction, and clamps it to [low, high].  NaN becomes 0.
+ */
+static float
+m_stochasticInteger_scalar(const float value, const uint32_t random, const float low, const float high) {
+    const float number = isnan(value) ? 0.0f : value;
+    const float down = floorf(number);
+    const float threshold = (float) (random >> 8) * MATRIX_STOCHASTIC_THRESHOLD_SCALE;
+    const float rounded = (threshold < (number - down)) ? down + 1.0f : down;
+    return (rounded < low) ? low : ((rounded > high) ? high : rounded);
+}
+
+static void
+m_stochasticInt8_scalar(uint8_t *destination, const float *source, const size_t length, const uint32_t *random, const int minimum, const int maximum) {
+    for(size_t index = 0; index < length; index++) {
+        destination[index] = (uint8_t) (int) m_stochasticInteger_scalar(source[index], random[index], (float) minimum, (float) maximum);
+    }
+}
+
+static void
+m_stochasticInt16_scalar(int16_t *destination, const float *source, const size_t length, const uint32_t *random) {
+    for(size_t index = 0; index < length; index++) {
+        destination[index] = (int16_t) m_stochasticInteger_scalar(source[index], random[index], (float) INT16_MIN, (float) INT16_MAX);
+    }
+}
+
+static void
+m_stochasticBf16_scalar(uint16_t *destination, const float *source, const size_t length, const uint32_t *random) {
+    for(size_t index = 0; index < length; index++) {
+        uint32_t bits;
+        memcpy(&bits, &source[index], sizeof(bits));
+        if((bits & 0x7FFFFFFFu) > 0x7F800000u) {
+            destination[index] = (uint16_t) ((bits >> 16) | 0x0040u);
+        } else {
+            destination[index] = (uint16_t) ((bits + (random[index] & 0xFFFFu)) >> 16);
+        }
+    }
+}
+
+__attribute__((target("avx2")))
+static inline __m256i
+m_stochasticIntegerLanes_avx2(const __m256 values, const __m256i random, const __m256 low, const __m256 high) {
+    const __m256 number = _mm256_and_ps(values, _mm256_cmp_ps(values, values, _CMP_ORD_Q));
+    const __m256 down = _mm256_floor_ps(number);
+    const __m256 threshold = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(random, 8)), _mm256_set1_ps(MATRIX_STOCHASTIC_THRESHOLD_SCALE));
+    const __m256 up = _mm256_and_ps(_mm256_cmp_ps(threshold, _mm256_sub_ps(number, down), _CMP_LT_OQ), _mm256_set1_ps(1.0f));
+    const __m256 rounded = _mm256_add_ps(down, up);
+    return _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(rounded, low), high));
+}
+
+__attribute__((target("avx2")))
+static void
+m_stochasticInt8_avx2(uint8_t *destination, const float *source, const size_t length, const uint32_t *random, const int minimum, const int maximum) {
+    const __m256 low = _mm256_set1_ps((float) minimum);
+    const __m256 high = _mm256_set1_ps((float) maximum);
+    size_t index = 0;
+    for(; index + 8 <= length; index += 8) {
+        const __m256i bits = _mm256_loadu_si256((const __m256i*) (random + index));
+        m_storeLowBytes_avx2(destination + index, m_stochasticIntegerLanes_avx2(_mm256_loadu_ps(source + index), bits, low, high));
+    }
+    m_stochasticInt8_scalar(destination + index, source + index, length - index, random + index, minimum, maximum);
+}
+
+__attribute__((target("avx2")))
+static void
+m_stochasticInt16_avx2(int16_t *destination, const float *source, const size_t length, const uint32_t *random) {
+    const __m256 low = _mm256_set1_ps((float) INT16_MIN);
+    const __m256 high = _mm256_set1_ps((float) INT16_MAX);
+    size_t index = 0;
+    for(; index + 8 <= length; index += 8) {
+        const __m256i bits = _mm256_loadu_si256((const __m256i*) (random + index));
+        const __m256i lanes = m_stochasticIntegerLanes_avx2(_mm256_loadu_ps(source + index), bits, low, high);
+        _mm_storeu_si128((__m128i*) (destination + index), _mm_packs_epi32(_mm256_castsi256_si128(lanes), _mm256_extracti128_si256(lanes, 1)));
+    }
+    m_stochasticInt16_scalar(destination + index, source + index, length - index, random + index);
+}
+
+__attribute__((target("avx2")))
+static void
+m_stochasticBf16_avx2(uint16_t *destination, const float *source, const size_t length, const uint32_t *random) {
+    const __m256i magnitude_mask = _mm256_set1_epi32(0x7FFFFFFF);
+    const __m256i infinity = _mm256_set1_epi32(0x7F800000);
+    const __m256i low_half = _mm256_set1_epi32(0xFFFF);
+    const __m256i quiet = _mm256_set1_epi32(0x0040);
+    size_t index = 0;
+    for(; index + 8 <= length; index += 8) {
+        const __m256i bits = _mm256_castps_si256(_mm256_loadu_ps(source + index));
+        const __m256i noise = _mm256_and_si256(_mm256_loadu_si256((const __m256i*) (random + index)), low_half);
+        const __m256i nan = _mm256_cmpgt_epi32(_mm256_and_si256(bits, magnitude_mask), infinity);
+        const __m256i rounded = _mm256_srli_epi32(_mm256_add_epi32(bits, noise), 16);
+        const __m256i quieted = _mm256_or_si256(_mm256_srli_epi32(bits, 16), quiet);
+        const __m256i result = _mm256_blendv_epi8(rounded, quieted, nan);
+        _mm_storeu_si128((__m128i*) (destination + index), _mm_packus_epi32(_mm256_castsi256_si128(result), _mm256_extracti128_si256(result, 1)));
+    }
+    m_stochasticBf16_scalar(destination + index, source + index, length - index, random + index);
+}
+
+__attribute__((target("avx512f")))
+static inline __m512i
+m_stochasticIntegerLanes_avx512(const __m512 values, const __m512i random, const __m512 low, const __m512 high) {
+    const __m512 number = _mm512_maskz_mov_ps(_mm512_cmp_ps_mask(values, values, _CMP_ORD_Q), values);
+    const __m512 down = _mm512_roundscale_ps(number, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+    const __m512 threshold = _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_srli_epi32(random, 8)), _mm512_set1_ps(MATRIX_STOCHASTIC_THRESHOLD_SCALE));
+    const __mmask16 up = _mm512_cmp_ps_mask(threshold, _mm512_sub_ps(number, down), _CMP_LT_OQ);
+    const __m512 rounded = _mm512_mask_add_ps(down, up, down, _mm512_set1_ps(1.0f));
+    return _mm512_cvttps_epi32(_mm512_min_ps(_mm512_max_ps(rounded, low), high));
+}
+
+__attribute__((target("avx512f")))
+static void
+m_stochasticInt8_avx512(uint8_t *destination, const float *source, const size_t length, const uint32_t *random, const int minimum, const int maximum) {
+    const __m512 low = _mm512_set1_ps((float) minimum);
+    const __m512 high = _mm512_set1_ps((float) maximum);
+    size_t index = 0;
+    for(; index + 16 <= length; index += 16) {
+        const __m512i lanes = m_stochasticIntegerLanes_avx512(_mm512_loadu_ps(source + index), _mm512_loadu_si512(random + index), low, high);
+        _mm_storeu_si128((__m128i*) (destination + index), _mm512_cvtepi32_epi8(lanes));
+    }
+    m_stochasticInt8_scalar(destination + index, source + index, length - index, random + index, minimum, maximum);
+}
+
+__attribute__((target("avx512f")))
+static void
+m_stochasticInt16_avx512(int16_t *destination, const float *source, const size_t length, const uint32_t *random) {
+    const __m512 low = _mm512_set1_ps((float) INT16_MIN);
+    const __m512 high = _mm512_set1_ps((float) INT16_MAX);
+    size_t index = 0;
+    for(; index + 16 <= length; index += 16) {
+        const __m512i lanes = m_stochasticIntegerLanes_avx512(_mm512_loadu_ps(source + index), _mm512_loadu_si512(random + index), low, high);
+        _mm256_storeu_si256((__m256i*) (destination + index), _mm512_cvtepi32_epi16(lanes));
+    }
+    m_stochasticInt16_scalar(destination + index, source + index, length - index, random + index);
+}
+
+__attribute__((target("avx512f")))
+static void
+m_stochasticBf16_avx512(uint16_t *destination, const float *source, const size_t length, const uint32_t *random) {
+    const __m512i magnitude_mask = _mm512_set1_epi32(0x7FFFFFFF);
+    const __m512i infinity = _mm512_set1_epi32(0x7F800000);
+    const __m512i low_half = _mm512_set1_epi32(0xFFFF);
+    const __m512i quiet = _mm512_set1_epi32(0x0040);
+    size_t index = 0;
+    for(; index + 16 <= length; index += 16) {
+        const __m512i bits = _mm512_castps_si512(_mm512_loadu_ps(source + index));
+        const __m512i noise = _mm512_and_si512(_mm512_loadu_si512(random + index), low_half);
+        const __mmask16 nan = _mm512_cmpgt_epi32_mask(_mm512_and_si512(bits, magnitude_mask), infinity);
+        const __m512i rounded = _mm512_srli_epi32(_mm512_add_epi32(bits, noise), 16);
+        const __m512i result = _mm512_mask_mov_epi32(rounded, nan, _mm512_or_si512(_mm512_srli_epi32(bits, 16), quiet));
+        _mm256_storeu_si256((__m256i*) (destination + index), _mm512_cvtepi32_epi16(result));
+    }
+    m_stochasticBf16_scalar(destination + index, source + index, length - index, random + index);
+}
+
+
+/*************************** DISPATCH ************************/
+
+static const matrix_kernels_int_t m_kernelTables_int[MATRIX_ISA_COUNT] = {
+    [MATRIX_ISA_SCALAR] = {
+        MATRIX_ISA_SCALAR, "scalar",
+        m_add_scalar, m_subtract_scalar, m_multiply_scalar, m_scalarAdd_scalar, m_scalarMultiply_scalar, m_axpy_scalar, m_dotProduct_scalar, m_summarize_scalar, m_widenInt8_scalar, m_widenInt16_scalar, m_gemmMicro_scalar, m_andPopcount_scalar
+    },
+    [MATRIX_ISA_SSE41] = {
+        MATRIX_ISA_SSE41, "sse4.1",
+        m_add_sse41, m_subtract_sse41, m_multiply_sse41, m_scalarAdd_sse41, m_scalarMultiply_sse41, m_axpy_sse41, m_dotProduct_sse41, m_summarize_sse41, m_widenInt8_sse41, m_widenInt16_sse41, m_gemmMicro_sse41, m_andPopcount_scalar
+    },
+    [MATRIX_ISA_AVX2] = {
+        MATRIX_ISA_AVX2, "avx2",
+        m_add_avx2, m_subtract_avx2, m_multiply_avx2, m_scalarAdd_avx2, m_scalarMultiply_avx2, m_axpy_avx2, m_dotProduct_avx2, m_summarize_avx2, m_widenInt8_avx2, m_widenInt16_avx2, m_gemmMicro_avx2, m_andPopcount_avx2
+    },
+    [MATRIX_ISA_AVX512] = {
+        MATRIX_ISA_AVX512, "avx512",
+        m_add_avx512, m_subtract_avx512, m_multiply_avx512, m_scalarAdd_avx512, m_scalarMultiply_avx512, m_axpy_avx512, m_dotProduct_avx512, m_summarize_avx512, m_widenInt8_avx512, m_widenInt16_avx512, m_gemmMicro_avx512, m_andPopcount_avx2
+    },
+    [MATRIX_ISA_AVX512_VPOPCNTDQ] = {
+        MATRIX_ISA_AVX512_VPOPCNTDQ, "avx512vpopcntdq",
+        m_add_avx512, m_subtract_avx512, m_multiply_avx512, m_scalarAdd_avx512, m_scalarMultiply_avx512, m_axpy_avx512, m_dotProduct_avx512, m_summarize_avx512, m_widenInt8_avx512, m_widenInt16_avx512, m_gemmMicro_avx512, m_andPopcount_avx512vpopcntdq
+    },
+};
+
+static const matrix_kernels_float_t m_kernelTables_float[MATRIX_ISA_COUNT] = {
+    [MATRIX_ISA_SCALAR] = {
+        MATRIX_ISA_SCALAR, "scalar",
+        m_addFloat_scalar, m_subtractFloat_scalar, m_scalarMultiplyFloat_scalar, m_axpyFloat_scalar, m_dotProductFloat_scalar, m_gemmMicroFloat_scalar
+    },
+    [MATRIX_ISA_SSE41] = {
+        MATRIX_ISA_SSE41, "sse4.1",
+        m_addFloat_scalar, m_subtractFloat_scalar, m_scalarMultiplyFloat_scalar, m_axpyFloat_scalar, m_dotProductFloat_scalar, m_gemmMicroFloat_scalar
+    },
+    [MATRIX_ISA_AVX2] = {
+        MATRIX_ISA_AVX2, "avx2",
+        m_addFloat_avx2, m_subtractFloat_avx2, m_scalarMultiplyFloat_avx2, m_axpyFloat_avx2, m_dotProductFloat_avx2, m_gemmMicroFloat_avx2
+    },
+    [MATRIX_ISA_AVX512] = {
+        MATRIX_ISA_AVX512, "avx512",
+        m_addFloat_avx512, m_subtractFloat_avx512, m_scalarMultiplyFloat_avx512, m_axpyFloat_avx512, m_dotProductFloat_avx512, m_gemmMicroFloat_avx512
+    },
+    [MATRIX_ISA_AVX512_VPOPCNTDQ] = {
+        MATRIX_ISA_AVX512_VPOPCNTDQ, "avx512vpopcntdq",
+        m_addFloat_avx512, m_subtractFloat_avx512, m_scalarMultiplyFloat_avx512, m_axpyFloat_avx512, m_dotProductFloat_avx512, m_gemmMicroFloat_avx512
+    },
+};
+
+static const matrix_kernels_double_t m_kernelTables_double[MATRIX_ISA_COUNT] = {
+    [MATRIX_ISA_SCALAR] = {
+        MATRIX_ISA_SCALAR, "scalar",
+        m_addDouble_scalar, m_subtractDouble_scalar, m_scalarMultiplyDouble_scalar, m_axpyDouble_scalar, m_dotProductDouble_scalar, m_gemmMicroDouble_scalar
+    },
+    [MATRIX_ISA_SSE41] = {
+        MATRIX_ISA_SSE41, "sse4.1",
+        m_addDouble_scalar, m_subtractDouble_scalar, m_scalarMultiplyDouble_scalar, m_axpyDouble_scalar, m_dotProductDouble_scalar, m_gemmMicroDouble_scalar
+    },
+    [MATRIX_ISA_AVX2] = {
+        MATRIX_ISA_AVX2, "avx2",
+        m_addDouble_avx2, m_subtractDouble_avx2, m_scalarMultiplyDouble_avx2, m_axpyDouble_avx2, m_dotProductDouble_avx2, m_gemmMicroDouble_avx2
+    },
+    [MATRIX_ISA_AVX512] = {
+        MATRIX_ISA_AVX512, "avx512",
+        m_addDouble_avx512, m_subtractDouble_avx512, m_scalarMultiplyDouble_avx512, m_axpyDouble_avx512, m_dotProductDouble_avx512, m_gemmMicroDouble_avx512
+    },
+    [MATRIX_ISA_AVX512_VPOPCNTDQ] = {
+        MATRIX_ISA_AVX512_VPOPCNTDQ, "avx512vpopcntdq",
+        m_addDouble_avx512, m_subtractDouble_avx512, m_scalarMultiplyDouble_avx512, m_axpyDouble_avx512, m_dotProductDouble_avx512, m_gemmMicroDouble_avx512
+    },
+};
+
+/**
+ * @note The mixed precision tables name every extension they use.  m_adaptMixedTables takes out the ones the host lacks before any table is handed out.
+ */
+static matrix_kernels_mixed_t m_kernelTables_mixed[MATRIX_ISA_COUNT] = {
+    [MATRIX_ISA_SCALAR] = {
+        MATRIX_ISA_SCALAR, "scalar",
+        m_gemmMicroInt8_scalar, m_gemmMicroInt16_scalar, NULL, m_widenBf16_scalar, m_narrowBf16_scalar, m_widenFp16_scalar, m_narrowFp16_scalar,
+        m_range_scalar, m_rangeColumns_scalar, m_quantize_scalar, m_quantizeColumns_scalar, m_dequantize_scalar, m_dequantizeColumns_scalar,
+        m_stochasticInt8_scalar, m_stochasticInt16_scalar, m_stochasticBf16_scalar
+    },
+    [MATRIX_ISA_SSE41] = {
+        MATRIX_ISA_SSE41, "sse4.1",
+        m_gemmMicroInt8_scalar, m_gemmMicroInt16_scalar, NULL, m_widenBf16_scalar, m_narrowBf16_scalar, m_widenFp16_scalar, m_narrowFp16_scalar,
+        m_range_scalar, m_rangeColumns_scalar, m_quantize_scalar, m_quantizeColumns_scalar, m_dequantize_scalar, m_dequantizeColumns_scalar,
+        m_stochasticInt8_scalar, m_stochasticInt16_scalar, m_stochasticBf16_scalar
+    },
+    [MATRIX_ISA_AVX2] = {
+        MATRIX_ISA_AVX2, "avx2+f16c",
+        m_gemmMicroInt8_scalar, m_gemmMicroInt16_scalar, NULL, m_widenBf16_avx2, m_narrowBf16_avx2, m_widenFp16_avx2, m_narrowFp16_avx2,
+        m_range_avx2, m_rangeColumns_avx2, m_quantize_avx2, m_quantizeColumns_avx2, m_dequantize_avx2, m_dequantizeColumns_avx2,
+        m_stochasticInt8_avx2, m_stochasticInt16_avx2, m_stochasticBf16_avx2
+    },
+    [MATRIX_ISA_AVX512] = {
+        MATRIX_ISA_AVX512, "avx512+vnni+bf16",
+        m_gemmMicroInt8_avx512vnni, m_gemmMicroInt16_avx512vnni, m_gemmMicroBf16_avx512bf16, m_widenBf16_avx512, m_narrowBf16_avx512, m_widenFp16_avx512, m_narrowFp16_avx512,
+        m_range_avx512, m_rangeColumns_avx512, m_quantize_avx512, m_quantizeColumns_avx512, m_dequantize_avx512, m_dequantizeColumns_avx512,
+        m_stochasticInt8_avx512, m_stochasticInt16_avx512, m_stochasticBf16_avx512
+    },
+    [MATRIX_ISA_AVX512_VPOPCNTDQ] = {
+        MATRIX_ISA_AVX512_VPOPCNTDQ, "avx512vpopcntdq+vnni+bf16",
+        m_gemmMicroInt8_avx512vnni, m_gemmMicroInt16_avx512vnni, m_gemmMicroBf16_avx512bf16, m_widenBf16_avx512, m_narrowBf16_avx512, m_widenFp16_avx512, m_narrowFp16_avx512,
+        m_range_avx512, m_rangeColumns_avx512, m_quantize_avx512, m_quantizeColumns_avx512, m_dequantize_avx512, m_dequantizeColumns_avx512,
+        m_stochasticInt8_avx512, m_stochasticInt16_avx512, m_stochasticBf16_avx512
+    },
+};
+
+static const matrix_kernels_int_t *m_activeKernels_int = NULL;
+static const matrix_kernels_mixed_t *m_activeKernels_mixed = NULL;
+static const matrix_kernels_float_t *m_activeKernels_float = NULL;
+static const matrix_kernels_double_t *m_activeKernels_double = NULL;
+
+/**
+ * @brief Reports whether the host CPU (and operating system) supports an instruction set.
+ */
+static bool
+m_isaSupported(const matrix_isa_t isa) {
+    __builtin_cpu_init();
+    switch(isa) {
+        case MATRIX_ISA_SCALAR:
+            return true;
+        case MATRIX_ISA_SSE41:
+            return __builtin_cpu_supports("sse4.1");
+        case MATRIX_ISA_AVX2:
+            return __builtin_cpu_supports("avx2");
+        case MATRIX_ISA_AVX512:
+            return __builtin_cpu_supports("avx512f");
+        case MATRIX_ISA_AVX512_VPOPCNTDQ:
+            return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vpopcntdq");
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Chooses the floating point tables for an integer instruction set.  FMA is a separate CPUID bit from AVX2, so an AVX2 host without it gets the scalar tables.  AVX-512F includes FMA.
+ */
+static matrix_isa_t
+m_floatingIsa(const matrix_isa_t isa) {
+    if((MATRIX_ISA_AVX2 == isa) && !__builtin_cpu_supports("fma")) {
+        return MATRIX_ISA_SCALAR;
+    }
+    return isa;
+}
+
+/**
+ * @brief Takes the extensions that CPUID reports apart from the instruction set out of the mixed precision tables when the host lacks them: F16C from the AVX2 table, VNNI and AVX512_BF16 from the AVX-512 ones.  Their kernels fall back to the scalar emulation, and bfloat16 products to widening (see matrix_mixed.h).
+ */
+static void
+m_adaptMixedTables(void) {
+    __builtin_cpu_init();
+    if(!__builtin_cpu_supports("f16c")) {
+        m_kernelTables_mixed[MATRIX_ISA_AVX2].name = "avx2";
+        m_kernelTables_mixed[MATRIX_ISA_AVX2].widen_fp16 = m_widenFp16_scalar;
+        m_kernelTables_mixed[MATRIX_ISA_AVX2].narrow_fp16 = m_narrowFp16_scalar;
+    }
+    const bool vnni = __builtin_cpu_supports("avx512vnni");
+    const bool bf16 = __builtin_cpu_supports("avx512bf16");
+    static const char *const names[2][2][2] = {
+        {{"avx512", "avx512+bf16"}, {"avx512+vnni", "avx512+vnni+bf16"}},
+        {{"avx512vpopcntdq", "avx512vpopcntdq+bf16"}, {"avx512vpopcntdq+vnni", "avx512vpopcntdq+vnni+bf16"}}
+    };
+    for(int isa = MATRIX_ISA_AVX512; isa <= MATRIX_ISA_AVX512_VPOPCNTDQ; isa++) {
+        matrix_kernels_mixed_t *table = &m_kernelTables_mixed[isa];
+        table->name = names[isa - MATRIX_ISA_AVX512][vnni][bf16];
+        if(!vnni) {
+            table->gemm_int8 = m_gemmMicroInt8_scalar;
+            table->gemm_int16 = m_gemmMicroInt16_scalar;
+        }
+        if(!bf16) {
+            table->gemm_bf16 = NULL;
+        }
+    }
+}
+
+/**
+ * @brief Picks the kernel tables once, before main runs.  MATRIX_ISA may lower the choice, e.g. to reproduce a result from an older host.
+ */
+__attribute__((constructor))
+static void
+m_selectKernels_int(void) {
+    matrix_isa_t best = MATRIX_ISA_SCALAR;
+    for(int isa = MATRIX_ISA_COUNT - 1; isa > MATRIX_ISA_SCALAR; isa--) {
+        if(m_isaSupported((matrix_isa_t) isa)) {
+            best = (matrix_isa_t) isa;
+            break;
+        }
+    }
+
+    const char *requested = getenv("MATRIX_ISA");
+    if(NULL != requested) {
+        for(int isa = MATRIX_ISA_SCALAR; isa < (int) best; isa++) {
+            if(0 == strcmp(requested, m_kernelTables_int[isa].name)) {
+                best = (matrix_isa_t) isa;
+                break;
+            }
+        }
+    }
+
+    m_activeKernels_int = &m_kernelTables_int[best];
+    m_activeKernels_float = &m_kernelTables_float[m_floatingIsa(best)];
+    m_activeKernels_double = &m_kernelTables_double[m_floatingIsa(best)];
+    m_adaptMixedTables();
+    m_activeKernels_mixed = &m_kernelTables_mixed[best];
+}
+
+/**
+ * @brief Returns the kernel table selected for this host.  The table is chosen once at startup: the most capable instruction set reported by CPUID, unless the environment variable MATRIX_ISA names a less capable one (scalar, sse4.1, avx2, avx512 or avx512vpopcntdq).
+ * @return A pointer to a static table.  Never NULL.
+ */
+const matrix_kernels_int_t*
+m_kernels_int(void) {
+    if(NULL == m_activeKernels_int) { /* Only reachable from another constructor that runs before ours */
+        m_selectKernels_int();
+    }
+    return m_activeKernels_int;
+}
+
+/**
+ * @brief Returns the kernel table of a specific instruction set.  This lets callers compare variants against each other.
+ * @param isa The instruction set
+ * @return A pointer to a static table, or NULL if the host does not support the instruction set.
+ */
+const matrix_kernels_int_t*
+m_kernelsForIsa_int(const matrix_isa_t isa) {
+    if((isa < MATRIX_ISA_SCALAR) || (isa >= MATRIX_ISA_COUNT) || !m_isaSupported(isa)) {
+        return NULL;
+    }
+    return &m_kernelTables_int[isa];
+}
+
+/**
+ * @brief Returns the single precision kernel table selected for this host, which follows the integer one (see m_kernels_int).
+ * @return A pointer to a static table.  Never NULL.
+ */
+const matrix_kernels_float_t*
+m_kernels_float(void) {
+    if(NULL == m_activeKernels_float) {
+        m_selectKernels_int();
+    }
+    return m_activeKernels_float;
+}
+
+/**
+ * @brief Returns the single precision kernel table of a specific instruction set.
+ * @param isa The instruction set
+ * @return A pointer to a static table, or NULL if the host does not support the instruction set.  The AVX2 table also needs FMA.
+ */
+const matrix_kernels_float_t*
+m_kernelsForIsa_float(const matrix_isa_t isa) {
+    if((NULL == m_kernelsForIsa_int(isa)) || (m_floatingIsa(isa) != isa)) {
+        return NULL;
+    }
+    return &m_kernelTables_float[isa];
+}
+
+/**
+ * @brief Returns the double precision kernel table selected for this host, which follows the integer one (see m_kernels_int).
+ * @return A pointer to a static table.  Never NULL.
+ */
+const matrix_kernels_double_t*
+m_kernels_double(void) {
+    if(NULL == m_activeKernels_double) {
+        m_selectKernels_int();
+    }
+    return m_activeKernels_double;
+}
+
+/**
+ * @brief Returns the double precision kernel table of a specific instruction set.
+ * @param isa The instruction set
+ * @return A pointer to a static table, or NULL if the host does not support the instruction set.  The AVX2 table also needs FMA.
+ */
+const matrix_kernels_double_t*
+m_kernelsForIsa_double(const matrix_isa_t isa) {
+    if((NULL == m_kernelsForIsa_int(isa)) || (m_floatingIsa(isa) != isa)) {
+        return NULL;
+    }
+    return &m_kernelTables_double[isa];
+}
+
+/**
+ * @brief Returns the mixed precision kernel table selected for this host, which follows the integer one (see m_kernels_int).
+ * @return A pointer to a static table.  Never NULL.
+ */
+const matrix_kernels_mixed_t*
+m_kernels_mixed(void) {
+    if(NULL == m_activeKernels_mixed) {
+        m_selectKernels_int();
+    }
+    return m_activeKernels_mixed;
+}
+
+/**
+ * @brief Returns the mixed precision kernel table of a specific instruction set.  The scalar table is the emulation that every other table must match.
+ * @param isa The instruction set
+ * @return A pointer to a static table, or NULL if the host does not support the instruction set.
+ */
+const matrix_kernels_mixed_t*
+m_kernelsForIsa_mixed(const matrix_isa_t isa) {
+    if(NULL == m_kernelsForIsa_int(isa)) {
+        return NULL;
+    }
+    if(NULL == m_activeKernels_mixed) {
+        m_selectKernels_int();
+    }
+    return &m_kernelTables_mixed[isa];
+}
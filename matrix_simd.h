@@ -0,0 +1,216 @@
+/**
+ * @file matrix_simd.h
+ * @brief Hand-vectorized integer kernels and the runtime CPU dispatch that selects between them
+ * @author Aaron Fleisher
+ * @date 2026-10-16
+ *
+ * Every kernel exists as a scalar fallback plus SSE4.1, AVX2 and AVX-512 variants.  The variants are compiled into the same binary with function level target attributes, and the best one the host supports is chosen once, at startup, with CPUID.  All variants produce bit-identical results: integer overflow wraps modulo 2^32 in every variant.
+ * The single and double precision kernels (see matrix_float.h and matrix_double.h) exist as a scalar fallback plus AVX2 and AVX-512 variants that fuse every multiply-add (FMA).  They follow the integer selection; the SSE4.1 tables use the scalar variants, which the compiler already vectorizes with SSE2, and an AVX2 host without FMA falls back to them as well.
+ * The mixed precision kernels (see matrix_mixed.h) depend on extensions that CPUID reports separately from the instruction set: the AVX-512 tables multiply int8 and int16 with VNNI and bfloat16 with AVX512_BF16 only when the host has them, and the AVX2 table converts float16 with F16C only when the host has it.  Otherwise they use the scalar emulation, whose results are the same.  The affine quantization kernels need only AVX2 or AVX-512F and are bit-identical as well, except that range may find either sign of a zero.
+ */
+
+#ifndef MATRIX_SIMD_H
+#define MATRIX_SIMD_H
+
+#include "myMatrix.h"
+
+/**
+ * @brief The instruction set extensions the kernels are specialized for, ordered from least to most capable.
+ */
+typedef enum Matrix_isa_e {
+    MATRIX_ISA_SCALAR = 0,
+    MATRIX_ISA_SSE41,
+    MATRIX_ISA_AVX2,
+    MATRIX_ISA_AVX512,
+    MATRIX_ISA_AVX512_VPOPCNTDQ, /** << AVX-512 plus the VPOPCNTDQ extension.  Only the bit matrix kernel differs from MATRIX_ISA_AVX512. */
+    MATRIX_ISA_COUNT
+} matrix_isa_t;
+
+/**
+ * @brief What m_characterize_int needs to know about a run of consecutive elements.
+ * @var bits The bitwise OR of every element.  It is zero when all elements are zero, has bits other than bit 0 set when any element is not binary, and has the sign bit set when any element is negative.
+ * @var sum The sum of the elements, accumulated in 64 bits so that it cannot overflow.
+ * @var minimum The smallest element, INT_MAX for an empty run
+ * @var maximum The largest element, INT_MIN for an empty run
+ */
+typedef struct Matrix_rangeSummary_int_s {
+    unsigned int bits;
+    int64_t sum;
+    int minimum;
+    int maximum;
+} matrix_rangeSummary_int_t;
+
+/**
+ * @brief A table of kernels for a single instruction set.  The library calls the kernels through the active table, so selecting a table is the only per-host decision.
+ * @var isa The instruction set this table is specialized for
+ * @var name A human readable name of the instruction set
+ * @var add result[n] = a1[n] + a2[n]
+ * @var subtract result[n] = a1[n] - a2[n]
+ * @var multiply result[n] = a1[n] * a2[n].  It scales the columns of a row by a diagonal matrix.
+ * @var scalar_add array[n] += scalar
+ * @var scalar_multiply array[n] *= scalar
+ * @var axpy y[n] += scalar * x[n].  It is the row update of the triangular solve.
+ * @var dot_product Returns the sum of a1[n] * a2[n]
+ * @var summarize Fills a matrix_rangeSummary_int_t for array[0 .. length)
+ * @var widen_int8 destination[n] = source[n], sign extended.  It reads the rows of a matrix in MATRIX_STORAGE_INT8.
+ * @var widen_int16 destination[n] = source[n], sign extended.  It reads the rows of a matrix in MATRIX_STORAGE_INT16.
+ * @var gemm_micro The MATRIX_GEMM_MR x MATRIX_GEMM_NR register-tiled micro-kernel of the matrix multiplication.  See m_MatrixMultiply_int.
+ * @var and_popcount Returns the number of bits set in a[n] & b[n].  It is the inner product of two rows of a bit matrix (see matrix_bits.h).
+ */
+typedef struct Matrix_kernels_int_s {
+    matrix_isa_t isa;
+    const char *name;
+    void (*add)(int *result, const int *a1, const int *a2, const size_t length);
+    void (*subtract)(int *result, const int *a1, const int *a2, const size_t length);
+    void (*multiply)(int *result, const int *a1, const int *a2, const size_t length);
+    void (*scalar_add)(int *array, const int scalar, const size_t length);
+    void (*scalar_multiply)(int *array, const int scalar, const size_t length);
+    void (*axpy)(int *y, const int scalar, const int *x, const size_t length);
+    int (*dot_product)(const int *a1, const int *a2, const size_t length);
+    void (*summarize)(const int *array, const size_t length, matrix_rangeSummary_int_t *summary);
+    void (*widen_int8)(int *destination, const int8_t *source, const size_t length);
+    void (*widen_int16)(int *destination, const int16_t *source, const size_t length);
+    void (*gemm_micro)(const size_t kc, const int *a_panel, const int *b_panel, int *c, const size_t ldc, const size_t mr, const size_t nr);
+    uint64_t (*and_popcount)(const uint64_t *a, const uint64_t *b, const size_t words);
+} matrix_kernels_int_t;
+
+/**
+ * @brief Returns the kernel table selected for this host.  The table is chosen once at startup: the most capable instruction set reported by CPUID, unless the environment variable MATRIX_ISA names a less capable one (scalar, sse4.1, avx2, avx512 or avx512vpopcntdq).
+ * @return A pointer to a static table.  Never NULL.
+ */
+const matrix_kernels_int_t*
+m_kernels_int(void);
+
+/**
+ * @brief Returns the kernel table of a specific instruction set.  This lets callers compare variants against each other.
+ * @param isa The instruction set
+ * @return A pointer to a static table, or NULL if the host does not support the instruction set.
+ */
+const matrix_kernels_int_t*
+m_kernelsForIsa_int(const matrix_isa_t isa);
+
+/**
+ * @brief A table of single precision kernels for one instruction set.  The AVX2 and AVX-512 variants round every multiply-add once (FMA) where the scalar variants round the product and the sum separately, so the tables may differ in the last bits.  The order of the additions into an element of a product never depends on the table, the tiling or the thread count.
+ * @var isa The instruction set this table is specialized for
+ * @var name A human readable name of the instruction set
+ * @var add result[n] = a1[n] + a2[n]
+ * @var subtract result[n] = a1[n] - a2[n]
+ * @var scalar_multiply array[n] *= scalar
+ * @var axpy y[n] += scalar * x[n]
+ * @var dot_product Returns the sum of a1[n] * a2[n]
+ * @var gemm_micro The MATRIX_GEMM_MR_FLOAT x MATRIX_GEMM_NR_FLOAT register-tiled micro-kernel of the matrix multiplication.  See m_MatrixMultiply_float.
+ */
+typedef struct Matrix_kernels_float_s {
+    matrix_isa_t isa;
+    const char *name;
+    void (*add)(float *result, const float *a1, const float *a2, const size_t length);
+    void (*subtract)(float *result, const float *a1, const float *a2, const size_t length);
+    void (*scalar_multiply)(float *array, const float scalar, const size_t length);
+    void (*axpy)(float *y, const float scalar, const float *x, const size_t length);
+    float (*dot_product)(const float *a1, const float *a2, const size_t length);
+    void (*gemm_micro)(const size_t kc, const float *a_panel, const float *b_panel, float *c, const size_t ldc, const size_t mr, const size_t nr);
+} matrix_kernels_float_t;
+
+/**
+ * @brief A table of double precision kernels for one instruction set.  See matrix_kernels_float_t.
+ * @var gemm_micro The MATRIX_GEMM_MR_DOUBLE x MATRIX_GEMM_NR_DOUBLE register-tiled micro-kernel of the matrix multiplication.  See m_MatrixMultiply_double.
+ */
+typedef struct Matrix_kernels_double_s {
+    matrix_isa_t isa;
+    const char *name;
+    void (*add)(double *result, const double *a1, const double *a2, const size_t length);
+    void (*subtract)(double *result, const double *a1, const double *a2, const size_t length);
+    void (*scalar_multiply)(double *array, const double scalar, const size_t length);
+    void (*axpy)(double *y, const double scalar, const double *x, const size_t length);
+    double (*dot_product)(const double *a1, const double *a2, const size_t length);
+    void (*gemm_micro)(const size_t kc, const double *a_panel, const double *b_panel, double *c, const size_t ldc, const size_t mr, const size_t nr);
+} matrix_kernels_double_t;
+
+/**
+ * @brief Returns the single precision kernel table selected for this host, which follows the integer one (see m_kernels_int).
+ * @return A pointer to a static table.  Never NULL.
+ */
+const matrix_kernels_float_t*
+m_kernels_float(void);
+
+/**
+ * @brief Returns the single precision kernel table of a specific instruction set.
+ * @param isa The instruction set
+ * @return A pointer to a static table, or NULL if the host does not support the instruction set.  The AVX2 table also needs FMA.
+ */
+const matrix_kernels_float_t*
+m_kernelsForIsa_float(const matrix_isa_t isa);
+
+/**
+ * @brief Returns the double precision kernel table selected for this host, which follows the integer one (see m_kernels_int).
+ * @return A pointer to a static table.  Never NULL.
+ */
+const matrix_kernels_double_t*
+m_kernels_double(void);
+
+/**
+ * @brief Returns the double precision kernel table of a specific instruction set.
+ * @param isa The instruction set
+ * @return A pointer to a static table, or NULL if the host does not support the instruction set.  The AVX2 table also needs FMA.
+ */
+const matrix_kernels_double_t*
+m_kernelsForIsa_double(const matrix_isa_t isa);
+
+/**
+ * @brief A table of mixed precision kernels for one instruction set.  The products work on operands packed in groups of 4 bytes along the shared dimension (see matrix_mixed.h).  A micro-kernel adds the MATRIX_GEMM_MR_LOWP x MATRIX_GEMM_NR_LOWP product of one micro-panel of each operand to the mr x nr tile at c.
+ * @var isa The instruction set this table is specialized for
+ * @var name A human readable name of the instruction set and the extensions the table uses
+ * @var gemm_int8 The 8-bit micro-kernel.  Each group of the first panel holds 4 unsigned bytes (int8 values offset by 128) and each group of the second 4 signed bytes (uint8 values offset by -128).
+ * @var gemm_int16 The int16 micro-kernel.  Each group holds 2 signed 16-bit values.
+ * @var gemm_bf16 The bfloat16 micro-kernel, or NULL when the host lacks AVX512_BF16.  Each group holds 2 bfloat16 values.
+ * @var widen_bf16 destination[n] = source[n] as single precision
+ * @var narrow_bf16 destination[n] = source[n] rounded to bfloat16
+ * @var widen_fp16 destination[n] = source[n] as single precision
+ * @var narrow_fp16 destination[n] = source[n] rounded to float16
+ * @var range Lowers *minimum to the smallest and raises *maximum to the largest value of source.  NaN is skipped.
+ * @var range_columns minimum[n] = min(minimum[n], source[n]) and maximum[n] = max(maximum[n], source[n]).  NaN is skipped.
+ * @var quantize destination[n] = clamp(round(source[n] * inverse_scale) + zero_point, minimum, maximum), rounded to nearest, ties to even, and stored as its low byte.  NaN becomes zero_point.
+ * @var quantize_columns quantize with inverse_scales[n] and zero_points[n] for element n
+ * @var dequantize destination[n] = scale * (source[n] - zero_point), with source[n] read as int8 if is_signed and as uint8 otherwise
+ * @var dequantize_columns dequantize with scales[n] and zero_points[n] for element n
+ * @var stochastic_int8 destination[n] = clamp(floor(source[n]) + u, minimum, maximum), stored as its low byte, where u is 1 when (random[n] >> 8) * 2^-24 is below the fraction of source[n] and 0 otherwise: it rounds up with the probability of the fraction, to within 2^-24.  NaN becomes 0.
+ * @var stochastic_int16 stochastic_int8 into int16, clamped to [INT16_MIN, INT16_MAX]
+ * @var stochastic_bf16 destination[n] = the upper 16 bits of source[n] + (random[n] & 0xFFFF): it rounds away from zero with the probability of the discarded bits.  A NaN is truncated and quieted.
+ */
+typedef struct Matrix_kernels_mixed_s {
+    matrix_isa_t isa;
+    const char *name;
+    void (*gemm_int8)(const size_t groups, const void *a_panel, const void *b_panel, int *c, const size_t ldc, const size_t mr, const size_t nr);
+    void (*gemm_int16)(const size_t groups, const void *a_panel, const void *b_panel, int *c, const size_t ldc, const size_t mr, const size_t nr);
+    void (*gemm_bf16)(const size_t groups, const void *a_panel, const void *b_panel, float *c, const size_t ldc, const size_t mr, const size_t nr);
+    void (*widen_bf16)(float *destination, const uint16_t *source, const size_t length);
+    void (*narrow_bf16)(uint16_t *destination, const float *source, const size_t length);
+    void (*widen_fp16)(float *destination, const uint16_t *source, const size_t length);
+    void (*narrow_fp16)(uint16_t *destination, const float *source, const size_t length);
+    void (*range)(const float *source, const size_t length, float *minimum, float *maximum);
+    void (*range_columns)(float *minimum, float *maximum, const float *source, const size_t length);
+    void (*quantize)(uint8_t *destination, const float *source, const size_t length, const float inverse_scale, const int zero_point, const int minimum, const int maximum);
+    void (*quantize_columns)(uint8_t *destination, const float *source, const size_t length, const float *inverse_scales, const int *zero_points, const int minimum, const int maximum);
+    void (*dequantize)(float *destination, const uint8_t *source, const size_t length, const float scale, const int zero_point, const bool is_signed);
+    void (*dequantize_columns)(float *destination, const uint8_t *source, const size_t length, const float *scales, const int *zero_points, const bool is_signed);
+    void (*stochastic_int8)(uint8_t *destination, const float *source, const size_t length, const uint32_t *random, const int minimum, const int maximum);
+    void (*stochastic_int16)(int16_t *destination, const float *source, const size_t length, const uint32_t *random);
+    void (*stochastic_bf16)(uint16_t *destination, const float *source, const size_t length, const uint32_t *random);
+} matrix_kernels_mixed_t;
+
+/**
+ * @brief Returns the mixed precision kernel table selected for this host, which follows the integer one (see m_kernels_int).
+ * @return A pointer to a static table.  Never NULL.
+ */
+const matrix_kernels_mixed_t*
+m_kernels_mixed(void);
+
+/**
+ * @brief Returns the mixed precision kernel table of a specific instruction set.  The scalar table is the emulation that every other table must match.
+ * @param isa The instruction set
+ * @return A pointer to a static table, or NULL if the host does not support the instruction set.
+ */
+const matrix_kernels_mixed_t*
+m_kernelsForIsa_mixed(const matrix_isa_t isa);
+
+#endif /** MATRIX_SIMD_H */
@@ -0,0 +1,727 @@
+/**
+ * @file matrix_sparse.c
+ * @brief Compressed sparse row and column storage and products for sparse matrices
+ * @author Aaron Fleisher
+ * @date 2026-10-16
+ */
+#include "matrix_sparse.h"
+#include "matrix_pool.h"
+#include "matrix_simd.h"
+#include "matrix_threads.h"
+
+/**
+ * @brief Returns the number of rows of a CSR matrix or columns of a CSC matrix.
+ */
+static size_t
+m_majorCount_sparse(const matrix_sparse_t *m) {
+    return (MATRIX_SPARSE_CSR == m->format) ? m->i : m->j;
+}
+
+/**
+ * @brief Returns the number of columns of a CSR matrix or rows of a CSC matrix.
+ */
+static size_t
+m_minorCount_sparse(const matrix_sparse_t *m) {
+    return (MATRIX_SPARSE_CSR == m->format) ? m->j : m->i;
+}
+
+/**
+ * @brief Allocates a sparse matrix of dimensions i by j with room for nnz elements.  The offsets are zeroed; the caller fills them, the indices and the values.
+ * @param i The number of rows
+ * @param j The number of columns
+ * @param format MATRIX_SPARSE_CSR or MATRIX_SPARSE_CSC
+ * @param nnz The number of elements
+ * @return A new sparse matrix allocated upon the heap
+ */
+matrix_sparse_t*
+initializeMatrix_sparse(const size_t i, const size_t j, const matrix_sparseFormat_t format, const size_t nnz) {
+    matrix_sparse_t *m = m_poolCalloc(sizeof(matrix_sparse_t));
+    assert(NULL != m);
+    m->i = i;
+    m->j = j;
+    m->format = format;
+    m->nnz = nnz;
+    /* The indices are 32 bits wide, half the memory of size_t. */
+    assert(m_minorCount_sparse(m) <= UINT32_MAX);
+    m->offsets = m_poolCalloc((m_majorCount_sparse(m) + 1) * sizeof(size_t));
+    m->indices = m_poolAlloc(nnz * sizeof(uint32_t));
+    m->values = m_poolAlloc(nnz * sizeof(int));
+    assert((NULL != m->offsets) && (NULL != m->indices) && (NULL != m->values));
+    return m;
+}
+
+/**
+ * @brief Frees a sparse matrix and its arrays.
+ * @param m The matrix.  NULL is ignored.
+ */
+void
+freeMatrix_sparse(matrix_sparse_t *m) {
+    if(NULL == m) {
+        return;
+    }
+    m_poolFree(m->values, m->nnz * sizeof(int));
+    m_poolFree(m->indices, m->nnz * sizeof(uint32_t));
+    m_poolFree(m->offsets, (m_majorCount_sparse(m) + 1) * sizeof(size_t));
+    m_poolFree(m, sizeof(matrix_sparse_t));
+}
+
+/**
+ * @brief Returns one element of a sparse matrix.  The nonzeros of its row (CSR) or column (CSC) are binary searched.
+ * @param m The matrix
+ * @param i The row index, using C style indexing
+ * @param j The column index, using C style indexing
+ * @return The value, 0 when it is not stored
+ */
+int
+m_at_sparse(const matrix_sparse_t *m, const size_t i, const size_t j) {
+    assert((i < m->i) && (j < m->j));
+    const size_t major = (MATRIX_SPARSE_CSR == m->format) ? i : j;
+    const size_t minor = (MATRIX_SPARSE_CSR == m->format) ? j : i;
+    size_t low = m->offsets[major];
+    size_t high = m->offsets[major + 1];
+    while(low < high) {
+        const size_t middle = low + ((high - low) / 2);
+        if(m->indices[middle] < minor) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return ((low < m->offsets[major + 1]) && (m->indices[low] == minor)) ? m->values[low] : 0;
+}
+
+/**
+ * @brief Finds whether at most MATRIX_SPARSE_DENSITY_THRESHOLD of the elements of a matrix are nonzero.  The count stops as soon as the threshold is passed, so a dense matrix is rejected after a few rows.
+ * @param m The matrix
+ * @return true if the matrix is worth storing as a matrix_sparse_t
+ */
+bool
+m_isSparse_int(matrix_int_t *m) {
+    const size_t limit = (size_t) (MATRIX_SPARSE_DENSITY_THRESHOLD * (double) m->i * (double) m->j);
+    size_t count = 0;
+    if(MATRIX_STORAGE_CSR == m->storage) {
+        return m->sparse->nnz <= limit;
+    }
+    if(m_isImplicit_int(m) || (MATRIX_STORAGE_DIAGONAL == m->storage)) {
+        /* Only the diagonal can hold nonzeros. */
+        const size_t length = (m->i < m->j) ? m->i : m->j;
+        for(size_t index = 0; index < length; index++) {
+            count += (0 != m_at_int(m, (int) index, (int) index));
+        }
+        return count <= limit;
+    }
+    for(size_t row = 0; row < m->i; row++) {
+        int *values = (MATRIX_STORAGE_DENSE == m->storage) ? (m->array + (row * m->ld)) : m_selectRow_int(m, (int) row);
+        for(size_t column = 0; column < m->j; column++) {
+            count += (0 != values[column]);
+        }
+        if(MATRIX_STORAGE_DENSE != m->storage) {
+            free(values);
+        }
+        if(count > limit) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Converts a sparse matrix to the given format.  CSR to CSC (and back) is a counting sort over the minor indices in O(nnz + i + j).  Read as the other format, the result is also the transpose of the matrix.
+ * @param m The matrix
+ * @param format The format of the result
+ * @return A new sparse matrix allocated upon the heap, a copy when m already has the format
+ */
+matrix_sparse_t*
+m_convert_sparse(const matrix_sparse_t *m, const matrix_sparseFormat_t format) {
+    matrix_sparse_t *converted = initializeMatrix_sparse(m->i, m->j, format, m->nnz);
+    const size_t major = m_majorCount_sparse(m);
+    if(format == m->format) {
+        memcpy(converted->offsets, m->offsets, (major + 1) * sizeof(size_t));
+        memcpy(converted->indices, m->indices, m->nnz * sizeof(uint32_t));
+        memcpy(converted->values, m->values, m->nnz * sizeof(int));
+        return converted;
+    }
+    /* Count the nonzeros of every minor index, then deal them out in major order, so that every new major index receives its new minor indices sorted. */
+    const size_t minor = m_minorCount_sparse(m);
+    for(size_t index = 0; index < m->nnz; index++) {
+        converted->offsets[m->indices[index] + 1]++;
+    }
+    for(size_t index = 0; index < minor; index++) {
+        converted->offsets[index + 1] += converted->offsets[index];
+    }
+    size_t *next = malloc((minor + 1) * sizeof(size_t));
+    assert(NULL != next);
+    memcpy(next, converted->offsets, (minor + 1) * sizeof(size_t));
+    for(size_t a = 0; a < major; a++) {
+        for(size_t index = m->offsets[a]; index < m->offsets[a + 1]; index++) {
+            const size_t position = next[m->indices[index]]++;
+            converted->indices[position] = (uint32_t) a;
+            converted->values[position] = m->values[index];
+        }
+    }
+    free(next);
+    return converted;
+}
+
+/**
+ * @brief Packs the nonzeros of an integer matrix, in any storage, into a sparse matrix.
+ * @param m The matrix
+ * @param format MATRIX_SPARSE_CSR or MATRIX_SPARSE_CSC
+ * @return A new sparse matrix allocated upon the heap
+ */
+matrix_sparse_t*
+m_packSparse_int(matrix_int_t *m, const matrix_sparseFormat_t format) {
+    if(MATRIX_STORAGE_CSR == m->storage) {
+        return m_convert_sparse(m->sparse, format);
+    }
+    matrix_sparse_t *rows = NULL;
+    if(m_isImplicit_int(m) || (MATRIX_STORAGE_DIAGONAL == m->storage)) {
+        /* Only the diagonal can hold nonzeros, so neither the count nor the copy looks anywhere else. */
+        const size_t length = (m->i < m->j) ? m->i : m->j;
+        size_t count = 0;
+        for(size_t index = 0; index < length; index++) {
+            count += (0 != m_at_int(m, (int) index, (int) index));
+        }
+        rows = initializeMatrix_sparse(m->i, m->j, MATRIX_SPARSE_CSR, count);
+        size_t position = 0;
+        for(size_t row = 0; row < m->i; row++) {
+            const int value = (row < length) ? m_at_int(m, (int) row, (int) row) : 0;
+            if(0 != value) {
+                rows->indices[position] = (uint32_t) row;
+                rows->values[position] = value;
+                position++;
+            }
+            rows->offsets[row + 1] = position;
+        }
+    } else {
+        matrix_int_t *source = m;
+        if(MATRIX_STORAGE_DENSE != m->storage) {
+            source = createCopy_int(m);
+            m_materialize_int(source);
+        }
+        size_t count = 0;
+        for(size_t row = 0; row < source->i; row++) {
+            const int *values = source->array + (row * source->ld);
+            for(size_t column = 0; column < source->j; column++) {
+                count += (0 != values[column]);
+            }
+        }
+        rows = initializeMatrix_sparse(m->i, m->j, MATRIX_SPARSE_CSR, count);
+        size_t position = 0;
+        for(size_t row = 0; row < source->i; row++) {
+            const int *values = source->array + (row * source->ld);
+            for(size_t column = 0; column < source->j; column++) {
+                if(0 != values[column]) {
+                    rows->indices[position] = (uint32_t) column;
+                    rows->values[position] = values[column];
+                    position++;
+                }
+            }
+            rows->offsets[row + 1] = position;
+        }
+        if(source != m) {
+            freeMatrix_int(source);
+        }
+    }
+    if(MATRIX_SPARSE_CSC == format) {
+        matrix_sparse_t *columns = m_convert_sparse(rows, MATRIX_SPARSE_CSC);
+        freeMatrix_sparse(rows);
+        return columns;
+    }
+    return rows;
+}
+
+/**
+ * @brief Unpacks a sparse matrix into a new dense integer matrix.
+ * @param m The sparse matrix
+ * @return A new matrix allocated upon the heap
+ */
+matrix_int_t*
+m_unpackSparse_int(const matrix_sparse_t *m) {
+    matrix_int_t *unpacked = initializeMatrix_int((int) m->i, (int) m->j);
+    const bool csr = (MATRIX_SPARSE_CSR == m->format);
+    for(size_t a = 0; a < m_majorCount_sparse(m); a++) {
+        for(size_t index = m->offsets[a]; index < m->offsets[a + 1]; index++) {
+            const size_t row = csr ? a : m->indices[index];
+            const size_t column = csr ? m->indices[index] : a;
+            unpacked->array[(row * unpacked->ld) + column] = m->values[index];
+        }
+    }
+    return unpacked;
+}
+
+/**
+ * @brief Describes one sparse product for the thread pool.  Every task computes a range of rows of the result.
+ * @var sparse The CSR operand whose rows are split between the tasks: the matrix of SpMV, the left operand of SpMM and SpGEMM
+ * @var right The CSR right operand of the dense x sparse product and of SpGEMM
+ * @var dense The dense operand of SpMM, or the dense left operand of the dense x sparse product, whose rows are split evenly
+ * @var x, y The vectors of SpMV
+ * @var result The dense product
+ * @var bounds, counts, indices, values SpGEMM only.  bounds[r] is where the nonzeros of row r are written, from an upper bound on every row, and counts[r] receives how many there are.
+ * @var task_count The number of tasks the rows are split into
+ */
+typedef struct Matrix_sparseJob_s {
+    const matrix_sparse_t *sparse;
+    const matrix_sparse_t *right;
+    const matrix_int_t *dense;
+    const int *x;
+    int *y;
+    matrix_int_t *result;
+    size_t *bounds;
+    size_t *counts;
+    uint32_t *indices;
+    int *values;
+    size_t task_count;
+} matrix_sparseJob_t;
+
+/**
+ * @brief Finds the first row of a task when the rows of a CSR matrix are split into tasks of equal nonzero count.  It is the first row that starts at or after the task's share of the nonzeros.
+ */
+static size_t
+m_rowBoundary_sparse(const matrix_sparse_t *m, const size_t task, const size_t task_count) {
+    if(task >= task_count) {
+        return m->i;
+    }
+    const size_t target = (m->nnz * task) / task_count;
+    size_t low = 0;
+    size_t high = m->i;
+    while(low < high) {
+        const size_t middle = low + ((high - low) / 2);
+        if(m->offsets[middle] < target) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+/**
+ * @brief Runs a row task over all rows, on the calling thread when the work is small and on the thread pool otherwise.
+ * @param job The product.  Its task_count is set here.
+ * @param work The number of multiply-adds, compared with MATRIX_GEMM_PARALLEL_THRESHOLD
+ * @param task The row task
+ */
+static void
+m_runRows_sparse(matrix_sparseJob_t *job, const size_t work, matrix_task_fn task) {
+    if(work < MATRIX_GEMM_PARALLEL_THRESHOLD) {
+        job->task_count = 1;
+        task(job, 0, 0);
+        return;
+    }
+    /* A few tasks per thread, so that work stealing can even out rows whose cost the nonzero count does not predict. */
+    job->task_count = 4 * m_getThreadCount();
+    m_parallelFor(job->task_count, task, job);
+}
+
+static void
+m_spmvTask_sparse(void *context, const size_t task, const size_t worker) {
+    (void) worker;
+    const matrix_sparseJob_t *job = context;
+    const matrix_sparse_t *m = job->sparse;
+    const size_t end = m_rowBoundary_sparse(m, task + 1, job->task_count);
+    for(size_t row = m_rowBoundary_sparse(m, task, job->task_count); row < end; row++) {
+        unsigned int sum = 0;
+        for(size_t index = m->offsets[row]; index < m->offsets[row + 1]; index++) {
+            sum += (unsigned int) m->values[index] * (unsigned int) job->x[m->indices[index]];
+        }
+        job->y[row] = (int) sum;
+    }
+}
+
+/**
+ * @brief Computes the sparse matrix-vector product y = M x (SpMV).  For CSR every row is a dot product of its nonzeros with x, and large products split the rows over the thread pool.  For CSC every column scatters x[c] times its nonzeros into y, on the calling thread.
+ * @param m The matrix, i x j
+ * @param x The vector, j values
+ * @param y Receives the product, i values.  It must not overlap x.
+ */
+void
+m_MatrixVectorMultiply_sparse(const matrix_sparse_t *m, const int *x, int *y) {
+    if(MATRIX_SPARSE_CSC == m->format) {
+        memset(y, 0, m->i * sizeof(int));
+        for(size_t column = 0; column < m->j; column++) {
+            const unsigned int scale = (unsigned int) x[column];
+            if(0 == scale) {
+                continue;
+            }
+            for(size_t index = m->offsets[column]; index < m->offsets[column + 1]; index++) {
+                y[m->indices[index]] = (int) ((unsigned int) y[m->indices[index]] + (scale * (unsigned int) m->values[index]));
+            }
+        }
+        return;
+    }
+    matrix_sparseJob_t job = {
+        .sparse = m,
+        .x = x,
+        .y = y,
+    };
+    m_runRows_sparse(&job, m->nnz, m_spmvTask_sparse);
+}
+
+/**
+ * @brief Returns a dense matrix with the values of m: m itself when it is dense, otherwise a temporary copy expanded from its compact storage that the caller frees.
+ */
+static matrix_int_t*
+m_denseOperand_sparse(matrix_int_t *m) {
+    if(MATRIX_STORAGE_DENSE == m->storage) {
+        return m;
+    }
+    matrix_int_t *dense = createCopy_int(m);
+    m_materialize_int(dense);
+    return dense;
+}
+
+static void
+m_spmmTask_sparse(void *context, const size_t task, const size_t worker) {
+    (void) worker;
+    const matrix_sparseJob_t *job = context;
+    void (*const axpy)(int*, const int, const int*, const size_t) = m_kernels_int()->axpy;
+    const matrix_sparse_t *m = job->sparse;
+    const matrix_int_t *dense = job->dense;
+    const size_t end = m_rowBoundary_sparse(m, task + 1, job->task_count);
+    for(size_t row = m_rowBoundary_sparse(m, task, job->task_count); row < end; row++) {
+        int *output = job->result->array + (row * job->result->ld);
+        for(size_t index = m->offsets[row]; index < m->offsets[row + 1]; index++) {
+            axpy(output, m->values[index], dense->array + (m->indices[index] * dense->ld), dense->j);
+        }
+    }
+}
+
+/**
+ * @brief Computes the product of a sparse and a dense matrix, M1 x M2 (SpMM).  Row r of the product is the sum of the rows k of M2 scaled by M1[r][k], one vectorized axpy (see matrix_simd.h) per nonzero of M1.
+ * @param m1 The sparse matrix, i x k.  A CSC matrix is converted to CSR first.
+ * @param m2 The dense matrix, k x j.  A matrix in compact storage is expanded into a temporary copy.
+ * @return A new i x j matrix allocated upon the heap
+ */
+matrix_int_t*
+m_MatrixMultiply_sparseDense(const matrix_sparse_t *m1, matrix_int_t *m2) {
+    assert(m1->j == m2->i);
+    matrix_sparse_t *rows = (MATRIX_SPARSE_CSR == m1->format) ? NULL : m_convert_sparse(m1, MATRIX_SPARSE_CSR);
+    matrix_int_t *dense = m_denseOperand_sparse(m2);
+    matrix_int_t *result = initializeMatrix_int((int) m1->i, (int) m2->j);
+    matrix_sparseJob_t job = {
+        .sparse = (NULL != rows) ? rows : m1,
+        .dense = dense,
+        .result = result,
+    };
+    m_runRows_sparse(&job, m1->nnz * m2->j, m_spmmTask_sparse);
+    if(dense != m2) {
+        freeMatrix_int(dense);
+    }
+    freeMatrix_sparse(rows);
+    m_invalidateProperties_int(result);
+    return result;
+}
+
+static void
+m_denseSparseTask_sparse(void *context, const size_t task, const size_t worker) {
+    (void) worker;
+    const matrix_sparseJob_t *job = context;
+    const matrix_int_t *dense = job->dense;
+    const matrix_sparse_t *m = job->right;
+    const size_t end = (dense->i * (task + 1)) / job->task_count;
+    for(size_t row = (dense->i * task) / job->task_count; row < end; row++) {
+        const int *values = dense->array + (row * dense->ld);
+        int *output = job->result->array + (row * job->result->ld);
+        for(size_t k = 0; k < dense->j; k++) {
+            const unsigned int scale = (unsigned int) values[k];
+            if(0 == scale) {
+                continue;
+            }
+            for(size_t index = m->offsets[k]; index < m->offsets[k + 1]; index++) {
+                output[m->indices[index]] = (int) ((unsigned int) output[m->indices[index]] + (scale * (unsigned int) m->values[index]));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Computes the product of a dense and a sparse matrix, M1 x M2.  Every nonzero M1[r][k] scatters row k of M2, scaled, into row r of the product.  Zeros of M1 are skipped.
+ * @param m1 The dense matrix, i x k.  A matrix in compact storage is expanded into a temporary copy.
+ * @param m2 The sparse matrix, k x j.  A CSC matrix is converted to CSR first.
+ * @return A new i x j matrix allocated upon the heap
+ */
+matrix_int_t*
+m_MatrixMultiply_denseSparse(matrix_int_t *m1, const matrix_sparse_t *m2) {
+    assert(m1->j == m2->i);
+    matrix_sparse_t *rows = (MATRIX_SPARSE_CSR == m2->format) ? NULL : m_convert_sparse(m2, MATRIX_SPARSE_CSR);
+    matrix_int_t *dense = m_denseOperand_sparse(m1);
+    matrix_int_t *result = initializeMatrix_int((int) m1->i, (int) m2->j);
+    matrix_sparseJob_t job = {
+        .right = (NULL != rows) ? rows : m2,
+        .dense = dense,
+        .result = result,
+    };
+    m_runRows_sparse(&job, m1->i * (m1->j + m2->nnz), m_denseSparseTask_sparse);
+    if(dense != m1) {
+        freeMatrix_int(dense);
+    }
+    freeMatrix_sparse(rows);
+    m_invalidateProperties_int(result);
+    return result;
+}
+
+static void
+m_symbolicTask_sparse(void *context, const size_t task, const size_t worker) {
+    (void) worker;
+    const matrix_sparseJob_t *job = context;
+    const matrix_sparse_t *a = job->sparse;
+    const matrix_sparse_t *b = job->right;
+    const size_t begin = m_rowBoundary_sparse(a, task, job->task_count);
+    const size_t end = m_rowBoundary_sparse(a, task + 1, job->task_count);
+    if(begin == end) {
+        return;
+    }
+    /* marker[c] == row + 1 once column c of the row has been counted, so the markers never need clearing between rows. */
+    size_t *marker = calloc(b->j, sizeof(size_t));
+    assert((NULL != marker) || (0 == b->j));
+    for(size_t row = begin; row < end; row++) {
+        size_t count = 0;
+        for(size_t index = a->offsets[row]; index < a->offsets[row + 1]; index++) {
+            const size_t k = a->indices[index];
+            for(size_t position = b->offsets[k]; position < b->offsets[k + 1]; position++) {
+                if(marker[b->indices[position]] != row + 1) {
+                    marker[b->indices[position]] = row + 1;
+                    count++;
+                }
+            }
+        }
+        job->bounds[row + 1] = count;
+    }
+    free(marker);
+}
+
+static int
+m_compareIndices_sparse(const void *a, const void *b) {
+    const uint32_t left = *(const uint32_t*) a;
+    const uint32_t right = *(const uint32_t*) b;
+    return (left > right) - (left < right);
+}
+
+static void
+m_numericTask_sparse(void *context, const size_t task, const size_t worker) {
+    (void) worker;
+    const matrix_sparseJob_t *job = context;
+    const matrix_sparse_t *a = job->sparse;
+    const matrix_sparse_t *b = job->right;
+    const size_t begin = m_rowBoundary_sparse(a, task, job->task_count);
+    const size_t end = m_rowBoundary_sparse(a, task + 1, job->task_count);
+    if(begin == end) {
+        return;
+    }
+    unsigned int *accumulator = calloc(b->j, sizeof(unsigned int));
+    size_t *marker = calloc(b->j, sizeof(size_t));
+    assert(((NULL != accumulator) && (NULL != marker)) || (0 == b->j));
+    for(size_t row = begin; row < end; row++) {
+        uint32_t *columns = job->indices + job->bounds[row];
+        int *values = job->values + job->bounds[row];
+        size_t count = 0;
+        for(size_t index = a->offsets[row]; index < a->offsets[row + 1]; index++) {
+            const size_t k = a->indices[index];
+            const unsigned int scale = (unsigned int) a->values[index];
+            for(size_t position = b->offsets[k]; position < b->offsets[k + 1]; position++) {
+                const uint32_t column = b->indices[position];
+                if(marker[column] != row + 1) {
+                    marker[column] = row + 1;
+                    columns[count++] = column;
+                }
+                accumulator[column] += scale * (unsigned int) b->values[position];
+            }
+        }
+        /* The accumulator is read back in column order, dropping the sums that cancelled and clearing it for the next row. */
+        qsort(columns, count, sizeof(uint32_t), m_compareIndices_sparse);
+        size_t kept = 0;
+        for(size_t index = 0; index < count; index++) {
+            const uint32_t column = columns[index];
+            if(0 != accumulator[column]) {
+                columns[kept] = column;
+                values[kept] = (int) accumulator[column];
+                kept++;
+            }
+            accumulator[column] = 0;
+        }
+        job->counts[row] = kept;
+    }
+    free(marker);
+    free(accumulator);
+}
+
+/**
+ * @brief Computes the product of two sparse matrices, M1 x M2 (SpGEMM), with Gustavson's algorithm.  Row r of the product gathers the rows k of M2 for every nonzero M1[r][k] in a dense accumulator.  A first pass bounds the nonzeros of every row, a second computes them, and both split the rows over the thread pool.  Sums that cancel to zero are not stored.
+ * @param m1 The first matrix, i x k.  A CSC matrix is converted to CSR first.
+ * @param m2 The second matrix, k x j.  A CSC matrix is converted to CSR first.
+ * @return A new i x j CSR matrix allocated upon the heap
+ */
+matrix_sparse_t*
+m_MatrixMultiply_sparse(const matrix_sparse_t *m1, const matrix_sparse_t *m2) {
+    assert(m1->j == m2->i);
+    matrix_sparse_t *rows1 = (MATRIX_SPARSE_CSR == m1->format) ? NULL : m_convert_sparse(m1, MATRIX_SPARSE_CSR);
+    matrix_sparse_t *rows2 = (MATRIX_SPARSE_CSR == m2->format) ? NULL : m_convert_sparse(m2, MATRIX_SPARSE_CSR);
+    const matrix_sparse_t *a = (NULL != rows1) ? rows1 : m1;
+    const matrix_sparse_t *b = (NULL != rows2) ? rows2 : m2;
+
+    size_t work = 0;
+    for(size_t index = 0; index < a->nnz; index++) {
+        work += b->offsets[a->indices[index] + 1] - b->offsets[a->indices[index]];
+    }
+    matrix_sparseJob_t job = {
+        .sparse = a,
+        .right = b,
+        .bounds = calloc(a->i + 1, sizeof(size_t)),
+        .counts = calloc(a->i + 1, sizeof(size_t)),
+    };
+    assert((NULL != job.bounds) && (NULL != job.counts));
+    m_runRows_sparse(&job, work, m_symbolicTask_sparse);
+    for(size_t row = 0; row < a->i; row++) {
+        job.bounds[row + 1] += job.bounds[row];
+    }
+    job.indices = malloc((job.bounds[a->i] + 1) * sizeof(uint32_t));
+    job.values = malloc((job.bounds[a->i] + 1) * sizeof(int));
+    assert((NULL != job.indices) && (NULL != job.values));
+    m_runRows_sparse(&job, work, m_numericTask_sparse);
+
+    size_t nnz = 0;
+    for(size_t row = 0; row < a->i; row++) {
+        nnz += job.counts[row];
+    }
+    matrix_sparse_t *product = initializeMatrix_sparse(m1->i, m2->j, MATRIX_SPARSE_CSR, nnz);
+    for(size_t row = 0; row < a->i; row++) {
+        const size_t start = product->offsets[row];
+        memcpy(product->indices + start, job.indices + job.bounds[row], job.counts[row] * sizeof(uint32_t));
+        memcpy(product->values + start, job.values + job.bounds[row], job.counts[row] * sizeof(int));
+        product->offsets[row + 1] = start + job.counts[row];
+    }
+    free(job.values);
+    free(job.indices);
+    free(job.counts);
+    free(job.bounds);
+    freeMatrix_sparse(rows2);
+    freeMatrix_sparse(rows1);
+    return product;
+}
+
+/**
+ * @brief Merges the nonzeros of two sparse matrices of the same format, adding or subtracting where both have one.
+ */
+static matrix_sparse_t*
+m_merge_sparse(const matrix_sparse_t *m1, const matrix_sparse_t *m2, const bool subtract) {
+    assert((m1->i == m2->i) && (m1->j == m2->j));
+    matrix_sparse_t *converted = (m1->format == m2->format) ? NULL : m_convert_sparse(m2, m1->format);
+    const matrix_sparse_t *b = (NULL != converted) ? converted : m2;
+    const size_t major = m_majorCount_sparse(m1);
+    /* The merge holds at most the nonzeros of both, and is copied into a matrix of its exact size at the end. */
+    size_t *offsets = calloc(major + 1, sizeof(size_t));
+    uint32_t *indices = malloc((m1->nnz + b->nnz + 1) * sizeof(uint32_t));
+    int *values = malloc((m1->nnz + b->nnz + 1) * sizeof(int));
+    assert((NULL != offsets) && (NULL != indices) && (NULL != values));
+    size_t count = 0;
+    for(size_t a = 0; a < major; a++) {
+        size_t first = m1->offsets[a];
+        size_t second = b->offsets[a];
+        while((first < m1->offsets[a + 1]) || (second < b->offsets[a + 1])) {
+            const bool take_first = (first < m1->offsets[a + 1]) && ((second == b->offsets[a + 1]) || (m1->indices[first] <= b->indices[second]));
+            const bool take_second = (second < b->offsets[a + 1]) && ((first == m1->offsets[a + 1]) || (b->indices[second] <= m1->indices[first]));
+            const uint32_t index = take_first ? m1->indices[first] : b->indices[second];
+            unsigned int value = take_first ? (unsigned int) m1->values[first++] : 0u;
+            if(take_second) {
+                value = subtract ? (value - (unsigned int) b->values[second]) : (value + (unsigned int) b->values[second]);
+                second++;
+            }
+            if(0 != value) {
+                indices[count] = index;
+                values[count] = (int) value;
+                count++;
+            }
+        }
+        offsets[a + 1] = count;
+    }
+    matrix_sparse_t *merged = initializeMatrix_sparse(m1->i, m1->j, m1->format, count);
+    memcpy(merged->offsets, offsets, (major + 1) * sizeof(size_t));
+    memcpy(merged->indices, indices, count * sizeof(uint32_t));
+    memcpy(merged->values, values, count * sizeof(int));
+    free(values);
+    free(indices);
+    free(offsets);
+    freeMatrix_sparse(converted);
+    return merged;
+}
+
+/**
+ * @brief Adds two sparse matrices, M1 + M2, by merging the sorted nonzeros of every row (or column) in O(nnz).  Sums that cancel to zero are not stored.
+ * @param m1 The first matrix
+ * @param m2 The second matrix, of the same dimensions.  It is converted to the format of m1 first if it has the other one.
+ * @return A new sparse matrix allocated upon the heap, in the format of m1
+ */
+matrix_sparse_t*
+m_MatrixAdd_sparse(const matrix_sparse_t *m1, const matrix_sparse_t *m2) {
+    return m_merge_sparse(m1, m2, false);
+}
+
+/**
+ * @brief Subtracts two sparse matrices, M1 - M2.  See m_MatrixAdd_sparse.
+ * @param m1 The first matrix
+ * @param m2 The second matrix, of the same dimensions
+ * @return A new sparse matrix allocated upon the heap, in the format of m1
+ */
+matrix_sparse_t*
+m_MatrixSubtract_sparse(const matrix_sparse_t *m1, const matrix_sparse_t *m2) {
+    return m_merge_sparse(m1, m2, true);
+}
+
+/**
+ * @brief Multiplies every nonzero of a sparse matrix by a scalar, in place.  Products that wrap around to zero are dropped, so the matrix still stores no zeros.
+ * @param m The matrix
+ * @param scalar The scalar
+ */
+void
+m_ScalarMultiply_sparse(matrix_sparse_t *m, const int scalar) {
+    m_kernels_int()->scalar_multiply(m->values, scalar, m->nnz);
+    size_t kept = 0;
+    for(size_t index = 0; index < m->nnz; index++) {
+        kept += (0 != m->values[index]);
+    }
+    if(kept == m->nnz) {
+        return;
+    }
+    /* The pool takes arrays back by their size, so the nonzeros that remain move to arrays of the new size. */
+    matrix_sparse_t *compact = initializeMatrix_sparse(m->i, m->j, m->format, kept);
+    size_t position = 0;
+    for(size_t a = 0; a < m_majorCount_sparse(m); a++) {
+        for(size_t index = m->offsets[a]; index < m->offsets[a + 1]; index++) {
+            if(0 != m->values[index]) {
+                compact->indices[position] = m->indices[index];
+                compact->values[position] = m->values[index];
+                position++;
+            }
+        }
+        compact->offsets[a + 1] = position;
+    }
+    const matrix_sparse_t original = *m;
+    *m = *compact;
+    *compact = original;
+    freeMatrix_sparse(compact);
+}
+
+/**
+ * @brief Adds a sparse and a dense matrix, M1 + M2.  The result is a copy of M2 with the nonzeros of M1 added in place, in O(i x j + nnz).
+ * @param m1 The sparse matrix
+ * @param m2 The dense matrix, of the same dimensions.  A matrix in compact storage is expanded in the copy.
+ * @return A new matrix allocated upon the heap
+ */
+matrix_int_t*
+m_MatrixAdd_sparseDense(const matrix_sparse_t *m1, matrix_int_t *m2) {
+    assert((m1->i == m2->i) && (m1->j == m2->j));
+    matrix_int_t *sum = createCopy_int(m2);
+    m_materialize_int(sum);
+    const bool csr = (MATRIX_SPARSE_CSR == m1->format);
+    for(size_t a = 0; a < m_majorCount_sparse(m1); a++) {
+        for(size_t index = m1->offsets[a]; index < m1->offsets[a + 1]; index++) {
+            const size_t row = csr ? a : m1->indices[index];
+            const size_t column = csr ? m1->indices[index] : a;
+            int *element = sum->array + (row * sum->ld) + column;
+            *element = (int) ((unsigned int) *element + (unsigned int) m1->values[index]);
+        }
+    }
+    m_invalidateProperties_int(sum);
+    return sum;
+}
@@ -0,0 +1,184 @@
+/**
+ * @file matrix_sparse.h
+ * @brief Compressed sparse row and column storage and products for sparse matrices
+ * @author Aaron Fleisher
+ * @date 2026-10-16
+ *
+ * A sparse matrix stores only its nonzero elements.  In compressed sparse row (CSR) format the column indices and values of each row are consecutive and sorted by column, and offsets[r] is the position of the first nonzero of row r.  Compressed sparse column (CSC) is the same with rows and columns exchanged.  Either format takes 8 bytes per nonzero plus 8 per row (or column), so a graph matrix that is 0.1% dense needs about 1/500 of the memory of matrix_int_t.
+ * The products only touch nonzeros: SpMV costs O(nnz), the sparse x dense products O(nnz x columns), and the sparse x sparse product (Gustavson's algorithm) the multiply-adds it actually performs.  Large products deal rows out to the thread pool (see matrix_threads.h) in ranges of equal nonzero count, so a few heavy rows do not leave the other threads idle.
+ * Integer overflow wraps modulo 2^32, as in the dense products.
+ * Characterization moves a large matrix_int_t with few nonzeros to MATRIX_STORAGE_CSR on its own, and m_MatrixMultiply_int and m_MatrixAdd_int then take these routes for it.
+ */
+
+#ifndef MATRIX_SPARSE_H
+#define MATRIX_SPARSE_H
+
+#include "myMatrix.h"
+
+/**
+ * @brief The largest fraction of nonzero elements for which m_isSparse_int holds.  Below it the sparse products beat the blocked dense product, as well as taking less memory.
+ */
+#define MATRIX_SPARSE_DENSITY_THRESHOLD 0.05
+
+/**
+ * @brief The order in which a sparse matrix stores its nonzeros.
+ */
+typedef enum Matrix_sparseFormat_e {
+    MATRIX_SPARSE_CSR = 0, /** << Compressed sparse row: row after row.  Rows are cheap to read, and products split over rows. */
+    MATRIX_SPARSE_CSC      /** << Compressed sparse column: column after column.  Columns are cheap to read. */
+} matrix_sparseFormat_t;
+
+/**
+ * @brief A sparse matrix in compressed row or column storage.
+ * @var i The number of rows
+ * @var j The number of columns
+ * @var format MATRIX_SPARSE_CSR or MATRIX_SPARSE_CSC.  The major dimension is the rows for CSR and the columns for CSC, the minor dimension is the other one.
+ * @var nnz The number of stored elements
+ * @var offsets The major dimension + 1 positions: the nonzeros of major index a are at [offsets[a], offsets[a + 1]).  offsets[0] is 0 and the last one is nnz.
+ * @var indices The minor index of each nonzero, increasing within each major index
+ * @var values The value of each nonzero.  The sparse constructors never store a zero.
+ */
+typedef struct Matrix_sparse_s {
+    size_t i;
+    size_t j;
+    matrix_sparseFormat_t format;
+    size_t nnz;
+    size_t *offsets;
+    uint32_t *indices;
+    int *values;
+} matrix_sparse_t;
+
+/**
+ * @brief Allocates a sparse matrix of dimensions i by j with room for nnz elements.  The offsets are zeroed; the caller fills them, the indices and the values.
+ * @param i The number of rows
+ * @param j The number of columns
+ * @param format MATRIX_SPARSE_CSR or MATRIX_SPARSE_CSC
+ * @param nnz The number of elements
+ * @return A new sparse matrix allocated upon the heap
+ */
+matrix_sparse_t*
+initializeMatrix_sparse(const size_t i, const size_t j, const matrix_sparseFormat_t format, const size_t nnz);
+
+/**
+ * @brief Frees a sparse matrix and its arrays.
+ * @param m The matrix.  NULL is ignored.
+ */
+void
+freeMatrix_sparse(matrix_sparse_t *m);
+
+/**
+ * @brief Returns one element of a sparse matrix.  The nonzeros of its row (CSR) or column (CSC) are binary searched.
+ * @param m The matrix
+ * @param i The row index, using C style indexing
+ * @param j The column index, using C style indexing
+ * @return The value, 0 when it is not stored
+ */
+int
+m_at_sparse(const matrix_sparse_t *m, const size_t i, const size_t j);
+
+/**
+ * @brief Finds whether at most MATRIX_SPARSE_DENSITY_THRESHOLD of the elements of a matrix are nonzero.  The count stops as soon as the threshold is passed, so a dense matrix is rejected after a few rows.
+ * @param m The matrix
+ * @return true if the matrix is worth storing as a matrix_sparse_t
+ */
+bool
+m_isSparse_int(matrix_int_t *m);
+
+/**
+ * @brief Packs the nonzeros of an integer matrix, in any storage, into a sparse matrix.
+ * @param m The matrix
+ * @param format MATRIX_SPARSE_CSR or MATRIX_SPARSE_CSC
+ * @return A new sparse matrix allocated upon the heap
+ */
+matrix_sparse_t*
+m_packSparse_int(matrix_int_t *m, const matrix_sparseFormat_t format);
+
+/**
+ * @brief Unpacks a sparse matrix into a new dense integer matrix.
+ * @param m The sparse matrix
+ * @return A new matrix allocated upon the heap
+ */
+matrix_int_t*
+m_unpackSparse_int(const matrix_sparse_t *m);
+
+/**
+ * @brief Converts a sparse matrix to the given format.  CSR to CSC (and back) is a counting sort over the minor indices in O(nnz + i + j).  Read as the other format, the result is also the transpose of the matrix.
+ * @param m The matrix
+ * @param format The format of the result
+ * @return A new sparse matrix allocated upon the heap, a copy when m already has the format
+ */
+matrix_sparse_t*
+m_convert_sparse(const matrix_sparse_t *m, const matrix_sparseFormat_t format);
+
+/**
+ * @brief Computes the sparse matrix-vector product y = M x (SpMV).  For CSR every row is a dot product of its nonzeros with x, and large products split the rows over the thread pool.  For CSC every column scatters x[c] times its nonzeros into y, on the calling thread.
+ * @param m The matrix, i x j
+ * @param x The vector, j values
+ * @param y Receives the product, i values.  It must not overlap x.
+ */
+void
+m_MatrixVectorMultiply_sparse(const matrix_sparse_t *m, const int *x, int *y);
+
+/**
+ * @brief Computes the product of a sparse and a dense matrix, M1 x M2 (SpMM).  Row r of the product is the sum of the rows k of M2 scaled by M1[r][k], one vectorized axpy (see matrix_simd.h) per nonzero of M1.
+ * @param m1 The sparse matrix, i x k.  A CSC matrix is converted to CSR first.
+ * @param m2 The dense matrix, k x j.  A matrix in compact storage is expanded into a temporary copy.
+ * @return A new i x j matrix allocated upon the heap
+ */
+matrix_int_t*
+m_MatrixMultiply_sparseDense(const matrix_sparse_t *m1, matrix_int_t *m2);
+
+/**
+ * @brief Computes the product of a dense and a sparse matrix, M1 x M2.  Every nonzero M1[r][k] scatters row k of M2, scaled, into row r of the product.  Zeros of M1 are skipped.
+ * @param m1 The dense matrix, i x k.  A matrix in compact storage is expanded into a temporary copy.
+ * @param m2 The sparse matrix, k x j.  A CSC matrix is converted to CSR first.
+ * @return A new i x j matrix allocated upon the heap
+ */
+matrix_int_t*
+m_MatrixMultiply_denseSparse(matrix_int_t *m1, const matrix_sparse_t *m2);
+
+/**
+ * @brief Computes the product of two sparse matrices, M1 x M2 (SpGEMM), with Gustavson's algorithm.  Row r of the product gathers the rows k of M2 for every nonzero M1[r][k] in a dense accumulator.  A first pass bounds the nonzeros of every row, a second computes them, and both split the rows over the thread pool.  Sums that cancel to zero are not stored.
+ * @param m1 The first matrix, i x k.  A CSC matrix is converted to CSR first.
+ * @param m2 The second matrix, k x j.  A CSC matrix is converted to CSR first.
+ * @return A new i x j CSR matrix allocated upon the heap
+ */
+matrix_sparse_t*
+m_MatrixMultiply_sparse(const matrix_sparse_t *m1, const matrix_sparse_t *m2);
+
+/**
+ * @brief Adds two sparse matrices, M1 + M2, by merging the sorted nonzeros of every row (or column) in O(nnz).  Sums that cancel to zero are not stored.
+ * @param m1 The first matrix
+ * @param m2 The second matrix, of the same dimensions.  It is converted to the format of m1 first if it has the other one.
+ * @return A new sparse matrix allocated upon the heap, in the format of m1
+ */
+matrix_sparse_t*
+m_MatrixAdd_sparse(const matrix_sparse_t *m1, const matrix_sparse_t *m2);
+
+/**
+ * @brief Subtracts two sparse matrices, M1 - M2.  See m_MatrixAdd_sparse.
+ * @param m1 The first matrix
+ * @param m2 The second matrix, of the same dimensions
+ * @return A new sparse matrix allocated upon the heap, in the format of m1
+ */
+matrix_sparse_t*
+m_MatrixSubtract_sparse(const matrix_sparse_t *m1, const matrix_sparse_t *m2);
+
+/**
+ * @brief Multiplies every nonzero of a sparse matrix by a scalar, in place.  Products that wrap around to zero are dropped, so the matrix still stores no zeros.
+ * @param m The matrix
+ * @param scalar The scalar
+ */
+void
+m_ScalarMultiply_sparse(matrix_sparse_t *m, const int scalar);
+
+/**
+ * @brief Adds a sparse and a dense matrix, M1 + M2.  The result is a copy of M2 with the nonzeros of M1 added in place, in O(i x j + nnz).
+ * @param m1 The sparse matrix
+ * @param m2 The dense matrix, of the same dimensions.  A matrix in compact storage is expanded in the copy.
+ * @return A new matrix allocated upon the heap
+ */
+matrix_int_t*
+m_MatrixAdd_sparseDense(const matrix_sparse_t *m1, matrix_int_t *m2);
+
+#endif /** MATRIX_SPARSE_H */
@@ -0,0 +1,305 @@
+/**
+ * @file matrix_threads.c
+ * @brief The library-owned thread pool used to parallelize matrix operations
+ * @author Aaron Fleisher
+ * @date 2026-10-16
+ */
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
+#include "matrix_threads.h"
+
+/**
+ * @brief The range of task indices dealt to one worker.  The owner and any thief claim tasks by atomically advancing next.  Each range sits on its own cache line so that claims on different ranges do not contend.
+ */
+typedef struct Matrix_taskRange_s {
+    _Alignas(64) atomic_size_t next;
+    size_t end;
+} matrix_taskRange_t;
+
+/**
+ * @brief The state of the pool.
+ * @var job_lock Serializes parallel jobs and changes to the pool
+ * @var wake_lock Protects generation, job_workers, active_workers and shutdown
+ * @var wake Signalled when a new job (or shutdown) is posted
+ * @var done Signalled when the last helper thread leaves the current job
+ * @var thread_count The number of threads, including the caller, while the pool exists.  0 if it does not exist.
+ * @var generation Incremented for every posted job
+ * @var job_workers The number of workers taking part in the current job
+ * @var active_workers The number of helper threads still working on the current job
+ */
+static struct {
+    pthread_mutex_t job_lock;
+    pthread_mutex_t wake_lock;
+    pthread_cond_t wake;
+    pthread_cond_t done;
+    size_t thread_count;
+    pthread_t *threads;
+    matrix_taskRange_t *ranges;
+    unsigned long generation;
+    size_t job_workers;
+    size_t active_workers;
+    bool shutdown;
+    matrix_task_fn task;
+    void *context;
+} m_pool = {
+    .job_lock = PTHREAD_MUTEX_INITIALIZER,
+    .wake_lock = PTHREAD_MUTEX_INITIALIZER,
+    .wake = PTHREAD_COND_INITIALIZER,
+    .done = PTHREAD_COND_INITIALIZER,
+};
+
+static size_t m_requestedThreadCount = 0;
+static _Thread_local bool m_insideParallelFor = false;
+
+/**
+ * @brief Returns the number of threads the library uses, including the calling thread.
+ * @return The explicit count set with m_setThreadCount, otherwise MATRIX_NUM_THREADS, otherwise the number of online processors.
+ */
+size_t
+m_getThreadCount(void) {
+    if(0 != m_requestedThreadCount) {
+        return m_requestedThreadCount;
+    }
+    const char *environment = getenv(MATRIX_THREADS_ENVIRONMENT);
+    if(NULL != environment) {
+        const long count = strtol(environment, NULL, 10);
+        if(count > 0) {
+            return (size_t) count;
+        }
+    }
+    const long processors = sysconf(_SC_NPROCESSORS_ONLN);
+    return (processors > 0) ? (size_t) processors : 1;
+}
+
+/**
+ * @brief Claims and runs tasks until every range is exhausted.  The worker drains its own range first and then steals from the ranges of the other workers.
+ * @param worker The index of the running worker
+ * @param worker_count The number of ranges in the current job
+ */
+static void
+m_runTasks(const size_t worker, const size_t worker_count) {
+    for(size_t offset = 0; offset < worker_count; offset++) {
+        matrix_taskRange_t *range = &m_pool.ranges[(worker + offset) % worker_count];
+        size_t task;
+        while((task = atomic_fetch_add_explicit(&range->next, 1, memory_order_relaxed)) < range->end) {
+            m_pool.task(m_pool.context, task, worker);
+        }
+    }
+}
+
+/**
+ * @brief The body of every helper thread.  It sleeps until a job is posted, takes part in it if it has a range, and reports back when its share is done.
+ * @param argument The worker index, cast to a pointer
+ */
+static void*
+m_workerMain(void *argument) {
+    const size_t worker = (size_t) argument;
+    unsigned long seen_generation = 0;
+    m_insideParallelFor = true;
+
+    pthread_mutex_lock(&m_pool.wake_lock);
+    for(;;) {
+        while((seen_generation == m_pool.generation) && !m_pool.shutdown) {
+            pthread_cond_wait(&m_pool.wake, &m_pool.wake_lock);
+        }
+        if(m_pool.shutdown) {
+            break;
+        }
+        seen_generation = m_pool.generation;
+        const size_t worker_count = m_pool.job_workers;
+        if(worker >= worker_count) {
+            continue;
+        }
+        pthread_mutex_unlock(&m_pool.wake_lock);
+
+        m_runTasks(worker, worker_count);
+
+        pthread_mutex_lock(&m_pool.wake_lock);
+        if(0 == --m_pool.active_workers) {
+            pthread_cond_signal(&m_pool.done);
+        }
+    }
+    pthread_mutex_unlock(&m_pool.wake_lock);
+    return NULL;
+}
+
+/**
+ * @brief Joins and frees the worker threads.  The caller must hold job_lock.
+ */
+static void
+m_destroyPoolLocked(void) {
+    if(0 == m_pool.thread_count) {
+        return;
+    }
+    pthread_mutex_lock(&m_pool.wake_lock);
+    m_pool.shutdown = true;
+    pthread_cond_broadcast(&m_pool.wake);
+    pthread_mutex_unlock(&m_pool.wake_lock);
+
+    for(size_t worker = 1; worker < m_pool.thread_count; worker++) {
+        pthread_join(m_pool.threads[worker], NULL);
+    }
+    free(m_pool.threads);
+    free(m_pool.ranges);
+    m_pool.threads = NULL;
+    m_pool.ranges = NULL;
+    m_pool.thread_count = 0;
+    m_pool.shutdown = false;
+}
+
+/**
+ * @brief Starts the helper threads.  The caller must hold job_lock.
+ * @param thread_count The number of threads, including the caller
+ */
+static void
+m_createPoolLocked(const size_t thread_count) {
+    static bool registered_atexit = false;
+    if(!registered_atexit) {
+        (void) atexit(m_shutdownThreadPool);
+        registered_atexit = true;
+    }
+
+    m_pool.threads = calloc(thread_count, sizeof(pthread_t));
+    m_pool.ranges = aligned_alloc(_Alignof(matrix_taskRange_t), thread_count * sizeof(matrix_taskRange_t));
+    assert((NULL != m_pool.threads) && (NULL != m_pool.ranges));
+    m_pool.generation = 0;
+
+    size_t started = 1;
+    for(; started < thread_count; started++) {
+        if(0 != pthread_create(&m_pool.threads[started], NULL, m_workerMain, (void *) started)) {
+            break;
+        }
+    }
+    m_pool.thread_count = started; /* Fewer threads than requested if the system refused to create more */
+}
+
+/**
+ * @brief The scratch buffers of one thread.  They are reached through a pthread key so that they are freed when the thread exits.
+ */
+typedef struct Matrix_threadScratch_s {
+    void *buffer[MATRIX_SCRATCH_SLOTS];
+    size_t capacity[MATRIX_SCRATCH_SLOTS];
+} matrix_threadScratch_t;
+
+static pthread_key_t m_scratchKey;
+static pthread_once_t m_scratchKeyOnce = PTHREAD_ONCE_INIT;
+
+static void
+m_freeThreadScratch(void *argument) {
+    matrix_threadScratch_t *scratch = argument;
+    for(size_t slot = 0; slot < MATRIX_SCRATCH_SLOTS; slot++) {
+        free(scratch->buffer[slot]);
+    }
+    free(scratch);
+}
+
+static void
+m_createScratchKey(void) {
+    (void) pthread_key_create(&m_scratchKey, m_freeThreadScratch);
+}
+
+/**
+ * @brief Returns a scratch buffer owned by the calling thread.  The buffer is kept between calls and only grows, so a kernel that runs over and over on the pool stops allocating after its first call.
+ * @param slot Which of the thread's MATRIX_SCRATCH_SLOTS buffers to use.  Different slots can be in use at the same time.
+ * @param bytes The minimum size of the buffer
+ * @return A 64-byte aligned buffer with unspecified contents.  It stays valid until the next call with the same slot on the same thread, and is freed when the thread exits.
+ */
+void*
+m_threadScratch(const size_t slot, const size_t bytes) {
+    assert(slot < MATRIX_SCRATCH_SLOTS);
+    (void) pthread_once(&m_scratchKeyOnce, m_createScratchKey);
+    matrix_threadScratch_t *scratch = pthread_getspecific(m_scratchKey);
+    if(NULL == scratch) {
+        scratch = calloc(1, sizeof(matrix_threadScratch_t));
+        assert(NULL != scratch);
+        (void) pthread_setspecific(m_scratchKey, scratch);
+    }
+    if(scratch->capacity[slot] < bytes) {
+        const size_t capacity = (bytes + 63) & ~(size_t) 63;
+        free(scratch->buffer[slot]);
+        scratch->buffer[slot] = aligned_alloc(64, capacity);
+        assert(NULL != scratch->buffer[slot]);
+        scratch->capacity[slot] = capacity;
+    }
+    return scratch->buffer[slot];
+}
+
+/**
+ * @brief Sets the number of threads the library uses, including the calling thread.  If the pool already exists with a different size, it is shut down and recreated on the next parallel call.
+ * @param thread_count The number of threads.  0 restores the default: the value of MATRIX_NUM_THREADS if it is set, otherwise the number of online processors.
+ */
+void
+m_setThreadCount(const size_t thread_count) {
+    pthread_mutex_lock(&m_pool.job_lock);
+    m_requestedThreadCount = thread_count;
+    if((0 != m_pool.thread_count) && (m_pool.thread_count != m_getThreadCount())) {
+        m_destroyPoolLocked();
+    }
+    pthread_mutex_unlock(&m_pool.job_lock);
+}
+
+/**
+ * @brief Joins and frees the worker threads.  It is registered with atexit, and may also be called directly.  The next parallel call creates a new pool.
+ */
+void
+m_shutdownThreadPool(void) {
+    pthread_mutex_lock(&m_pool.job_lock);
+    m_destroyPoolLocked();
+    pthread_mutex_unlock(&m_pool.job_lock);
+}
+
+/**
+ * @brief Runs task(context, t, worker) for every t in [0, task_count) on the thread pool and returns when all tasks have finished.  The tasks are dealt out to the workers in contiguous ranges.  A worker that finishes its own range steals the remaining tasks of the other workers' ranges.
+ * @param task_count The number of tasks
+ * @param task The function to run
+ * @param context Passed through to the function
+ * @note Calls are serialized: one parallel job runs at a time.  A call made from inside a task runs its tasks serially on the calling thread.
+ */
+void
+m_parallelFor(const size_t task_count, matrix_task_fn task, void *context) {
+    if((task_count <= 1) || m_insideParallelFor || (1 == m_getThreadCount())) {
+        for(size_t index = 0; index < task_count; index++) {
+            task(context, index, 0);
+        }
+        return;
+    }
+
+    pthread_mutex_lock(&m_pool.job_lock);
+    if(0 == m_pool.thread_count) {
+        m_createPoolLocked(m_getThreadCount());
+    }
+    const size_t worker_count = (task_count < m_pool.thread_count) ? task_count : m_pool.thread_count;
+
+    /* Deal the tasks out in contiguous ranges, spreading the remainder over the first workers. */
+    const size_t share = task_count / worker_count;
+    const size_t remainder = task_count % worker_count;
+    size_t begin = 0;
+    for(size_t worker = 0; worker < worker_count; worker++) {
+        const size_t length = share + ((worker < remainder) ? 1 : 0);
+        atomic_store_explicit(&m_pool.ranges[worker].next, begin, memory_order_relaxed);
+        m_pool.ranges[worker].end = begin + length;
+        begin += length;
+    }
+    m_pool.task = task;
+    m_pool.context = context;
+
+    pthread_mutex_lock(&m_pool.wake_lock);
+    m_pool.job_workers = worker_count;
+    m_pool.active_workers = worker_count - 1;
+    m_pool.generation++;
+    pthread_cond_broadcast(&m_pool.wake);
+    pthread_mutex_unlock(&m_pool.wake_lock);
+
+    m_insideParallelFor = true;
+    m_runTasks(0, worker_count);
+    m_insideParallelFor = false;
+
+    pthread_mutex_lock(&m_pool.wake_lock);
+    while(0 != m_pool.active_workers) {
+        pthread_cond_wait(&m_pool.done, &m_pool.wake_lock);
+    }
+    pthread_mutex_unlock(&m_pool.wake_lock);
+    pthread_mutex_unlock(&m_pool.job_lock);
+}
@@ -0,0 +1,72 @@
+/**
+ * @file matrix_threads.h
+ * @brief The library-owned thread pool used to parallelize matrix operations
+ * @author Aaron Fleisher
+ * @date 2026-10-16
+ *
+ * The pool is created the first time an operation runs in parallel and is reused by every later call.  Threads are never created per call.
+ */
+
+#ifndef MATRIX_THREADS_H
+#define MATRIX_THREADS_H
+
+#include "myMatrix.h"
+
+/**
+ * @brief The name of the environment variable that overrides the default number of threads.
+ */
+#define MATRIX_THREADS_ENVIRONMENT "MATRIX_NUM_THREADS"
+
+/**
+ * @brief A unit of parallel work.
+ * @param context The pointer handed to m_parallelFor
+ * @param task The index of the task, 0 <= task < task_count
+ * @param worker The index of the thread running the task, 0 <= worker < m_getThreadCount().  Worker 0 is always the calling thread.
+ */
+typedef void (*matrix_task_fn)(void *context, const size_t task, const size_t worker);
+
+/**
+ * @brief Sets the number of threads the library uses, including the calling thread.  If the pool already exists with a different size, it is shut down and recreated on the next parallel call.
+ * @param thread_count The number of threads.  0 restores the default: the value of MATRIX_NUM_THREADS if it is set, otherwise the number of online processors.
+ */
+void
+m_setThreadCount(const size_t thread_count);
+
+/**
+ * @brief Returns the number of threads the library uses, including the calling thread.
+ * @return The explicit count set with m_setThreadCount, otherwise MATRIX_NUM_THREADS, otherwise the number of online processors.
+ */
+size_t
+m_getThreadCount(void);
+
+/**
+ * @brief Runs task(context, t, worker) for every t in [0, task_count) on the thread pool and returns when all tasks have finished.  The tasks are dealt out to the workers in contiguous ranges.  A worker that finishes its own range steals the remaining tasks of the other workers' ranges.
+ * @param task_count The number of tasks
+ * @param task The function to run
+ * @param context Passed through to the function
+ * @note Calls are serialized: one parallel job runs at a time.  A call made from inside a task runs its tasks serially on the calling thread.
+ */
+void
+m_parallelFor(const size_t task_count, matrix_task_fn task, void *context);
+
+/**
+ * @brief The number of scratch slots each thread owns.
+ */
+#define MATRIX_SCRATCH_SLOTS 4
+
+/**
+ * @brief Returns a scratch buffer owned by the calling thread.  The buffer is kept between calls and only grows, so a kernel that runs over and over on the pool stops allocating after its first call.
+ * @param slot Which of the thread's MATRIX_SCRATCH_SLOTS buffers to use.  Different slots can be in use at the same time.
+ * @param bytes The minimum size of the buffer
+ * @return A 64-byte aligned buffer with unspecified contents.  It stays valid until the next call with the same slot on the same thread, and is freed when the thread exits.
+ */
+void*
+m_threadScratch(const size_t slot, const size_t bytes);
+
+/**
+ * @brief Joins and frees the worker threads.  It is registered with atexit, and may also be called directly.  The next parallel call creates a new pool.
+ */
+void
+m_shutdownThreadPool(void);
+
+#endif /** MATRIX_THREADS_H */
@@ -4,48 +4,556 @@
  * @author Aaron Fleisher
  * @date 2026-01-26
  * 
- * @todo Find a better way to hold the allocations in memory, perhaps an arena or pool.
  * @todo Use discriminated unions to make an easier way to use matrices of different types
  * @todo Use a better random number generator such as Mersenne twister or openSSL's random number generator
  * @todo Add a description of the space and time O() values of each function
  * @todo Ensure const correctness
  */
+#include <limits.h>
+#include <math.h>
+
 #include "myMatrix.h"
+#include "matrix_bits.h"
+#include "matrix_pool.h"
+#include "matrix_simd.h"
+#include "matrix_sparse.h"
+#include "matrix_threads.h"
+
 
 
 /*************************** MATRIX WIDE OPERATIONS ************************/
 
+/**
+ * @brief Allocates zeroed memory from an arena, or from the size-class pool (see matrix_pool.h) when the arena is NULL.
+ */
+static void*
+m_allocate(matrix_arena_t *arena, const size_t bytes) {
+    if(NULL == arena) {
+        void *memory = m_poolCalloc(bytes);
+        assert(NULL != memory);
+        return memory;
+    }
+    void *memory = m_arenaAlloc(arena, bytes);
+    memset(memory, 0, bytes);
+    return memory;
+}
+
+/**
+ * @brief Gives back memory taken with m_allocate.  Memory of an arena is left for the arena's reset.
+ */
+static void
+m_release(matrix_arena_t *arena, void *memory, const size_t bytes) {
+    if(NULL == arena) {
+        m_poolFree(memory, bytes);
+    }
+}
+
+/**
+ * @brief Records the properties that follow from the dimensions alone.
+ */
+static void
+m_setShapeProperties_int(matrix_int_t *m) {
+    m_setProperties_int(m, MATRIX_IS_SQUARE, m->i == m->j);
+    m_setProperties_int(m, MATRIX_IS_COLUMN, 1 == m->i);
+    m_setProperties_int(m, MATRIX_IS_ROW, 1 == m->j);
+    m_setProperties_int(m, MATRIX_IS_SINGLETON, (1 == m->i) && (1 == m->j));
+}
+
+/**
+ * @brief Chooses the leading dimension of a new matrix with j columns.  Rows of at least a cache line are padded to a whole number of cache lines, so that every row starts on an aligned boundary.  A row stride that is a multiple of 4096 bytes gets one more cache line, because rows that far apart map to the same L1 sets and alias in the load/store unit.  Narrower rows stay packed so small matrices do not pay for padding.
+ */
+static size_t
+m_leadingDimension_int(const size_t j) {
+    const size_t line = MATRIX_ALIGNMENT / sizeof(int);
+    if(j < line) {
+        return j;
+    }
+    size_t ld = ((j + line - 1) / line) * line;
+    if(0 == ((ld * sizeof(int)) % 4096)) {
+        ld += line;
+    }
+    return ld;
+}
+
+/**
+ * @brief Returns the size in bytes of the array of a matrix, which depends on its storage.
+ */
+static size_t
+m_arrayBytes_int(const matrix_int_t *m) {
+    switch(m->storage) {
+        case MATRIX_STORAGE_DENSE:
+            return m->i * m->ld * sizeof(int);
+        case MATRIX_STORAGE_DIAGONAL:
+            return m->i * sizeof(int);
+        case MATRIX_STORAGE_UPPER:
+        case MATRIX_STORAGE_LOWER:
+        case MATRIX_STORAGE_SYMMETRIC:
+            return ((m->i * (m->i + 1)) / 2) * sizeof(int);
+        case MATRIX_STORAGE_BANDED:
+            return m->i * (m->lower_bandwidth + m->upper_bandwidth + 1) * sizeof(int);
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Finds whether a matrix holds nothing off its diagonal by its storage alone: it is implicit or in compact diagonal storage.
+ */
+static bool
+m_isDiagonalStorage_int(const matrix_int_t *m) {
+    return m_isImplicit_int(m) || (MATRIX_STORAGE_DIAGONAL == m->storage);
+}
+
+/**
+ * @brief Finds whether a matrix is in packed upper or lower triangular storage.
+ */
+static bool
+m_isPackedTriangle_int(const matrix_int_t *m) {
+    return (MATRIX_STORAGE_UPPER == m->storage) || (MATRIX_STORAGE_LOWER == m->storage);
+}
+
+/**
+ * @brief Finds whether a matrix keeps part of its rows in a packed array: packed triangular, packed symmetric or banded storage.
+ */
+static bool
+m_isPacked_int(const matrix_int_t *m) {
+    return m_isPackedTriangle_int(m) || (MATRIX_STORAGE_SYMMETRIC == m->storage) || (MATRIX_STORAGE_BANDED == m->storage);
+}
+
+/**
+ * @brief Finds whether a matrix keeps its elements in 8 or 16 bits.
+ */
+static bool
+m_isNarrow_int(const matrix_int_t *m) {
+    return (MATRIX_STORAGE_INT8 == m->storage) || (MATRIX_STORAGE_INT16 == m->storage);
+}
+
+/**
+ * @brief Returns the size in bytes of the elements of a narrowed matrix, 0 for any other.
+ */
+static size_t
+m_narrowWidth_int(const matrix_int_t *m) {
+    switch(m->storage) {
+        case MATRIX_STORAGE_INT8:
+            return sizeof(int8_t);
+        case MATRIX_STORAGE_INT16:
+            return sizeof(int16_t);
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Finds whether a matrix keeps its values outside of its array: in sparse, bitpacked or narrowed storage.
+ */
+static bool
+m_isEncoded_int(const matrix_int_t *m) {
+    return (MATRIX_STORAGE_CSR == m->storage) || (MATRIX_STORAGE_BITS == m->storage) || m_isNarrow_int(m);
+}
+
+/**
+ * @brief Gives back the array of a matrix, or the encoding of an encoded one, and leaves it with neither.  The storage is for the caller to set.
+ */
+static void
+m_releaseStorage_int(matrix_int_t *m) {
+    if(MATRIX_STORAGE_CSR == m->storage) {
+        freeMatrix_sparse(m->sparse);
+    } else if(MATRIX_STORAGE_BITS == m->storage) {
+        freeMatrix_bits(m->bits);
+    } else if(m_isNarrow_int(m)) {
+        m_release(NULL, m->narrow, m->i * m->ld * m_narrowWidth_int(m));
+    } else {
+        m_release(m->arena, m->array, m_arrayBytes_int(m));
+    }
+    m->array = NULL;
+    m->lower_bandwidth = 0;
+    m->upper_bandwidth = 0;
+}
+
+/**
+ * @brief Finds the columns [first, end) that one row of a dense or packed matrix stores.  In a packed triangular or banded matrix every other element of the row is zero; in a packed symmetric one, which stores the upper triangle, the others are found in the rows above.
+ */
+static void
+m_storedColumns_int(const matrix_int_t *m, const size_t row, size_t *first, size_t *end) {
+    if(MATRIX_STORAGE_BANDED == m->storage) {
+        *first = (row > m->lower_bandwidth) ? (row - m->lower_bandwidth) : 0;
+        *end = ((row + m->upper_bandwidth + 1) < m->j) ? (row + m->upper_bandwidth + 1) : m->j;
+        return;
+    }
+    *first = ((MATRIX_STORAGE_UPPER == m->storage) || (MATRIX_STORAGE_SYMMETRIC == m->storage)) ? row : 0;
+    *end = (MATRIX_STORAGE_LOWER == m->storage) ? (row + 1) : m->j;
+}
+
+/**
+ * @brief Returns a pointer through which element (row, c) of a dense or packed matrix is at [c], for every column c that the row stores (see m_storedColumns_int).  A packed upper or symmetric row stores no columns left of the diagonal, so its pointer is offset back by row elements, and a banded row starts kl columns left of the diagonal, so its pointer is offset back by row - kl.
+ */
+static int*
+m_rowPointer_int(const matrix_int_t *m, const size_t row) {
+    switch(m->storage) {
+        case MATRIX_STORAGE_BANDED:
+            return m->array + (row * (m->lower_bandwidth + m->upper_bandwidth)) + m->lower_bandwidth;
+        case MATRIX_STORAGE_UPPER:
+        case MATRIX_STORAGE_SYMMETRIC:
+            return m->array + ((row * ((2 * m->i) - row + 1)) / 2) - row;
+        case MATRIX_STORAGE_LOWER:
+            return m->array + ((row * (row + 1)) / 2);
+        default:
+            return m->array + (row * m->ld);
+    }
+}
+
+/**
+ * @brief Returns element (row, column) of a matrix in packed symmetric storage, from the upper triangle either way.
+ */
+static int
+m_symmetricAt_int(const matrix_int_t *m, const size_t row, const size_t column) {
+    return (column >= row) ? m_rowPointer_int(m, row)[column] : m_rowPointer_int(m, column)[row];
+}
+
+/**
+ * @brief Widens length elements of one row of a narrowed matrix, from column first on, into destination.
+ */
+static void
+m_widenRow_int(const matrix_int_t *m, const size_t row, const size_t first, const size_t length, int *destination) {
+    const size_t offset = (row * m->ld) + first;
+    if(MATRIX_STORAGE_INT8 == m->storage) {
+        m_kernels_int()->widen_int8(destination, (const int8_t *) m->narrow + offset, length);
+    } else {
+        m_kernels_int()->widen_int16(destination, (const int16_t *) m->narrow + offset, length);
+    }
+}
+
+/**
+ * @brief Copies every element of one row of a matrix, in any storage, into destination, which holds m->j integers.
+ */
+static void
+m_copyRow_int(matrix_int_t *m, const size_t row, int *destination) {
+    if(m_isDiagonalStorage_int(m)) {
+        memset(destination, 0, m->j * sizeof(int));
+        if(row < m->j) {
+            destination[row] = m_at_int(m, row, row);
+        }
+        return;
+    }
+    if(MATRIX_STORAGE_CSR == m->storage) {
+        const matrix_sparse_t *sparse = m->sparse;
+        memset(destination, 0, m->j * sizeof(int));
+        for(size_t index = sparse->offsets[row]; index < sparse->offsets[row + 1]; index++) {
+            destination[sparse->indices[index]] = sparse->values[index];
+        }
+        return;
+    }
+    if(MATRIX_STORAGE_BITS == m->storage) {
+        for(size_t column = 0; column < m->j; column++) {
+            destination[column] = m_at_bits(m->bits, row, column);
+        }
+        return;
+    }
+    if(m_isNarrow_int(m)) {
+        m_widenRow_int(m, row, 0, m->j, destination);
+        return;
+    }
+    size_t first, end;
+    m_storedColumns_int(m, row, &first, &end);
+    const int *values = m_rowPointer_int(m, row);
+    if(MATRIX_STORAGE_SYMMETRIC == m->storage) {
+        /* Left of the diagonal, row r is column r of the rows above. */
+        for(size_t column = 0; column < first; column++) {
+            destination[column] = m_rowPointer_int(m, column)[row];
+        }
+    } else {
+        memset(destination, 0, first * sizeof(int));
+        memset(destination + end, 0, (m->j - end) * sizeof(int));
+    }
+    memcpy(destination + first, values + first, (end - first) * sizeof(int));
+}
+
+/**
+ * @brief Allocates the header of an i x j matrix without an element array.  Implicit matrices stop here; initializeMatrixArena_int goes on to allocate the array.
+ */
+static matrix_int_t*
+m_initializeHeader_int(matrix_arena_t *arena, const size_t i, const size_t j) {
+    matrix_int_t *m = m_allocate(arena, sizeof(matrix_int_t));
+    m->i = i;
+    m->j = j;
+    m->ld = m_leadingDimension_int(j);
+    m->arena = arena;
+    m_setShapeProperties_int(m);
+    return m;
+}
+
+/**
+ * @brief Records every content property of an implicit matrix.  They follow from the storage and the diagonal value, so an implicit matrix never needs a sweep.
+ */
+static void
+m_setImplicitProperties_int(matrix_int_t *m) {
+    const bool square = (m->i == m->j);
+    if(MATRIX_STORAGE_NULL == m->storage) {
+        m_setProperties_int(m, MATRIX_IS_BINARY | MATRIX_IS_NULL, true);
+        m_setProperties_int(m, MATRIX_IS_UPPER_TRIANGULAR | MATRIX_IS_LOWER_TRIANGULAR | MATRIX_IS_DIAGONAL | MATRIX_IS_SYMMETRIC | MATRIX_IS_SINGULAR | MATRIX_IS_IDEMPOTENT | MATRIX_IS_NILPOTENT, square);
+        m_setProperties_int(m, MATRIX_IS_IDENTITY | MATRIX_IS_STOCHASTIC | MATRIX_IS_ORTHOGONAL | MATRIX_IS_INVOLUTORY, false);
+        return;
+    }
+    /* Identity and scalar matrices are square and diagonal, with a diagonal value other than 0. */
+    const bool identity = (MATRIX_STORAGE_IDENTITY == m->storage);
+    m_setProperties_int(m, MATRIX_IS_UPPER_TRIANGULAR | MATRIX_IS_LOWER_TRIANGULAR | MATRIX_IS_DIAGONAL | MATRIX_IS_SYMMETRIC, true);
+    m_setProperties_int(m, MATRIX_IS_NULL | MATRIX_IS_SINGULAR | MATRIX_IS_NILPOTENT, false);
+    m_setProperties_int(m, MATRIX_IS_BINARY | MATRIX_IS_IDENTITY | MATRIX_IS_IDEMPOTENT | MATRIX_IS_STOCHASTIC, identity);
+    m_setProperties_int(m, MATRIX_IS_ORTHOGONAL | MATRIX_IS_INVOLUTORY, identity || (-1 == m->scalar));
+}
+
+/**
+ * @brief Makes m the implicit matrix scalar x I, choosing the identity or null storage for a scalar of 1 or 0.  The old values and properties are forgotten, and the new properties recorded; the array, if any, is not freed.
+ */
+static void
+m_setImplicit_int(matrix_int_t *m, const int scalar) {
+    m->storage = (0 == scalar) ? MATRIX_STORAGE_NULL : ((1 == scalar) ? MATRIX_STORAGE_IDENTITY : MATRIX_STORAGE_SCALAR);
+    m->scalar = scalar;
+    m_invalidateProperties_int(m);
+}
+
 /**
  * @brief Allocates a place in the heap for the matrix of dimensions i, columns, by j, rows 
  * @param i The number of rows, i.e. vectors
  * @param j The number of columns, i.e. items in each vector
- * @return A pointer to a matrix stuct
+ * @return A pointer to a matrix stuct.  The header and arrays of up to MATRIX_POOL_MAX_BLOCK bytes come from the size-class pool, so small matrices are recycled without touching malloc.
  */
 matrix_int_t* 
 initializeMatrix_int(const int i, const int j) {
-    matrix_int_t *m = malloc(sizeof(matrix_int_t));
-
-    m->i = i;
-    m->j = j;
+    return initializeMatrixArena_int(NULL, i, j);
+}
 
-    /* Allocating an array the size of the matrix */
-    m->array = calloc(i * j, sizeof(int));
+/**
+ * @brief Allocates a matrix of dimensions i by j from an arena.  The values are zero.
+ * @param arena The arena to allocate from, or NULL to allocate upon the heap
+ * @param i The number of rows, i.e. vectors
+ * @param j The number of columns, i.e. items in each vector
+ * @return A pointer to a matrix stuct.  freeMatrix_int does nothing for an arena matrix; it is taken back when the arena is reset.
+ */
+matrix_int_t*
+initializeMatrixArena_int(matrix_arena_t *arena, const int i, const int j) {
+    matrix_int_t *m = m_initializeHeader_int(arena, i, j);
 
-    /* The eigenvector of a matrix is a column vector of the same size as the column of the original matrix */
-    m->properties.eigenvector = calloc(j, sizeof(complex));
+    /* Allocating an array the size of the matrix, including the padding of every row.  Derived data, such as the eigenvector, is only allocated when it is computed. */
+    m->array = m_allocate(arena, (size_t) i * m->ld * sizeof(int));
 
     return m;
 }
 
 /**
- * @brief The matrix_int_t type has two arrays that need to be cleaned up before freeing the memory for the entire struct.
+ * @brief Frees the derived data of a matrix, if it has any.  The derived data of an arena matrix is simply dropped; the arena takes it back on reset.
+ */
+static void
+m_freeDerived_int(matrix_int_t *m) {
+    if(NULL != m->properties.derived) {
+        if(NULL != m->properties.derived->eigenvector) {
+            m_release(m->arena, m->properties.derived->eigenvector, m->j * sizeof(complex));
+        }
+        m_release(m->arena, m->properties.derived, sizeof(matrix_derived_int_t));
+        m->properties.derived = NULL;
+    }
+}
+
+/**
+ * @brief The matrix_int_t type has an array, and possibly derived data, that need to be cleaned up before freeing the memory for the entire struct.  The header, derived data and small arrays go back to the calling thread's pool (see matrix_pool.h).  Matrices allocated from an arena are left alone; the arena owns their memory.  For a view only the derived data is released, since the view does not own its array and lives wherever the caller stored it.
  * @param m The matrix that will be freed.
  */
 void
 freeMatrix_int(matrix_int_t *m) {
-    free(m->array);
-    free(m->properties.eigenvector);
-    free(m);
+    /* An implicit matrix has no array, so releasing the NULL array below does nothing. */
+    if(NULL != m->parent) {
+        m_freeDerived_int(m);
+        return;
+    }
+    if(NULL != m->arena) {
+        return;
+    }
+    m_releaseStorage_int(m);
+    m_freeDerived_int(m);
+    m_release(NULL, m, sizeof(matrix_int_t));
+}
+
+/**
+ * @brief Returns the cached state of a single property without computing it.
+ * @param m matrix_int_t. The matrix
+ * @param flag A single matrix_propertyFlag_t
+ * @return MATRIX_PROPERTY_UNKNOWN if the property has not been computed, otherwise MATRIX_PROPERTY_TRUE or MATRIX_PROPERTY_FALSE
+ */
+matrix_property_t
+m_propertyState_int(const matrix_int_t *m, const uint32_t flag) {
+    if(0 == (m->properties.known & flag)) {
+        return MATRIX_PROPERTY_UNKNOWN;
+    }
+    return (0 != (m->properties.value & flag)) ? MATRIX_PROPERTY_TRUE : MATRIX_PROPERTY_FALSE;
+}
+
+/**
+ * @brief Records the value of one or more properties in the cache.
+ * @param m matrix_int_t. The matrix
+ * @param flags One or more matrix_propertyFlag_t or'ed together
+ * @param value The value to record for all of them
+ */
+void
+m_setProperties_int(matrix_int_t *m, const uint32_t flags, const bool value) {
+    m->properties.known |= flags;
+    if(value) {
+        m->properties.value |= flags;
+    } else {
+        m->properties.value &= ~flags;
+    }
+}
+
+/**
+ * @brief Tests, without computing anything, whether any of the given properties is known to be true.  This is a single AND of the known and value words, so dispatch code can ask e.g. "diagonal or identity or null" in O(1).
+ * @param m matrix_int_t. The matrix
+ * @param flags One or more matrix_propertyFlag_t or'ed together
+ * @return true if at least one of the flags is cached as true
+ */
+bool
+m_hasAnyProperty_int(const matrix_int_t *m, const uint32_t flags) {
+    return 0 != (m->properties.known & m->properties.value & flags);
+}
+
+/**
+ * @brief Returns the derived data of the matrix, allocating it on first use.  Functions that compute an eigenvector, eigenvalue or determinant store the result here.
+ * @param m matrix_int_t. The matrix
+ * @return The matrix's derived data.  It is freed by freeMatrix_int and by m_invalidateProperties_int.  An arena matrix takes it from the same arena.
+ */
+matrix_derived_int_t*
+m_derived_int(matrix_int_t *m) {
+    if(NULL == m->properties.derived) {
+        m->properties.derived = m_allocate(m->arena, sizeof(matrix_derived_int_t));
+    }
+    return m->properties.derived;
+}
+
+/**
+ * @brief Forgets every cached property that depends on the values in the matrix.  The shape properties (square, row, column, singleton) are kept, because no operation changes the dimensions in place.  Every function that modifies a matrix calls this, and code that writes to m->array directly must call it too (after m_materialize_int).
+ * @param m matrix_int_t. The matrix that was modified
+ */
+void
+m_invalidateProperties_int(matrix_int_t *m) {
+    assert(NULL != m);
+    m_freeDerived_int(m);
+    m->properties.known &= MATRIX_SHAPE_PROPERTIES;
+    /* The properties of an implicit matrix follow from its header, so they are never unknown. */
+    if(m_isImplicit_int(m)) {
+        m_setImplicitProperties_int(m);
+    }
+    /* Writing through a view changes its owner's values too. */
+    if(NULL != m->parent) {
+        m_invalidateProperties_int(m->parent);
+    }
+}
+
+/**
+ * @brief Gives a matrix in an implicit, compact or encoded storage (see matrix_storage_t) a dense element array holding its values.  Functions that write elements call this first, and code that reads or writes m->array directly must call it too.  The cached properties stay valid, since the values do not change.
+ * @param m matrix_int_t. The matrix.  A dense matrix is left alone.
+ */
+void
+m_materialize_int(matrix_int_t *m) {
+    if(MATRIX_STORAGE_DENSE == m->storage) {
+        return;
+    }
+    int *dense = m_allocate(m->arena, m->i * m->ld * sizeof(int));
+    if(m_isPacked_int(m) || m_isEncoded_int(m)) {
+        for(size_t row = 0; row < m->i; row++) {
+            m_copyRow_int(m, row, dense + (row * m->ld));
+        }
+    } else if(MATRIX_STORAGE_NULL != m->storage) {
+        /* Stepping ld + 1 elements moves one row down and one column right. */
+        for(size_t index = 0; index < m->i; index++) {
+            dense[index * (m->ld + 1)] = m_at_int(m, index, index);
+        }
+    }
+    m_releaseStorage_int(m);
+    m->array = dense;
+    m->storage = MATRIX_STORAGE_DENSE;
+}
+
+/**
+ * @brief Moves a dense, packed or sparse, square matrix whose values are only on the diagonal to the most compact storage for it: an implicit scalar matrix (which includes the identity and null matrices) when the diagonal is constant, otherwise MATRIX_STORAGE_DIAGONAL.  The cached properties stay valid.
+ */
+static void
+m_compactDiagonal_int(matrix_int_t *m) {
+    int *diagonal = m_allocate(m->arena, m->i * sizeof(int));
+    bool constant = true;
+    for(size_t index = 0; index < m->i; index++) {
+        diagonal[index] = m_at_int(m, index, index);
+        constant = constant && (diagonal[index] == diagonal[0]);
+    }
+    m_releaseStorage_int(m);
+    m->array = diagonal;
+    m->storage = MATRIX_STORAGE_DIAGONAL;
+    if(constant) {
+        const int scalar = diagonal[0];
+        m_release(m->arena, m->array, m_arrayBytes_int(m));
+        m->array = NULL;
+        m_setImplicit_int(m, scalar);
+    }
+}
+
+/**
+ * @brief Moves a dense, square matrix that is upper or lower triangular, or symmetric, to the packed storage for it, which holds the n(n + 1)/2 values of one triangle instead of n x ld.  The cached properties stay valid.
+ */
+static void
+m_packTriangle_int(matrix_int_t *m, const matrix_storage_t storage) {
+    /* The header of the packed matrix, for its size and row offsets, until the array is handed over. */
+    matrix_int_t packed = *m;
+    packed.storage = storage;
+    packed.array = m_allocate(m->arena, m_arrayBytes_int(&packed));
+    for(size_t row = 0; row < m->i; row++) {
+        size_t first, end;
+        m_storedColumns_int(&packed, row, &first, &end);
+        memcpy(m_rowPointer_int(&packed, row) + first, m->array + (row * m->ld) + first, (end - first) * sizeof(int));
+    }
+    m_release(m->arena, m->array, m_arrayBytes_int(m));
+    m->array = packed.array;
+    m->storage = storage;
+}
+
+/**
+ * @brief Moves a square matrix, in any storage, whose nonzeros all lie within lower diagonals below the diagonal and upper diagonals above it to banded storage, which holds the n(lower + upper + 1) values of the band instead of n x ld.  A dense or banded row is copied from where it is, a sparse one from its nonzeros, and any other through a row buffer, so nothing is expanded whole.  The cached properties stay valid.
+ */
+static void
+m_packBand_int(matrix_int_t *m, const size_t lower, const size_t upper) {
+    /* The header of the banded matrix, for its size and row offsets, until the array is handed over. */
+    matrix_int_t band = *m;
+    band.storage = MATRIX_STORAGE_BANDED;
+    band.lower_bandwidth = (uint32_t) lower;
+    band.upper_bandwidth = (uint32_t) upper;
+    band.array = m_allocate(m->arena, m_arrayBytes_int(&band));
+    const matrix_sparse_t *sparse = (MATRIX_STORAGE_CSR == m->storage) ? m->sparse : NULL;
+    const bool direct = (MATRIX_STORAGE_DENSE == m->storage) || (MATRIX_STORAGE_BANDED == m->storage);
+    int *buffer = NULL;
+    if(!direct && (NULL == sparse)) {
+        buffer = malloc(m->j * sizeof(int));
+        assert(NULL != buffer);
+    }
+    for(size_t row = 0; row < m->i; row++) {
+        int *destination = m_rowPointer_int(&band, row);
+        if(NULL != sparse) {
+            for(size_t index = sparse->offsets[row]; index < sparse->offsets[row + 1]; index++) {
+                destination[sparse->indices[index]] = sparse->values[index];
+            }
+            continue;
+        }
+        const int *values = buffer;
+        if(direct) {
+            values = m_rowPointer_int(m, row);
+        } else {
+            m_copyRow_int(m, row, buffer);
+        }
+        size_t first, end;
+        m_storedColumns_int(&band, row, &first, &end);
+        memcpy(destination + first, values + first, (end - first) * sizeof(int));
+    }
+    free(buffer);
+    m_releaseStorage_int(m);
+    m->array = band.array;
+    m->storage = MATRIX_STORAGE_BANDED;
+    m->lower_bandwidth = (uint32_t) lower;
+    m->upper_bandwidth = (uint32_t) upper;
 }
 
 /**
@@ -57,10 +565,12 @@ freeMatrix_int(matrix_int_t *m) {
 void
 copyArrayToMatrix_int(matrix_int_t *m, const int *array, const size_t array_length) {
     assert(array_length == (m->i * m->j));
+    m_materialize_int(m);
 
-    for(size_t index = 0; index < array_length; index++) {
-        m->array[index] = array[index];
+    for(size_t row = 0; row < m->i; row++) {
+        memcpy(m->array + (row * m->ld), array + (row * m->j), m->j * sizeof(int));
     }
+    m_invalidateProperties_int(m);
 }
 
 /**
@@ -71,11 +581,11 @@ void
 printMatrix_int(matrix_int_t *m) {
     for(size_t row = 0; row < m->i; row++) {
         for(size_t column = 0; column < m->j; column++) {
-            size_t array_member = (row * m->j) + column;
-            (void) printf("%d ", m->array[array_member]);
+            (void) printf("%d ", m_at_int(m, row, column));
         }
         (void) printf("\n");
     }
+    /* The first query characterizes the whole matrix in one sweep; the rest are answered from the cached flags. */
     (void) printf("\tisBinary: %d\n", m_isBinary_int(m));
     (void) printf("\tisColumn: %d\n", m_isColumn_int(m));
     (void) printf("\tisRow: %d\n", m_isRow_int(m));
@@ -85,6 +595,9 @@ printMatrix_int(matrix_int_t *m) {
     (void) printf("\tisLowerTriangular: %d\n", m_isLowerTriangular_int(m));
     (void) printf("\tisIdentity: %d\n", m_isIdentity_int(m));
     (void) printf("\tisDiagonal: %d\n", m_isDiagonal_int(m));
+    (void) printf("\tisNull: %d\n", m_isNull_int(m));
+    (void) printf("\tisSymmetric: %d\n", m_isSymmetric_int(m));
+    (void) printf("\tisStochastic: %d\n", m_isStochastic_int(m));
     (void) printf("\n");
 }
 
@@ -92,58 +605,105 @@ printMatrix_int(matrix_int_t *m) {
 /**
  * @brief This generates an identity matrix of size, dim x dim.
  * @param dim the number of rows and columns in the matrix.  All identity matrices are square.  So, the function requires only one number to define the size of the matrix.
- * @return A new matrix allocated upon the heap
+ * @return A new matrix allocated upon the heap.  It is implicit (MATRIX_STORAGE_IDENTITY): only the header is allocated, whatever dim is.
  */
 matrix_int_t*
 generateIdentityMatrix_int(const int dim) {
-    assert(dim > 0);
-    matrix_int_t *identity_matrix = initializeMatrix_int(dim, dim);
+    return generateIdentityMatrixArena_int(NULL, dim);
+}
 
-    /**
-     * To find the place to insert the 1 value, 
-     * the algorithm must increase the column position by one per row.
-     * This library uses an array for all values,
-     * so we must keep track of the row number and column number
-     * seperately than the index value.  To do this simply,
-     * a modulo operation can help.  This will require only one extra variable,
-     * an column position index value.
-     */
-    unsigned int column_position = 0;
-    unsigned int array_index = 0;
-    while(array_index < (dim * dim)) {
-        if((array_index % dim) == column_position) {
-            identity_matrix->array[array_index] = 1;
-            column_position++;
-            array_index++; /* Have to move the array index up one more in order to get past the modulo.  Otherwise, it turns into all 1s on the first row and 0s elsewhere. */
-        } else {
-            identity_matrix->array[array_index] = 0;
-        }
-        array_index++;
-    }
+/**
+ * @brief Generates an identity matrix of size dim x dim in an arena.
+ * @param arena The arena to allocate from, or NULL to allocate upon the heap
+ * @param dim the number of rows and columns in the matrix
+ * @return A new implicit matrix allocated from the arena
+ */
+matrix_int_t*
+generateIdentityMatrixArena_int(matrix_arena_t *arena, const int dim) {
+    return generateScalarMatrixArena_int(arena, dim, 1);
+}
 
-    identity_matrix->properties.is_identity = true;
-    
-    identity_matrix->properties.determinant = 1;
-    identity_matrix->properties.is_binary = true;
-    
-    if(1 == dim) {
-        identity_matrix->properties.is_column = true;
-        identity_matrix->properties.is_row = true;
-        identity_matrix->properties.is_singleton = true;
-    } else {
-        identity_matrix->properties.is_column = false;
-        identity_matrix->properties.is_row = false;
-        identity_matrix->properties.is_singleton = false;
-    }
+/**
+ * @brief Generates a null matrix of size i x j, i.e. one whose elements are all 0.
+ * @param i The number of rows
+ * @param j The number of columns
+ * @return A new implicit matrix (MATRIX_STORAGE_NULL) allocated upon the heap.  Only the header is allocated.
+ */
+matrix_int_t*
+generateNullMatrix_int(const int i, const int j) {
+    return generateNullMatrixArena_int(NULL, i, j);
+}
+
+/**
+ * @brief Generates a null matrix of size i x j in an arena.
+ * @param arena The arena to allocate from, or NULL to allocate upon the heap
+ * @param i The number of rows
+ * @param j The number of columns
+ * @return A new implicit matrix allocated from the arena
+ */
+matrix_int_t*
+generateNullMatrixArena_int(matrix_arena_t *arena, const int i, const int j) {
+    assert((i >= 0) && (j >= 0));
+    matrix_int_t *null_matrix = m_initializeHeader_int(arena, i, j);
+    m_setImplicit_int(null_matrix, 0);
+    return null_matrix;
+}
+
+/**
+ * @brief Generates the scalar matrix scalar x I of size dim x dim.
+ * @param dim the number of rows and columns in the matrix
+ * @param scalar The value on the diagonal.  A scalar of 1 gives an identity matrix and a scalar of 0 a null matrix.
+ * @return A new implicit matrix allocated upon the heap.  Only the header is allocated.
+ */
+matrix_int_t*
+generateScalarMatrix_int(const int dim, const int scalar) {
+    return generateScalarMatrixArena_int(NULL, dim, scalar);
+}
+
+/**
+ * @brief Generates the scalar matrix scalar x I of size dim x dim in an arena.
+ * @param arena The arena to allocate from, or NULL to allocate upon the heap
+ * @param dim the number of rows and columns in the matrix
+ * @param scalar The value on the diagonal
+ * @return A new implicit matrix allocated from the arena
+ */
+matrix_int_t*
+generateScalarMatrixArena_int(matrix_arena_t *arena, const int dim, const int scalar) {
+    assert(dim > 0);
+    matrix_int_t *scalar_matrix = m_initializeHeader_int(arena, dim, dim);
+
+    /* Every content property is known up front, so none of them will ever need a sweep.  The determinant and eigenvalue of an identity matrix (both 1) follow from the identity flag, so no derived data is allocated. */
+    m_setImplicit_int(scalar_matrix, scalar);
+    return scalar_matrix;
+}
 
-    identity_matrix->properties.is_diagonal = true;
-    identity_matrix->properties.is_square = true;
-    identity_matrix->properties.is_identity = true;
-    identity_matrix->properties.is_idempotent = true;
-    identity_matrix->properties.is_null = false;
-    identity_matrix->properties.is_involutory = true;
+/**
+ * @brief Generates a diagonal matrix of size dim x dim in compact storage (MATRIX_STORAGE_DIAGONAL): only the dim diagonal values are allocated.
+ * @param dim the number of rows and columns in the matrix
+ * @param diagonal The dim values of the diagonal
+ * @return A new matrix allocated upon the heap
+ */
+matrix_int_t*
+generateDiagonalMatrix_int(const int dim, const int *diagonal) {
+    return generateDiagonalMatrixArena_int(NULL, dim, diagonal);
+}
 
-    return identity_matrix;
+/**
+ * @brief Generates a diagonal matrix of size dim x dim in compact storage in an arena.
+ * @param arena The arena to allocate from, or NULL to allocate upon the heap
+ * @param dim the number of rows and columns in the matrix
+ * @param diagonal The dim values of the diagonal
+ * @return A new matrix allocated from the arena
+ */
+matrix_int_t*
+generateDiagonalMatrixArena_int(matrix_arena_t *arena, const int dim, const int *diagonal) {
+    assert(dim > 0);
+    matrix_int_t *diagonal_matrix = m_initializeHeader_int(arena, dim, dim);
+    diagonal_matrix->storage = MATRIX_STORAGE_DIAGONAL;
+    diagonal_matrix->array = m_allocate(arena, m_arrayBytes_int(diagonal_matrix));
+    memcpy(diagonal_matrix->array, diagonal, dim * sizeof(int));
+    m_setProperties_int(diagonal_matrix, MATRIX_IS_UPPER_TRIANGULAR | MATRIX_IS_LOWER_TRIANGULAR | MATRIX_IS_DIAGONAL | MATRIX_IS_SYMMETRIC, true);
+    return diagonal_matrix;
 }
 
 /**
@@ -153,29 +713,65 @@ generateIdentityMatrix_int(const int dim) {
  */
 matrix_int_t*
 createCopy_int(matrix_int_t *m) {
+    return createCopyArena_int(NULL, m);
+}
+
+/**
+ * @brief Creates a copy of a matrix in an arena.
+ * @param arena The arena to allocate from, or NULL to allocate upon the heap
+ * @param m matrix_int_t The matrix to copy
+ * @return A new matrix allocated from the arena
+ */
+matrix_int_t*
+createCopyArena_int(matrix_arena_t *arena, matrix_int_t *m) {
     assert(m != NULL);
-    matrix_int_t *m2 = initializeMatrix_int(m->i, m->j);
-    memcpy(m2->array, m->array, (m->i * m->j) * sizeof(int));
-    m2->properties.determinant = m->properties.determinant;
-    m2->properties.dot_product = m->properties.dot_product;
-    memcpy(m2->properties.eigenvector, m->properties.eigenvector, m->j * sizeof(complex));
-    m2->properties.is_binary = m->properties.is_binary;
-    m2->properties.is_column = m->properties.is_column;
-    m2->properties.is_diagonal = m->properties.is_diagonal;
-    m2->properties.is_idempotent = m->properties.is_idempotent;
-    m2->properties.is_identity = m->properties.is_identity;
-    m2->properties.is_involutory = m->properties.is_involutory;
-    m2->properties.is_nilpotent = m->properties.is_nilpotent;
-    m2->properties.is_null = m->properties.is_null;
-    m2->properties.is_orthoganal = m->properties.is_orthoganal;
-    m2->properties.is_row = m->properties.is_row;
-    m2->properties.is_singleton = m->properties.is_singleton;
-    m2->properties.is_singular = m->properties.is_singular;
-    m2->properties.is_square = m->properties.is_square;
-    m2->properties.is_stochastic = m->properties.is_stochastic;
-    m2->properties.is_symmetric = m->properties.is_symmetric;
-    m2->properties.is_LowerTriangular = m->properties.is_LowerTriangular;
-    m2->properties.is_UpperTriangular = m->properties.is_UpperTriangular;
+    matrix_int_t *m2;
+    if(MATRIX_STORAGE_DENSE == m->storage) {
+        m2 = initializeMatrixArena_int(arena, m->i, m->j);
+        for(size_t row = 0; row < m->i; row++) {
+            memcpy(m2->array + (row * m2->ld), m->array + (row * m->ld), m->j * sizeof(int));
+        }
+    } else if(m_isEncoded_int(m) && (NULL != arena)) {
+        /* Encodings live upon the heap, so the copy in an arena is dense. */
+        m2 = initializeMatrixArena_int(arena, m->i, m->j);
+        for(size_t row = 0; row < m->i; row++) {
+            m_copyRow_int(m, row, m2->array + (row * m2->ld));
+        }
+    } else {
+        /* Copying an implicit matrix copies its header alone; a compact matrix copies its compact array, and an encoded one its encoding. */
+        m2 = m_initializeHeader_int(arena, m->i, m->j);
+        m2->storage = m->storage;
+        m2->scalar = m->scalar;
+        m2->lower_bandwidth = m->lower_bandwidth;
+        m2->upper_bandwidth = m->upper_bandwidth;
+        if(MATRIX_STORAGE_CSR == m->storage) {
+            m2->sparse = m_convert_sparse(m->sparse, MATRIX_SPARSE_CSR);
+        } else if(MATRIX_STORAGE_BITS == m->storage) {
+            m2->bits = initializeMatrix_bits(m->i, m->j);
+            memcpy(m2->bits->array, m->bits->array, m->bits->i * m->bits->ld * sizeof(uint64_t));
+        } else if(m_isNarrow_int(m)) {
+            m2->narrow = m_allocate(NULL, m->i * m->ld * m_narrowWidth_int(m));
+            memcpy(m2->narrow, m->narrow, m->i * m->ld * m_narrowWidth_int(m));
+        } else if(NULL != m->array) {
+            m2->array = m_allocate(arena, m_arrayBytes_int(m));
+            memcpy(m2->array, m->array, m_arrayBytes_int(m));
+        }
+    }
+    m2->format = m->format;
+    /* The copy has the same values, so every cached property carries over.  Derived data is only copied if it was computed. */
+    m2->properties.known = m->properties.known;
+    m2->properties.value = m->properties.value;
+    m2->properties.minimum = m->properties.minimum;
+    m2->properties.maximum = m->properties.maximum;
+    if(NULL != m->properties.derived) {
+        matrix_derived_int_t *derived = m_derived_int(m2);
+        *derived = *m->properties.derived;
+        if(NULL != m->properties.derived->eigenvector) {
+            derived->eigenvector = m_allocate(arena, m->j * sizeof(complex));
+            assert(NULL != derived->eigenvector);
+            memcpy(derived->eigenvector, m->properties.derived->eigenvector, m->j * sizeof(complex));
+        }
+    }
     return m2;
 }
 
@@ -189,27 +785,66 @@ createCopy_int(matrix_int_t *m) {
  */
 matrix_int_t*
 generateRandomMatrix_int(const int i, const int j, const int lower_bound, const int upper_bound) { 
-    matrix_int_t *m = initializeMatrix_int(i, j);
-    srand(time(0));
-    for(int index = 0; index < (m->i * m->j); index++) {
-        m->array[index] = rand() % ((upper_bound - lower_bound) +1) + lower_bound;
-    }
-    return m;
+    return generateRandomMatrixArena_int(NULL, i, j, lower_bound, upper_bound);
 }
 
-
-/******************************* INTERNAL MATRIX OPERATIONS **********************/
-
 /**
- * @brief This function finds the value of the matrix at any given dimension.
- * @param m The matrix
- * @param i The row index, using C style indexing (starting at 0)
- * @param j The column index, using C style indexing (starting at 0)
+ * @brief Generates a random matrix of size i x j, with values lower_bound <= x <= upper_bound, in an arena.
+ * @param arena The arena to allocate from, or NULL to allocate upon the heap
+ * @param i integer the number of rows in the matrix.
+ * @param j integer the number of columns in the matrix.
+ * @param lower_bound integer All values in the matrix are greater than or equal to this lower bound.
+ * @param upper_bound integer All values in the matrix are less than or equal to this upper bound.
+ * @return A new matrix allocated from the arena
+ */
+matrix_int_t*
+generateRandomMatrixArena_int(matrix_arena_t *arena, const int i, const int j, const int lower_bound, const int upper_bound) {
+    matrix_int_t *m = initializeMatrixArena_int(arena, i, j);
+    srand(time(0));
+    for(size_t row = 0; row < m->i; row++) {
+        for(size_t column = 0; column < m->j; column++) {
+            m->array[(row * m->ld) + column] = rand() % ((upper_bound - lower_bound) +1) + lower_bound;
+        }
+    }
+    return m;
+}
+
+
+/******************************* INTERNAL MATRIX OPERATIONS **********************/
+
+/**
+ * @brief This function finds the value of the matrix at any given dimension.
+ * @param m The matrix
+ * @param i The row index, using C style indexing (starting at 0)
+ * @param j The column index, using C style indexing (starting at 0)
  * @return Value at that column x row
  */
 int
 m_at_int(matrix_int_t *m, const int i, const int j) {
-    return m->array[(i * m->j) + j];
+    switch(m->storage) {
+        case MATRIX_STORAGE_DENSE:
+            return m->array[(i * m->ld) + j];
+        case MATRIX_STORAGE_DIAGONAL:
+            return (i == j) ? m->array[i] : 0;
+        case MATRIX_STORAGE_UPPER:
+            return (j >= i) ? m_rowPointer_int(m, i)[j] : 0;
+        case MATRIX_STORAGE_LOWER:
+            return (j <= i) ? m_rowPointer_int(m, i)[j] : 0;
+        case MATRIX_STORAGE_SYMMETRIC:
+            return m_symmetricAt_int(m, i, j);
+        case MATRIX_STORAGE_BANDED:
+            return (((size_t) j + m->lower_bandwidth >= (size_t) i) && ((size_t) j <= (size_t) i + m->upper_bandwidth)) ? m_rowPointer_int(m, i)[j] : 0;
+        case MATRIX_STORAGE_CSR:
+            return m_at_sparse(m->sparse, i, j);
+        case MATRIX_STORAGE_BITS:
+            return m_at_bits(m->bits, i, j);
+        case MATRIX_STORAGE_INT8:
+            return ((const int8_t *) m->narrow)[(i * m->ld) + j];
+        case MATRIX_STORAGE_INT16:
+            return ((const int16_t *) m->narrow)[(i * m->ld) + j];
+        default:
+            return (i == j) ? m->scalar : 0;
+    }
 }
 
 /**
@@ -222,7 +857,7 @@ int*
 m_selectColumn_int(matrix_int_t *m, const int column_number) {
     assert(0 <= column_number);
     assert(column_number < m->j);
-    int *column = calloc(m->j, sizeof(int));
+    int *column = calloc(m->i, sizeof(int));
     for(int index = 0; index < m->i; index++) {
         column[index] = m_at_int(m, index, column_number);
     }
@@ -240,15 +875,336 @@ m_selectRow_int(matrix_int_t *m, const int row_number) {
     assert(0 <= row_number);
     assert(row_number < m->i);
 
-    int *row = calloc(m->i, sizeof(int));
-    /**
-     * Find the index by multiplying the row_number by the number of columns in the matrix
-     */
-    memcpy(row, m->array + (row_number * m->j), m->j * sizeof(int));
+    int *row = calloc(m->j, sizeof(int));
+    m_copyRow_int(m, row_number, row);
     return row;
 }
 
 
+/**
+ * @brief Returns a view of a rectangular block of a matrix.  The view shares the parent's array and leading dimension, so creating it neither allocates nor copies, and every function that takes a matrix_int_t accepts it.
+ * @param m The matrix to view.  If m is itself a view, the new view points at the same owner.  A matrix in an implicit or compact storage is materialized first, since a view needs a dense array to point into.  The owner is pinned, so that characterizing it later does not move its array from under the view.
+ * @param row The first row of the block
+ * @param column The first column of the block
+ * @param rows The number of rows in the block
+ * @param columns The number of columns in the block
+ * @return The view, by value.  It stays valid as long as the parent's array does.  Writing through a view invalidates the properties of its owner; writing to the owner does not reach views that have already cached properties, so views are meant to be short-lived.
+ */
+matrix_int_t
+m_blockView_int(matrix_int_t *m, const size_t row, const size_t column, const size_t rows, const size_t columns) {
+    assert((row + rows) <= m->i);
+    assert((column + columns) <= m->j);
+    m_materialize_int(m);
+    if(NULL == m->parent) {
+        m->pinned = true;
+    }
+    matrix_int_t view = {
+        .i = rows,
+        .j = columns,
+        .array = m->array + (row * m->ld) + column,
+        .ld = m->ld,
+        .arena = m->arena,
+        .parent = (NULL != m->parent) ? m->parent : m,
+    };
+    m_setShapeProperties_int(&view);
+    return view;
+}
+
+/**
+ * @brief Returns a 1 x j view of one row of a matrix.  See m_blockView_int.
+ * @param m The matrix to view
+ * @param row The row, using C style indexing
+ * @return The view, by value
+ */
+matrix_int_t
+m_rowView_int(matrix_int_t *m, const size_t row) {
+    return m_blockView_int(m, row, 0, 1, m->j);
+}
+
+/**
+ * @brief Returns an i x 1 view of one column of a matrix.  Consecutive elements of the view are ld elements apart in memory.  See m_blockView_int.
+ * @param m The matrix to view
+ * @param column The column, using C style indexing
+ * @return The view, by value
+ */
+matrix_int_t
+m_columnView_int(matrix_int_t *m, const size_t column) {
+    return m_blockView_int(m, 0, column, m->i, 1);
+}
+
+/**
+ * @brief Finds whether a matrix is a view of another matrix's storage.
+ * @param m Pointer to the matrix_int_t struct
+ * @return boolean.  True if the matrix does not own its array.
+ */
+bool
+m_isView_int(const matrix_int_t *m) {
+    return NULL != m->parent;
+}
+
+/**
+ * @brief Finds whether a matrix is implicit, i.e. an identity, null or scalar matrix without an element array (see matrix_storage_t).
+ * @param m Pointer to the matrix_int_t struct
+ * @return boolean.  True if the matrix is not dense.
+ */
+bool
+m_isImplicit_int(const matrix_int_t *m) {
+    return (MATRIX_STORAGE_IDENTITY == m->storage) || (MATRIX_STORAGE_NULL == m->storage) || (MATRIX_STORAGE_SCALAR == m->storage);
+}
+
+/**
+ * @brief Adds the diagonal of an implicit or diagonal matrix to the diagonal of a dense matrix of the same shape, or subtracts it.  This is how such an operand joins a sum without being materialized.  A rectangular matrix has min(i, j) diagonal elements.
+ */
+static void
+m_addDiagonal_int(matrix_int_t *m, matrix_int_t *diagonal, const bool subtract) {
+    const size_t length = (m->i < m->j) ? m->i : m->j;
+    for(size_t index = 0; index < length; index++) {
+        const unsigned int value = (unsigned int) m_at_int(diagonal, index, index);
+        int *destination = m->array + (index * (m->ld + 1));
+        *destination = (int) (subtract ? ((unsigned int) *destination - value) : ((unsigned int) *destination + value));
+    }
+    m_invalidateProperties_int(m);
+}
+
+/**
+ * @brief Returns the diagonal of a square matrix with nothing off its diagonal as an array: the array of a compact diagonal matrix, or else buffer, filled with the diagonal of whatever storage the matrix is in.
+ */
+static const int*
+m_diagonalValues_int(matrix_int_t *m, int *buffer) {
+    if(MATRIX_STORAGE_DIAGONAL == m->storage) {
+        return m->array;
+    }
+    for(size_t index = 0; index < m->i; index++) {
+        buffer[index] = m_at_int(m, index, index);
+    }
+    return buffer;
+}
+
+/**
+ * @brief Combines the diagonals of two square matrices with nothing off their diagonals, elementwise, with an add, subtract or multiply kernel.  The result is an implicit scalar matrix when both operands are implicit, otherwise a compact diagonal matrix.  It costs O(n).
+ */
+static matrix_int_t*
+m_combineDiagonals_int(matrix_arena_t *arena, matrix_int_t *m1, matrix_int_t *m2, void (*kernel)(int*, const int*, const int*, const size_t)) {
+    if(m_isImplicit_int(m1) && m_isImplicit_int(m2)) {
+        int scalar;
+        kernel(&scalar, &m1->scalar, &m2->scalar, 1);
+        return generateScalarMatrixArena_int(arena, m1->i, scalar);
+    }
+    matrix_int_t *m = m_initializeHeader_int(arena, m1->i, m1->j);
+    m->storage = MATRIX_STORAGE_DIAGONAL;
+    m->array = m_allocate(arena, m_arrayBytes_int(m));
+    /* An operand that is not compact is spread over the result's array first; the kernels are elementwise, so they may write over their input.  Only when neither is compact does the second one need a buffer of its own. */
+    int *buffer = NULL;
+    const int *d1 = m_diagonalValues_int(m1, m->array);
+    if((d1 == m->array) && (MATRIX_STORAGE_DIAGONAL != m2->storage)) {
+        buffer = malloc(m->i * sizeof(int));
+        assert(NULL != buffer);
+    }
+    const int *d2 = m_diagonalValues_int(m2, (NULL != buffer) ? buffer : m->array);
+    kernel(m->array, d1, d2, m->i);
+    free(buffer);
+    m_setProperties_int(m, MATRIX_IS_UPPER_TRIANGULAR | MATRIX_IS_LOWER_TRIANGULAR | MATRIX_IS_DIAGONAL | MATRIX_IS_SYMMETRIC, true);
+    return m;
+}
+
+/**
+ * @brief Applies a unary kernel to every row of a matrix.  A matrix without padding is one contiguous run and takes a single call.
+ */
+static void
+m_applyRows_int(matrix_int_t *m, void (*kernel)(int*, const int, const size_t), const int scalar) {
+    if(m->ld == m->j) {
+        kernel(m->array, scalar, m->i * m->j);
+        return;
+    }
+    for(size_t row = 0; row < m->i; row++) {
+        kernel(m->array + (row * m->ld), scalar, m->j);
+    }
+}
+
+/**
+ * @brief Applies a binary kernel to every row of two matrices, writing into a third.  When none of them is padded the whole matrix takes a single call.
+ */
+static void
+m_combineRows_int(matrix_int_t *m, const matrix_int_t *m1, const matrix_int_t *m2, void (*kernel)(int*, const int*, const int*, const size_t)) {
+    if((m->ld == m->j) && (m1->ld == m1->j) && (m2->ld == m2->j)) {
+        kernel(m->array, m1->array, m2->array, m->i * m->j);
+        return;
+    }
+    for(size_t row = 0; row < m->i; row++) {
+        kernel(m->array + (row * m->ld), m1->array + (row * m1->ld), m2->array + (row * m2->ld), m->j);
+    }
+}
+
+/**
+ * @brief Returns the property that a packed storage guarantees: upper or lower triangular, or symmetric.
+ */
+static uint32_t
+m_packedProperty_int(const matrix_int_t *m) {
+    switch(m->storage) {
+        case MATRIX_STORAGE_UPPER:
+            return MATRIX_IS_UPPER_TRIANGULAR;
+        case MATRIX_STORAGE_LOWER:
+            return MATRIX_IS_LOWER_TRIANGULAR;
+        default:
+            return MATRIX_IS_SYMMETRIC;
+    }
+}
+
+/**
+ * @brief Adds or subtracts two banded matrices into a banded matrix with the wider of each pair of bandwidths.  Each row of the result takes the band of M1 and then combines the band of M2 into it, so the cost is O(n x bw).  Two matrices with the same band are combined as their arrays, in one kernel call.
+ */
+static matrix_int_t*
+m_combineBands_int(matrix_arena_t *arena, const matrix_int_t *m1, const matrix_int_t *m2, void (*kernel)(int*, const int*, const int*, const size_t)) {
+    matrix_int_t *m = m_initializeHeader_int(arena, m1->i, m1->j);
+    m->storage = MATRIX_STORAGE_BANDED;
+    m->lower_bandwidth = (m1->lower_bandwidth > m2->lower_bandwidth) ? m1->lower_bandwidth : m2->lower_bandwidth;
+    m->upper_bandwidth = (m1->upper_bandwidth > m2->upper_bandwidth) ? m1->upper_bandwidth : m2->upper_bandwidth;
+    m->array = m_allocate(arena, m_arrayBytes_int(m));
+    if((m1->lower_bandwidth == m2->lower_bandwidth) && (m1->upper_bandwidth == m2->upper_bandwidth)) {
+        kernel(m->array, m1->array, m2->array, m_arrayBytes_int(m) / sizeof(int));
+        return m;
+    }
+    for(size_t row = 0; row < m->i; row++) {
+        int *destination = m_rowPointer_int(m, row);
+        size_t first, end;
+        m_storedColumns_int(m1, row, &first, &end);
+        memcpy(destination + first, m_rowPointer_int(m1, row) + first, (end - first) * sizeof(int));
+        m_storedColumns_int(m2, row, &first, &end);
+        kernel(destination + first, destination + first, m_rowPointer_int(m2, row) + first, end - first);
+    }
+    return m;
+}
+
+/**
+ * @brief Adds or subtracts two matrices of which at least one is in packed triangular, symmetric or banded storage.  Two matrices in the same packed storage are combined as their packed arrays, in one kernel call over n(n + 1)/2 values, and the result is packed as well; two banded matrices are combined band by band (see m_combineBands_int).  Otherwise the packed operands take part through dense copies.
+ */
+static matrix_int_t*
+m_combinePacked_int(matrix_arena_t *arena, matrix_int_t *m1, matrix_int_t *m2, void (*kernel)(int*, const int*, const int*, const size_t)) {
+    if((MATRIX_STORAGE_BANDED == m1->storage) && (MATRIX_STORAGE_BANDED == m2->storage)) {
+        return m_combineBands_int(arena, m1, m2, kernel);
+    }
+    if(m1->storage == m2->storage) {
+        matrix_int_t *m = m_initializeHeader_int(arena, m1->i, m1->j);
+        m->storage = m1->storage;
+        m->array = m_allocate(arena, m_arrayBytes_int(m));
+        kernel(m->array, m1->array, m2->array, m_arrayBytes_int(m) / sizeof(int));
+        m_setProperties_int(m, m_packedProperty_int(m), true);
+        return m;
+    }
+    matrix_int_t *dense1 = m1;
+    matrix_int_t *dense2 = m2;
+    if(m_isPacked_int(m1)) {
+        dense1 = createCopy_int(m1);
+        m_materialize_int(dense1);
+    }
+    if(m_isPacked_int(m2)) {
+        dense2 = createCopy_int(m2);
+        m_materialize_int(dense2);
+    }
+    matrix_int_t *m = initializeMatrixArena_int(arena, m1->i, m1->j);
+    m_combineRows_int(m, dense1, dense2, kernel);
+    if(dense1 != m1) {
+        freeMatrix_int(dense1);
+    }
+    if(dense2 != m2) {
+        freeMatrix_int(dense2);
+    }
+    return m;
+}
+
+/**
+ * @brief Gives a sparse matrix in CSR format a header upon the heap, in MATRIX_STORAGE_CSR.  The header takes the sparse matrix over.
+ */
+static matrix_int_t*
+m_wrapSparse_int(matrix_sparse_t *sparse) {
+    assert(MATRIX_SPARSE_CSR == sparse->format);
+    matrix_int_t *m = m_initializeHeader_int(NULL, sparse->i, sparse->j);
+    m->storage = MATRIX_STORAGE_CSR;
+    m->sparse = sparse;
+    return m;
+}
+
+/**
+ * @brief Returns m itself unless it is encoded, otherwise a temporary dense copy of it that the caller frees.  Code that reads arrays takes encoded operands this way.
+ */
+static matrix_int_t*
+m_decoded_int(matrix_int_t *m) {
+    if(!m_isEncoded_int(m)) {
+        return m;
+    }
+    matrix_int_t *dense = createCopy_int(m);
+    m_materialize_int(dense);
+    return dense;
+}
+
+/**
+ * @brief Adds the nonzeros of a sparse matrix into a dense matrix of the same dimensions, or subtracts them.
+ */
+static void
+m_scatterSparse_int(matrix_int_t *m, const matrix_sparse_t *sparse, const bool subtract) {
+    for(size_t row = 0; row < m->i; row++) {
+        int *values = m->array + (row * m->ld);
+        for(size_t index = sparse->offsets[row]; index < sparse->offsets[row + 1]; index++) {
+            const unsigned int value = (unsigned int) sparse->values[index];
+            int *destination = values + sparse->indices[index];
+            *destination = (int) (subtract ? ((unsigned int) *destination - value) : ((unsigned int) *destination + value));
+        }
+    }
+    m_invalidateProperties_int(m);
+}
+
+/**
+ * @brief Adds or subtracts two matrices of which at least one is in sparse, bitpacked or narrowed storage.  Two sparse matrices are merged into a sparse sum, unless it goes to an arena.  Otherwise a sparse operand is added into a dense copy of the other one, and the other encodings are expanded a row at a time.
+ */
+static matrix_int_t*
+m_combineEncoded_int(matrix_arena_t *arena, matrix_int_t *m1, matrix_int_t *m2, const bool subtract) {
+    const bool sparse1 = (MATRIX_STORAGE_CSR == m1->storage);
+    const bool sparse2 = (MATRIX_STORAGE_CSR == m2->storage);
+    if(sparse1 && sparse2 && (NULL == arena)) {
+        return m_wrapSparse_int(subtract ? m_MatrixSubtract_sparse(m1->sparse, m2->sparse) : m_MatrixAdd_sparse(m1->sparse, m2->sparse));
+    }
+    if(sparse1 || sparse2) {
+        /* S - B is -B with the nonzeros of S added. */
+        matrix_int_t *m = createCopyArena_int(arena, sparse1 ? m2 : m1);
+        m_materialize_int(m);
+        if(sparse1 && subtract) {
+            m_ScalarMultiply_int(m, -1);
+        }
+        m_scatterSparse_int(m, sparse1 ? m1->sparse : m2->sparse, subtract && !sparse1);
+        return m;
+    }
+    void (*const kernel)(int*, const int*, const int*, const size_t) = subtract ? m_kernels_int()->subtract : m_kernels_int()->add;
+    if(m_isPacked_int(m1) || m_isPacked_int(m2)) {
+        matrix_int_t *dense1 = m_decoded_int(m1);
+        matrix_int_t *dense2 = m_decoded_int(m2);
+        matrix_int_t *m = m_combinePacked_int(arena, dense1, dense2, kernel);
+        if(dense1 != m1) {
+            freeMatrix_int(dense1);
+        }
+        if(dense2 != m2) {
+            freeMatrix_int(dense2);
+        }
+        return m;
+    }
+    /* One row at a time: the first operand is expanded straight into the result, the second into a row buffer unless it is dense. */
+    matrix_int_t *m = initializeMatrixArena_int(arena, m1->i, m1->j);
+    int *buffer = NULL;
+    if(MATRIX_STORAGE_DENSE != m2->storage) {
+        buffer = malloc(m2->j * sizeof(int));
+        assert(NULL != buffer);
+    }
+    for(size_t row = 0; row < m->i; row++) {
+        int *destination = m->array + (row * m->ld);
+        m_copyRow_int(m1, row, destination);
+        if(NULL != buffer) {
+            m_copyRow_int(m2, row, buffer);
+        }
+        kernel(destination, destination, (NULL != buffer) ? buffer : (m2->array + (row * m2->ld)), m->j);
+    }
+    free(buffer);
+    return m;
+}
+
 /**
  * @brief This function performs scalar matrix addition.  It modifies the matrix passed to the function
  * @param m matrix_int_t The matrix
@@ -257,217 +1213,2278 @@ m_selectRow_int(matrix_int_t *m, const int row_number) {
 void
 m_ScalarAdd_int(matrix_int_t *m, const int scalar) {
     assert(NULL != m);
-    for(size_t index = 0; index < (m->i * m->j); index++) {
-        m->array[index] += scalar;
+    m_materialize_int(m);
+    m_applyRows_int(m, m_kernels_int()->scalar_add, scalar);
+    m_invalidateProperties_int(m);
+}
+
+/**
+ * @brief This function performs matrix addition, M1 + M2.  The result will be a new matrix struct allocated upon the heap.
+ * @param m1 The first matrix
+ * @param m2 The second matrix
+ * @return A new matrix allocated upon the heap
+ * @note The sum of two implicit, diagonal, packed, banded or sparse matrices in the same storage stays in it, and costs O(stored values).  Any other sum is dense.  An implicit or diagonal operand only touches the diagonal of a copy of the other one.
+ */
+matrix_int_t*
+m_MatrixAdd_int(matrix_int_t *m1, matrix_int_t *m2) {
+    return m_MatrixAddArena_int(NULL, m1, m2);
+}
+
+/**
+ * @brief Performs matrix addition, M1 + M2, into a new matrix allocated from an arena.
+ * @param arena The arena to allocate from, or NULL to allocate upon the heap
+ * @param m1 The first matrix
+ * @param m2 The second matrix
+ * @return A new matrix allocated from the arena
+ */
+matrix_int_t*
+m_MatrixAddArena_int(matrix_arena_t *arena, matrix_int_t *m1, matrix_int_t *m2) {
+    assert((m1->i == m2->i) && (m1->j == m2->j));
+    /* A + 0 is A.  The null flags are only tested if they are cached, so a dense operand is never swept for this. */
+    if(m_hasAnyProperty_int(m2, MATRIX_IS_NULL)) {
+        return createCopyArena_int(arena, m1);
+    }
+    if(m_hasAnyProperty_int(m1, MATRIX_IS_NULL)) {
+        return createCopyArena_int(arena, m2);
+    }
+    if(m_isDiagonalStorage_int(m1) && m_isDiagonalStorage_int(m2)) {
+        return m_combineDiagonals_int(arena, m1, m2, m_kernels_int()->add);
+    }
+    if(m_isDiagonalStorage_int(m1) || m_isDiagonalStorage_int(m2)) {
+        matrix_int_t *diagonal = m_isDiagonalStorage_int(m1) ? m1 : m2;
+        matrix_int_t *m = createCopyArena_int(arena, m_isDiagonalStorage_int(m1) ? m2 : m1);
+        m_materialize_int(m);
+        m_addDiagonal_int(m, diagonal, false);
+        return m;
+    }
+    if(m_isEncoded_int(m1) || m_isEncoded_int(m2)) {
+        return m_combineEncoded_int(arena, m1, m2, false);
+    }
+    if(m_isPacked_int(m1) || m_isPacked_int(m2)) {
+        return m_combinePacked_int(arena, m1, m2, m_kernels_int()->add);
+    }
+    matrix_int_t *m = initializeMatrixArena_int(arena, m1->i, m2->j);
+    m_combineRows_int(m, m1, m2, m_kernels_int()->add);
+    return m;
+}
+
+
+/**
+ * @brief This function performs scalar matrix subtraction.  It modifies the matrix passed to the function
+ * @param m matrix_int_t The matrix
+ * @param scalar const int The scalar used for subtraction 
+ */
+void
+m_ScalarSubtract_int(matrix_int_t *m, const int scalar) {
+    assert(NULL != m);
+    m_materialize_int(m);
+    m_applyRows_int(m, m_kernels_int()->scalar_add, (int) (0u - (unsigned int) scalar));
+    m_invalidateProperties_int(m);
+}
+
+/**
+ * @brief This function performs matrix subtraction, M1 + M2.  The result will be a new matrix struct allocated upon the heap.
+ * @param m1 The first matrix
+ * @param m2 The second matrix
+ * @return A new matrix allocated upon the heap
+ */
+matrix_int_t*
+m_MatrixSubtract_int(matrix_int_t *m1, matrix_int_t *m2) {
+    return m_MatrixSubtractArena_int(NULL, m1, m2);
+}
+
+/**
+ * @brief Performs matrix subtraction, M1 - M2, into a new matrix allocated from an arena.
+ * @param arena The arena to allocate from, or NULL to allocate upon the heap
+ * @param m1 The first matrix
+ * @param m2 The second matrix
+ * @return A new matrix allocated from the arena
+ */
+matrix_int_t*
+m_MatrixSubtractArena_int(matrix_arena_t *arena, matrix_int_t *m1, matrix_int_t *m2) {
+    assert((m1->i == m2->i) && (m1->j == m2->j));
+    if(m_hasAnyProperty_int(m2, MATRIX_IS_NULL)) {
+        return createCopyArena_int(arena, m1);
+    }
+    if(m_isDiagonalStorage_int(m1) && m_isDiagonalStorage_int(m2)) {
+        return m_combineDiagonals_int(arena, m1, m2, m_kernels_int()->subtract);
+    }
+    if(m_isDiagonalStorage_int(m1)) {
+        /* D - B is -B with D added to the diagonal; 0 - B is -B. */
+        matrix_int_t *m = createCopyArena_int(arena, m2);
+        m_materialize_int(m);
+        m_ScalarMultiply_int(m, -1);
+        m_addDiagonal_int(m, m1, false);
+        return m;
+    }
+    if(m_isDiagonalStorage_int(m2)) {
+        matrix_int_t *m = createCopyArena_int(arena, m1);
+        m_materialize_int(m);
+        m_addDiagonal_int(m, m2, true);
+        return m;
+    }
+    if(m_isEncoded_int(m1) || m_isEncoded_int(m2)) {
+        return m_combineEncoded_int(arena, m1, m2, true);
+    }
+    if(m_isPacked_int(m1) || m_isPacked_int(m2)) {
+        return m_combinePacked_int(arena, m1, m2, m_kernels_int()->subtract);
+    }
+    matrix_int_t *m = initializeMatrixArena_int(arena, m1->i, m2->j);
+    m_combineRows_int(m, m1, m2, m_kernels_int()->subtract);
+    return m;
+}
+
+/**
+ * @brief This checks if the values of two matrices, M1 and M2, are equal.
+ * @param m1 The first matrix
+ * @param m2 The second matrix
+ * @return boolean. True if matrices are equal, false otherwise
+ */
+bool
+m_isEqual_int(matrix_int_t *m1, matrix_int_t *m2) {
+    if((m1->i != m2->i) || (m1->j != m2->j)) {
+        return false;
+    }
+    if(m_isImplicit_int(m1) && m_isImplicit_int(m2)) {
+        return m1->scalar == m2->scalar;
+    }
+    if(m_isPacked_int(m1) && (m1->storage == m2->storage) && (m1->lower_bandwidth == m2->lower_bandwidth) && (m1->upper_bandwidth == m2->upper_bandwidth)) {
+        /* The places of a band outside the matrix are never written, so they are zero in both. */
+        return 0 == memcmp(m1->array, m2->array, m_arrayBytes_int(m1));
+    }
+    if((MATRIX_STORAGE_CSR == m1->storage) && (MATRIX_STORAGE_CSR == m2->storage)) {
+        /* Sorted and free of zeros, the nonzeros of equal sparse matrices are the same arrays. */
+        const matrix_sparse_t *sparse1 = m1->sparse;
+        const matrix_sparse_t *sparse2 = m2->sparse;
+        return (sparse1->nnz == sparse2->nnz)
+            && (0 == memcmp(sparse1->offsets, sparse2->offsets, (m1->i + 1) * sizeof(size_t)))
+            && (0 == memcmp(sparse1->indices, sparse2->indices, sparse1->nnz * sizeof(uint32_t)))
+            && (0 == memcmp(sparse1->values, sparse2->values, sparse1->nnz * sizeof(int)));
+    }
+    if((MATRIX_STORAGE_BITS == m1->storage) && (MATRIX_STORAGE_BITS == m2->storage)) {
+        /* The bits past the last column are always zero. */
+        return 0 == memcmp(m1->bits->array, m2->bits->array, m1->bits->i * m1->bits->ld * sizeof(uint64_t));
+    }
+    if(m_isNarrow_int(m1) && (m1->storage == m2->storage) && (m1->ld == m2->ld)) {
+        /* The padding past the last column is never written, so it is zero in both. */
+        return 0 == memcmp(m1->narrow, m2->narrow, m1->i * m1->ld * m_narrowWidth_int(m1));
+    }
+    if(m_isDiagonalStorage_int(m1) && m_isDiagonalStorage_int(m2)) {
+        /* Neither has values off the diagonal. */
+        for(size_t index = 0; index < m1->i; index++) {
+            if(m_at_int(m1, index, index) != m_at_int(m2, index, index)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    if((MATRIX_STORAGE_DENSE != m1->storage) || (MATRIX_STORAGE_DENSE != m2->storage)) {
+        for(size_t row = 0; row < m1->i; row++) {
+            for(size_t column = 0; column < m1->j; column++) {
+                if(m_at_int(m1, row, column) != m_at_int(m2, row, column)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+    for(size_t row = 0; row < m1->i; row++) {
+        if(0 != memcmp(m1->array + (row * m1->ld), m2->array + (row * m2->ld), m1->j * sizeof(int))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/**
+ * @brief This function performs scalar matrix multiplication.  It modifies the matrix passed to the function
+ * @param m matrix_int_t The matrix
+ * @param scalar const int The scalar used for multiplication 
+ * @note An implicit matrix stays implicit: only its diagonal value changes.  A diagonal, packed triangular or banded matrix only scales its compact array, and a sparse matrix its nonzeros.
+ */
+void
+m_ScalarMultiply_int(matrix_int_t *m, const int scalar) {
+    assert(NULL != m);
+    if(MATRIX_STORAGE_NULL == m->storage) {
+        return;
+    }
+    if(m_isImplicit_int(m)) {
+        m_setImplicit_int(m, (int) ((unsigned int) m->scalar * (unsigned int) scalar));
+        return;
+    }
+    if(MATRIX_STORAGE_CSR == m->storage) {
+        m_ScalarMultiply_sparse(m->sparse, scalar);
+        m_invalidateProperties_int(m);
+        return;
+    }
+    if(m_isEncoded_int(m)) {
+        /* The products may not fit in bits, or in the narrow type. */
+        m_materialize_int(m);
+    }
+    if(MATRIX_STORAGE_DENSE != m->storage) {
+        /* A diagonal, packed or banded array holds every value that can be nonzero, in one run. */
+        m_kernels_int()->scalar_multiply(m->array, scalar, m_arrayBytes_int(m) / sizeof(int));
+        m_invalidateProperties_int(m);
+        return;
+    }
+    m_applyRows_int(m, m_kernels_int()->scalar_multiply, scalar);
+    m_invalidateProperties_int(m);
+}
+
+/**
+ * @brief Packs an mc x kc block of a matrix into consecutive micro-panels of MATRIX_GEMM_MR rows.  Within a micro-panel the values are stored column by column, so the micro-kernel reads the buffer strictly sequentially.  Rows past the edge of the matrix are padded with zeros so that every micro-panel is full, and so is the zero half of a packed triangular matrix.  A packed symmetric matrix is read from its upper triangle, and a narrowed matrix is widened to int.
+ * @param m The matrix to pack from (the left operand of the product)
+ * @param transpose Pack the block of M^T instead.  M must be dense.
+ * @param row_offset The first row of the block
+ * @param column_offset The first column of the block
+ * @param mc The number of rows in the block
+ * @param kc The number of columns in the block
+ * @param buffer Destination buffer holding at least ceil(mc / MATRIX_GEMM_MR) * MATRIX_GEMM_MR * kc integers
+ */
+static void
+m_packPanelA_int(const matrix_int_t *m, const bool transpose, const size_t row_offset, const size_t column_offset, const size_t mc, const size_t kc, int *buffer) {
+    if(transpose) {
+        /* Row r of M^T is column r of M, so the MR values of one depth are consecutive in a row of M. */
+        for(size_t panel = 0; panel < mc; panel += MATRIX_GEMM_MR) {
+            const size_t rows = (mc - panel < MATRIX_GEMM_MR) ? (mc - panel) : MATRIX_GEMM_MR;
+            const int *source = m->array + (column_offset * m->ld) + row_offset + panel;
+            for(size_t k = 0; k < kc; k++) {
+                size_t r = 0;
+                for(; r < rows; r++) {
+                    *buffer++ = source[(k * m->ld) + r];
+                }
+                for(; r < MATRIX_GEMM_MR; r++) {
+                    *buffer++ = 0;
+                }
+            }
+        }
+        return;
     }
+    if(MATRIX_STORAGE_SYMMETRIC == m->storage) {
+        for(size_t panel = 0; panel < mc; panel += MATRIX_GEMM_MR) {
+            const size_t rows = (mc - panel < MATRIX_GEMM_MR) ? (mc - panel) : MATRIX_GEMM_MR;
+            for(size_t k = column_offset; k < column_offset + kc; k++) {
+                size_t r = 0;
+                for(; r < rows; r++) {
+                    *buffer++ = m_symmetricAt_int(m, row_offset + panel + r, k);
+                }
+                for(; r < MATRIX_GEMM_MR; r++) {
+                    *buffer++ = 0;
+                }
+            }
+        }
+        return;
+    }
+    if(m_isPackedTriangle_int(m)) {
+        /* Each row of a packed triangle has its own start and range of stored columns; the rest of the row is packed as zeros. */
+        for(size_t panel = 0; panel < mc; panel += MATRIX_GEMM_MR) {
+            const size_t rows = (mc - panel < MATRIX_GEMM_MR) ? (mc - panel) : MATRIX_GEMM_MR;
+            const int *source[MATRIX_GEMM_MR];
+            size_t first[MATRIX_GEMM_MR];
+            size_t end[MATRIX_GEMM_MR];
+            for(size_t r = 0; r < rows; r++) {
+                source[r] = m_rowPointer_int(m, row_offset + panel + r);
+                m_storedColumns_int(m, row_offset + panel + r, first + r, end + r);
+            }
+            for(size_t k = column_offset; k < column_offset + kc; k++) {
+                size_t r = 0;
+                for(; r < rows; r++) {
+                    *buffer++ = ((k >= first[r]) && (k < end[r])) ? source[r][k] : 0;
+                }
+                for(; r < MATRIX_GEMM_MR; r++) {
+                    *buffer++ = 0;
+                }
+            }
+        }
+        return;
+    }
+    if(m_isNarrow_int(m)) {
+        /* The rows of a micro-panel are widened a block at a time, then interleaved as in the dense case below. */
+        int widened[MATRIX_GEMM_MR][MATRIX_GEMM_KC];
+        for(size_t panel = 0; panel < mc; panel += MATRIX_GEMM_MR) {
+            const size_t rows = (mc - panel < MATRIX_GEMM_MR) ? (mc - panel) : MATRIX_GEMM_MR;
+            for(size_t k_block = 0; k_block < kc; k_block += MATRIX_GEMM_KC) {
+                const size_t depth = (kc - k_block < MATRIX_GEMM_KC) ? (kc - k_block) : MATRIX_GEMM_KC;
+                for(size_t r = 0; r < rows; r++) {
+                    m_widenRow_int(m, row_offset + panel + r, column_offset + k_block, depth, widened[r]);
+                }
+                for(size_t k = 0; k < depth; k++) {
+                    size_t r = 0;
+                    for(; r < rows; r++) {
+                        *buffer++ = widened[r][k];
+                    }
+                    for(; r < MATRIX_GEMM_MR; r++) {
+                        *buffer++ = 0;
+                    }
+                }
+            }
+        }
+        return;
+    }
+    for(size_t panel = 0; panel < mc; panel += MATRIX_GEMM_MR) {
+        const size_t rows = (mc - panel < MATRIX_GEMM_MR) ? (mc - panel) : MATRIX_GEMM_MR;
+        const int *source = m->array + ((row_offset + panel) * m->ld) + column_offset;
+        for(size_t k = 0; k < kc; k++) {
+            size_t r = 0;
+            for(; r < rows; r++) {
+                *buffer++ = source[(r * m->ld) + k];
+            }
+            for(; r < MATRIX_GEMM_MR; r++) {
+                *buffer++ = 0;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Packs a kc x nc block of a matrix into consecutive micro-panels of MATRIX_GEMM_NR columns.  Within a micro-panel the values are stored row by row.  Columns past the edge of the matrix are padded with zeros so that every micro-panel is full, and so is the zero half of a packed triangular matrix.  A packed symmetric matrix is read from its upper triangle, and a narrowed matrix is widened to int.
+ * @param m The matrix to pack from (the right operand of the product)
+ * @param transpose Pack the block of M^T instead.  M must be dense.
+ * @param row_offset The first row of the block
+ * @param column_offset The first column of the block
+ * @param kc The number of rows in the block
+ * @param nc The number of columns in the block
+ * @param buffer Destination buffer holding at least ceil(nc / MATRIX_GEMM_NR) * MATRIX_GEMM_NR * kc integers
+ */
+static void
+m_packPanelB_int(const matrix_int_t *m, const bool transpose, const size_t row_offset, const size_t column_offset, const size_t kc, const size_t nc, int *buffer) {
+    if(transpose) {
+        /* Column c of M^T is row c of M: each row is read once, contiguously, and spread down its column of the micro-panel. */
+        for(size_t panel = 0; panel < nc; panel += MATRIX_GEMM_NR) {
+            const size_t columns = (nc - panel < MATRIX_GEMM_NR) ? (nc - panel) : MATRIX_GEMM_NR;
+            for(size_t c = 0; c < MATRIX_GEMM_NR; c++) {
+                const int *source = m->array + ((column_offset + panel + c) * m->ld) + row_offset;
+                for(size_t k = 0; k < kc; k++) {
+                    buffer[(k * MATRIX_GEMM_NR) + c] = (c < columns) ? source[k] : 0;
+                }
+            }
+            buffer += kc * MATRIX_GEMM_NR;
+        }
+        return;
+    }
+    if(MATRIX_STORAGE_SYMMETRIC == m->storage) {
+        for(size_t panel = 0; panel < nc; panel += MATRIX_GEMM_NR) {
+            const size_t columns = (nc - panel < MATRIX_GEMM_NR) ? (nc - panel) : MATRIX_GEMM_NR;
+            for(size_t k = row_offset; k < row_offset + kc; k++) {
+                size_t c = 0;
+                for(; c < columns; c++) {
+                    *buffer++ = m_symmetricAt_int(m, k, column_offset + panel + c);
+                }
+                for(; c < MATRIX_GEMM_NR; c++) {
+                    *buffer++ = 0;
+                }
+            }
+        }
+        return;
+    }
+    if(m_isPackedTriangle_int(m)) {
+        for(size_t panel = 0; panel < nc; panel += MATRIX_GEMM_NR) {
+            const size_t columns = (nc - panel < MATRIX_GEMM_NR) ? (nc - panel) : MATRIX_GEMM_NR;
+            for(size_t k = row_offset; k < row_offset + kc; k++) {
+                const int *source = m_rowPointer_int(m, k);
+                size_t first, end;
+                m_storedColumns_int(m, k, &first, &end);
+                size_t c = column_offset + panel;
+                for(; c < column_offset + panel + columns; c++) {
+                    *buffer++ = ((c >= first) && (c < end)) ? source[c] : 0;
+                }
+                for(c -= column_offset + panel; c < MATRIX_GEMM_NR; c++) {
+                    *buffer++ = 0;
+                }
+            }
+        }
+        return;
+    }
+    if(m_isNarrow_int(m)) {
+        /* Each row of a micro-panel is consecutive in the matrix, so it is widened straight into place. */
+        for(size_t panel = 0; panel < nc; panel += MATRIX_GEMM_NR) {
+            const size_t columns = (nc - panel < MATRIX_GEMM_NR) ? (nc - panel) : MATRIX_GEMM_NR;
+            for(size_t k = 0; k < kc; k++) {
+                m_widenRow_int(m, row_offset + k, column_offset + panel, columns, buffer);
+                memset(buffer + columns, 0, (MATRIX_GEMM_NR - columns) * sizeof(int));
+                buffer += MATRIX_GEMM_NR;
+            }
+        }
+        return;
+    }
+    for(size_t panel = 0; panel < nc; panel += MATRIX_GEMM_NR) {
+        const size_t columns = (nc - panel < MATRIX_GEMM_NR) ? (nc - panel) : MATRIX_GEMM_NR;
+        const int *source = m->array + (row_offset * m->ld) + column_offset + panel;
+        for(size_t k = 0; k < kc; k++) {
+            size_t c = 0;
+            for(; c < columns; c++) {
+                *buffer++ = source[(k * m->ld) + c];
+            }
+            for(; c < MATRIX_GEMM_NR; c++) {
+                *buffer++ = 0;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Describes one parallel matrix multiplication.  The result is cut into tiles of row_group x MATRIX_GEMM_MC rows by column_block columns; every tile is one task for the thread pool.
+ * @var triangle_a, triangle_b MATRIX_STORAGE_UPPER or MATRIX_STORAGE_LOWER for an operand known to be triangular, MATRIX_STORAGE_DENSE otherwise (see m_triangle_int).  The product skips the zero half of a triangular operand.
+ * @var transpose_a, transpose_b Multiply by the transpose of the dense operand instead, without forming it.
+ * @var upper_only Compute only the upper triangle of the result, for a product known to be symmetric.  Micro-tiles wholly below the diagonal are skipped.
+ * @var packed_a, packed_b Packing buffers for a job that runs on the calling thread only.  NULL means every task uses the scratch buffers of the thread that runs it.
+ */
+typedef struct Matrix_gemmJob_int_s {
+    const matrix_int_t *m1;
+    const matrix_int_t *m2;
+    matrix_int_t *result;
+    matrix_storage_t triangle_a;
+    matrix_storage_t triangle_b;
+    bool transpose_a;
+    bool transpose_b;
+    bool upper_only;
+    size_t row_tiles;
+    size_t row_group;
+    size_t column_block;
+    int *packed_a;
+    int *packed_b;
+} matrix_gemmJob_int_t;
+
+/**
+ * @brief Converts an index of the shared dimension to an offset within the packed depth block [pc, pc + kc), clamped to [0, kc].
+ */
+static size_t
+m_depthOffset_int(const size_t index, const size_t pc, const size_t kc) {
+    if(index <= pc) {
+        return 0;
+    }
+    return (index - pc < kc) ? (index - pc) : kc;
+}
+
+/**
+ * @brief The macro-kernel.  Walks the packed A block and the packed B panel one micro-tile at a time, handing each pair of micro-panels to the register-tiled micro-kernel selected for this CPU (see matrix_simd.h).
+ * @param job The product.  For a triangular operand each micro-tile runs over only the depths where its micro-panels can be nonzero: row r of an upper A is zero before depth r and of a lower A after it, and column c of an upper B is zero after depth c and of a lower B before it.  The micro-kernel accumulates into C, so a shorter run is exact.  For an upper_only product the rows of a column of micro-tiles stop at the diagonal.
+ * @param ic, jc, pc The first row, column and depth of the block in the whole product
+ * @param mc The number of rows in the packed A block
+ * @param nc The number of columns in the packed B panel
+ * @param kc The shared dimension of the packed blocks
+ * @param packed_a The packed A block
+ * @param packed_b The packed B panel
+ */
+static void
+m_gemmMacroKernel_int(const matrix_gemmJob_int_t *job, const size_t ic, const size_t jc, const size_t pc, const size_t mc, const size_t nc, const size_t kc, const int *packed_a, const int *packed_b) {
+    void (*const micro_kernel)(const size_t, const int*, const int*, int*, const size_t, const size_t, const size_t) = m_kernels_int()->gemm_micro;
+    const size_t ldc = job->result->ld;
+    int *c = job->result->array + (ic * ldc) + jc;
+    for(size_t column = 0; column < nc; column += MATRIX_GEMM_NR) {
+        const size_t nr = (nc - column < MATRIX_GEMM_NR) ? (nc - column) : MATRIX_GEMM_NR;
+        const int *b_panel = packed_b + (column * kc);
+        size_t b_begin = 0;
+        size_t b_end = kc;
+        if(MATRIX_STORAGE_UPPER == job->triangle_b) {
+            b_end = m_depthOffset_int(jc + column + nr, pc, kc);
+        } else if(MATRIX_STORAGE_LOWER == job->triangle_b) {
+            b_begin = m_depthOffset_int(jc + column, pc, kc);
+        }
+        for(size_t row = 0; row < mc; row += MATRIX_GEMM_MR) {
+            const size_t mr = (mc - row < MATRIX_GEMM_MR) ? (mc - row) : MATRIX_GEMM_MR;
+            if(job->upper_only && (ic + row >= jc + column + nr)) {
+                break;
+            }
+            const int *a_panel = packed_a + (row * kc);
+            size_t k_begin = b_begin;
+            size_t k_end = b_end;
+            if(MATRIX_STORAGE_UPPER == job->triangle_a) {
+                const size_t a_begin = m_depthOffset_int(ic + row, pc, kc);
+                k_begin = (a_begin > k_begin) ? a_begin : k_begin;
+            } else if(MATRIX_STORAGE_LOWER == job->triangle_a) {
+                const size_t a_end = m_depthOffset_int(ic + row + mr, pc, kc);
+                k_end = (a_end < k_end) ? a_end : k_end;
+            }
+            if(k_begin < k_end) {
+                micro_kernel(k_end - k_begin, a_panel + (k_begin * MATRIX_GEMM_MR), b_panel + (k_begin * MATRIX_GEMM_NR), c + (row * ldc) + column, ldc, mr, nr);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Computes one output tile of a matrix multiplication over the whole shared dimension.  The tile packs its own blocks into the running thread's scratch buffers, so tasks never share or allocate memory.  Each packed panel of M2 is reused by every MC row block of the tile.
+ * @param context The matrix_gemmJob_int_t
+ * @param task The index of the tile.  Consecutive tasks walk down a column of tiles so they reuse the same panel of M2.
+ * @param worker Unused
+ */
+static void
+m_gemmTask_int(void *context, const size_t task, const size_t worker) {
+    (void) worker;
+    const matrix_gemmJob_int_t *job = context;
+    const size_t rows = job->result->i;
+    const size_t columns = job->result->j;
+    const size_t depth = job->transpose_a ? job->m1->i : job->m1->j;
+
+    const size_t row_begin = (task % job->row_tiles) * job->row_group * MATRIX_GEMM_MC;
+    const size_t row_span = job->row_group * MATRIX_GEMM_MC;
+    const size_t row_end = (rows - row_begin < row_span) ? rows : (row_begin + row_span);
+    const size_t jc = (task / job->row_tiles) * job->column_block;
+    const size_t nc = (columns - jc < job->column_block) ? (columns - jc) : job->column_block;
+    if(job->upper_only && (row_begin >= jc + nc)) {
+        return;
+    }
+    const size_t kc_max = (depth < MATRIX_GEMM_KC) ? depth : MATRIX_GEMM_KC;
+    const size_t mc_max = (row_end - row_begin < MATRIX_GEMM_MC) ? (row_end - row_begin) : MATRIX_GEMM_MC;
+    const size_t mc_padded = ((mc_max + MATRIX_GEMM_MR - 1) / MATRIX_GEMM_MR) * MATRIX_GEMM_MR;
+    const size_t nc_padded = ((nc + MATRIX_GEMM_NR - 1) / MATRIX_GEMM_NR) * MATRIX_GEMM_NR;
+    int *packed_a = (NULL != job->packed_a) ? job->packed_a : m_threadScratch(0, mc_padded * kc_max * sizeof(int));
+    int *packed_b = (NULL != job->packed_b) ? job->packed_b : m_threadScratch(1, nc_padded * kc_max * sizeof(int));
+
+    for(size_t pc = 0; pc < depth; pc += MATRIX_GEMM_KC) {
+        const size_t kc = (depth - pc < MATRIX_GEMM_KC) ? (depth - pc) : MATRIX_GEMM_KC;
+        /* A depth block that is zero for the whole tile is neither packed nor multiplied. */
+        if(((MATRIX_STORAGE_UPPER == job->triangle_b) && (pc >= jc + nc)) || ((MATRIX_STORAGE_LOWER == job->triangle_b) && (pc + kc <= jc))) {
+            continue;
+        }
+        m_packPanelB_int(job->m2, job->transpose_b, pc, jc, kc, nc, packed_b);
+        for(size_t ic = row_begin; ic < row_end; ic += MATRIX_GEMM_MC) {
+            const size_t mc = (row_end - ic < MATRIX_GEMM_MC) ? (row_end - ic) : MATRIX_GEMM_MC;
+            if(job->upper_only && (ic >= jc + nc)) {
+                break;
+            }
+            if(((MATRIX_STORAGE_UPPER == job->triangle_a) && (pc + kc <= ic)) || ((MATRIX_STORAGE_LOWER == job->triangle_a) && (pc >= ic + mc))) {
+                continue;
+            }
+            m_packPanelA_int(job->m1, job->transpose_a, ic, pc, mc, kc, packed_a);
+            m_gemmMacroKernel_int(job, ic, jc, pc, mc, nc, kc, packed_a, packed_b);
+        }
+    }
+}
+
+/**
+ * @brief Computes D x A for a matrix D with nothing off its diagonal, in any storage: row r of A scaled by D[r][r].  A is in any storage.
+ */
+static matrix_int_t*
+m_scaleRows_int(matrix_arena_t *arena, matrix_int_t *diagonal, matrix_int_t *m2) {
+    void (*const scalar_multiply)(int*, const int, const size_t) = m_kernels_int()->scalar_multiply;
+    matrix_int_t *m = initializeMatrixArena_int(arena, m2->i, m2->j);
+    for(size_t row = 0; row < m->i; row++) {
+        int *destination = m->array + (row * m->ld);
+        m_copyRow_int(m2, row, destination);
+        scalar_multiply(destination, m_at_int(diagonal, row, row), m->j);
+    }
+    return m;
+}
+
+/**
+ * @brief Computes A x D for a matrix D with nothing off its diagonal, in any storage: column c of A scaled by D[c][c], which is every row of A multiplied elementwise by the diagonal.  A is in any storage.
+ */
+static matrix_int_t*
+m_scaleColumns_int(matrix_arena_t *arena, matrix_int_t *m1, matrix_int_t *diagonal) {
+    void (*const multiply)(int*, const int*, const int*, const size_t) = m_kernels_int()->multiply;
+    matrix_int_t *m = initializeMatrixArena_int(arena, m1->i, m1->j);
+    int *buffer = NULL;
+    if(MATRIX_STORAGE_DIAGONAL != diagonal->storage) {
+        buffer = malloc(diagonal->i * sizeof(int));
+        assert(NULL != buffer);
+    }
+    const int *values = m_diagonalValues_int(diagonal, buffer);
+    for(size_t row = 0; row < m->i; row++) {
+        int *destination = m->array + (row * m->ld);
+        m_copyRow_int(m1, row, destination);
+        multiply(destination, destination, values, m->j);
+    }
+    free(buffer);
+    return m;
+}
+
+/**
+ * @brief Finds which half of a matrix is known to be zero, from its storage or from the cached triangular flags of a dense matrix.  Nothing is computed.
+ * @return MATRIX_STORAGE_UPPER or MATRIX_STORAGE_LOWER for a triangular matrix, MATRIX_STORAGE_DENSE otherwise
+ */
+static matrix_storage_t
+m_triangle_int(const matrix_int_t *m) {
+    if((MATRIX_STORAGE_UPPER == m->storage) || ((MATRIX_STORAGE_DENSE == m->storage) && m_hasAnyProperty_int(m, MATRIX_IS_UPPER_TRIANGULAR))) {
+        return MATRIX_STORAGE_UPPER;
+    }
+    if((MATRIX_STORAGE_LOWER == m->storage) || ((MATRIX_STORAGE_DENSE == m->storage) && m_hasAnyProperty_int(m, MATRIX_IS_LOWER_TRIANGULAR))) {
+        return MATRIX_STORAGE_LOWER;
+    }
+    return MATRIX_STORAGE_DENSE;
+}
+
+/**
+ * @brief Runs the blocked product described by a job whose operands, result and flags are filled in.  It chooses the tiling, then runs the tiles on the calling thread or spreads them over the thread pool.  The loops are those of BLIS: a KC x NC panel of M2 and an MC x KC block of M1 are packed (see m_packPanelB_int and m_packPanelA_int), and the macro-kernel streams both through the micro-kernel.
+ * @param arena The arena of the result, or NULL.  A product on the calling thread takes its packing buffers from a scratch scope of the arena.
+ * @param job The product.  The tiling fields and packing buffers are set here.
+ */
+static void
+m_runGemm_int(matrix_arena_t *arena, matrix_gemmJob_int_t *job) {
+    const size_t rows = job->result->i;
+    const size_t columns = job->result->j;
+    const size_t depth = job->transpose_a ? job->m1->i : job->m1->j;
+    const size_t row_blocks = (rows + MATRIX_GEMM_MC - 1) / MATRIX_GEMM_MC;
+    job->row_tiles = 1;
+    job->row_group = row_blocks;
+    job->column_block = (columns < MATRIX_GEMM_NC) ? columns : MATRIX_GEMM_NC;
+    job->packed_a = NULL;
+    job->packed_b = NULL;
+    size_t column_tiles = (columns + job->column_block - 1) / job->column_block;
+
+    /**
+     * Products too small to be worth waking the pool run as a single task on the calling thread.  Otherwise aim for a few tiles per thread, so that work stealing can even out the load, while keeping the tiles as tall as possible so each packed panel of M2 is reused by many row blocks.
+     */
+    if((rows * columns * depth) < MATRIX_GEMM_PARALLEL_THRESHOLD) {
+        matrix_arenaMark_t scratch;
+        if(NULL != arena) {
+            /* The result was allocated before the mark, so releasing the scope gives back only the packing buffers. */
+            const size_t kc_max = (depth < MATRIX_GEMM_KC) ? depth : MATRIX_GEMM_KC;
+            const size_t mc_max = (rows < MATRIX_GEMM_MC) ? rows : MATRIX_GEMM_MC;
+            scratch = m_arenaMark(arena);
+            job->packed_a = m_arenaAlloc(arena, (((mc_max + MATRIX_GEMM_MR - 1) / MATRIX_GEMM_MR) * MATRIX_GEMM_MR) * kc_max * sizeof(int));
+            job->packed_b = m_arenaAlloc(arena, (((job->column_block + MATRIX_GEMM_NR - 1) / MATRIX_GEMM_NR) * MATRIX_GEMM_NR) * kc_max * sizeof(int));
+        }
+        for(size_t task = 0; task < column_tiles; task++) {
+            m_gemmTask_int(job, task, 0);
+        }
+        if(NULL != arena) {
+            m_arenaRelease(arena, scratch);
+        }
+        return;
+    }
+    const size_t target_tasks = 4 * m_getThreadCount();
+    while(((row_blocks * column_tiles) < target_tasks) && (job->column_block > (4 * MATRIX_GEMM_NR))) {
+        job->column_block = (((job->column_block / 2) + MATRIX_GEMM_NR - 1) / MATRIX_GEMM_NR) * MATRIX_GEMM_NR;
+        column_tiles = (columns + job->column_block - 1) / job->column_block;
+    }
+    const size_t wanted_row_tiles = (target_tasks + column_tiles - 1) / column_tiles;
+    job->row_tiles = (wanted_row_tiles < row_blocks) ? wanted_row_tiles : row_blocks;
+    job->row_group = (row_blocks + job->row_tiles - 1) / job->row_tiles;
+    job->row_tiles = (row_blocks + job->row_group - 1) / job->row_group;
+    m_parallelFor(job->row_tiles * column_tiles, m_gemmTask_int, job);
+}
+
+/**
+ * @brief Packs the product of two matrices packed in the same triangle, which is triangular in that triangle as well.
+ */
+static void
+m_packProduct_int(matrix_int_t *m, const matrix_int_t *m1, const matrix_int_t *m2) {
+    if(m_isPackedTriangle_int(m1) && (m1->storage == m2->storage)) {
+        m_packTriangle_int(m, m1->storage);
+        m_setProperties_int(m, (MATRIX_STORAGE_UPPER == m->storage) ? MATRIX_IS_UPPER_TRIANGULAR : MATRIX_IS_LOWER_TRIANGULAR, true);
+    }
+}
+
+/**
+ * @brief Multiplies two matrices of which at least one is sparse, touching only the nonzeros (see matrix_sparse.h).  The product of two sparse matrices is sparse.  The sparse products allocate upon the heap, so a product for an arena is copied into it.
+ */
+static matrix_int_t*
+m_multiplySparse_int(matrix_arena_t *arena, matrix_int_t *m1, matrix_int_t *m2) {
+    matrix_int_t *m;
+    if((MATRIX_STORAGE_CSR == m1->storage) && (MATRIX_STORAGE_CSR == m2->storage)) {
+        m = m_wrapSparse_int(m_MatrixMultiply_sparse(m1->sparse, m2->sparse));
+    } else if(MATRIX_STORAGE_CSR == m1->storage) {
+        m = m_MatrixMultiply_sparseDense(m1->sparse, m2);
+    } else {
+        m = m_MatrixMultiply_denseSparse(m1, m2->sparse);
+    }
+    if(NULL != arena) {
+        matrix_int_t *copy = createCopyArena_int(arena, m);
+        freeMatrix_int(m);
+        m = copy;
+    }
+    return m;
+}
+
+/**
+ * @brief Describes one product with a banded operand for the thread pool.  Every task computes a contiguous range of rows of the result.
+ */
+typedef struct Matrix_bandJob_int_s {
+    const matrix_int_t *m1;
+    const matrix_int_t *m2;
+    matrix_int_t *result;
+    size_t task_count;
+} matrix_bandJob_int_t;
+
+/**
+ * @brief Computes one range of rows of a product with a banded operand.  Row r of the product gathers the rows k of M2 scaled by M1[r][k], for the k that row r of M1 stores, and each scaled row is one axpy (see matrix_simd.h) over the columns that row k of M2 stores.
+ * @param context The matrix_bandJob_int_t
+ * @param task The index of the row range
+ * @param worker Unused
+ */
+static void
+m_bandTask_int(void *context, const size_t task, const size_t worker) {
+    (void) worker;
+    const matrix_bandJob_int_t *job = context;
+    void (*const axpy)(int*, const int, const int*, const size_t) = m_kernels_int()->axpy;
+    const size_t rows = job->result->i;
+    const size_t row_end = ((task + 1) * rows) / job->task_count;
+    for(size_t row = (task * rows) / job->task_count; row < row_end; row++) {
+        int *destination = m_rowPointer_int(job->result, row);
+        const int *coefficients = m_rowPointer_int(job->m1, row);
+        size_t k_first, k_end;
+        m_storedColumns_int(job->m1, row, &k_first, &k_end);
+        for(size_t k = k_first; k < k_end; k++) {
+            if(0 != coefficients[k]) {
+                size_t first, end;
+                m_storedColumns_int(job->m2, k, &first, &end);
+                axpy(destination + first, coefficients[k], m_rowPointer_int(job->m2, k) + first, end - first);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Multiplies two matrices of which at least one is banded, touching only the band (see m_bandTask_int).  The product of two banded matrices is banded, with the bandwidths added, unless so wide a band would not take fewer bytes than a dense matrix.  An operand in any other storage than dense or banded takes part through a dense copy.
+ */
+static matrix_int_t*
+m_multiplyBanded_int(matrix_arena_t *arena, matrix_int_t *m1, matrix_int_t *m2) {
+    matrix_int_t *a = m1;
+    matrix_int_t *b = m2;
+    if((MATRIX_STORAGE_BANDED != m1->storage) && (MATRIX_STORAGE_DENSE != m1->storage)) {
+        a = createCopy_int(m1);
+        m_materialize_int(a);
+    }
+    if((MATRIX_STORAGE_BANDED != m2->storage) && (MATRIX_STORAGE_DENSE != m2->storage)) {
+        b = createCopy_int(m2);
+        m_materialize_int(b);
+    }
+    const size_t rows = a->i;
+    const size_t columns = b->j;
+    matrix_int_t *m = NULL;
+    if((MATRIX_STORAGE_BANDED == a->storage) && (MATRIX_STORAGE_BANDED == b->storage)) {
+        const size_t lower = ((a->lower_bandwidth + b->lower_bandwidth) < rows) ? (a->lower_bandwidth + b->lower_bandwidth) : (rows - 1);
+        const size_t upper = ((a->upper_bandwidth + b->upper_bandwidth) < rows) ? (a->upper_bandwidth + b->upper_bandwidth) : (rows - 1);
+        if((lower + upper + 1) < m_leadingDimension_int(columns)) {
+            m = m_initializeHeader_int(arena, rows, columns);
+            m->storage = MATRIX_STORAGE_BANDED;
+            m->lower_bandwidth = (uint32_t) lower;
+            m->upper_bandwidth = (uint32_t) upper;
+            m->array = m_allocate(arena, m_arrayBytes_int(m));
+        }
+    }
+    if(NULL == m) {
+        m = initializeMatrixArena_int(arena, rows, columns);
+    }
+    /* The work is the multiply-adds: the stored part of a row of M1 times the stored part of a row of M2, per row. */
+    const size_t depth = (MATRIX_STORAGE_BANDED == a->storage) ? (a->lower_bandwidth + a->upper_bandwidth + 1) : a->j;
+    const size_t width = (MATRIX_STORAGE_BANDED == b->storage) ? (b->lower_bandwidth + b->upper_bandwidth + 1) : columns;
+    matrix_bandJob_int_t job = {
+        .m1 = a,
+        .m2 = b,
+        .result = m,
+        .task_count = 1,
+    };
+    if((rows * depth * width) < MATRIX_GEMM_PARALLEL_THRESHOLD) {
+        m_bandTask_int(&job, 0, 0);
+    } else {
+        job.task_count = 4 * m_getThreadCount();
+        m_parallelFor(job.task_count, m_bandTask_int, &job);
+    }
+    if(b != m2) {
+        freeMatrix_int(b);
+    }
+    if(a != m1) {
+        freeMatrix_int(a);
+    }
+    return m;
+}
+
+/**
+ * @brief This function performs matrix multiplication, M1 x M2.  The result will be a new matrix struct allocated upon the heap.
+ * @param m1 The first matrix
+ * @param m2 The second matrix
+ * @return A new matrix allocated upon the heap
+ * @note The operands are characterized but never moved.  A null, identity, scalar or diagonal operand costs O(n^2) or less, a banded one O(n x bw) and a sparse one O(nnz) per column or row of the other.  The product of two sparse, two banded or two matrices packed in the same triangle stays in that storage; any other product is dense.  Two binary operands multiply by popcount (see matrix_bits.h), and everything else runs the cache-blocked product (see MATRIX_GEMM_MR).
+ */
+matrix_int_t*
+m_MatrixMultiply_int(matrix_int_t *m1, matrix_int_t *m2) {
+    return m_MatrixMultiplyArena_int(NULL, m1, m2);
+}
+
+/**
+ * @brief Performs matrix multiplication, M1 x M2, into a new matrix allocated from an arena.
+ * @param arena The arena to allocate from, or NULL to allocate upon the heap
+ * @param m1 The first matrix
+ * @param m2 The second matrix
+ * @return A new matrix allocated from the arena
+ * @note When the product runs on the calling thread, the packing buffers are taken from a scratch scope of the arena and given back before the function returns.
+ */
+matrix_int_t*
+m_MatrixMultiplyArena_int(matrix_arena_t *arena, matrix_int_t *m1, matrix_int_t *m2) {
+    assert(m1->j == m2->i);
+    /** The matrix result with have m1->rows and m2->columns */
+    /** Characterizing costs a sweep the first time and nothing once the flags are cached.  It only records the flags: the operands stay in the storage they are in, and the dispatch below follows the flags as well as the storage. */
+    const bool diagonal1 = m_isDiagonal_int(m1);
+    const bool diagonal2 = m_isDiagonal_int(m2);
+    if(m_hasAnyProperty_int(m1, MATRIX_IS_NULL) || m_hasAnyProperty_int(m2, MATRIX_IS_NULL)) {
+        return generateNullMatrixArena_int(arena, m1->i, m2->j);
+    }
+    if(diagonal1 && diagonal2) {
+        return m_combineDiagonals_int(arena, m1, m2, m_kernels_int()->multiply);
+    }
+    if(m_isImplicit_int(m1) || m_isImplicit_int(m2)) {
+        /* sI x A = A x sI = sA.  For the identity the scaling is skipped. */
+        matrix_int_t *implicit = m_isImplicit_int(m1) ? m1 : m2;
+        matrix_int_t *m = createCopyArena_int(arena, m_isImplicit_int(m1) ? m2 : m1);
+        if(MATRIX_STORAGE_SCALAR == implicit->storage) {
+            m_ScalarMultiply_int(m, implicit->scalar);
+        }
+        return m;
+    }
+    if(m_hasAnyProperty_int(m1, MATRIX_IS_IDENTITY)) {
+        return createCopyArena_int(arena, m2);
+    }
+    if(m_hasAnyProperty_int(m2, MATRIX_IS_IDENTITY)) {
+        return createCopyArena_int(arena, m1);
+    }
+    if(diagonal1) {
+        return m_scaleRows_int(arena, m1, m2);
+    }
+    if(diagonal2) {
+        return m_scaleColumns_int(arena, m1, m2);
+    }
+    if((MATRIX_STORAGE_BANDED == m1->storage) || (MATRIX_STORAGE_BANDED == m2->storage)) {
+        return m_multiplyBanded_int(arena, m1, m2);
+    }
+    if((MATRIX_STORAGE_CSR == m1->storage) || (MATRIX_STORAGE_CSR == m2->storage)) {
+        return m_multiplySparse_int(arena, m1, m2);
+    }
+    matrix_int_t *m = initializeMatrixArena_int(arena, m1->i, m2->j);
+
+    const size_t rows = m1->i;
+    const size_t columns = m2->j;
+    const size_t depth = m1->j;
+    if((0 == rows) || (0 == columns) || (0 == depth)) {
+        return m;
+    }
+
+    /** Binary operands multiply 64 elements per popcount once packed into bits (see matrix_bits.h).  The diagonal tests above have already characterized both, and an operand in bitpacked storage is packed already. */
+    if((depth >= MATRIX_BITS_MIN_DEPTH) && m_isBinary_int(m1) && m_isBinary_int(m2)) {
+        matrix_bits_t *bits1 = (MATRIX_STORAGE_BITS == m1->storage) ? m1->bits : m_packBits_int(m1);
+        matrix_bits_t *bits2 = (MATRIX_STORAGE_BITS == m2->storage) ? m2->bits : m_packBits_int(m2);
+        m_MatrixMultiplyInto_bits(bits1, bits2, m);
+        if(MATRIX_STORAGE_BITS != m2->storage) {
+            freeMatrix_bits(bits2);
+        }
+        if(MATRIX_STORAGE_BITS != m1->storage) {
+            freeMatrix_bits(bits1);
+        }
+        return m;
+    }
+
+    /** The packers read arrays, and widen narrowed ones, so only a bitpacked operand of a product that is not binary takes part through a dense copy. */
+    matrix_int_t *a = m_isNarrow_int(m1) ? m1 : m_decoded_int(m1);
+    matrix_int_t *b = m_isNarrow_int(m2) ? m2 : m_decoded_int(m2);
+    matrix_gemmJob_int_t job = {
+        .m1 = a,
+        .m2 = b,
+        .result = m,
+        .triangle_a = m_triangle_int(a),
+        .triangle_b = m_triangle_int(b),
+    };
+    m_runGemm_int(arena, &job);
+    m_packProduct_int(m, a, b);
+    if(b != m2) {
+        freeMatrix_int(b);
+    }
+    if(a != m1) {
+        freeMatrix_int(a);
+    }
+    return m;
+}
+
+/**
+ * @brief Describes one triangular solve for the thread pool.  Every task solves column_block columns of X, all of whose rows depend only on the same columns of the rows solved before.
+ */
+typedef struct Matrix_trsmJob_int_s {
+    matrix_int_t *t;
+    matrix_int_t *x;
+    bool lower;
+    size_t column_block;
+} matrix_trsmJob_int_t;
+
+/**
+ * @brief Solves one block of columns of T x X = B in place, X holding B on entry.  Row r of X is B[r] minus T[r][k] X[k] for every k solved before r, divided by T[r][r].
+ * @param context The matrix_trsmJob_int_t
+ * @param task The index of the column block
+ * @param worker Unused
+ */
+static void
+m_trsmTask_int(void *context, const size_t task, const size_t worker) {
+    (void) worker;
+    const matrix_trsmJob_int_t *job = context;
+    void (*const axpy)(int*, const int, const int*, const size_t) = m_kernels_int()->axpy;
+    matrix_int_t *x = job->x;
+    const size_t n = x->i;
+    const size_t column = task * job->column_block;
+    const size_t width = (x->j - column < job->column_block) ? (x->j - column) : job->column_block;
+    const bool diagonal_storage = m_isDiagonalStorage_int(job->t);
+    const matrix_sparse_t *sparse = (MATRIX_STORAGE_CSR == job->t->storage) ? job->t->sparse : NULL;
+    for(size_t step = 0; step < n; step++) {
+        const size_t row = job->lower ? step : (n - 1 - step);
+        int *target = x->array + (row * x->ld) + column;
+        if(NULL != sparse) {
+            /* A sparse T only updates with its nonzeros. */
+            for(size_t index = sparse->offsets[row]; index < sparse->offsets[row + 1]; index++) {
+                const size_t k = sparse->indices[index];
+                if(job->lower ? (k < row) : (k > row)) {
+                    axpy(target, (int) (0u - (unsigned int) sparse->values[index]), x->array + (k * x->ld) + column, width);
+                }
+            }
+        } else if(!diagonal_storage) {
+            const int *coefficients = m_rowPointer_int(job->t, row);
+            size_t first, end;
+            m_storedColumns_int(job->t, row, &first, &end);
+            const size_t k_begin = job->lower ? first : (row + 1);
+            const size_t k_end = job->lower ? row : end;
+            for(size_t k = k_begin; k < k_end; k++) {
+                if(0 != coefficients[k]) {
+                    axpy(target, (int) (0u - (unsigned int) coefficients[k]), x->array + (k * x->ld) + column, width);
+                }
+            }
+        }
+        const int divisor = m_at_int(job->t, row, row);
+        if(1 != divisor) {
+            for(size_t index = 0; index < width; index++) {
+                target[index] /= divisor;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Solves T x X = B for X, where T is upper or lower triangular (TRSM).  The rows of X are found by forward substitution for a lower T and by back substitution for an upper one.  Only the triangle of T is read, and each row of X is updated with the vectorized axpy kernel (see matrix_simd.h).
+ * @param t The triangular matrix, n x n.  m_isUpperTriangular_int or m_isLowerTriangular_int is asserted, and so is a diagonal without zeros.
+ * @param b The right-hand side, n x m
+ * @return A new n x m matrix allocated upon the heap
+ * @note The arithmetic is integer: each row is divided by its diagonal value with truncation, so X is exact when every division is, as it always is when T has ones on its diagonal.  The columns of B are solved independently, so large systems split them over the thread pool (see matrix_threads.h).
+ */
+matrix_int_t*
+m_TriangularSolve_int(matrix_int_t *t, matrix_int_t *b) {
+    return m_TriangularSolveArena_int(NULL, t, b);
+}
+
+/**
+ * @brief Solves T x X = B for a triangular T into a new matrix allocated from an arena.  See m_TriangularSolve_int.
+ * @param arena The arena to allocate from, or NULL to allocate upon the heap
+ * @param t The triangular matrix, n x n
+ * @param b The right-hand side, n x m
+ * @return A new n x m matrix allocated from the arena
+ */
+matrix_int_t*
+m_TriangularSolveArena_int(matrix_arena_t *arena, matrix_int_t *t, matrix_int_t *b) {
+    assert(m_isSquare_int(t));
+    assert(t->j == b->i);
+    const bool lower = m_isLowerTriangular_int(t);
+    assert(lower || m_isUpperTriangular_int(t));
+    for(size_t index = 0; index < t->i; index++) {
+        assert(0 != m_at_int(t, index, index));
+    }
+    matrix_int_t *x = createCopyArena_int(arena, b);
+    m_materialize_int(x);
+    m_invalidateProperties_int(x);
+    if((0 == x->i) || (0 == x->j)) {
+        return x;
+    }
+    /* A sparse T is read row by row from its nonzeros; a bitpacked or narrowed one through a dense copy. */
+    matrix_int_t *triangle = (MATRIX_STORAGE_CSR != t->storage) ? m_decoded_int(t) : t;
+    matrix_trsmJob_int_t job = {
+        .t = triangle,
+        .x = x,
+        .lower = lower,
+        .column_block = x->j,
+    };
+    if((t->i * t->i * x->j) < MATRIX_GEMM_PARALLEL_THRESHOLD) {
+        m_trsmTask_int(&job, 0, 0);
+    } else {
+        /* One column block per thread: the rows of X stream through every update, and wider rows stream faster.  Each block is a whole number of cache lines wide so that no two tasks write to the same line. */
+        const size_t target_tasks = m_getThreadCount();
+        const size_t width = (x->j + target_tasks - 1) / target_tasks;
+        job.column_block = ((width + MATRIX_GEMM_NR - 1) / MATRIX_GEMM_NR) * MATRIX_GEMM_NR;
+        m_parallelFor((x->j + job.column_block - 1) / job.column_block, m_trsmTask_int, &job);
+    }
+    if(triangle != t) {
+        freeMatrix_int(triangle);
+    }
+    return x;
+}
+
+/**
+ * @brief Solves A x X = B for X, where A is a square matrix with a narrow band, such as the tridiagonal matrices of finite differences (GBSV).  A is factored by Gaussian elimination with partial pivoting within the band, which for a tridiagonal A is the Thomas algorithm with row exchanges, and every column of X is then found by forward and back substitution.  The factors fill at most kl + (kl + ku) diagonals, so the solve costs O(n x kl x (kl + ku)) plus O(n x (2kl + ku)) per column of B, rather than O(n^3).
+ * @param a The matrix, n x n, in any storage.  Its bandwidths are those of its storage when it is banded, and are measured otherwise.  A singular A is asserted against.
+ * @param b The right-hand side, n x m
+ * @return A new n x m matrix allocated upon the heap
+ * @note Elimination mixes rows in proportions that integers cannot hold, so the factorization and substitutions are in double precision and each value of X is rounded to the nearest integer.  X is exact when the solution is integral and A is well conditioned.
+ */
+matrix_int_t*
+m_BandedSolve_int(matrix_int_t *a, matrix_int_t *b) {
+    return m_BandedSolveArena_int(NULL, a, b);
+}
+
+/**
+ * @brief Solves A x X = B for a banded A into a new matrix allocated from an arena.  See m_BandedSolve_int.
+ * @param arena The arena to allocate from, or NULL to allocate upon the heap
+ * @param a The matrix, n x n
+ * @param b The right-hand side, n x m
+ * @return A new n x m matrix allocated from the arena
+ */
+matrix_int_t*
+m_BandedSolveArena_int(matrix_arena_t *arena, matrix_int_t *a, matrix_int_t *b) {
+    assert(m_isSquare_int(a));
+    assert(a->j == b->i);
+    const size_t n = a->i;
+    matrix_int_t *x = initializeMatrixArena_int(arena, b->i, b->j);
+    if((0 == n) || (0 == b->j)) {
+        return x;
+    }
+    /* A matrix in any other storage is read one expanded row at a time, once to measure its band and once to copy it. */
+    size_t lower = a->lower_bandwidth;
+    size_t upper = a->upper_bandwidth;
+    int *buffer = NULL;
+    if(MATRIX_STORAGE_BANDED != a->storage) {
+        buffer = malloc(n * sizeof(int));
+        assert(NULL != buffer);
+        for(size_t row = 0; row < n; row++) {
+            m_copyRow_int(a, row, buffer);
+            for(size_t c = 0; c < n; c++) {
+                if(0 != buffer[c]) {
+                    lower = ((c < row) && ((row - c) > lower)) ? (row - c) : lower;
+                    upper = ((c > row) && ((c - row) > upper)) ? (c - row) : upper;
+                }
+            }
+        }
+    }
+    /**
+     * The factors are kept as LAPACK keeps them, one row of the band at a time: row r holds columns r - kl to r + kl + ku, the kl extra diagonals above taking the fill that row exchanges bring up.  factors + (r x (width - 1)) + kl is the row pointer through which column c of row r is at [c].
+     */
+    const size_t width = (2 * lower) + upper + 1;
+    double *factors = calloc(n * width, sizeof(double));
+    size_t *pivots = malloc(n * sizeof(size_t));
+    double *column = malloc(n * sizeof(double));
+    assert((NULL != factors) && (NULL != pivots) && (NULL != column));
+    for(size_t row = 0; row < n; row++) {
+        double *destination = factors + (row * (width - 1)) + lower;
+        const int *values = buffer;
+        if(NULL == buffer) {
+            values = m_rowPointer_int(a, row);
+        } else {
+            m_copyRow_int(a, row, buffer);
+        }
+        const size_t first = (row > lower) ? (row - lower) : 0;
+        const size_t end = ((row + upper + 1) < n) ? (row + upper + 1) : n;
+        for(size_t c = first; c < end; c++) {
+            destination[c] = values[c];
+        }
+    }
+    free(buffer);
+
+    /* Step k takes the largest of the kl values below the pivot as the pivot, exchanges the rows, and eliminates column k below it, keeping each multiplier in the place it zeroes. */
+    for(size_t k = 0; k < n; k++) {
+        double *pivot_row = factors + (k * (width - 1)) + lower;
+        const size_t last = ((k + lower) < n) ? (k + lower) : (n - 1);
+        const size_t end = ((k + lower + upper + 1) < n) ? (k + lower + upper + 1) : n;
+        size_t pivot = k;
+        double largest = fabs(pivot_row[k]);
+        for(size_t row = k + 1; row <= last; row++) {
+            const double magnitude = fabs(factors[(row * (width - 1)) + lower + k]);
+            if(magnitude > largest) {
+                pivot = row;
+                largest = magnitude;
+            }
+        }
+        assert(0.0 != largest);
+        pivots[k] = pivot;
+        if(pivot != k) {
+            double *other = factors + (pivot * (width - 1)) + lower;
+            for(size_t c = k; c < end; c++) {
+                const double value = pivot_row[c];
+                pivot_row[c] = other[c];
+                other[c] = value;
+            }
+        }
+        for(size_t row = k + 1; row <= last; row++) {
+            double *target = factors + (row * (width - 1)) + lower;
+            const double multiplier = target[k] / pivot_row[k];
+            target[k] = multiplier;
+            if(0.0 != multiplier) {
+                for(size_t c = k + 1; c < end; c++) {
+                    target[c] -= multiplier * pivot_row[c];
+                }
+            }
+        }
+    }
+
+    /* Every column of B replays the exchanges and the elimination, then is solved upwards against the upper factor. */
+    for(size_t c = 0; c < b->j; c++) {
+        for(size_t row = 0; row < n; row++) {
+            column[row] = m_at_int(b, row, c);
+        }
+        for(size_t k = 0; k < n; k++) {
+            if(pivots[k] != k) {
+                const double value = column[k];
+                column[k] = column[pivots[k]];
+                column[pivots[k]] = value;
+            }
+            const size_t last = ((k + lower) < n) ? (k + lower) : (n - 1);
+            for(size_t row = k + 1; row <= last; row++) {
+                column[row] -= factors[(row * (width - 1)) + lower + k] * column[k];
+            }
+        }
+        for(size_t step = 0; step < n; step++) {
+            const size_t k = n - 1 - step;
+            const double *factor_row = factors + (k * (width - 1)) + lower;
+            const size_t end = ((k + lower + upper + 1) < n) ? (k + lower + upper + 1) : n;
+            double sum = column[k];
+            for(size_t j = k + 1; j < end; j++) {
+                sum -= factor_row[j] * column[j];
+            }
+            column[k] = sum / factor_row[k];
+        }
+        for(size_t row = 0; row < n; row++) {
+            x->array[(row * x->ld) + c] = (int) lround(column[row]);
+        }
+    }
+    free(column);
+    free(pivots);
+    free(factors);
+    return x;
+}
+
+/**
+ * @brief Computes the symmetric rank-k product M x M^T, or M^T x M (SYRK).  For a data matrix with one observation per row, M^T x M is its Gram matrix, and its covariance matrix once the columns are centered.  Only the upper triangle of the result is computed: the tiles below the diagonal are skipped, which saves almost half the multiply-adds, and the transposed operand is packed straight from M without forming M^T.
+ * @param m The matrix, n x k
+ * @param transpose false for M x M^T (n x n), true for M^T x M (k x k)
+ * @return A new matrix allocated upon the heap, in packed symmetric storage (see matrix_storage_t)
+ */
+matrix_int_t*
+m_SymmetricRankK_int(matrix_int_t *m, const bool transpose) {
+    return m_SymmetricRankKArena_int(NULL, m, transpose);
+}
+
+/**
+ * @brief Computes M x M^T, or M^T x M, into a new matrix allocated from an arena.  See m_SymmetricRankK_int.
+ * @param arena The arena to allocate from, or NULL to allocate upon the heap
+ * @param m The matrix, n x k
+ * @param transpose false for M x M^T, true for M^T x M
+ * @return A new matrix allocated from the arena
+ */
+matrix_int_t*
+m_SymmetricRankKArena_int(matrix_arena_t *arena, matrix_int_t *m, const bool transpose) {
+    assert(NULL != m);
+    const size_t n = transpose ? m->j : m->i;
+    const size_t depth = transpose ? m->i : m->j;
+    matrix_int_t *result = initializeMatrixArena_int(arena, n, n);
+    if((0 == n) || (0 == depth)) {
+        return result;
+    }
+    /* The transposed packers read rows of a dense array, so a compact operand is expanded into a temporary copy first. */
+    matrix_int_t *operand = m;
+    if(MATRIX_STORAGE_DENSE != m->storage) {
+        operand = createCopy_int(m);
+        m_materialize_int(operand);
+    }
+    matrix_gemmJob_int_t job = {
+        .m1 = operand,
+        .m2 = operand,
+        .result = result,
+        .transpose_a = transpose,
+        .transpose_b = !transpose,
+        .upper_only = true,
+    };
+    m_runGemm_int(arena, &job);
+    if(operand != m) {
+        freeMatrix_int(operand);
+    }
+    m_packTriangle_int(result, MATRIX_STORAGE_SYMMETRIC);
+    m_setProperties_int(result, MATRIX_IS_SYMMETRIC, true);
+    return result;
+}
+
+/**
+ * @brief Finds the dot product of two integer arrays of equal size
+ * @param a1 integer array
+ * @param a2 integer array
+ * @param length length of both arrays
+ * @return An integer value
+ */
+int
+m_dotProduct_int(int *a1, int *a2, const size_t length) {
+    return m_kernels_int()->dot_product(a1, a2, length);
+}
+
+/**
+ * @brief
+ * @param
+ * @return
+ */
+float
+m_eigenValue_int(matrix_int_t *m) {
+    if(m_isIdentity_int(m)) {
+        return 1.0;
+    }
+    return 0;
+}
+
+/**
+ * @brief
+ * @param
+ * @return
+ */
+complex*
+m_eigenVector_int(matrix_int_t *m);
+
+/**
+ * @brief Creates a new array in memory containing the transpose of the matrix. 
+ * @param m Pointer to matrix_int_t object. 
+ * @return A new array in memory.
+ */
+int*
+m_transpose_int(matrix_int_t *m) {
+    int *transpose_array = calloc(m->i * m->j, sizeof(int));
+    /* A matrix with nothing off its diagonal, in whatever storage, is its own transpose. */
+    if(m_isDiagonalStorage_int(m) || m_isDiagonal_int(m)) {
+        const size_t length = (m->i < m->j) ? m->i : m->j;
+        for(size_t index = 0; index < length; index++) {
+            transpose_array[index * (m->i + 1)] = m_at_int(m, index, index);
+        }
+        return transpose_array;
+    }
+    int transpose_index = 0;
+    for(int i_index = 0; i_index < m->i; i_index++) {
+        for(int j_index = 0; j_index < m->j; j_index++) {
+            transpose_array[transpose_index] = m_at_int(m, j_index, i_index);
+            transpose_index++;
+        }
+    }
+    return transpose_array;
+}
+
+/**
+ * @brief Returns the value (a scalar) of the determinant of a matrix.  Only square matrices have determinants.  A triangular matrix, which includes the diagonal and implicit ones, takes the product of its diagonal in O(n).  Any other matrix is reduced by fraction-free (Bareiss) elimination in O(n^3).
+ * @param  m Pointer to matrix_int_t object.
+ * @return integer value.  Like the products, it wraps modulo 2^32 for a triangular matrix.  Elimination is exact as long as every minor fits in 64 bits.  The determinant of a 0 x 0 matrix is 1.
+ */
+int
+m_determinant_int(matrix_int_t *m) {
+    assert(m_isSquare_int(m));
+    if(m_isIdentity_int(m)) {
+        return 1;
+    }
+    const size_t n = m->i;
+    if(m_isUpperTriangular_int(m) || m_isLowerTriangular_int(m)) {
+        unsigned int product = 1;
+        for(size_t index = 0; index < n; index++) {
+            product *= (unsigned int) m_at_int(m, index, index);
+        }
+        return (int) product;
+    }
+    int64_t *a = malloc(n * n * sizeof(int64_t));
+    int *row_buffer = malloc(n * sizeof(int));
+    assert((NULL != a) && (NULL != row_buffer));
+    for(size_t row = 0; row < n; row++) {
+        m_copyRow_int(m, row, row_buffer);
+        for(size_t column = 0; column < n; column++) {
+            a[(row * n) + column] = row_buffer[column];
+        }
+    }
+    free(row_buffer);
+    /* After step k every entry below and right of the pivot is a (k + 2) x (k + 2) minor of m, so the division by the previous pivot is exact. */
+    int64_t previous = 1;
+    int64_t sign = 1;
+    int64_t determinant = 1;
+    for(size_t k = 0; k < n; k++) {
+        size_t pivot = k;
+        while((pivot < n) && (0 == a[(pivot * n) + k])) {
+            pivot++;
+        }
+        if(pivot == n) {
+            free(a);
+            return 0;
+        }
+        if(pivot != k) {
+            for(size_t column = k; column < n; column++) {
+                const int64_t swap = a[(k * n) + column];
+                a[(k * n) + column] = a[(pivot * n) + column];
+                a[(pivot * n) + column] = swap;
+            }
+            sign = -sign;
+        }
+        const int64_t diagonal = a[(k * n) + k];
+        for(size_t row = k + 1; row < n; row++) {
+            const int64_t factor = a[(row * n) + k];
+            for(size_t column = k + 1; column < n; column++) {
+                a[(row * n) + column] = ((diagonal * a[(row * n) + column]) - (factor * a[(k * n) + column])) / previous;
+            }
+        }
+        previous = diagonal;
+        determinant = diagonal;
+    }
+    free(a);
+    return (int) (sign * determinant);
+}
+
+/**
+ * @brief Determines if a matrix is nilpotent.  In other words, whether that 
+ * @param m Pointer to matrix_int_t object.
+ * @return boolean.  True if orthogonal, false otherwise.
+ */
+unsigned int
+m_nilPotentDegree_int(matrix_int_t *m);
+
+
+/*************************** MATRIX CHARACTERIZATIONS ************************** */
+
+/**
+ * @brief Records the properties of a square matrix with nothing off its diagonal, in whatever storage it is.  Only a constant diagonal can make it null (0), the identity or stochastic (1).
+ * @param constant Whether every diagonal value equals scalar
+ */
+static void
+m_setDiagonalProperties_int(matrix_int_t *m, const bool constant, const int scalar, const bool binary) {
+    m_setProperties_int(m, MATRIX_IS_UPPER_TRIANGULAR | MATRIX_IS_LOWER_TRIANGULAR | MATRIX_IS_DIAGONAL | MATRIX_IS_SYMMETRIC, true);
+    m_setProperties_int(m, MATRIX_IS_NULL, constant && (0 == scalar));
+    m_setProperties_int(m, MATRIX_IS_IDENTITY | MATRIX_IS_STOCHASTIC, constant && (1 == scalar));
+    m_setProperties_int(m, MATRIX_IS_BINARY, binary);
+}
+
+/**
+ * @brief Characterizes a matrix in compact diagonal storage from its n diagonal values.  A constant diagonal moves it on to an implicit scalar matrix if convert is set.
+ */
+static void
+m_characterizeDiagonal_int(matrix_int_t *m, const bool convert) {
+    bool constant = true;
+    for(size_t index = 1; constant && (index < m->i); index++) {
+        constant = (m->array[index] == m->array[0]);
+    }
+    if(constant && convert) {
+        const int scalar = m->array[0];
+        m_release(m->arena, m->array, m_arrayBytes_int(m));
+        m->array = NULL;
+        m_setImplicit_int(m, scalar);
+        return;
+    }
+    matrix_rangeSummary_int_t summary;
+    m_kernels_int()->summarize(m->array, m->i, &summary);
+    m_setDiagonalProperties_int(m, constant, m->array[0], 0 == (summary.bits & ~1u));
+}
+
+/**
+ * @brief Finishes the characterization of a packed or banded matrix that turned out to hold nothing off its diagonal.  If convert is set, a null matrix becomes an implicit null matrix and any other one moves on to a diagonal or implicit storage; otherwise only its properties are recorded.
+ */
+static void
+m_characterizeOffDiagonalZero_int(matrix_int_t *m, const bool convert, const bool null, const bool constant, const bool binary) {
+    if(!convert) {
+        m_setDiagonalProperties_int(m, constant, (0 != m->i) ? m_at_int(m, 0, 0) : 0, binary);
+        return;
+    }
+    if(null) {
+        m_release(m->arena, m->array, m_arrayBytes_int(m));
+        m->array = NULL;
+        m->lower_bandwidth = 0;
+        m->upper_bandwidth = 0;
+        m_setImplicit_int(m, 0);
+        return;
+    }
+    m_compactDiagonal_int(m);
+    m_characterize_int(m);
+}
+
+/**
+ * @brief Characterizes a matrix in packed triangular storage from the n(n + 1)/2 values of its triangle.  If convert is set, a matrix with nothing off the diagonal moves on to a diagonal or implicit storage, and a null one to an implicit null matrix.  Otherwise the matrix is triangular in its own triangle only, so it is neither diagonal nor symmetric.
+ */
+static void
+m_characterizeTriangular_int(matrix_int_t *m, const bool convert) {
+    void (*const summarize)(const int*, const size_t, matrix_rangeSummary_int_t*) = m_kernels_int()->summarize;
+    const bool upper = (MATRIX_STORAGE_UPPER == m->storage);
+    bool binary = true;
+    bool null = true;
+    bool off_diagonal_zero = true;
+    bool constant = true;
+    bool stochastic = true;
+    for(size_t row = 0; row < m->i; row++) {
+        const int *values = m_rowPointer_int(m, row);
+        matrix_rangeSummary_int_t off_diagonal;
+        if(upper) {
+            summarize(values + row + 1, m->i - row - 1, &off_diagonal);
+        } else {
+            summarize(values, row, &off_diagonal);
+        }
+        const int diagonal_value = values[row];
+        const unsigned int bits = off_diagonal.bits | (unsigned int) diagonal_value;
+        binary = binary && (0 == (bits & ~1u));
+        null = null && (0 == bits);
+        off_diagonal_zero = off_diagonal_zero && (0 == off_diagonal.bits);
+        constant = constant && (diagonal_value == m_at_int(m, 0, 0));
+        stochastic = stochastic && (0 == (bits & 0x80000000u)) && (1 == (off_diagonal.sum + diagonal_value));
+    }
+    if(off_diagonal_zero) {
+        m_characterizeOffDiagonalZero_int(m, convert, null, constant, binary);
+        return;
+    }
+    m_setProperties_int(m, upper ? MATRIX_IS_UPPER_TRIANGULAR : MATRIX_IS_LOWER_TRIANGULAR, true);
+    m_setProperties_int(m, (upper ? MATRIX_IS_LOWER_TRIANGULAR : MATRIX_IS_UPPER_TRIANGULAR) | MATRIX_IS_DIAGONAL | MATRIX_IS_IDENTITY | MATRIX_IS_NULL | MATRIX_IS_SYMMETRIC, false);
+    m_setProperties_int(m, MATRIX_IS_BINARY, binary);
+    m_setProperties_int(m, MATRIX_IS_STOCHASTIC, stochastic);
+}
+
+/**
+ * @brief Characterizes a matrix in packed symmetric storage from the n(n + 1)/2 values of its upper triangle.  If convert is set, a matrix with nothing off the diagonal moves on to a diagonal or implicit storage, and a null one to an implicit null matrix.  Otherwise it is symmetric and not triangular.
+ */
+static void
+m_characterizeSymmetric_int(matrix_int_t *m, const bool convert) {
+    void (*const summarize)(const int*, const size_t, matrix_rangeSummary_int_t*) = m_kernels_int()->summarize;
+    const size_t n = m->i;
+    bool binary = true;
+    bool null = true;
+    bool off_diagonal_zero = true;
+    bool constant = true;
+    bool stochastic = true;
+    /* Row r holds its stored part and, mirrored, column r of the rows above it, so its sum gathers both. */
+    int64_t *sums = calloc(n, sizeof(int64_t));
+    assert(NULL != sums);
+    for(size_t row = 0; row < n; row++) {
+        const int *values = m_rowPointer_int(m, row);
+        matrix_rangeSummary_int_t off_diagonal;
+        summarize(values + row + 1, n - row - 1, &off_diagonal);
+        const int diagonal_value = values[row];
+        const unsigned int bits = off_diagonal.bits | (unsigned int) diagonal_value;
+        binary = binary && (0 == (bits & ~1u));
+        null = null && (0 == bits);
+        off_diagonal_zero = off_diagonal_zero && (0 == off_diagonal.bits);
+        constant = constant && (diagonal_value == m_at_int(m, 0, 0));
+        stochastic = stochastic && (0 == (bits & 0x80000000u));
+        if(stochastic) {
+            sums[row] += off_diagonal.sum + diagonal_value;
+            for(size_t column = row + 1; column < n; column++) {
+                sums[column] += values[column];
+            }
+        }
+    }
+    for(size_t row = 0; stochastic && (row < n); row++) {
+        stochastic = (1 == sums[row]);
+    }
+    free(sums);
+    if(off_diagonal_zero) {
+        m_characterizeOffDiagonalZero_int(m, convert, null, constant, binary);
+        return;
+    }
+    m_setProperties_int(m, MATRIX_IS_SYMMETRIC, true);
+    m_setProperties_int(m, MATRIX_IS_UPPER_TRIANGULAR | MATRIX_IS_LOWER_TRIANGULAR | MATRIX_IS_DIAGONAL | MATRIX_IS_IDENTITY | MATRIX_IS_NULL, false);
+    m_setProperties_int(m, MATRIX_IS_BINARY, binary);
+    m_setProperties_int(m, MATRIX_IS_STOCHASTIC, stochastic);
+}
+
+/**
+ * @brief Characterizes a matrix in banded storage from the values of its band.  If convert is set, a null matrix becomes an implicit null matrix, one with nothing off the diagonal moves on to a diagonal or implicit storage, and a band whose outer diagonals hold only zeros, as a sum or product may leave, is narrowed to the diagonals that hold values.  For symmetry every value off the diagonal is compared with its mirror, which is zero when the band does not store it.
+ */
+static void
+m_characterizeBanded_int(matrix_int_t *m, const bool convert) {
+    void (*const summarize)(const int*, const size_t, matrix_rangeSummary_int_t*) = m_kernels_int()->summarize;
+    bool binary = true;
+    bool null = true;
+    bool constant = true;
+    bool symmetric = true;
+    bool stochastic = true;
+    size_t lower = 0;
+    size_t upper = 0;
+    for(size_t row = 0; row < m->i; row++) {
+        const int *values = m_rowPointer_int(m, row);
+        size_t first, end;
+        m_storedColumns_int(m, row, &first, &end);
+        matrix_rangeSummary_int_t summary;
+        summarize(values + first, end - first, &summary);
+        binary = binary && (0 == (summary.bits & ~1u));
+        null = null && (0 == summary.bits);
+        stochastic = stochastic && (0 == (summary.bits & 0x80000000u)) && (1 == summary.sum);
+        constant = constant && (m_at_int(m, row, row) == m_at_int(m, 0, 0));
+        for(size_t column = first; column < row; column++) {
+            if(0 != values[column]) {
+                lower = ((row - column) > lower) ? (row - column) : lower;
+                break;
+            }
+        }
+        for(size_t column = end; column > (row + 1); column--) {
+            if(0 != values[column - 1]) {
+                upper = ((column - 1 - row) > upper) ? (column - 1 - row) : upper;
+                break;
+            }
+        }
+        for(size_t column = first; symmetric && (column < end); column++) {
+            symmetric = (values[column] == m_at_int(m, column, row));
+        }
+    }
+    if((0 == lower) && (0 == upper)) {
+        m_characterizeOffDiagonalZero_int(m, convert, null, constant, binary);
+        return;
+    }
+    if(convert && ((lower < m->lower_bandwidth) || (upper < m->upper_bandwidth))) {
+        m_packBand_int(m, lower, upper);
+    }
+    m_setProperties_int(m, MATRIX_IS_UPPER_TRIANGULAR, 0 == lower);
+    m_setProperties_int(m, MATRIX_IS_LOWER_TRIANGULAR, 0 == upper);
+    m_setProperties_int(m, MATRIX_IS_DIAGONAL | MATRIX_IS_IDENTITY | MATRIX_IS_NULL, false);
+    m_setProperties_int(m, MATRIX_IS_SYMMETRIC, symmetric);
+    m_setProperties_int(m, MATRIX_IS_BINARY, binary);
+    m_setProperties_int(m, MATRIX_IS_STOCHASTIC, stochastic);
+}
+
+/**
+ * @brief The side of the square tiles that the symmetry test compares.  Two 32 x 32 tiles of ints take 8 KiB, so both stay in the L1 cache.
+ */
+#define MATRIX_SYMMETRY_TILE 32
+
+/**
+ * @brief Tests a dense, square matrix for symmetry one pair of tiles at a time.  Tile (J, I) is transposed into a buffer, so that it lines up with tile (I, J) and each of its rows can be compared with one memcmp.  Both tiles are read once, and the test stops at the first tile that differs.
+ */
+static bool
+m_isSymmetricBlocked_int(const matrix_int_t *m) {
+    int tile[MATRIX_SYMMETRY_TILE * MATRIX_SYMMETRY_TILE];
+    const size_t n = m->i;
+    for(size_t ib = 0; ib < n; ib += MATRIX_SYMMETRY_TILE) {
+        const size_t rows = (n - ib < MATRIX_SYMMETRY_TILE) ? (n - ib) : MATRIX_SYMMETRY_TILE;
+        for(size_t jb = ib; jb < n; jb += MATRIX_SYMMETRY_TILE) {
+            const size_t columns = (n - jb < MATRIX_SYMMETRY_TILE) ? (n - jb) : MATRIX_SYMMETRY_TILE;
+            for(size_t column = 0; column < columns; column++) {
+                const int *source = m->array + ((jb + column) * m->ld) + ib;
+                for(size_t row = 0; row < rows; row++) {
+                    tile[(row * MATRIX_SYMMETRY_TILE) + column] = source[row];
+                }
+            }
+            for(size_t row = 0; row < rows; row++) {
+                if(0 != memcmp(m->array + ((ib + row) * m->ld) + jb, tile + (row * MATRIX_SYMMETRY_TILE), columns * sizeof(int))) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Finds whether a matrix may move to an encoded storage: it is upon the heap, and it is neither a view nor pinned by one.
+ */
+static bool
+m_isEncodable_int(const matrix_int_t *m) {
+    return (NULL == m->arena) && (NULL == m->parent) && !m->pinned;
+}
+
+/**
+ * @brief Measures the nonzeros, bandwidths and diagonal blocks of a matrix in any storage, one row at a time.  Every row gives its first and last nonzero column and its count: a sparse row from its indices, a dense row by a scan, any other row from a copy.  Rows that hold nothing do not count towards the bandwidths.
+ * @param limit The measurement stops as soon as there are more nonzeros than this
+ * @return false if it stopped, in which case only structure->nonzeros is meaningful
+ */
+static bool
+m_measureStructure_int(matrix_int_t *m, const size_t limit, matrix_structure_int_t *structure) {
+    const size_t rows = m->i;
+    const size_t columns = m->j;
+    const bool square = (rows == columns);
+    const matrix_sparse_t *sparse = (MATRIX_STORAGE_CSR == m->storage) ? m->sparse : NULL;
+    const bool diagonal_storage = m_isDiagonalStorage_int(m);
+    int *buffer = NULL;
+    if(!diagonal_storage && (NULL == sparse) && (MATRIX_STORAGE_DENSE != m->storage)) {
+        buffer = malloc(columns * sizeof(int));
+        assert(NULL != buffer);
+    }
+    /* The first and last nonzero column of every row of a square matrix, for the blocks.  An empty row has first = n and last = 0, which never keeps a split from happening. */
+    size_t *first_columns = NULL;
+    size_t *last_columns = NULL;
+    if(square) {
+        first_columns = malloc(rows * sizeof(size_t));
+        last_columns = malloc(rows * sizeof(size_t));
+        assert((NULL != first_columns) && (NULL != last_columns));
+    }
+    *structure = (matrix_structure_int_t) {0};
+    structure->storage = m->storage;
+    bool measured = true;
+    for(size_t row = 0; row < rows; row++) {
+        size_t count = 0;
+        size_t first = columns;
+        size_t last = 0;
+        if(diagonal_storage) {
+            if((row < columns) && (0 != m_at_int(m, row, row))) {
+                count = 1;
+                first = row;
+                last = row;
+            }
+        } else if(NULL != sparse) {
+            count = sparse->offsets[row + 1] - sparse->offsets[row];
+            if(0 != count) {
+                first = sparse->indices[sparse->offsets[row]];
+                last = sparse->indices[sparse->offsets[row + 1] - 1];
+            }
+        } else {
+            const int *values = m->array + (row * m->ld);
+            if(NULL != buffer) {
+                m_copyRow_int(m, row, buffer);
+                values = buffer;
+            }
+            for(size_t column = 0; column < columns; column++) {
+                if(0 != values[column]) {
+                    first = (0 == count) ? column : first;
+                    last = column;
+                    count++;
+                }
+            }
+        }
+        structure->nonzeros += count;
+        if(structure->nonzeros > limit) {
+            measured = false;
+            break;
+        }
+        if(0 != count) {
+            if((first < row) && ((row - first) > structure->lower_bandwidth)) {
+                structure->lower_bandwidth = row - first;
+            }
+            if((last > row) && ((last - row) > structure->upper_bandwidth)) {
+                structure->upper_bandwidth = last - row;
+            }
+        }
+        if(square) {
+            first_columns[row] = first;
+            last_columns[row] = last;
+        }
+    }
+    if(measured) {
+        structure->blocks = ((0 == rows) || (0 == columns)) ? 0 : 1;
+        /* The diagonal splits between rows k and k + 1 when no row up to k reaches right of column k, and no row after it reaches left of column k + 1. */
+        if(square && (rows > 0)) {
+            for(size_t row = rows - 1; row > 0; row--) {
+                if(first_columns[row] < first_columns[row - 1]) {
+                    first_columns[row - 1] = first_columns[row];
+                }
+            }
+            size_t reach = 0;
+            for(size_t k = 0; (k + 1) < rows; k++) {
+                reach = (last_columns[k] > reach) ? last_columns[k] : reach;
+                if((reach <= k) && (first_columns[k + 1] > k)) {
+                    structure->blocks++;
+                }
+            }
+        }
+    }
+    free(last_columns);
+    free(first_columns);
+    free(buffer);
+    return measured;
+}
+
+/**
+ * @brief Measures the bandwidths of a dense, square matrix.  Each row only summarizes its parts outside the band found so far, and scans such a part for its outermost nonzero only when it is not zero, so a banded matrix is read once at the speed of the summarize kernel (see matrix_simd.h).
+ * @param limit The measurement stops as soon as the band takes more than this many diagonals
+ * @return false if it stopped
+ */
+static bool
+m_measureBand_int(const matrix_int_t *m, const size_t limit, size_t *lower, size_t *upper) {
+    void (*const summarize)(const int*, const size_t, matrix_rangeSummary_int_t*) = m_kernels_int()->summarize;
+    const size_t n = m->i;
+    *lower = 0;
+    *upper = 0;
+    for(size_t row = 0; row < n; row++) {
+        const int *values = m->array + (row * m->ld);
+        matrix_rangeSummary_int_t summary;
+        if(row > *lower) {
+            summarize(values, row - *lower, &summary);
+            if(0 != summary.bits) {
+                size_t column = 0;
+                while(0 == values[column]) {
+                    column++;
+                }
+                *lower = row - column;
+            }
+        }
+        const size_t end = row + *upper + 1;
+        if(end < n) {
+            summarize(values + end, n - end, &summary);
+            if(0 != summary.bits) {
+                size_t column = n - 1;
+                while(0 == values[column]) {
+                    column--;
+                }
+                *upper = column - row;
+            }
+        }
+        if((*lower + *upper + 1) > limit) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Records the range of the values of a matrix with its cached properties.
+ */
+static void
+m_recordRange_int(matrix_int_t *m, const int minimum, const int maximum) {
+    m_setProperties_int(m, MATRIX_HAS_RANGE, true);
+    m->properties.minimum = minimum;
+    m->properties.maximum = maximum;
 }
 
 /**
- * @brief This function performs matrix addition, M1 + M2.  The result will be a new matrix struct allocated upon the heap.
- * @param m1 The first matrix
- * @param m2 The second matrix
- * @return A new matrix allocated upon the heap
+ * @brief Measures the range of the values of a matrix from the values its storage holds, with the summarize kernel.  A storage that leaves elements out adds their zero to the range.
  */
-matrix_int_t*
-m_MatrixAdd_int(matrix_int_t *m1, matrix_int_t *m2) {
-    assert((m1->i == m2->i) && (m1->j == m2->j));
-    matrix_int_t *m = initializeMatrix_int(m1->i, m2->j);
-    for(size_t index = 0; index < (m1->i * m1->j); index++) {
-        m->array[index] = m1->array[index] + m2->array[index];
+static void
+m_measureRange_int(matrix_int_t *m) {
+    void (*const summarize)(const int*, const size_t, matrix_rangeSummary_int_t*) = m_kernels_int()->summarize;
+    const size_t elements = m->i * m->j;
+    size_t stored = elements;
+    matrix_rangeSummary_int_t summary;
+    if(0 == elements) {
+        m_recordRange_int(m, 0, 0);
+        return;
     }
-    return m;
+    if(m_isImplicit_int(m)) {
+        summarize(&m->scalar, 1, &summary);
+        stored = m->i;
+    } else if(MATRIX_STORAGE_DIAGONAL == m->storage) {
+        summarize(m->array, m->i, &summary);
+        stored = m->i;
+    } else if(MATRIX_STORAGE_BANDED == m->storage) {
+        /* The places outside the matrix are zero but not elements, so only the stored columns of each row are summarized. */
+        summary.minimum = INT_MAX;
+        summary.maximum = INT_MIN;
+        stored = 0;
+        for(size_t row = 0; row < m->i; row++) {
+            size_t first, end;
+            m_storedColumns_int(m, row, &first, &end);
+            matrix_rangeSummary_int_t row_summary;
+            summarize(m_rowPointer_int(m, row) + first, end - first, &row_summary);
+            summary.minimum = (row_summary.minimum < summary.minimum) ? row_summary.minimum : summary.minimum;
+            summary.maximum = (row_summary.maximum > summary.maximum) ? row_summary.maximum : summary.maximum;
+            stored += end - first;
+        }
+    } else if(m_isPacked_int(m)) {
+        /* A packed symmetric matrix holds every value it has in its triangle. */
+        summarize(m->array, m_arrayBytes_int(m) / sizeof(int), &summary);
+        stored = m_isPackedTriangle_int(m) ? (m_arrayBytes_int(m) / sizeof(int)) : elements;
+    } else if(MATRIX_STORAGE_CSR == m->storage) {
+        summarize(m->sparse->values, m->sparse->nnz, &summary);
+        stored = m->sparse->nnz;
+    } else {
+        int *buffer = NULL;
+        if(MATRIX_STORAGE_DENSE != m->storage) {
+            buffer = malloc(m->j * sizeof(int));
+            assert(NULL != buffer);
+        }
+        summary.minimum = INT_MAX;
+        summary.maximum = INT_MIN;
+        for(size_t row = 0; row < m->i; row++) {
+            if(NULL != buffer) {
+                m_copyRow_int(m, row, buffer);
+            }
+            matrix_rangeSummary_int_t row_summary;
+            summarize((NULL != buffer) ? buffer : (m->array + (row * m->ld)), m->j, &row_summary);
+            summary.minimum = (row_summary.minimum < summary.minimum) ? row_summary.minimum : summary.minimum;
+            summary.maximum = (row_summary.maximum > summary.maximum) ? row_summary.maximum : summary.maximum;
+        }
+        free(buffer);
+    }
+    if(stored < elements) {
+        summary.minimum = (summary.minimum > 0) ? 0 : summary.minimum;
+        summary.maximum = (summary.maximum < 0) ? 0 : summary.maximum;
+    }
+    m_recordRange_int(m, summary.minimum, summary.maximum);
 }
 
-
 /**
- * @brief This function performs scalar matrix subtraction.  It modifies the matrix passed to the function
- * @param m matrix_int_t The matrix
- * @param scalar const int The scalar used for subtraction 
+ * @brief Returns the size in bytes of the narrowest of int8_t, int16_t and int that holds every value in [minimum, maximum].
  */
-void
-m_ScalarSubtract_int(matrix_int_t *m, const int scalar) {
-    assert(NULL != m);
-    for(size_t index = 0; index < (m->i * m->j); index++) {
-        m->array[index] -= scalar;
+static size_t
+m_rangeWidth_int(const int minimum, const int maximum) {
+    if((minimum >= INT8_MIN) && (maximum <= INT8_MAX)) {
+        return sizeof(int8_t);
+    }
+    if((minimum >= INT16_MIN) && (maximum <= INT16_MAX)) {
+        return sizeof(int16_t);
     }
+    return sizeof(int);
 }
 
 /**
- * @brief This function performs matrix subtraction, M1 + M2.  The result will be a new matrix struct allocated upon the heap.
- * @param m1 The first matrix
- * @param m2 The second matrix
- * @return A new matrix allocated upon the heap
+ * @brief Chooses the storage that holds a matrix in the fewest bytes.  Dense takes i x ld ints, packed n(n + 1)/2, banded n(kl + ku + 1), compressed sparse rows 8 bytes per nonzero plus 8 per row, narrowed i x ld elements of 1 or 2 bytes, and bitpacked one bit per element.  The encodings are only weighed for a large matrix that may take them (see m_isEncodable_int), and narrowing only against dense storage.
+ * @param packed The packed storage the matrix fits, or MATRIX_STORAGE_DENSE if none
+ * @param binary Whether the matrix is binary
+ * @param structure The number of nonzeros, or SIZE_MAX if there are too many to be worth storing sparse, and the bandwidths, or SIZE_MAX if the band is too wide to be worth storing
+ * @param width The bytes per element that the range of the values needs (see m_rangeWidth_int)
  */
-matrix_int_t*
-m_MatrixSubtract_int(matrix_int_t *m1, matrix_int_t *m2) {
-    assert((m1->i == m2->i) && (m1->j == m2->j));
-    matrix_int_t *m = initializeMatrix_int(m1->i, m2->j);
-    for(size_t index = 0; index < (m1->i * m1->j); index++) {
-        m->array[index] = m1->array[index] - m2->array[index];
+static matrix_storage_t
+m_cheapestStorage_int(const matrix_int_t *m, const matrix_storage_t packed, const bool binary, const matrix_structure_int_t *structure, const size_t width) {
+    matrix_storage_t storage = MATRIX_STORAGE_DENSE;
+    size_t bytes = m->i * m->ld * sizeof(int);
+    if(MATRIX_STORAGE_DENSE != packed) {
+        storage = packed;
+        bytes = ((m->i * (m->i + 1)) / 2) * sizeof(int);
     }
-    return m;
+    if((SIZE_MAX != structure->lower_bandwidth) && (SIZE_MAX != structure->upper_bandwidth)) {
+        const size_t band_bytes = m->i * (structure->lower_bandwidth + structure->upper_bandwidth + 1) * sizeof(int);
+        if(band_bytes < bytes) {
+            storage = MATRIX_STORAGE_BANDED;
+            bytes = band_bytes;
+        }
+    }
+    if(!m_isEncodable_int(m) || ((m->i * m->j) < MATRIX_FORMAT_MIN_ELEMENTS)) {
+        return storage;
+    }
+    if(SIZE_MAX != structure->nonzeros) {
+        const size_t sparse_bytes = (structure->nonzeros * (sizeof(uint32_t) + sizeof(int))) + ((m->i + 1) * sizeof(size_t));
+        if(sparse_bytes < bytes) {
+            storage = MATRIX_STORAGE_CSR;
+            bytes = sparse_bytes;
+        }
+    }
+    if((MATRIX_STORAGE_DENSE == packed) && (width < sizeof(int))) {
+        const size_t narrow_bytes = m->i * m->ld * width;
+        if(narrow_bytes < bytes) {
+            storage = (sizeof(int8_t) == width) ? MATRIX_STORAGE_INT8 : MATRIX_STORAGE_INT16;
+            bytes = narrow_bytes;
+        }
+    }
+    if(binary) {
+        const size_t bits_bytes = m->i * ((m->j + 63) / 64) * sizeof(uint64_t);
+        if(bits_bytes < bytes) {
+            storage = MATRIX_STORAGE_BITS;
+        }
+    }
+    return storage;
 }
 
 /**
- * @brief This checks if the values of two matrices, M1 and M2, are equal.
- * @param m1 The first matrix
- * @param m2 The second matrix
- * @return boolean. True if matrices are equal, false otherwise
+ * @brief Moves a matrix to compressed sparse row, bitpacked or narrowed storage.  The cached properties stay valid.
  */
-bool
-m_isEqual_int(matrix_int_t *m1, matrix_int_t *m2) {
-    if((m1->i != m2->i) || (m1->j != m2->j)) {
-        return false;
+static void
+m_encode_int(matrix_int_t *m, const matrix_storage_t storage) {
+    if(storage == m->storage) {
+        return;
     }
-    for(size_t index = 0; index < (m1->i * m1->j); index++) {
-        if(m1->array[index] != m2->array[index]) {
-            return false;
+    if(MATRIX_STORAGE_CSR == storage) {
+        matrix_sparse_t *sparse = m_packSparse_int(m, MATRIX_SPARSE_CSR);
+        m_releaseStorage_int(m);
+        m->sparse = sparse;
+    } else if(MATRIX_STORAGE_BITS == storage) {
+        matrix_bits_t *bits = m_packBits_int(m);
+        m_releaseStorage_int(m);
+        m->bits = bits;
+    } else {
+        /* The range of the values fits the narrow type, so the conversions keep every value. */
+        void *narrow = m_allocate(NULL, m->i * m->ld * ((MATRIX_STORAGE_INT8 == storage) ? sizeof(int8_t) : sizeof(int16_t)));
+        int *buffer = NULL;
+        if(MATRIX_STORAGE_DENSE != m->storage) {
+            buffer = malloc(m->j * sizeof(int));
+            assert(NULL != buffer);
+        }
+        for(size_t row = 0; row < m->i; row++) {
+            if(NULL != buffer) {
+                m_copyRow_int(m, row, buffer);
+            }
+            const int *values = (NULL != buffer) ? buffer : (m->array + (row * m->ld));
+            if(MATRIX_STORAGE_INT8 == storage) {
+                int8_t *destination = (int8_t *) narrow + (row * m->ld);
+                for(size_t column = 0; column < m->j; column++) {
+                    destination[column] = (int8_t) values[column];
+                }
+            } else {
+                int16_t *destination = (int16_t *) narrow + (row * m->ld);
+                for(size_t column = 0; column < m->j; column++) {
+                    destination[column] = (int16_t) values[column];
+                }
+            }
         }
+        free(buffer);
+        m_releaseStorage_int(m);
+        m->narrow = narrow;
     }
-    return true;
+    m->storage = storage;
 }
 
+/**
+ * @brief Finds the storage that m->format asks for.  MATRIX_FORMAT_BITS only asks for one if the matrix is binary, MATRIX_FORMAT_NARROW asks for the narrowest type that the range of the values fits, which may be int: dense, and MATRIX_FORMAT_BANDED asks for the band of the nonzeros of a square matrix, and for dense storage otherwise.
+ * @param storage Receives the storage
+ * @param structure Receives the bandwidths of a banded storage
+ * @return false if the format leaves the choice to characterization
+ */
+static bool
+m_requestedStorage_int(matrix_int_t *m, const bool binary, matrix_storage_t *storage, matrix_structure_int_t *structure) {
+    switch(m->format) {
+        case MATRIX_FORMAT_BANDED:
+            (void) m_measureStructure_int(m, SIZE_MAX, structure);
+            *storage = ((m->i == m->j) && (0 != m->i)) ? MATRIX_STORAGE_BANDED : MATRIX_STORAGE_DENSE;
+            return true;
+        case MATRIX_FORMAT_DENSE:
+            *storage = MATRIX_STORAGE_DENSE;
+            return true;
+        case MATRIX_FORMAT_SPARSE:
+            *storage = MATRIX_STORAGE_CSR;
+            return true;
+        case MATRIX_FORMAT_BITS:
+            *storage = MATRIX_STORAGE_BITS;
+            return binary;
+        case MATRIX_FORMAT_NARROW: {
+            int minimum, maximum;
+            m_range_int(m, &minimum, &maximum);
+            const size_t width = m_rangeWidth_int(minimum, maximum);
+            *storage = (sizeof(int8_t) == width) ? MATRIX_STORAGE_INT8 : ((sizeof(int16_t) == width) ? MATRIX_STORAGE_INT16 : MATRIX_STORAGE_DENSE);
+            return true;
+        }
+        default:
+            return false;
+    }
+}
 
 /**
- * @brief This function performs scalar matrix multiplication.  It modifies the matrix passed to the function
- * @param m matrix_int_t The matrix
- * @param scalar const int The scalar used for multiplication 
+ * @brief Moves a matrix to the storage chosen by m_cheapestStorage_int, expanding it first if that is dense or packed.
+ * @param structure The bandwidths, for a banded storage.  Unused otherwise.
  */
-void
-m_ScalarMultiply_int(matrix_int_t *m, const int scalar) {
-    assert(NULL != m);
-    for(size_t index = 0; index < (m->i * m->j); index++) {
-        m->array[index] *= scalar;
+static void
+m_store_int(matrix_int_t *m, const matrix_storage_t storage, const matrix_structure_int_t *structure) {
+    if(storage == m->storage) {
+        return;
+    }
+    if((MATRIX_STORAGE_CSR == storage) || (MATRIX_STORAGE_BITS == storage) || (MATRIX_STORAGE_INT8 == storage) || (MATRIX_STORAGE_INT16 == storage)) {
+        m_encode_int(m, storage);
+        return;
+    }
+    if(MATRIX_STORAGE_BANDED == storage) {
+        m_packBand_int(m, structure->lower_bandwidth, structure->upper_bandwidth);
+        return;
+    }
+    m_materialize_int(m);
+    if(MATRIX_STORAGE_DENSE != storage) {
+        m_packTriangle_int(m, storage);
     }
 }
 
 /**
- * @brief This function performs matrix multiplication, M1 x M2.  The result will be a new matrix struct allocated upon the heap.
- * @param m1 The first matrix
- * @param m2 The second matrix
- * @return A new matrix allocated upon the heap
+ * @brief Characterizes a matrix in compressed sparse row storage from its nonzeros alone, in O(nnz + i).  If convert is set, and unless the sparse format was requested, a matrix that is no longer sparse, or too small to be worth it, goes back to dense and is characterized there, a null one becomes implicit, a diagonal one compact, and a binary one bitpacked if that is smaller.
  */
-matrix_int_t*
-m_MatrixMultiply_int(matrix_int_t *m1, matrix_int_t *m2) {
-    assert(m1->j == m2->i);
-    /** The matrix result with have m1->rows and m2->columns */
-    if(m1->properties.is_identity) {
-        return createCopy_int(m2);
+static void
+m_characterizeSparse_int(matrix_int_t *m, const bool convert) {
+    if(convert && (MATRIX_FORMAT_SPARSE != m->format) && (((m->i * m->j) < MATRIX_FORMAT_MIN_ELEMENTS) || !m_isSparse_int(m))) {
+        m_materialize_int(m);
+        m_characterize_int(m);
+        return;
     }
-    if(m2->properties.is_identity) {
-        return createCopy_int(m1);
+    const matrix_sparse_t *sparse = m->sparse;
+    const size_t rows = m->i;
+    const bool square = (m->i == m->j);
+    matrix_rangeSummary_int_t summary;
+    m_kernels_int()->summarize(sparse->values, sparse->nnz, &summary);
+    const bool binary = (0 == (summary.bits & ~1u));
+    const bool null = (0 == sparse->nnz);
+    bool upper = square;
+    bool lower = square;
+    bool ones_on_diagonal = square;
+    bool stochastic = square && (0 == (summary.bits & 0x80000000u));
+    size_t lower_bandwidth = 0;
+    size_t upper_bandwidth = 0;
+    for(size_t row = 0; row < rows; row++) {
+        const size_t begin = sparse->offsets[row];
+        const size_t end = sparse->offsets[row + 1];
+        if(begin != end) {
+            upper = upper && (sparse->indices[begin] >= row);
+            lower = lower && (sparse->indices[end - 1] <= row);
+            if((sparse->indices[begin] < row) && ((row - sparse->indices[begin]) > lower_bandwidth)) {
+                lower_bandwidth = row - sparse->indices[begin];
+            }
+            if((sparse->indices[end - 1] > row) && ((sparse->indices[end - 1] - row) > upper_bandwidth)) {
+                upper_bandwidth = sparse->indices[end - 1] - row;
+            }
+        }
+        ones_on_diagonal = ones_on_diagonal && (1 == m_at_sparse(sparse, row, row));
+        if(stochastic) {
+            int64_t sum = 0;
+            for(size_t index = begin; index < end; index++) {
+                sum += sparse->values[index];
+            }
+            stochastic = (1 == sum);
+        }
     }
-    matrix_int_t *m = initializeMatrix_int(m1->j, m2->i);
-    /**
-     * Take dot product of first row of first matrix 
-     *      and first column of second matrix.
-     */
-    //const size_t result_array_length = m->i * m->j;
-    size_t result_array_index = 0;
+    /* The transpose of a symmetric matrix is itself, so its CSC arrays are its CSR arrays. */
+    bool symmetric = square;
+    if(symmetric) {
+        matrix_sparse_t *transpose = m_convert_sparse(sparse, MATRIX_SPARSE_CSC);
+        symmetric = (0 == memcmp(transpose->offsets, sparse->offsets, (rows + 1) * sizeof(size_t)))
+                 && (0 == memcmp(transpose->indices, sparse->indices, sparse->nnz * sizeof(uint32_t)))
+                 && (0 == memcmp(transpose->values, sparse->values, sparse->nnz * sizeof(int)));
+        freeMatrix_sparse(transpose);
+    }
+    const uint32_t value = (binary ? MATRIX_IS_BINARY : 0)
+                         | (null ? MATRIX_IS_NULL : 0)
+                         | (upper ? MATRIX_IS_UPPER_TRIANGULAR : 0)
+                         | (lower ? MATRIX_IS_LOWER_TRIANGULAR : 0)
+                         | ((upper && lower) ? MATRIX_IS_DIAGONAL : 0)
+                         | ((upper && lower && ones_on_diagonal) ? MATRIX_IS_IDENTITY : 0)
+                         | (symmetric ? MATRIX_IS_SYMMETRIC : 0)
+                         | (stochastic ? MATRIX_IS_STOCHASTIC : 0);
+    m->properties.known |= MATRIX_CHARACTERIZED_PROPERTIES;
+    m->properties.value = (m->properties.value & ~(uint32_t) MATRIX_CHARACTERIZED_PROPERTIES) | value;
+
+    /* The range comes with the summary: the elements left out add their zero. */
+    if(sparse->nnz < (m->i * m->j)) {
+        summary.minimum = (summary.minimum > 0) ? 0 : summary.minimum;
+        summary.maximum = (summary.maximum < 0) ? 0 : summary.maximum;
+    }
+    m_recordRange_int(m, summary.minimum, summary.maximum);
+    if(!convert) {
+        return;
+    }
+
+    matrix_storage_t requested;
+    matrix_structure_int_t structure;
+    if(m_requestedStorage_int(m, binary, &requested, &structure)) {
+        m_store_int(m, requested, &structure);
+    } else if(null) {
+        m_releaseStorage_int(m);
+        m_setImplicit_int(m, 0);
+    } else if(upper && lower) {
+        m_compactDiagonal_int(m);
+        m_characterize_int(m);
+    } else {
+        const matrix_storage_t packed = upper ? MATRIX_STORAGE_UPPER : (lower ? MATRIX_STORAGE_LOWER : (symmetric ? MATRIX_STORAGE_SYMMETRIC : MATRIX_STORAGE_DENSE));
+        structure = (matrix_structure_int_t) {
+            .nonzeros = sparse->nnz,
+            .lower_bandwidth = square ? lower_bandwidth : SIZE_MAX,
+            .upper_bandwidth = square ? upper_bandwidth : SIZE_MAX,
+        };
+        m_store_int(m, m_cheapestStorage_int(m, packed, binary, &structure, m_rangeWidth_int(summary.minimum, summary.maximum)), &structure);
+    }
+}
 
-    for(size_t row_index = 0; row_index < m->i; row_index++) {
-        for(size_t column_index = 0; column_index < m->j; column_index++) {
-            int *row1_array = calloc(m1->i, sizeof(int));
-            int *column2_array = calloc(m2->j, sizeof(int));
-            int row_offset = m1->j * row_index;
-            memcpy(row1_array, m1->array + row_offset, m1->i * sizeof(int));
-            for(size_t index = 0; index < m2->j; index++) {
-                column2_array[index] = m_at_int(m2, index, column_index);
+/**
+ * @brief Sweeps a dense matrix once and records the characterized properties in m->properties.  Each row is split at the diagonal and its halves are summarized by the summarize kernel (see matrix_simd.h).  A half is skipped once no flag that depends on it can still be true, and the sweep ends once every flag is decided.
+ */
+static void
+m_sweepDense_int(matrix_int_t *m) {
+    void (*const summarize)(const int*, const size_t, matrix_rangeSummary_int_t*) = m_kernels_int()->summarize;
+    const size_t rows = m->i;
+    const size_t columns = m->j;
+    const size_t ld = m->ld;
+    const bool square = (rows == columns);
+
+    bool binary = true;
+    bool null = true;
+    bool upper = square;
+    bool lower = square;
+    bool ones_on_diagonal = square;
+    const bool symmetric = square && m_isSymmetricBlocked_int(m);
+    bool stochastic = square;
+
+    for(size_t row = 0; row < rows; row++) {
+        const int *values = m->array + (row * ld);
+        if(!square) {
+            matrix_rangeSummary_int_t summary;
+            summarize(values, columns, &summary);
+            binary = binary && (0 == (summary.bits & ~1u));
+            null = null && (0 == summary.bits);
+            if(!binary && !null) {
+                break;
             }
-            int element = m_dotProduct_int(row1_array, column2_array, m1->i);
-            m->array[result_array_index] = element;
-            free(column2_array);
-            free(row1_array);
+            continue;
+        }
 
-            result_array_index++;
+        /* Left of the diagonal: row > column.  Right of the diagonal: row < column. */
+        const bool need_shared = binary || null || (upper && lower) || stochastic;
+        matrix_rangeSummary_int_t left = {0, 0};
+        matrix_rangeSummary_int_t right = {0, 0};
+        if(need_shared || upper) {
+            summarize(values, row, &left);
+        }
+        if(need_shared || lower) {
+            summarize(values + row + 1, columns - row - 1, &right);
+        }
+        const int diagonal_value = values[row];
+        const unsigned int bits = left.bits | right.bits | (unsigned int) diagonal_value;
+
+        binary = binary && (0 == (bits & ~1u));
+        null = null && (0 == bits);
+        upper = upper && (0 == left.bits);
+        lower = lower && (0 == right.bits);
+        ones_on_diagonal = ones_on_diagonal && (1 == diagonal_value);
+        stochastic = stochastic && (0 == (bits & 0x80000000u)) && (1 == (left.sum + right.sum + diagonal_value));
+
+        if(!(binary || null || upper || lower || stochastic)) {
+            break;
         }
     }
 
-    return m;
+    const uint32_t value = (binary ? MATRIX_IS_BINARY : 0)
+                         | (null ? MATRIX_IS_NULL : 0)
+                         | (upper ? MATRIX_IS_UPPER_TRIANGULAR : 0)
+                         | (lower ? MATRIX_IS_LOWER_TRIANGULAR : 0)
+                         | ((upper && lower) ? MATRIX_IS_DIAGONAL : 0)
+                         | ((upper && lower && ones_on_diagonal) ? MATRIX_IS_IDENTITY : 0)
+                         | (symmetric ? MATRIX_IS_SYMMETRIC : 0)
+                         | (stochastic ? MATRIX_IS_STOCHASTIC : 0);
+    m->properties.known |= MATRIX_CHARACTERIZED_PROPERTIES;
+    m->properties.value = (m->properties.value & ~(uint32_t) MATRIX_CHARACTERIZED_PROPERTIES) | value;
 }
 
 /**
- * @brief Finds the dot product of two integer arrays of equal size
- * @param a1 integer array
- * @param a2 integer array
- * @param length length of both arrays
- * @return An integer value
+ * @brief Moves a dense matrix whose properties m_sweepDense_int just recorded to the storage that m->format asks for, or else to the implicit, diagonal or cheapest storage for it (see m_cheapestStorage_int).  The band is only searched while it may still pay (see m_measureBand_int), and the nonzeros are only counted up to MATRIX_SPARSE_DENSITY_THRESHOLD of the elements.
  */
-int
-m_dotProduct_int(int *a1, int *a2, const size_t length) {
-    int product = 0;
-    for(size_t index = 0; index < length; index++) {
-        product += a1[index] * a2[index];
+static void
+m_chooseStorage_int(matrix_int_t *m) {
+    const size_t rows = m->i;
+    const size_t columns = m->j;
+    const size_t ld = m->ld;
+    const bool square = (rows == columns);
+    const bool binary = m_hasAnyProperty_int(m, MATRIX_IS_BINARY);
+    const bool null = m_hasAnyProperty_int(m, MATRIX_IS_NULL);
+    const bool upper = m_hasAnyProperty_int(m, MATRIX_IS_UPPER_TRIANGULAR);
+    const bool lower = m_hasAnyProperty_int(m, MATRIX_IS_LOWER_TRIANGULAR);
+    const bool symmetric = m_hasAnyProperty_int(m, MATRIX_IS_SYMMETRIC);
+    /* Only an owner whose array no view points into may trade its array for a compact one. */
+    if((NULL != m->parent) || m->pinned || (0 == rows) || (0 == columns)) {
+        return;
+    }
+    matrix_storage_t requested;
+    matrix_structure_int_t structure;
+    if(m_requestedStorage_int(m, binary, &requested, &structure) && (m_isEncodable_int(m) || (MATRIX_STORAGE_DENSE == requested) || (MATRIX_STORAGE_BANDED == requested))) {
+        m_store_int(m, requested, &structure);
+    } else if(null) {
+        m_release(m->arena, m->array, m_arrayBytes_int(m));
+        m->array = NULL;
+        m_setImplicit_int(m, 0);
+    } else if(upper && lower) {
+        m_compactDiagonal_int(m);
+    } else {
+        const matrix_storage_t packed = upper ? MATRIX_STORAGE_UPPER : (lower ? MATRIX_STORAGE_LOWER : (symmetric ? MATRIX_STORAGE_SYMMETRIC : MATRIX_STORAGE_DENSE));
+        /* The band is only searched up to the width at which it stops paying against a dense row or the average row of a triangle, and the nonzeros are only counted up to the density at which sparse storage stops paying. */
+        structure = (matrix_structure_int_t) {
+            .nonzeros = SIZE_MAX,
+            .lower_bandwidth = SIZE_MAX,
+            .upper_bandwidth = SIZE_MAX,
+        };
+        size_t width = sizeof(int);
+        size_t lower_bandwidth, upper_bandwidth;
+        if(square && m_measureBand_int(m, (MATRIX_STORAGE_DENSE != packed) ? ((rows + 1) / 2) : ld, &lower_bandwidth, &upper_bandwidth)) {
+            structure.lower_bandwidth = lower_bandwidth;
+            structure.upper_bandwidth = upper_bandwidth;
+        }
+        if(m_isEncodable_int(m) && ((rows * columns) >= MATRIX_FORMAT_MIN_ELEMENTS)) {
+            matrix_structure_int_t counted;
+            if(m_measureStructure_int(m, (size_t) (MATRIX_SPARSE_DENSITY_THRESHOLD * (double) rows * (double) columns), &counted)) {
+                structure.nonzeros = counted.nonzeros;
+            }
+            /* Bitpacking beats narrowing for a binary matrix, and a packed triangle is not narrowed, so only the others need the range. */
+            if(!binary && (MATRIX_STORAGE_DENSE == packed)) {
+                int minimum, maximum;
+                m_range_int(m, &minimum, &maximum);
+                width = m_rangeWidth_int(minimum, maximum);
+            }
+        }
+        m_store_int(m, m_cheapestStorage_int(m, packed, binary, &structure, width), &structure);
     }
-    return product;
 }
 
 /**
- * @brief
- * @param
- * @return
+ * @brief Characterizes a matrix from the values its storage holds and records every result in m->properties.  If convert is set, the matrix then moves to the storage chosen for it; otherwise its storage is left as it is, and an encoded matrix is swept through a temporary dense copy.
  */
-float
-m_eigenValue_int(matrix_int_t *m) {
-    if(m_isIdentity_int(m)) {
-        return 1.0;
+static void
+m_characterizeStorage_int(matrix_int_t *m, const bool convert) {
+    if(m_isImplicit_int(m)) {
+        m_setImplicitProperties_int(m);
+        return;
+    }
+    if(MATRIX_STORAGE_DIAGONAL == m->storage) {
+        m_characterizeDiagonal_int(m, convert);
+        return;
+    }
+    if(m_isPackedTriangle_int(m)) {
+        m_characterizeTriangular_int(m, convert);
+        return;
+    }
+    if(MATRIX_STORAGE_SYMMETRIC == m->storage) {
+        m_characterizeSymmetric_int(m, convert);
+        return;
+    }
+    if(MATRIX_STORAGE_BANDED == m->storage) {
+        m_characterizeBanded_int(m, convert);
+        return;
+    }
+    if(MATRIX_STORAGE_CSR == m->storage) {
+        m_characterizeSparse_int(m, convert);
+        return;
+    }
+    if(!convert && m_isEncoded_int(m)) {
+        matrix_int_t *dense = m_decoded_int(m);
+        m_sweepDense_int(dense);
+        m->properties.known |= MATRIX_CHARACTERIZED_PROPERTIES;
+        m->properties.value = (m->properties.value & ~(uint32_t) MATRIX_CHARACTERIZED_PROPERTIES) | (dense->properties.value & MATRIX_CHARACTERIZED_PROPERTIES);
+        freeMatrix_int(dense);
+        return;
+    }
+    /* A bitpacked or narrowed matrix is only characterized again after it was written to, which expands it anyway. */
+    m_materialize_int(m);
+    m_sweepDense_int(m);
+    if(convert) {
+        m_chooseStorage_int(m);
     }
-    return 0;
 }
 
 /**
- * @brief
- * @param
- * @return
+ * @brief Characterizes the matrix, records every result in m->properties, and moves it to the storage that holds it in the fewest bytes, or to the one m_setFormat_int asked for.  The m_is..._int queries record the same flags but never move a matrix.  A view, or a matrix pinned by one, stays where it is.
+ * @param m Pointer to the matrix_int_t struct
+ * @note It costs O(i x j) for a dense matrix, and O(stored values) otherwise.
  */
-complex*
-m_eigenVector_int(matrix_int_t *m);
+void
+m_characterize_int(matrix_int_t *m) {
+    assert(NULL != m);
+    m_characterizeStorage_int(m, true);
+}
 
 /**
- * @brief Creates a new array in memory containing the transpose of the matrix. 
- * @param m Pointer to matrix_int_t object. 
- * @return A new array in memory.
+ * @brief Sets the storage of a matrix, overriding the choice of characterization.  MATRIX_FORMAT_DENSE expands the matrix now and keeps it dense.  MATRIX_FORMAT_SPARSE, MATRIX_FORMAT_BITS, MATRIX_FORMAT_NARROW and MATRIX_FORMAT_BANDED convert it now.  MATRIX_FORMAT_AUTO hands the choice back to characterization, which makes it again at once.  Functions that write elements still expand the matrix, and the next m_characterize_int converts it back.
+ * @param m Pointer to the matrix_int_t struct.  The sparse, bitpacked and narrow formats (but not the banded one) need a matrix upon the heap that is neither a view nor pinned by one; this is asserted.  A matrix that is not binary keeps the bitpacked format but is stored as with MATRIX_FORMAT_AUTO.
+ * @param format The format
  */
-int*
-m_transpose_int(matrix_int_t *m) {
-    int *transpose_array = calloc(m->i * m->j, sizeof(int));
-    if(m_isIdentity_int(m) || (m_isDiagonal_int(m))) {
-        memcpy(transpose_array, m->array, (m->i * m->j) * sizeof(int));
-        return transpose_array;
+void
+m_setFormat_int(matrix_int_t *m, const matrix_format_t format) {
+    assert(NULL != m);
+    m->format = format;
+    if(MATRIX_FORMAT_AUTO == format) {
+        m_characterize_int(m);
+        return;
     }
-    int transpose_index = 0;
-    for(int i_index = 0; i_index < m->i; i_index++) {
-        for(int j_index = 0; j_index < m->j; j_index++) {
-            transpose_array[transpose_index] = m_at_int(m, j_index, i_index);
-            transpose_index++;
-        }
+    matrix_storage_t storage;
+    matrix_structure_int_t structure;
+    if(!m_requestedStorage_int(m, (MATRIX_FORMAT_BITS == format) && m_isBinary_int(m), &storage, &structure)) {
+        m_characterize_int(m);
+        return;
     }
-    return transpose_array;
+    assert((MATRIX_STORAGE_DENSE == storage) || m_isEncodable_int(m) || ((MATRIX_STORAGE_BANDED == storage) && (NULL == m->parent) && !m->pinned));
+    m_store_int(m, storage, &structure);
 }
 
 /**
- * @brief Returns the value (a scalar) of the determinant of a matrix.  Only square matrices have determinants. 
- * @param  m Pointer to matrix_int_t object.
- * @return integer value
+ * @brief Measures the nonzero structure of a matrix: its nonzeros, bandwidths and diagonal blocks.  The matrix is not moved, so the storage reported is the one it is in; call m_characterize_int first to report the one characterization chooses.
+ * @param m Pointer to the matrix_int_t struct
+ * @param structure Receives the measurements
  */
-int
-m_determinant_int(matrix_int_t *m) {
-    assert(m_isSquare_int(m));
-    if(m_isIdentity_int(m)) {
-        return 1;
-    }
+void
+m_structure_int(matrix_int_t *m, matrix_structure_int_t *structure) {
+    assert((NULL != m) && (NULL != structure));
+    (void) m_measureStructure_int(m, SIZE_MAX, structure);
 }
 
 /**
- * @brief Determines if a matrix is nilpotent.  In other words, whether that 
- * @param m Pointer to matrix_int_t object.
- * @return boolean.  True if orthogonal, false otherwise.
+ * @brief Finds the smallest and largest value of a matrix.  The range is cached with the properties: characterization records it when it weighs narrowing a matrix, and it is forgotten when the matrix is modified.
+ * @param m Pointer to the matrix_int_t struct
+ * @param minimum Receives the smallest value.  0 for a matrix without elements.
+ * @param maximum Receives the largest value.  0 for a matrix without elements.
  */
-unsigned int
-m_nilPotentDegree_int(matrix_int_t *m);
-
+void
+m_range_int(matrix_int_t *m, int *minimum, int *maximum) {
+    assert((NULL != m) && (NULL != minimum) && (NULL != maximum));
+    if(0 == (m->properties.known & MATRIX_HAS_RANGE)) {
+        m_measureRange_int(m);
+    }
+    *minimum = m->properties.minimum;
+    *maximum = m->properties.maximum;
+}
 
-/*************************** MATRIX CHARACTERIZATIONS ************************** */
+/**
+ * @brief Answers a query for a property that m_characterize_int computes.  The sweep runs only if the property is not cached, and only records the flags: a query never moves the matrix to another storage.
+ */
+static bool
+m_queryCharacterizedProperty_int(matrix_int_t *m, const uint32_t flag) {
+    if(0 == (m->properties.known & flag)) {
+        m_characterizeStorage_int(m, false);
+    }
+    return 0 != (m->properties.value & flag);
+}
 
 /**
  * @brief Find whether all values in the matrix are binary (i.e. 0 or 1)
@@ -476,12 +3493,7 @@ m_nilPotentDegree_int(matrix_int_t *m);
  */
 bool
 m_isBinary_int(matrix_int_t *m) {
-    for(size_t index = 0; index < (m->i * m->j); index++) { /* Note: m->i and m->j are size_t, so the index for this loop is also size_t.  Can this be improved? */
-        if((0 != m->array[index]) && (1 != m->array[index])) {
-            return false;
-        }
-    }
-    return true;
+    return m_queryCharacterizedProperty_int(m, MATRIX_IS_BINARY);
 }
 
 /**
@@ -525,57 +3537,23 @@ m_isSingleton_int(matrix_int_t *m) {
 }
 
 /**
- * @brief Find if the matrix is upper triangular (but not strictly so), i.e. if the row number is less than the column number, the value must be zero.
+ * @brief Find if the matrix is upper triangular (but not strictly so), i.e. if the row number is greater than the column number, the value must be zero.
  * @param m Pointer to the matrix_int_t struct
  * @return boolean.  True if this matrix is upper triangular; false if not.
  */
 bool
 m_isUpperTriangular_int(matrix_int_t *m) {
-    if(false == m_isSquare_int(m)) {
-        return false;
-    }
-    
-
-    /**
-     * Go through each row, except the first.  There's nothing to check in the first line.
-     * The items from the first until the middle (i.e. the current row number) should be zero.
-     */
-    for(size_t row_index = 1; row_index < m->i; row_index++) {
-        for(size_t column_index = 0; column_index < row_index; column_index++) {
-            if(0 != m_at_int(m, row_index, column_index)) {
-                return false;
-            }
-        }
-    }
-
-    /* The function would only reach this return if it has encountered no instance not indicative of an upper triangular matrix. */
-    return true;
+    return m_queryCharacterizedProperty_int(m, MATRIX_IS_UPPER_TRIANGULAR);
 }
 
 /**
- * @brief Find if the matrix is lower triangular (but not strictly so), i.e. if the row number is greater than the column number, the value must be zero.
+ * @brief Find if the matrix is lower triangular (but not strictly so), i.e. if the row number is less than the column number, the value must be zero.
  * @param m Pointer to the matrix_int_t struct
  * @return boolean.  True if this matrix is lower triangular; false if not.
  */
 bool
 m_isLowerTriangular_int(matrix_int_t *m) {
-    if(false == m_isSquare_int(m)) {
-        return false;
-    }
-    size_t i_index = 0;
-    size_t j_index = 1;
-    while((i_index < m->i) && (j_index < m->j)) {
-        if(i_index < j_index) {
-            j_index++;
-            if(0 != m_at_int(m, i_index, j_index)) {
-                return false;
-            }
-        } else {
-            i_index++;
-        }
-    }
-    /* The function would only reach this return if it has encountered no instance not indicative of an upper triangular matrix. */
-    return true;
+    return m_queryCharacterizedProperty_int(m, MATRIX_IS_LOWER_TRIANGULAR);
 }
 
 /**
@@ -585,32 +3563,7 @@ m_isLowerTriangular_int(matrix_int_t *m) {
  */
 bool
 m_isDiagonal_int(matrix_int_t *m) {
-    /**
-     * To find the place which should have a 1 value, 
-     * the algorithm must increase the column position by one per row.
-     * This library uses an array for all values,
-     * so we must keep track of the row number and column number
-     * seperately than the index value.  To do this simply,
-     * a modulo operation can help.  This will require only one extra variable,
-     * an column position index value.
-     */
-    unsigned int column_position = 0;
-    unsigned int array_index = 0;
-    while(array_index < (m->i * m->j)) {
-        if((array_index % m->j) == column_position) {
-            if(0 == m->array[array_index]) {
-                return false;
-            }
-            column_position++;
-            array_index++; /* Have to move the array index up one more in order to get past the modulo.  Otherwise, it turns into all 1s on the first row and 0s elsewhere. */
-        } else {
-            if(0 != m->array[array_index]) {
-                return false;
-            }
-        }
-        array_index++;
-    }
-    return true;
+    return m_queryCharacterizedProperty_int(m, MATRIX_IS_DIAGONAL);
 }
 
 /**
@@ -620,35 +3573,7 @@ m_isDiagonal_int(matrix_int_t *m) {
  */
 bool
 m_isIdentity_int(matrix_int_t *m) {
-    if(!m_isBinary_int(m)) {
-        return false;
-    }
-    /**
-     * To find the place which should have a 1 value, 
-     * the algorithm must increase the column position by one per row.
-     * This library uses an array for all values,
-     * so we must keep track of the row number and column number
-     * seperately than the index value.  To do this simply,
-     * a modulo operation can help.  This will require only one extra variable,
-     * an column position index value.
-     */
-    unsigned int column_position = 0;
-    unsigned int array_index = 0;
-    while(array_index < (m->i * m->j)) {
-        if((array_index % m->j) == column_position) {
-            if(1 != m->array[array_index]) {
-                return false;
-            }
-            column_position++;
-            array_index++; /* Have to move the array index up one more in order to get past the modulo.  Otherwise, it turns into all 1s on the first row and 0s elsewhere. */
-        } else {
-            if(0 != m->array[array_index]) {
-                return false;
-            }
-        }
-        array_index++;
-    }
-    return true;
+    return m_queryCharacterizedProperty_int(m, MATRIX_IS_IDENTITY);
 }
 
 /**
@@ -658,23 +3583,27 @@ m_isIdentity_int(matrix_int_t *m) {
  */
 bool
 m_isNull_int(matrix_int_t *m) {
-    for(int index = 0; index < (m->i * m->j); index++) {
-        if(0 != m->array[index]) {
-            return false;
-        }
-    }
-    return true;
+    return m_queryCharacterizedProperty_int(m, MATRIX_IS_NULL);
 }
 
 /**
  * @brief Finds if the matrix is symmetric, this means for all x and y, Mxy = Myx
- * @param m Pointer to matrix_int_t object.
+ * @param m Pointer to matrix_int_t object
  * @return boolean.  True if symmetric, false otherwise.
  */
 bool
 m_isSymmetric_int(matrix_int_t *m) {
-    assert(m_isSquare_int(m));
+    return m_queryCharacterizedProperty_int(m, MATRIX_IS_SYMMETRIC);
+}
 
+/**
+ * @brief Determines if the matrix is (right) stochastic.  In other words the matrix is square, it has only nonnegative values, and the sum of each row is 1.  For integers this means each row has a single 1.
+ * @param m Pointer to matrix_int_t object.
+ * @return boolean.  True if stochastic, false otherwise.
+ */
+bool
+m_isStochastic_int(matrix_int_t *m) {
+    return m_queryCharacterizedProperty_int(m, MATRIX_IS_STOCHASTIC);
 }
 
 /**
@@ -713,6 +3642,9 @@ m_isSingular_int(matrix_int_t *m);
  */
 bool
 m_isIdempotent_int(matrix_int_t *m) {
+    if(0 != (m->properties.known & MATRIX_IS_IDEMPOTENT)) {
+        return 0 != (m->properties.value & MATRIX_IS_IDEMPOTENT);
+    }
     if(true == m_isIdentity_int(m)) {
         return true;
     }
@@ -734,39 +3666,3 @@ m_isInvolutory_int(matrix_int_t *m);
  */
 bool
 m_isNilpotent_int(matrix_int_t *m);
-
-/**
- * @brief Determines if the matrix is right stochastic.  In other words the matrix is square, it has nonnegative real numbers, and the sum of each row is 1.
- * @param m Pointer to matrix_float_t object.
- * @return boolean.  True if orthogonal, false otherwise.
- * @note Easy to parallelize
- */
-bool
-m_isRightStochastic_float(matrix_int_t *m);
-
-/**
- * @brief Determines if the matrix is left stochastic.  In other words the matrix is square, it has nonnegative real numbers, and the sum of each column is 1.
- * @param m Pointer to matrix_float_t object.
- * @return boolean.  True if orthogonal, false otherwise.
- * @note Easy to parallelize
- */
-bool
-m_isLeftStochastic_float(matrix_int_t *m);
-
-/**
- * @brief Determines if the matrix is doubly stochastic.  In other words the matrix is square, it has nonnegative real numbers, the sum of each row is 1, and sum of each column is 1.
- * @param m Pointer to matrix_float_t object.
- * @return boolean.  True if orthogonal, false otherwise.
- * @note Easy to parallelize
- */
-bool
-m_isDoublyStochastic_float(matrix_int_t *m);
-
-/**
- * @brief Determines if the matrix is substochastic.  In other words the matrix is square, it has nonnegative real numbers, and the sum of each row is less than or equal to 1.  All right and doubly stochastic matrices are substochastic as well
- * @param m Pointer to matrix_float_t object.
- * @return boolean.  True if orthogonal, false otherwise.
- * @note Easy to parallelize
- */
-bool
-m_isSubStochastic_float(matrix_int_t *m);
\ No newline at end of file
@@ -4,8 +4,7 @@
  * @author Aaron Fleisher
  * @date 2026-01-26
  * 
- * @todo Find a better way to hold the allocations in memory, perhaps an arena or pool.
- * @todo Use discriminated unions to make an easier way to use matrices of different types
+ * Matrices of every element type are also used through one tagged handle, matrix_t, whose operations dispatch on the element type (see matrix_generic.h).
  */
 
 #ifndef MYMATRIX_H
@@ -24,136 +23,242 @@
  */
 #include <complex.h>
 
+#include "matrix_arena.h"
+
+/**
+ * @brief The alignment, in bytes, of the element arrays of matrices.  It is a cache line.
+ */
+#define MATRIX_ALIGNMENT 64
+
+
+/**
+ * @brief The state of a cached matrix property.  A property starts out unknown, is computed the first time it is queried, and is forgotten again when the matrix is modified.
+ * @note MATRIX_PROPERTY_UNKNOWN is 0, so a zero-initialized matrix has no cached properties.
+ */
+typedef enum Matrix_property_e {
+    MATRIX_PROPERTY_UNKNOWN = 0,
+    MATRIX_PROPERTY_TRUE,
+    MATRIX_PROPERTY_FALSE
+} matrix_property_t;
+
+/**
+ * @brief The bit of each boolean matrix property in the known and value words of the properties struct.  Flags can be or'ed together to test several properties with a single AND, e.g. MATRIX_IS_DIAGONAL | MATRIX_IS_IDENTITY | MATRIX_IS_NULL.
+ */
+typedef enum Matrix_propertyFlag_e {
+    MATRIX_IS_BINARY             = 1u << 0, /** << If the matrix is binary it can be represented though bitpacking */
+    MATRIX_IS_COLUMN             = 1u << 1,
+    MATRIX_IS_ROW                = 1u << 2,
+    MATRIX_IS_SINGLETON          = 1u << 3,
+    MATRIX_IS_SQUARE             = 1u << 4,
+    MATRIX_IS_UPPER_TRIANGULAR   = 1u << 5,
+    MATRIX_IS_LOWER_TRIANGULAR   = 1u << 6,
+    MATRIX_IS_DIAGONAL           = 1u << 7,
+    MATRIX_IS_IDENTITY           = 1u << 8,
+    MATRIX_IS_NULL               = 1u << 9,
+    MATRIX_IS_SYMMETRIC          = 1u << 10,
+    MATRIX_IS_ORTHOGONAL         = 1u << 11,
+    MATRIX_IS_SINGULAR           = 1u << 12,
+    MATRIX_IS_IDEMPOTENT         = 1u << 13,
+    MATRIX_IS_INVOLUTORY         = 1u << 14,
+    MATRIX_IS_NILPOTENT          = 1u << 15,
+    MATRIX_IS_STOCHASTIC         = 1u << 16,
+    MATRIX_HAS_RANGE             = 1u << 17  /** << Not a property itself: known once properties.minimum and properties.maximum hold the range of the values (see m_range_int) */
+} matrix_propertyFlag_t;
+
+/**
+ * @brief The properties that depend only on the dimensions.  They are known from initialization on and never invalidated.
+ */
+#define MATRIX_SHAPE_PROPERTIES (MATRIX_IS_COLUMN | MATRIX_IS_ROW | MATRIX_IS_SINGLETON | MATRIX_IS_SQUARE)
+
+/**
+ * @brief The properties that m_characterize_int computes in its single sweep.
+ */
+#define MATRIX_CHARACTERIZED_PROPERTIES (MATRIX_IS_BINARY | MATRIX_IS_UPPER_TRIANGULAR | MATRIX_IS_LOWER_TRIANGULAR | MATRIX_IS_DIAGONAL | MATRIX_IS_IDENTITY | MATRIX_IS_NULL | MATRIX_IS_SYMMETRIC | MATRIX_IS_STOCHASTIC)
+
+/**
+ * @brief How the values of a matrix are stored.  The implicit storages (identity, null and scalar) have no array: the value on the diagonal is in scalar and every other element is zero.  The encoded storages (CSR, bits, int8 and int16) keep their values outside of array, which is NULL.
+ * @note MATRIX_STORAGE_DENSE is 0, so a zero-initialized header, such as a view, is dense.
+ */
+typedef enum Matrix_storage_e {
+    MATRIX_STORAGE_DENSE = 0, /** << Every element is in the array */
+    MATRIX_STORAGE_IDENTITY,  /** << Ones on the diagonal.  scalar is 1. */
+    MATRIX_STORAGE_NULL,      /** << Every element is zero.  scalar is 0.  The only implicit storage that may be rectangular. */
+    MATRIX_STORAGE_SCALAR,    /** << scalar x I, for a scalar other than 0 and 1 */
+    MATRIX_STORAGE_DIAGONAL,  /** << The array holds the i diagonal values, array[k] being element (k, k).  Square. */
+    MATRIX_STORAGE_UPPER,     /** << Packed upper triangle, row after row: row r holds columns r to n - 1, starting at array[r(2n - r + 1)/2].  Square. */
+    MATRIX_STORAGE_LOWER,     /** << Packed lower triangle, row after row: row r holds columns 0 to r, starting at array[r(r + 1)/2].  Square. */
+    MATRIX_STORAGE_SYMMETRIC, /** << The upper triangle, packed as in MATRIX_STORAGE_UPPER.  Element (r, c) below the diagonal is element (c, r).  Square. */
+    MATRIX_STORAGE_BANDED,    /** << The band of kl = lower_bandwidth diagonals below the diagonal and ku = upper_bandwidth above it, row after row: row r holds columns r - kl to r + ku, starting at array[r(kl + ku + 1)].  The places of columns outside the matrix are zero.  Square. */
+    MATRIX_STORAGE_CSR,       /** << The nonzeros in compressed sparse row format, in sparse */
+    MATRIX_STORAGE_BITS,      /** << One bit per element, in bits.  Binary. */
+    MATRIX_STORAGE_INT8,      /** << Every element as an int8_t in narrow, laid out like array with the same ld */
+    MATRIX_STORAGE_INT16      /** << Every element as an int16_t in narrow, laid out like array with the same ld */
+} matrix_storage_t;
+
+/**
+ * @brief The storage requested for a matrix with m_setFormat_int.  By default characterization chooses it (see m_characterize_int).
+ * @note MATRIX_FORMAT_AUTO is 0, so a zero-initialized header leaves the choice to characterization.
+ */
+typedef enum Matrix_format_e {
+    MATRIX_FORMAT_AUTO = 0, /** << The storage that holds the matrix in the fewest bytes */
+    MATRIX_FORMAT_DENSE,    /** << Always dense.  Characterization records the properties but never moves the array. */
+    MATRIX_FORMAT_SPARSE,   /** << Compressed sparse row, whatever the density */
+    MATRIX_FORMAT_BITS,     /** << Bitpacked, as long as the matrix is binary.  Otherwise as MATRIX_FORMAT_AUTO. */
+    MATRIX_FORMAT_NARROW,   /** << Dense in the narrowest of int8_t, int16_t and int that holds the range of the values */
+    MATRIX_FORMAT_BANDED    /** << Banded, with the bandwidths of the nonzeros, as long as the matrix is square.  Otherwise dense. */
+} matrix_format_t;
+
+/**
+ * @brief The nonzero structure of a matrix, as measured by m_structure_int, and the storage it is in.
+ * @var nonzeros The number of nonzero elements
+ * @var lower_bandwidth The largest r - c of a nonzero (r, c) below the diagonal, 0 if there is none
+ * @var upper_bandwidth The largest c - r of a nonzero (r, c) above the diagonal, 0 if there is none
+ * @var blocks The number of diagonal blocks: the most square blocks along the diagonal of a square matrix outside of which every element is zero.  A diagonal matrix has n, a matrix that does not split has 1, and so has a rectangular one.
+ * @var storage The storage of the matrix
+ */
+typedef struct Matrix_structure_int_s {
+    size_t nonzeros;
+    size_t lower_bandwidth;
+    size_t upper_bandwidth;
+    size_t blocks;
+    matrix_storage_t storage;
+} matrix_structure_int_t;
+
+/**
+ * @brief Values derived from a matrix that are expensive to compute and rarely needed.  The struct is only allocated when one of them is computed, and is freed as soon as the matrix is modified, so ordinary matrices carry a single NULL pointer instead.
+ * @var eigenvector The eigenvector, a column of length j.  NULL until computed.
+ * @var eigenvalue The eigenvalue
+ * @var determinant The determinant
+ */
+typedef struct Matrix_derived_int_s {
+    /**
+     * @note not all eigenvectors exist in the real numbers.  Some only exist in the complex numbers.  This is basically a double.
+     */
+    complex *eigenvector;
+    float eigenvalue;
+    int determinant;
+} matrix_derived_int_t;
 
 /**
  * @brief The matrix type holds the dimensions of the matrix (i columns x j rows) as well as a pointer to an array that holds the matrix information.  The array has one dimension in order to maintain a contiguous block of memory for all the elements of the array.  A "2-dimensional", or double pointer, a[i][j] does not guarantee fast memory usage.  The 
  * @var i - size_t.  This denotes the number of rows in the matrix
  * @var j - size_t.  This denotes the number of columns in the matrix
- * @var array - a pointer to a place in memory in the heap that will hold the values in the array
- * @var struct of properties
- * @todo bitpack the boolean properties
- * @todo when the matrix is identity, symmetric, diagonal, etc... it can have a more compact representation.
+ * @var array, sparse, bits, narrow - where the values are, by storage (see matrix_storage_t).  array is a pointer to a place in memory in the heap that will hold the values in the array, MATRIX_ALIGNMENT aligned, and NULL for an implicit matrix until m_materialize_int gives it one.  sparse holds the nonzeros of a MATRIX_STORAGE_CSR matrix, bits the words of a MATRIX_STORAGE_BITS matrix, and narrow the elements of a MATRIX_STORAGE_INT8 or MATRIX_STORAGE_INT16 matrix; these are always allocated upon the heap.  They share their place, so only the one that storage names is meaningful.
+ * @var ld - size_t.  The leading dimension: the distance, in elements, from the start of one row to the start of the next.  Element (r, c) is array[(r * ld) + c].  ld >= j; rows may be padded so that each one starts on a cache line, and a matrix can describe a block of a larger buffer.
+ * @var arena - the arena the matrix was allocated from, or NULL if it was allocated upon the heap.  The array and derived data of an arena matrix belong to the arena as well.
+ * @var parent - NULL if the matrix owns its array.  For a view (see m_blockView_int) it is the matrix that owns the storage the view points into.
+ * @var storage - how the values are stored (see matrix_storage_t).
+ * @var format - the storage requested with m_setFormat_int, MATRIX_FORMAT_AUTO unless it was set.
+ * @var scalar - the value on the diagonal of an implicit matrix.  Unused otherwise.
+ * @var lower_bandwidth, upper_bandwidth - the diagonals below and above the diagonal that a MATRIX_STORAGE_BANDED matrix stores.  0 for any other storage.
+ * @var pinned - set once a view has been taken of the matrix.  Its array then stays where it is: characterization no longer moves the matrix to a compact storage.
+ * @var struct of properties.  Derived values (eigenvector, eigenvalue, determinant) live in a separately allocated matrix_derived_int_t.  The boolean properties are bitpacked into two words (see matrix_propertyFlag_t): a property is unknown until the first query computes it, then cached until the matrix is modified.
  */
 typedef struct Matrix_int_s {
     size_t i; // Row
     size_t j; // Column
-    int *array;
+    size_t ld; // Leading dimension
+    union {
+        int *array;
+        struct Matrix_sparse_s *sparse; // Nonzeros of a sparse matrix
+        struct Matrix_bits_s *bits; // Words of a bitpacked matrix
+        void *narrow; // Elements of a narrowed matrix
+    };
+    matrix_arena_t *arena;
+    struct Matrix_int_s *parent; // Owner of the array, if this is a view
+    matrix_storage_t storage;
+    matrix_format_t format; // Requested storage
+    int scalar; // Diagonal value of an implicit matrix
+    uint32_t lower_bandwidth; // Diagonals below the diagonal of a banded matrix
+    uint32_t upper_bandwidth; // Diagonals above the diagonal of a banded matrix
+    bool pinned; // Views point into the array
     struct {
-        /**
-         * @note not all eigenvectors exist in the real numbers.  Some only exist in the complex numbers.  This is basically a double.
-         */
-        complex *eigenvector;
-        int dot_product;
-        float eigenvalue;
-        int determinant;
-        /**
-         * @todo change make these 16 booleans into bitpacked int.
-         */
-        bool is_binary; /** << If the matrix is binary it can be represented though bitpacking */
-        bool is_column;  
-        bool is_row;
-        bool is_singleton;
-        bool is_square;
-        bool is_UpperTriangular;
-        bool is_LowerTriangular;
-        bool is_diagonal;
-        bool is_identity;
-        bool is_null;
-        bool is_symmetric;
-        bool is_orthoganal;
-        bool is_singular;
-        bool is_idempotent;
-        bool is_involutory;
-        bool is_nilpotent;
-        bool is_stochastic;
+        matrix_derived_int_t *derived; /** << NULL until something derived from the values is computed */
+        uint32_t known; /** << One matrix_propertyFlag_t bit per property whose value is cached */
+        uint32_t value; /** << The cached values.  A bit is only meaningful when the same bit is set in known. */
+        int minimum; /** << The smallest value, once MATRIX_HAS_RANGE is known */
+        int maximum; /** << The largest value, once MATRIX_HAS_RANGE is known */
     } properties;
 } matrix_int_t;
 
 
-typedef struct Matrix_float_s {
-    size_t i; // Row
-    size_t j; // Column
-    float *array;
-    struct {
-        int *eigenvector;
-        int dot_product;
-        float eigenvalue;
-        int determinant;
-        /**
-         * @todo change make these 16 booleans into bitpacked int.
-         */
-        bool is_binary; /** << If the matrix is binary it can be represented though bitpacking */
-        bool is_column;  
-        bool is_row;
-        bool is_singleton;
-        bool is_square;
-        bool is_UpperTriangular;
-        bool is_LowerTriangular;
-        bool is_diagonal;
-        bool is_identity;
-        bool is_null;
-        bool is_symmetric;
-        bool is_orthoganal;
-        bool is_singular;
-        bool is_idempotent;
-        bool is_involutory;
-        bool is_nilpotent;
-        bool is_stochastic;
-    } properties;
-} matrix_float_t;
-
-
-typedef struct Matrix_double_s {
-    size_t i; // Row
-    size_t j; // Column
-    double *array;
-    struct {
-        double *eigenvector;
-        int dot_product;
-        float eigenvalue;
-        int determinant;
-        /**
-         * @todo change make these 16 booleans into bitpacked int.
-         */
-        bool is_binary; /** << If the matrix is binary it can be represented though bitpacking */
-        bool is_column;  
-        bool is_row;
-        bool is_singleton;
-        bool is_square;
-        bool is_UpperTriangular;
-        bool is_LowerTriangular;
-        bool is_diagonal;
-        bool is_identity;
-        bool is_null;
-        bool is_symmetric;
-        bool is_orthoganal;
-        bool is_singular;
-        bool is_idempotent;
-        bool is_involutory;
-        bool is_nilpotent;
-    } properties;
-} matrix_double_t;
-
-
-
 /*************************** MATRIX WIDE OPERATIONS ************************/
 
 /**
  * @brief Allocates a place in the heap for the matrix of dimensions i, columns, by j, rows 
  * @param i The number of rows, i.e. vectors
  * @param j The number of columns, i.e. items in each vector
- * @return A pointer to a matrix stuct
+ * @return A pointer to a matrix stuct.  The header and arrays of up to MATRIX_POOL_MAX_BLOCK bytes come from the size-class pool, so small matrices are recycled without touching malloc.
  */
 matrix_int_t* 
 initializeMatrix_int(const int i, const int j);
 
 /**
- * @brief The matrix_int_t type has two arrays that need to be cleaned up before freeing the memory for the entire struct.
+ * @brief Allocates a matrix of dimensions i by j from an arena.  The values are zero.
+ * @param arena The arena to allocate from, or NULL to allocate upon the heap
+ * @param i The number of rows, i.e. vectors
+ * @param j The number of columns, i.e. items in each vector
+ * @return A pointer to a matrix stuct.  freeMatrix_int does nothing for an arena matrix; it is taken back when the arena is reset.
+ */
+matrix_int_t*
+initializeMatrixArena_int(matrix_arena_t *arena, const int i, const int j);
+
+/**
+ * @brief The matrix_int_t type has an array, and possibly derived data, that need to be cleaned up before freeing the memory for the entire struct.  The header, derived data and small arrays go back to the calling thread's pool (see matrix_pool.h).  Matrices allocated from an arena are left alone; the arena owns their memory.  For a view only the derived data is released, since the view does not own its array and lives wherever the caller stored it.
  * @param m The matrix that will be freed.
  */
 void
 freeMatrix_int(matrix_int_t *m);
 
+/**
+ * @brief Returns the cached state of a single property without computing it.
+ * @param m matrix_int_t. The matrix
+ * @param flag A single matrix_propertyFlag_t
+ * @return MATRIX_PROPERTY_UNKNOWN if the property has not been computed, otherwise MATRIX_PROPERTY_TRUE or MATRIX_PROPERTY_FALSE
+ */
+matrix_property_t
+m_propertyState_int(const matrix_int_t *m, const uint32_t flag);
+
+/**
+ * @brief Records the value of one or more properties in the cache.
+ * @param m matrix_int_t. The matrix
+ * @param flags One or more matrix_propertyFlag_t or'ed together
+ * @param value The value to record for all of them
+ */
+void
+m_setProperties_int(matrix_int_t *m, const uint32_t flags, const bool value);
+
+/**
+ * @brief Tests, without computing anything, whether any of the given properties is known to be true.  This is a single AND of the known and value words, so dispatch code can ask e.g. "diagonal or identity or null" in O(1).
+ * @param m matrix_int_t. The matrix
+ * @param flags One or more matrix_propertyFlag_t or'ed together
+ * @return true if at least one of the flags is cached as true
+ */
+bool
+m_hasAnyProperty_int(const matrix_int_t *m, const uint32_t flags);
+
+/**
+ * @brief Returns the derived data of the matrix, allocating it on first use.  Functions that compute an eigenvector, eigenvalue or determinant store the result here.
+ * @param m matrix_int_t. The matrix
+ * @return The matrix's derived data.  It is freed by freeMatrix_int and by m_invalidateProperties_int.  An arena matrix takes it from the same arena.
+ */
+matrix_derived_int_t*
+m_derived_int(matrix_int_t *m);
+
+/**
+ * @brief Forgets every cached property that depends on the values in the matrix.  The shape properties (square, row, column, singleton) are kept, because no operation changes the dimensions in place.  Every function that modifies a matrix calls this, and code that writes to m->array directly must call it too (after m_materialize_int).
+ * @param m matrix_int_t. The matrix that was modified
+ */
+void
+m_invalidateProperties_int(matrix_int_t *m);
+
+/**
+ * @brief Gives a matrix in an implicit, compact or encoded storage (see matrix_storage_t) a dense element array holding its values.  Functions that write elements call this first, and code that reads or writes m->array directly must call it too.  The cached properties stay valid, since the values do not change.
+ * @param m matrix_int_t. The matrix.  A dense matrix is left alone.
+ */
+void
+m_materialize_int(matrix_int_t *m);
+
 /**
  * @brief This function copies an array into the array of the matrix struct.  The array must be the length of the full size (i * j) of the matrix;
  * @param m matrix_int_t. The matrix struct
@@ -173,11 +278,77 @@ printMatrix_int(matrix_int_t *m);
 /**
  * @brief This generates an identity matrix of size, dim x dim.
  * @param dim the number of rows and columns in the matrix.  All identity matrices are square.  So, the function requires only one number to define the size of the matrix.
- * @return A new matrix allocated upon the heap
+ * @return A new matrix allocated upon the heap.  It is implicit (MATRIX_STORAGE_IDENTITY): only the header is allocated, whatever dim is.
  */
 matrix_int_t*
 generateIdentityMatrix_int(const int dim);
 
+/**
+ * @brief Generates an identity matrix of size dim x dim in an arena.
+ * @param arena The arena to allocate from, or NULL to allocate upon the heap
+ * @param dim the number of rows and columns in the matrix
+ * @return A new implicit matrix allocated from the arena
+ */
+matrix_int_t*
+generateIdentityMatrixArena_int(matrix_arena_t *arena, const int dim);
+
+/**
+ * @brief Generates a null matrix of size i x j, i.e. one whose elements are all 0.
+ * @param i The number of rows
+ * @param j The number of columns
+ * @return A new implicit matrix (MATRIX_STORAGE_NULL) allocated upon the heap.  Only the header is allocated.
+ */
+matrix_int_t*
+generateNullMatrix_int(const int i, const int j);
+
+/**
+ * @brief Generates a null matrix of size i x j in an arena.
+ * @param arena The arena to allocate from, or NULL to allocate upon the heap
+ * @param i The number of rows
+ * @param j The number of columns
+ * @return A new implicit matrix allocated from the arena
+ */
+matrix_int_t*
+generateNullMatrixArena_int(matrix_arena_t *arena, const int i, const int j);
+
+/**
+ * @brief Generates the scalar matrix scalar x I of size dim x dim.
+ * @param dim the number of rows and columns in the matrix
+ * @param scalar The value on the diagonal.  A scalar of 1 gives an identity matrix and a scalar of 0 a null matrix.
+ * @return A new implicit matrix allocated upon the heap.  Only the header is allocated.
+ */
+matrix_int_t*
+generateScalarMatrix_int(const int dim, const int scalar);
+
+/**
+ * @brief Generates the scalar matrix scalar x I of size dim x dim in an arena.
+ * @param arena The arena to allocate from, or NULL to allocate upon the heap
+ * @param dim the number of rows and columns in the matrix
+ * @param scalar The value on the diagonal
+ * @return A new implicit matrix allocated from the arena
+ */
+matrix_int_t*
+generateScalarMatrixArena_int(matrix_arena_t *arena, const int dim, const int scalar);
+
+/**
+ * @brief Generates a diagonal matrix of size dim x dim in compact storage (MATRIX_STORAGE_DIAGONAL): only the dim diagonal values are allocated.
+ * @param dim the number of rows and columns in the matrix
+ * @param diagonal The dim values of the diagonal
+ * @return A new matrix allocated upon the heap
+ */
+matrix_int_t*
+generateDiagonalMatrix_int(const int dim, const int *diagonal);
+
+/**
+ * @brief Generates a diagonal matrix of size dim x dim in compact storage in an arena.
+ * @param arena The arena to allocate from, or NULL to allocate upon the heap
+ * @param dim the number of rows and columns in the matrix
+ * @param diagonal The dim values of the diagonal
+ * @return A new matrix allocated from the arena
+ */
+matrix_int_t*
+generateDiagonalMatrixArena_int(matrix_arena_t *arena, const int dim, const int *diagonal);
+
 /**
  * @brief Creates a new integer matrix in the heap using the contents of another matrix
  * @param m matrix_int_t The matrix to copy
@@ -186,6 +357,15 @@ generateIdentityMatrix_int(const int dim);
 matrix_int_t*
 createCopy_int(matrix_int_t *m);
 
+/**
+ * @brief Creates a copy of a matrix in an arena.
+ * @param arena The arena to allocate from, or NULL to allocate upon the heap
+ * @param m matrix_int_t The matrix to copy
+ * @return A new matrix allocated from the arena
+ */
+matrix_int_t*
+createCopyArena_int(matrix_arena_t *arena, matrix_int_t *m);
+
 /**
  * @brief This generates an random matrix of size, i x j, with values lower_bound <= x <= upper_bound
  * @param i integer the number of rows in the matrix.
@@ -197,6 +377,18 @@ createCopy_int(matrix_int_t *m);
 matrix_int_t*
 generateRandomMatrix_int(const int i, const int j, const int lower_bound, const int upper_bound);
 
+/**
+ * @brief Generates a random matrix of size i x j, with values lower_bound <= x <= upper_bound, in an arena.
+ * @param arena The arena to allocate from, or NULL to allocate upon the heap
+ * @param i integer the number of rows in the matrix.
+ * @param j integer the number of columns in the matrix.
+ * @param lower_bound integer All values in the matrix are greater than or equal to this lower bound.
+ * @param upper_bound integer All values in the matrix are less than or equal to this upper bound.
+ * @return A new matrix allocated from the arena
+ */
+matrix_int_t*
+generateRandomMatrixArena_int(matrix_arena_t *arena, const int i, const int j, const int lower_bound, const int upper_bound);
+
 
 /******************************* INTERNAL MATRIX OPERATIONS **********************/
 
@@ -228,6 +420,52 @@ m_selectColumn_int(matrix_int_t *m, const int column_number);
 int*
 m_selectRow_int(matrix_int_t *m, const int row_number);
 
+/**
+ * @brief Returns a view of a rectangular block of a matrix.  The view shares the parent's array and leading dimension, so creating it neither allocates nor copies, and every function that takes a matrix_int_t accepts it.
+ * @param m The matrix to view.  If m is itself a view, the new view points at the same owner.  A matrix in an implicit or compact storage is materialized first, since a view needs a dense array to point into.  The owner is pinned, so that characterizing it later does not move its array from under the view.
+ * @param row The first row of the block
+ * @param column The first column of the block
+ * @param rows The number of rows in the block
+ * @param columns The number of columns in the block
+ * @return The view, by value.  It stays valid as long as the parent's array does.  Writing through a view invalidates the properties of its owner; writing to the owner does not reach views that have already cached properties, so views are meant to be short-lived.
+ */
+matrix_int_t
+m_blockView_int(matrix_int_t *m, const size_t row, const size_t column, const size_t rows, const size_t columns);
+
+/**
+ * @brief Returns a 1 x j view of one row of a matrix.  See m_blockView_int.
+ * @param m The matrix to view
+ * @param row The row, using C style indexing
+ * @return The view, by value
+ */
+matrix_int_t
+m_rowView_int(matrix_int_t *m, const size_t row);
+
+/**
+ * @brief Returns an i x 1 view of one column of a matrix.  Consecutive elements of the view are ld elements apart in memory.  See m_blockView_int.
+ * @param m The matrix to view
+ * @param column The column, using C style indexing
+ * @return The view, by value
+ */
+matrix_int_t
+m_columnView_int(matrix_int_t *m, const size_t column);
+
+/**
+ * @brief Finds whether a matrix is a view of another matrix's storage.
+ * @param m Pointer to the matrix_int_t struct
+ * @return boolean.  True if the matrix does not own its array.
+ */
+bool
+m_isView_int(const matrix_int_t *m);
+
+/**
+ * @brief Finds whether a matrix is implicit, i.e. an identity, null or scalar matrix without an element array (see matrix_storage_t).
+ * @param m Pointer to the matrix_int_t struct
+ * @return boolean.  True if the matrix is not dense.
+ */
+bool
+m_isImplicit_int(const matrix_int_t *m);
+
 /**
  * @brief This function performs scalar matrix addition.  It modifies the matrix passed to the function
  * @param m matrix_int_t The matrix
@@ -241,9 +479,20 @@ m_ScalarAdd_int(matrix_int_t *m, const int scalar);
  * @param m1 The first matrix
  * @param m2 The second matrix
  * @return A new matrix allocated upon the heap
+ * @note The sum of two implicit, diagonal, packed, banded or sparse matrices in the same storage stays in it, and costs O(stored values).  Any other sum is dense.  An implicit or diagonal operand only touches the diagonal of a copy of the other one.
  */
 matrix_int_t*
 m_MatrixAdd_int(matrix_int_t *m1, matrix_int_t *m2);
+
+/**
+ * @brief Performs matrix addition, M1 + M2, into a new matrix allocated from an arena.
+ * @param arena The arena to allocate from, or NULL to allocate upon the heap
+ * @param m1 The first matrix
+ * @param m2 The second matrix
+ * @return A new matrix allocated from the arena
+ */
+matrix_int_t*
+m_MatrixAddArena_int(matrix_arena_t *arena, matrix_int_t *m1, matrix_int_t *m2);
 /**
  * @brief This function performs scalar matrix subtraction.  It modifies the matrix passed to the function
  * @param m matrix_int_t The matrix
@@ -261,6 +510,16 @@ m_ScalarSubtract_int(matrix_int_t *m, const int scalar);
 matrix_int_t*
 m_MatrixSubtract_int(matrix_int_t *m1, matrix_int_t *m2);
 
+/**
+ * @brief Performs matrix subtraction, M1 - M2, into a new matrix allocated from an arena.
+ * @param arena The arena to allocate from, or NULL to allocate upon the heap
+ * @param m1 The first matrix
+ * @param m2 The second matrix
+ * @return A new matrix allocated from the arena
+ */
+matrix_int_t*
+m_MatrixSubtractArena_int(matrix_arena_t *arena, matrix_int_t *m1, matrix_int_t *m2);
+
 /**
  * @brief This checks if the values of two matrices, M1 and M2, are equal.
  * @param m1 The first matrix
@@ -274,19 +533,106 @@ m_isEqual_int(matrix_int_t *m1, matrix_int_t *m2);
  * @brief This function performs scalar matrix multiplication.  It modifies the matrix passed to the function
  * @param m matrix_int_t The matrix
  * @param scalar const int The scalar used for multiplication 
+ * @note An implicit matrix stays implicit: only its diagonal value changes.  A diagonal, packed triangular or banded matrix only scales its compact array, and a sparse matrix its nonzeros.
  */
 void
 m_ScalarMultiply_int(matrix_int_t *m, const int scalar);
 
+/**
+ * @brief Blocking parameters of the matrix multiplication kernel.
+ * @note MR x NR is the register tile of the micro-kernel.  NR is 16 so that a row of the tile fills one AVX-512 register, two AVX2 registers or four SSE registers (see matrix_simd.h).  A KC x NR micro-panel of the second matrix (16 KiB) fits in the L1 cache, an MC x KC block of the first matrix (64 KiB) fits in the L2 cache, and a KC x NC panel of the second matrix (2 MiB) fits in the L3 cache.  MC must be a multiple of MR and NC must be a multiple of NR.
+ */
+#define MATRIX_GEMM_MR 4
+#define MATRIX_GEMM_NR 16
+#define MATRIX_GEMM_KC 256
+#define MATRIX_GEMM_MC 64
+#define MATRIX_GEMM_NC 2048
+
+/**
+ * @brief Products with fewer multiply-adds (rows x columns x depth) than this run on the calling thread instead of the thread pool.
+ */
+#define MATRIX_GEMM_PARALLEL_THRESHOLD (128 * 128 * 128)
+
 /**
  * @brief This function performs matrix multiplication, M1 x M2.  The result will be a new matrix struct allocated upon the heap.
  * @param m1 The first matrix
  * @param m2 The second matrix
  * @return A new matrix allocated upon the heap
+ * @note The operands are characterized but never moved.  A null, identity, scalar or diagonal operand costs O(n^2) or less, a banded one O(n x bw) and a sparse one O(nnz) per column or row of the other.  The product of two sparse, two banded or two matrices packed in the same triangle stays in that storage; any other product is dense.  Two binary operands multiply by popcount (see matrix_bits.h), and everything else runs the cache-blocked product (see MATRIX_GEMM_MR).
  */
 matrix_int_t*
 m_MatrixMultiply_int(matrix_int_t *m1, matrix_int_t *m2);
 
+/**
+ * @brief Performs matrix multiplication, M1 x M2, into a new matrix allocated from an arena.
+ * @param arena The arena to allocate from, or NULL to allocate upon the heap
+ * @param m1 The first matrix
+ * @param m2 The second matrix
+ * @return A new matrix allocated from the arena
+ * @note When the product runs on the calling thread, the packing buffers are taken from a scratch scope of the arena and given back before the function returns.
+ */
+matrix_int_t*
+m_MatrixMultiplyArena_int(matrix_arena_t *arena, matrix_int_t *m1, matrix_int_t *m2);
+
+/**
+ * @brief Solves T x X = B for X, where T is upper or lower triangular (TRSM).  The rows of X are found by forward substitution for a lower T and by back substitution for an upper one.  Only the triangle of T is read, and each row of X is updated with the vectorized axpy kernel (see matrix_simd.h).
+ * @param t The triangular matrix, n x n.  m_isUpperTriangular_int or m_isLowerTriangular_int is asserted, and so is a diagonal without zeros.
+ * @param b The right-hand side, n x m
+ * @return A new n x m matrix allocated upon the heap
+ * @note The arithmetic is integer: each row is divided by its diagonal value with truncation, so X is exact when every division is, as it always is when T has ones on its diagonal.  The columns of B are solved independently, so large systems split them over the thread pool (see matrix_threads.h).
+ */
+matrix_int_t*
+m_TriangularSolve_int(matrix_int_t *t, matrix_int_t *b);
+
+/**
+ * @brief Solves T x X = B for a triangular T into a new matrix allocated from an arena.  See m_TriangularSolve_int.
+ * @param arena The arena to allocate from, or NULL to allocate upon the heap
+ * @param t The triangular matrix, n x n
+ * @param b The right-hand side, n x m
+ * @return A new n x m matrix allocated from the arena
+ */
+matrix_int_t*
+m_TriangularSolveArena_int(matrix_arena_t *arena, matrix_int_t *t, matrix_int_t *b);
+
+/**
+ * @brief Solves A x X = B for X, where A is a square matrix with a narrow band, such as the tridiagonal matrices of finite differences (GBSV).  A is factored by Gaussian elimination with partial pivoting within the band, which for a tridiagonal A is the Thomas algorithm with row exchanges, and every column of X is then found by forward and back substitution.  The factors fill at most kl + (kl + ku) diagonals, so the solve costs O(n x kl x (kl + ku)) plus O(n x (2kl + ku)) per column of B, rather than O(n^3).
+ * @param a The matrix, n x n, in any storage.  Its bandwidths are those of its storage when it is banded, and are measured otherwise.  A singular A is asserted against.
+ * @param b The right-hand side, n x m
+ * @return A new n x m matrix allocated upon the heap
+ * @note Elimination mixes rows in proportions that integers cannot hold, so the factorization and substitutions are in double precision and each value of X is rounded to the nearest integer.  X is exact when the solution is integral and A is well conditioned.
+ */
+matrix_int_t*
+m_BandedSolve_int(matrix_int_t *a, matrix_int_t *b);
+
+/**
+ * @brief Solves A x X = B for a banded A into a new matrix allocated from an arena.  See m_BandedSolve_int.
+ * @param arena The arena to allocate from, or NULL to allocate upon the heap
+ * @param a The matrix, n x n
+ * @param b The right-hand side, n x m
+ * @return A new n x m matrix allocated from the arena
+ */
+matrix_int_t*
+m_BandedSolveArena_int(matrix_arena_t *arena, matrix_int_t *a, matrix_int_t *b);
+
+/**
+ * @brief Computes the symmetric rank-k product M x M^T, or M^T x M (SYRK).  For a data matrix with one observation per row, M^T x M is its Gram matrix, and its covariance matrix once the columns are centered.  Only the upper triangle of the result is computed: the tiles below the diagonal are skipped, which saves almost half the multiply-adds, and the transposed operand is packed straight from M without forming M^T.
+ * @param m The matrix, n x k
+ * @param transpose false for M x M^T (n x n), true for M^T x M (k x k)
+ * @return A new matrix allocated upon the heap, in packed symmetric storage (see matrix_storage_t)
+ */
+matrix_int_t*
+m_SymmetricRankK_int(matrix_int_t *m, const bool transpose);
+
+/**
+ * @brief Computes M x M^T, or M^T x M, into a new matrix allocated from an arena.  See m_SymmetricRankK_int.
+ * @param arena The arena to allocate from, or NULL to allocate upon the heap
+ * @param m The matrix, n x k
+ * @param transpose false for M x M^T, true for M^T x M
+ * @return A new matrix allocated from the arena
+ */
+matrix_int_t*
+m_SymmetricRankKArena_int(matrix_arena_t *arena, matrix_int_t *m, const bool transpose);
+
 
 /**
  * @brief Finds the dot product of two integer arrays of equal size
@@ -323,9 +669,9 @@ int*
 m_transpose_int(matrix_int_t *m);
 
 /**
- * @brief Returns the value (a scalar) of the determinant of a matrix.  Only square matrices have determinants. 
+ * @brief Returns the value (a scalar) of the determinant of a matrix.  Only square matrices have determinants.  A triangular matrix, which includes the diagonal and implicit ones, takes the product of its diagonal in O(n).  Any other matrix is reduced by fraction-free (Bareiss) elimination in O(n^3).
  * @param  m Pointer to matrix_int_t object.
- * @return integer value
+ * @return integer value.  Like the products, it wraps modulo 2^32 for a triangular matrix.  Elimination is exact as long as every minor fits in 64 bits.  The determinant of a 0 x 0 matrix is 1.
  */
 int
 m_determinant_int(matrix_int_t *m);
@@ -341,6 +687,44 @@ m_nilPotentDegree_int(matrix_int_t *m);
 
 /*************************** MATRIX CHARACTERIZATIONS ************************** */
 
+/**
+ * @brief The fewest elements for which characterization considers the sparse and bitpacked storages.  A smaller matrix takes at most 16 KiB dense, which the bookkeeping of an encoding would not win back.
+ */
+#define MATRIX_FORMAT_MIN_ELEMENTS 4096
+
+/**
+ * @brief Characterizes the matrix, records every result in m->properties, and moves it to the storage that holds it in the fewest bytes, or to the one m_setFormat_int asked for.  The m_is..._int queries record the same flags but never move a matrix.  A view, or a matrix pinned by one, stays where it is.
+ * @param m Pointer to the matrix_int_t struct
+ * @note It costs O(i x j) for a dense matrix, and O(stored values) otherwise.
+ */
+void
+m_characterize_int(matrix_int_t *m);
+
+/**
+ * @brief Sets the storage of a matrix, overriding the choice of characterization.  MATRIX_FORMAT_DENSE expands the matrix now and keeps it dense.  MATRIX_FORMAT_SPARSE, MATRIX_FORMAT_BITS, MATRIX_FORMAT_NARROW and MATRIX_FORMAT_BANDED convert it now.  MATRIX_FORMAT_AUTO hands the choice back to characterization, which makes it again at once.  Functions that write elements still expand the matrix, and the next m_characterize_int converts it back.
+ * @param m Pointer to the matrix_int_t struct.  The sparse, bitpacked and narrow formats (but not the banded one) need a matrix upon the heap that is neither a view nor pinned by one; this is asserted.  A matrix that is not binary keeps the bitpacked format but is stored as with MATRIX_FORMAT_AUTO.
+ * @param format The format
+ */
+void
+m_setFormat_int(matrix_int_t *m, const matrix_format_t format);
+
+/**
+ * @brief Measures the nonzero structure of a matrix: its nonzeros, bandwidths and diagonal blocks.  The matrix is not moved, so the storage reported is the one it is in; call m_characterize_int first to report the one characterization chooses.
+ * @param m Pointer to the matrix_int_t struct
+ * @param structure Receives the measurements
+ */
+void
+m_structure_int(matrix_int_t *m, matrix_structure_int_t *structure);
+
+/**
+ * @brief Finds the smallest and largest value of a matrix.  The range is cached with the properties: characterization records it when it weighs narrowing a matrix, and it is forgotten when the matrix is modified.
+ * @param m Pointer to the matrix_int_t struct
+ * @param minimum Receives the smallest value.  0 for a matrix without elements.
+ * @param maximum Receives the largest value.  0 for a matrix without elements.
+ */
+void
+m_range_int(matrix_int_t *m, int *minimum, int *maximum);
+
 /**
  * @brief Find whether all values in the matrix are binary (i.e. 0 or 1)
  * @param m Pointer to the matrix_int_t struct.  It includes the number of rows, the number of columns, and the array of values required by the function
@@ -382,7 +766,7 @@ bool
 m_isSingleton_int(matrix_int_t *m);
 
 /**
- * @brief Find if the matrix is upper triangular (but not strictly so), i.e. if the row number is less than the column number, the value must be zero.
+ * @brief Find if the matrix is upper triangular (but not strictly so), i.e. if the row number is greater than the column number, the value must be zero.
  * @param m Pointer to the matrix_int_t struct
  * @return boolean.  True if this matrix is upper triangular; false if not.
  */
@@ -390,7 +774,7 @@ bool
 m_isUpperTriangular_int(matrix_int_t *m);
 
 /**
- * @brief Find if the matrix is lower triangular (but not strictly so), i.e. if the row number is greater than the column number, the value must be zero.
+ * @brief Find if the matrix is lower triangular (but not strictly so), i.e. if the row number is less than the column number, the value must be zero.
  * @param m Pointer to the matrix_int_t struct
  * @return boolean.  True if this matrix is lower triangular; false if not.
  */
@@ -423,12 +807,20 @@ m_isNull_int(matrix_int_t *m);
 
 /**
  * @brief Finds if the matrix is symmetric, this means for all x and y, Mxy = Myx
- * @param m Pointer to matrix_int_t object.
+ * @param m Pointer to matrix_int_t object
  * @return boolean.  True if symmetric, false otherwise.
  */
 bool
 m_isSymmetric_int(matrix_int_t *m);
 
+/**
+ * @brief Determines if the matrix is (right) stochastic.  In other words the matrix is square, it has only nonnegative values, and the sum of each row is 1.  For integers this means each row has a single 1.
+ * @param m Pointer to matrix_int_t object.
+ * @return boolean.  True if stochastic, false otherwise.
+ */
+bool
+m_isStochastic_int(matrix_int_t *m);
+
 /**
  * @brief Finds if the matrix is invertible.  This means that this matrix can be multiplied by another matrix to yield the identity matrix.
  * @param m Pointer to matrix_int_t object.
@@ -480,45 +872,4 @@ bool
 m_isNilpotent_int(matrix_int_t *m);
 
 
-
-
-
-
-/**
- * @brief Determines if the matrix is right stochastic.  In other words the matrix is square, it has nonnegative real numbers, and the sum of each row is 1.
- * @param m Pointer to matrix_float_t object.
- * @return boolean.  True if orthogonal, false otherwise.
- * @note Easy to parallelize
- */
-bool
-m_isRightStochastic_float(matrix_float_t *m);
-
-/**
- * @brief Determines if the matrix is left stochastic.  In other words the matrix is square, it has nonnegative real numbers, and the sum of each column is 1.
- * @param m Pointer to matrix_float_t object.
- * @return boolean.  True if orthogonal, false otherwise.
- * @note Easy to parallelize
- */
-bool
-m_isLeftStochastic_float(matrix_float_t *m);
-
-/**
- * @brief Determines if the matrix is doubly stochastic.  In other words the matrix is square, it has nonnegative real numbers, the sum of each row is 1, and sum of each column is 1.
- * @param m Pointer to matrix_float_t object.
- * @return boolean.  True if orthogonal, false otherwise.
- * @note Easy to parallelize
- */
-bool
-m_isDoublyStochastic_float(matrix_float_t *m);
-
-/**
- * @brief Determines if the matrix is substochastic.  In other words the matrix is square, it has nonnegative real numbers, and the sum of each row is less than or equal to 1.  All right and doubly stochastic matrices are substochastic as well
- * @param m Pointer to matrix_float_t object.
- * @return boolean.  True if orthogonal, false otherwise.
- * @note Easy to parallelize
- */
-bool
-m_isSubStochastic_float(matrix_float_t *m);
-
-
 #endif /** MYMATRIX_H */
\ No newline at end of file